@@ -552,6 +552,8 @@ int main(int argc, char *argv[])
 
       sge_mirror_initialize(evc, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr);
       evc->ec_set_busy_handling(evc, EV_BUSY_UNTIL_ACK);
+      /* get the events missed during a reconnect, don't miss job end triggers */
+      evc->ec_set_resumable(evc, true);
 
       /* put out information about -trigger option */
       for (i=0;i<enabled_options.trigger_option_count;i++) {
@@ -48,6 +48,8 @@
 #include "uti/sge_unistd.h"
 #include "uti/sge_bootstrap_files.h"
 
+#include "cull/cull_pack.h"
+
 #include "sgeobj/cull/sge_all_listsL.h"
 #include "sgeobj/sge_host.h"
 #include "sgeobj/parse.h"
@@ -222,6 +224,9 @@ int main(int argc, char *argv[]) {
    cell_root = bootstrap_get_cell_root();
    lInit(nmv);      
 
+   // most sublists of the jobs and queues received are never looked at, unpack them on demand
+   lSetLazyUnpackMode(true);
+
    if (!strcmp(sge_basename(*argv++, '/'), "qselect")) {
       qstat_env.qselect_mode = 1;
    } else {
@@ -175,6 +175,9 @@ sge_read_configuration(const lListElem *aSpoolContext, lList **config_list, lLis
       DRETURN(-1);
    }
 
+   // no worker threads are running yet
+   sge_lock_set_fgl(LOCK_GLOBAL, mconf_get_enable_fine_grained_locking());
+
    sge_show_conf();
 
    DRETURN(0);
@@ -370,6 +373,9 @@ sge_mod_configuration(lListElem *aConf, lList **anAnswer, const char *aUser, con
       cl_com_update_parameter_list(qmaster_params);
       sge_free(&qmaster_params);
 
+      // 'ENABLE_FINE_GRAINED_LOCKING' may have changed, the global lock is held in write mode
+      sge_lock_set_fgl(LOCK_GLOBAL, mconf_get_enable_fine_grained_locking());
+
 
       // propagate possible changes in the reporting_params to reporting writers
       ocs::ReportingFileWriter::update_config_all();
@@ -24,7 +24,8 @@
 namespace ocs {
    class MirrorReaderDataStore : public MirrorServerDataStore {
    public:
-      MirrorReaderDataStore() : MirrorServerDataStore(DataStore::Id::READER, LOCK_READER) {};
+      // reader threads pin versions of the data store so that they are not blocked while events are applied
+      MirrorReaderDataStore() : MirrorServerDataStore(DataStore::Id::READER, LOCK_READER, true) {};
       ~MirrorReaderDataStore() override = default;
       void subscribe_events() override;
       void update_sessions_and_move_requests(const u_long64 unique_id) override;
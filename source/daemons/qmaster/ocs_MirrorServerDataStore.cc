@@ -32,8 +32,9 @@
  *
  * @param data_store_id Data store that will be filled with data.
  * @param lock_type Lock that should be used to secure the data store
+ * @param use_versions Readers pin published versions of the data store instead of using the lock
  */
-ocs::MirrorServerDataStore::MirrorServerDataStore(ocs::DataStore::Id data_store_id, sge_locktype_t lock_type) : MirrorDataStore(data_store_id, lock_type) {
+ocs::MirrorServerDataStore::MirrorServerDataStore(ocs::DataStore::Id data_store_id, sge_locktype_t lock_type, bool use_versions) : MirrorDataStore(data_store_id, lock_type, use_versions) {
    // Additional data stores are not allowed to use the global lock
    SGE_ASSERT(lock_type != LOCK_GLOBAL);
    SGE_ASSERT(data_store_id != DataStore::Id::GLOBAL);
@@ -24,7 +24,7 @@
 namespace ocs {
    class MirrorServerDataStore : public MirrorDataStore {
    public:
-      MirrorServerDataStore(ocs::DataStore::Id data_store_id, sge_locktype_t lock_type);
+      MirrorServerDataStore(ocs::DataStore::Id data_store_id, sge_locktype_t lock_type, bool use_versions = false);
       ~MirrorServerDataStore() override = default;
       void init_event_mirror() override;
       void init_connection() override;
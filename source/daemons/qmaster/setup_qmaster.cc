@@ -1105,6 +1105,9 @@ setup_qmaster() {
          // normalize the priority and store the normalized value
          job_normalize_priority(jep, lGetUlong(jep, JB_priority));
 
+         // share the big sublists with the events and the mirrored data stores
+         job_mark_immutable_sublists_shared(jep);
+
          /* doing this operation we need the complete job list read in */
          job_suc_pre(jep);
 
@@ -35,12 +35,16 @@
 #include "sge_c_report.h"
 
 #include <cstring>
+#include <mutex>
+#include <set>
 
 #include "uti/sge_bootstrap.h"
 #include "uti/sge_log.h"
 #include "uti/sge_rmon_macros.h"
 #include "uti/sge.h"
 #include "uti/sge_hostname.h"
+#include "uti/sge_fgl.h"
+#include "uti/sge_string.h"
 
 #include "sgeobj/ocs_DataStore.h"
 #include "sgeobj/ocs_Version.h"
@@ -62,34 +66,83 @@
 #include "sge_persistence_qmaster.h"
 #include "reschedule.h"
 
+// max number of exec hosts that are reserved for a batch of reports (see sge_c_report_add_fgl_reservations())
+#define REPORT_FGL_MAX_HOSTS 64
+
+/*
+ * sequence number of the last job report that was applied per execution host.
+ * With LOCK_FGL the job reports of a batch are applied after the global lock was
+ * released (see sge_worker_main()). Meanwhile, another worker can handle a newer
+ * report of the same host, so the job part has to check the order on its own
+ */
+static std::mutex job_report_seqno_mutex;
+static std::map<std::string, u_long32> job_report_seqno;
+
 static int
 update_license_data(lListElem *hep, lList *lp_lic, u_long64 gdi_session);
 
+/* true if this_seqno is older than last_seqno, sequence numbers wrap after 9999 */
+static bool
+report_seqno_is_old(u_long32 this_seqno, u_long32 last_seqno) {
+   return (this_seqno < last_seqno && (last_seqno - this_seqno) <= 9000) &&
+          !(last_seqno > 9990 && this_seqno < 10);
+}
+
+/* remember the sequence number of a job report, false if a newer one was applied already */
+static bool
+report_job_seqno_accept(const char *host, u_long32 this_seqno, u_long32 *last_seqno) {
+   std::lock_guard<std::mutex> guard(job_report_seqno_mutex);
+   auto it = job_report_seqno.find(host);
+
+   if (it != job_report_seqno.end() && report_seqno_is_old(this_seqno, it->second)) {
+      *last_seqno = it->second;
+      return false;
+   }
+   job_report_seqno[host] = this_seqno;
+   return true;
+}
+
 
 /****** sge_c_report() *******************************************************
 *  NAME
 *     sge_c_report() -- process execd load report
 *
 *  SYNOPSIS
-*     void sge_c_report(char *rhost, char *commproc, int id, lList *report_list)
+*     bool sge_c_report(char *rhost, char *commproc, int id, lList *report_list,
+*                       monitoring_t *monitor, int parts,
+*                       std::map<std::string, bool> *changed_hosts)
 *
 *  FUNCTION
+*     Handles the reports of an execd. A packet can be handled in two
+*     steps: first the load, configuration and processor reports
+*     (REPORT_PART_HOST) which only modify execution hosts, then the job
+*     reports (REPORT_PART_JOB). Both steps check the sequence number of
+*     the packet: between the two steps another worker thread can apply
+*     the job reports of a newer packet of the same host.
 *
 *  INPUTS
 *     char *rhost
 *     char *commproc
 *     int id
 *     lList *report_list
+*     monitoring_t *monitor
+*     int parts                 - report_part_t values of the reports to handle
+*     std::map<std::string, bool> *changed_hosts
+*                               - if not nullptr then the events for hosts with
+*                                 modified load values are not sent but the
+*                                 hosts are added here. The caller has to call
+*                                 sge_update_load_values_done().
 *
 *  RESULT
-*     void - nothing
+*     bool - false if the packet was rejected (unknown host, old report)
 *
 *  NOTES
 *     MT-NOTE: sge_c_report() is MT safe
 *
 ******************************************************************************/
-void
-sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *commproc, int id, lList *report_list, monitoring_t *monitor) {
+bool
+sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *commproc, int id, lList *report_list, monitoring_t *monitor,
+             int parts, std::map<std::string, bool> *changed_hosts) {
    lListElem *hep = nullptr;
    u_long32 rep_type;
    lListElem *report;
@@ -109,7 +162,7 @@ sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *
       } else {
          WARNING(MSG_QMASTER_RECEIVED_EMPTY_LOAD_REPORT_S, "unknown");
       }
-      DRETURN_VOID;
+      DRETURN(false);
    }
 
 #ifdef OBSERVE
@@ -145,13 +198,13 @@ sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *
    /* accept reports only from execd's */
    if (strcmp(prognames[EXECD], commproc)) {
       ERROR(MSG_GOTSTATUSREPORTOFUNKNOWNCOMMPROC_S, commproc);
-      DRETURN_VOID;
+      DRETURN(false);
    }
 
    /* do not process load reports from old execution daemons */
    rversion = lGetUlong(lFirst(report_list), REP_version);
    if (!ocs::Version::do_versions_match(nullptr, rversion, rhost, commproc, id)) {
-      DRETURN_VOID;
+      DRETURN(false);
    }
 
    this_seqno = lGetUlong(lFirst(report_list), REP_seqno);
@@ -159,27 +212,43 @@ sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *
    /* need exec host for all types of reports */
    if (!(hep = host_list_locate(*ocs::DataStore::get_master_list(SGE_TYPE_EXECHOST), rhost))) {
       ERROR(MSG_GOTSTATUSREPORTOFUNKNOWNEXECHOST_S, rhost);
-      DRETURN_VOID;
+      DRETURN(false);
    }
 
    /* prevent old reports being proceeded 
       frequent loggings of outdated reports can be an indication 
-      of too high message traffic arriving at qmaster */
-   last_seqno = lGetUlong(hep, EH_report_seqno);
+      of too high message traffic arriving at qmaster.
+      the job part of a packet has already passed this check with the host part */
+   if ((parts & REPORT_PART_HOST) != 0) {
+      last_seqno = lGetUlong(hep, EH_report_seqno);
+
+      if (report_seqno_is_old(this_seqno, last_seqno)) {
+         /* this must be an old report, log and then ignore it */
+         INFO(MSG_QMASTER_RECEIVED_OLD_LOAD_REPORT_UUS, this_seqno, last_seqno, rhost);
+         DRETURN(false);
+      }
+
+      lSetUlong(hep, EH_report_seqno, this_seqno);
+   }
 
-   if ((this_seqno < last_seqno && (last_seqno - this_seqno) <= 9000) &&
-       !(last_seqno > 9990 && this_seqno < 10)) {
-      /* this must be an old report, log and then ignore it */
+   /* the job part of an older packet must not overwrite the job state of a newer one
+      that was applied between the host part and the job part of this packet */
+   if ((parts & REPORT_PART_JOB) != 0 && sge_c_report_has_job_report(packet) &&
+       !report_job_seqno_accept(lGetHost(hep, EH_name), this_seqno, &last_seqno)) {
       INFO(MSG_QMASTER_RECEIVED_OLD_LOAD_REPORT_UUS, this_seqno, last_seqno, rhost);
-      DRETURN_VOID;
+      DRETURN(false);
    }
 
-   lSetUlong(hep, EH_report_seqno, this_seqno);
+   /* the reschedule unknown list belongs to the job reports of a packet,
+      for packets without job reports it is handled with the host part */
+   bool handle_reschedule_unknown = (parts & REPORT_PART_JOB) != 0 || !sge_c_report_has_job_report(packet);
 
    /* RU: */
    /* tag all reschedule_unknown list entries we hope to 
       hear about in that job report */
-   update_reschedule_unknown_list(hep, packet->gdi_session);
+   if (handle_reschedule_unknown) {
+      update_reschedule_unknown_list(hep, packet->gdi_session);
+   }
 
    /*
    ** process the reports one after the other
@@ -189,6 +258,10 @@ sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *
    for_each_rw(report, report_list) {
       rep_type = lGetUlong(report, REP_type);
 
+      if ((parts & (rep_type == NUM_REP_REPORT_JOB ? REPORT_PART_JOB : REPORT_PART_HOST)) == 0) {
+         continue;
+      }
+
       switch (rep_type) {
          case NUM_REP_REPORT_LOAD:
          case NUM_REP_FULL_REPORT_LOAD:
@@ -201,7 +274,7 @@ sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *
                   is_pb_used = true;
                   init_packbuffer(&pb, 1024);
                }
-               sge_update_load_values(rhost, lGetListRW(report, REP_list), packet->gdi_session);
+               sge_update_load_values(rhost, lGetListRW(report, REP_list), packet->gdi_session, changed_hosts);
 
                if (mconf_get_simulate_execds()) {
                   const lList *master_exechost_list = *ocs::DataStore::get_master_list(SGE_TYPE_EXECHOST);
@@ -223,7 +296,7 @@ sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *
                                  lSetHost(clp, LR_host, sim_host);
                               }
                            }
-                           sge_update_load_values(sim_host, lGetListRW(report, REP_list), packet->gdi_session);
+                           sge_update_load_values(sim_host, lGetListRW(report, REP_list), packet->gdi_session, changed_hosts);
                         }
                      }
                   }
@@ -267,7 +340,9 @@ sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *
 
    /* RU: */
    /* delete reschedule unknown list entries we heard about */
-   delete_from_reschedule_unknown_list(hep, packet->gdi_session);
+   if (handle_reschedule_unknown) {
+      delete_from_reschedule_unknown_list(hep, packet->gdi_session);
+   }
 
    if (is_pb_used) {
       if (pb_filled(&pb)) {
@@ -286,9 +361,252 @@ sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *rhost, char *
       }
    }
 
-   DRETURN_VOID;
+   DRETURN(true);
 } /* sge_c_report */
 
+static lListElem *
+report_list_locate_load_report(lList *report_list) {
+   lListElem *report;
+
+   for_each_rw(report, report_list) {
+      u_long32 rep_type = lGetUlong(report, REP_type);
+
+      if (rep_type == NUM_REP_REPORT_LOAD || rep_type == NUM_REP_FULL_REPORT_LOAD) {
+         return report;
+      }
+   }
+   return nullptr;
+}
+
+static const lListElem *
+load_list_locate(const lList *load_list, const char *name, const char *host) {
+   const lListElem *ep;
+
+   for_each_ep(ep, load_list) {
+      if (sge_strnullcmp(lGetString(ep, LR_name), name) == 0 &&
+          sge_hostcmp(lGetHost(ep, LR_host), host) == 0) {
+         return ep;
+      }
+   }
+   return nullptr;
+}
+
+/**
+ * @brief Merges the load reports of pending report packets of the same execution host.
+ *
+ * Execution daemons send a load report each load_report_time. If the qmaster is busy then
+ * multiple reports of the same host might be waiting in the request queue. Only the most
+ * recent load values are of interest, therefore the load values of an older load report are
+ * moved into the next load report of the same host unless the newer report contains the
+ * same load value (LR_name and LR_host) itself.
+ *
+ * The load report is removed from the older packet. Packets that do not contain
+ * any other report afterwards are deleted and removed from the vector.
+ * The order of the remaining packets is not changed so that the sequence number
+ * checks in sge_c_report() still work.
+ *
+ * Older load reports are not acknowledged to the execution daemon. This is harmless
+ * because the execd will resend values of reports that were not acknowledged.
+ *
+ * @param reports report packets in the sequence they were received
+ */
+void
+sge_c_report_coalesce(std::vector<ocs::gdi::Packet *> &reports) {
+   DENTER(TOP_LAYER);
+
+   for (size_t i = 0; i < reports.size(); i++) {
+      ocs::gdi::Packet *older = reports[i];
+      lList *older_report_list = older->tasks[0]->data_list;
+      lListElem *older_report = report_list_locate_load_report(older_report_list);
+
+      if (older_report == nullptr) {
+         continue;
+      }
+
+      // find the next load report of the same execd
+      lListElem *newer_report = nullptr;
+      for (size_t j = i + 1; j < reports.size() && newer_report == nullptr; j++) {
+         ocs::gdi::Packet *newer = reports[j];
+
+         if (sge_hostcmp(older->host, newer->host) == 0 && strcmp(older->commproc, newer->commproc) == 0) {
+            newer_report = report_list_locate_load_report(newer->tasks[0]->data_list);
+         }
+      }
+      if (newer_report == nullptr) {
+         continue;
+      }
+
+      // move the load values that are not part of the newer report
+      lList *older_load_list = nullptr;
+      lXchgList(older_report, REP_list, &older_load_list);
+      lList *newer_load_list = lGetListRW(newer_report, REP_list);
+      lListElem *lr;
+      while ((lr = lFirstRW(older_load_list)) != nullptr) {
+         lr = lDechainElem(older_load_list, lr);
+         if (load_list_locate(newer_load_list, lGetString(lr, LR_name), lGetHost(lr, LR_host)) != nullptr) {
+            lFreeElem(&lr);
+         } else {
+            if (newer_load_list == nullptr) {
+               newer_load_list = lCreateList("load values", LR_Type);
+               lSetList(newer_report, REP_list, newer_load_list);
+            }
+            lAppendElem(newer_load_list, lr);
+         }
+      }
+      lFreeList(&older_load_list);
+
+      // the merged report contains all values if one of both was a full report
+      if (lGetUlong(older_report, REP_type) == NUM_REP_FULL_REPORT_LOAD) {
+         lSetUlong(newer_report, REP_type, NUM_REP_FULL_REPORT_LOAD);
+      }
+
+      DPRINTF("coalesced load report " sge_u32 " of host %s into a newer one\n", lGetUlong(older_report, REP_seqno), older->host);
+      lRemoveElem(older_report_list, &older_report);
+      if (lGetNumberOfElem(older_report_list) == 0) {
+         delete older;
+         reports[i] = nullptr;
+      }
+   }
+
+   std::erase(reports, nullptr);
+
+   DRETURN_VOID;
+}
+
+/**
+ * @brief Checks if the host part of a report packet can be handled with fine-grained locking.
+ *
+ * Load, configuration and processor reports only modify the execution host objects they
+ * belong to. Job reports modify jobs and queue instances, they are handled afterwards with
+ * the global write lock (REPORT_PART_JOB). The simulation of execution hosts modifies
+ * arbitrary hosts and unknown report types are not known to be harmless, such packets
+ * require the global write lock completely.
+ *
+ * @param packet report packet
+ * @return true if sge_c_report() may be called with LOCK_FGL and REPORT_PART_HOST
+ */
+bool
+sge_c_report_is_fgl_capable(const ocs::gdi::Packet *packet) {
+   DENTER(TOP_LAYER);
+
+   if (mconf_get_simulate_execds()) {
+      DRETURN(false);
+   }
+
+   const lListElem *report;
+   for_each_ep(report, packet->tasks[0]->data_list) {
+      u_long32 rep_type = lGetUlong(report, REP_type);
+
+      if (rep_type != NUM_REP_REPORT_LOAD && rep_type != NUM_REP_FULL_REPORT_LOAD &&
+          rep_type != NUM_REP_REPORT_CONF && rep_type != NUM_REP_REPORT_PROCESSORS &&
+          rep_type != NUM_REP_REPORT_JOB) {
+         DRETURN(false);
+      }
+   }
+   DRETURN(true);
+}
+
+/**
+ * @brief Checks if a report packet contains a job report.
+ *
+ * @param packet report packet
+ * @return true if the packet has to be handled with REPORT_PART_JOB as well
+ */
+bool
+sge_c_report_has_job_report(const ocs::gdi::Packet *packet) {
+   return lGetElemUlong(packet->tasks[0]->data_list, REP_type, NUM_REP_REPORT_JOB) != nullptr;
+}
+
+/**
+ * @brief Forgets the sequence number of the last job report of a host.
+ *
+ * Has to be called together with resetting EH_report_seqno when an execd
+ * starts, because the execd then starts counting from the beginning.
+ *
+ * @param host name of the execution host
+ */
+void
+sge_c_report_reset_seqno(const char *host) {
+   std::lock_guard<std::mutex> guard(job_report_seqno_mutex);
+   job_report_seqno.erase(host);
+}
+
+static void
+report_add_host(std::set<const lListElem *> &hosts, const lList *master_exechost_list, const char *hostname) {
+   const lListElem *hep = host_list_locate(master_exechost_list, hostname);
+
+   // unknown hosts are skipped by sge_c_report() and sge_update_load_values()
+   if (hep != nullptr) {
+      hosts.insert(hep);
+   }
+}
+
+/**
+ * @brief Registers the fine-grained lock reservations for a batch of report packets.
+ *
+ * The master exechost list is reserved read-only, each execution host that sent a report
+ * or that is referenced by a load value is reserved read-write. Host names are resolved
+ * to the names of the host objects therefore the function has to be called when the
+ * global lock is already held in LOCK_FGL mode. The reservations are only valid as long
+ * as the global lock is held.
+ *
+ * Reports of hosts that were not heard from till now switch the state of queue instances
+ * and the reservations would exceed the fgl limits if there are too many hosts. In those
+ * cases no reservations are done and the reports have to be handled with the global
+ * write lock.
+ *
+ * Only the host part of the reports is handled with these reservations, job reports
+ * require the global write lock.
+ *
+ * @param reports report packets that passed sge_c_report_is_fgl_capable()
+ * @return true if the reservations have been added
+ */
+bool
+sge_c_report_add_fgl_reservations(const std::vector<ocs::gdi::Packet *> &reports) {
+   DENTER(TOP_LAYER);
+
+   const lList *master_exechost_list = *ocs::DataStore::get_master_list(SGE_TYPE_EXECHOST);
+   std::set<const lListElem *> hosts;
+
+   for (const auto *packet : reports) {
+      const lListElem *hep = host_list_locate(master_exechost_list, packet->host);
+
+      if (hep == nullptr) {
+         continue;
+      }
+      if (lGetUlong64(hep, EH_lt_heard_from) == 0) {
+         DRETURN(false);
+      }
+      hosts.insert(hep);
+
+      const lListElem *report;
+      for_each_ep(report, packet->tasks[0]->data_list) {
+         u_long32 rep_type = lGetUlong(report, REP_type);
+
+         if (rep_type == NUM_REP_REPORT_LOAD || rep_type == NUM_REP_FULL_REPORT_LOAD) {
+            const lListElem *lr;
+
+            for_each_ep(lr, lGetList(report, REP_list)) {
+               if (lGetUlong(lr, LR_global)) {
+                  report_add_host(hosts, master_exechost_list, SGE_GLOBAL_NAME);
+               } else if (lGetHost(lr, LR_host) != nullptr) {
+                  report_add_host(hosts, master_exechost_list, lGetHost(lr, LR_host));
+               }
+            }
+         }
+      }
+      if (hosts.size() > REPORT_FGL_MAX_HOSTS) {
+         DRETURN(false);
+      }
+   }
+
+   fgl_add_r(SGE_TYPE_EXECHOST, false);
+   for (const auto *hep : hosts) {
+      fgl_add_s(SGE_TYPE_EXECHOST, lGetHost(hep, EH_name), true);
+   }
+   DRETURN(true);
+}
+
 /*
 ** NAME
 **   update_license_data
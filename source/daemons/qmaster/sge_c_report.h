@@ -34,10 +34,32 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "cull/cull.h"
 #include "uti/sge_monitor.h"
 
 #include "gdi/ocs_gdi_Packet.h"
 
 
-void sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *aHost, char *aCommproc, int anId, lList *aReport, monitoring_t *monitor);
+// parts of a report packet that are handled by sge_c_report()
+enum report_part_t {
+   REPORT_PART_HOST = 1,   // load, configuration and processor reports
+   REPORT_PART_JOB = 2,    // job reports
+   REPORT_PART_ALL = REPORT_PART_HOST | REPORT_PART_JOB
+};
+
+bool sge_c_report(ocs::gdi::Packet *packet, ocs::gdi::Task *task, char *aHost, char *aCommproc, int anId, lList *aReport, monitoring_t *monitor,
+                  int parts, std::map<std::string, bool> *changed_hosts);
+
+void sge_c_report_coalesce(std::vector<ocs::gdi::Packet *> &reports);
+
+bool sge_c_report_is_fgl_capable(const ocs::gdi::Packet *packet);
+
+bool sge_c_report_has_job_report(const ocs::gdi::Packet *packet);
+
+void sge_c_report_reset_seqno(const char *host);
+
+bool sge_c_report_add_fgl_reservations(const std::vector<ocs::gdi::Packet *> &reports);
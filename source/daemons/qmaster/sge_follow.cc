@@ -110,6 +110,14 @@ static int ticket_orders_field[] = {OR_job_number,
                                     OR_ticket,
                                     NoName};
 
+/* job attributes modified by the priority and ticket orders, only these are sent to the mirror threads */
+static const int job_priority_field[] = {JB_nurg,
+                                         JB_urg,
+                                         JB_rrcontr,
+                                         JB_dlcontr,
+                                         JB_wtcontr,
+                                         NoName};
+
 /** @brief sets the next spooling time for stree/prj/user
  *
  *  This function sets the next spooling time. It is called by the scheduler
@@ -760,7 +768,8 @@ sge_follow_order(lListElem *ep, char *ruser, char *rhost, lList **topp, monitori
 
             sge_mutex_unlock("follow_last_update_mutex", __func__, __LINE__, &Follow_Control.last_update_mutex);
             // @todo CS-913 we should have the tickets in sub-objects and have a ticket event having only the sub-object as data
-            sge_add_event(now, sgeE_JOB_MOD, job_number, 0, nullptr, nullptr, nullptr, jep, gdi_session);
+            sge_add_delta_event(now, sgeE_JOB_MOD, job_number, 0, nullptr, nullptr, nullptr, jep, job_priority_field,
+                                gdi_session);
          }
          break;
 
@@ -867,7 +876,8 @@ sge_follow_order(lListElem *ep, char *ruser, char *rhost, lList **topp, monitori
             if (send_task_event) {
                sge_add_event(now, sgeE_JATASK_MOD, job_number, task_number, nullptr, nullptr, nullptr, jatp, gdi_session);
             }
-            sge_add_event(now, sgeE_JOB_MOD, job_number, 0, nullptr, nullptr, nullptr, jep, gdi_session);
+            sge_add_delta_event(now, sgeE_JOB_MOD, job_number, 0, nullptr, nullptr, nullptr, jep, job_priority_field,
+                                gdi_session);
 
 #if 0
             DPRINTF(("PRIORITY: " sge_u32 "." sge_u32" %f/%f tix/ntix %f npri %f/%f urg/nurg %f prio\n",
@@ -1070,7 +1080,8 @@ sge_follow_order(lListElem *ep, char *ruser, char *rhost, lList **topp, monitori
                }
             }
             sge_add_event(now, sgeE_JATASK_MOD, job_number, task_number, nullptr, nullptr, nullptr, jatp, gdi_session);
-            sge_add_event(now, sgeE_JOB_MOD, job_number, 0, nullptr, nullptr, nullptr, jep, gdi_session);
+            sge_add_delta_event(now, sgeE_JOB_MOD, job_number, 0, nullptr, nullptr, nullptr, jep, job_priority_field,
+                                gdi_session);
          }
          break;
 
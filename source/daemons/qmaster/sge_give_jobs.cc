@@ -99,6 +99,10 @@
 
 #include <ocs_gdi_ClientServerBase.h>
 
+/* attributes changed by (un)debiting consumables, only these are sent to the mirror threads */
+static const int host_utilization_field[] = {EH_resource_utilization, NoName};
+static const int qinstance_utilization_field[] = {QU_resource_utilization, NoName};
+
 static void
 sge_clear_granted_resources(lListElem *jep, lListElem *ja_task, int incslots,
                             monitoring_t *monitor, u_long64 gdi_session);
@@ -1015,8 +1019,8 @@ sge_commit_job(lListElem *jep, lListElem *jatep, lListElem *jr, sge_commit_mode_
                                          do_per_global_host_booking,
                                          nullptr) > 0) {
                   /* this info is not spooled */
-                  sge_add_event(0, sgeE_EXECHOST_MOD, 0, 0,
-                                "global", nullptr, nullptr, global_host_ep, gdi_session);
+                  sge_add_delta_event(0, sgeE_EXECHOST_MOD, 0, 0, "global", nullptr, nullptr, global_host_ep,
+                                      host_utilization_field, gdi_session);
                   ocs::ReportingFileWriter::create_host_consumable_records(&answer_list, global_host_ep, jep, now);
                   answer_list_output(&answer_list);
                }
@@ -1024,8 +1028,8 @@ sge_commit_job(lListElem *jep, lListElem *jatep, lListElem *jr, sge_commit_mode_
                if (debit_host_consumable(jep, jatep, pe, host, master_centry_list, tmp_slot, master_task,
                                          do_per_host_booking, nullptr) > 0) {
                   /* this info is not spooled */
-                  sge_add_event(0, sgeE_EXECHOST_MOD, 0, 0,
-                                queue_hostname, nullptr, nullptr, host, gdi_session);
+                  sge_add_delta_event(0, sgeE_EXECHOST_MOD, 0, 0, queue_hostname, nullptr, nullptr, host,
+                                      host_utilization_field, gdi_session);
                   ocs::ReportingFileWriter::create_host_consumable_records(&answer_list, host, jep, now);
                   answer_list_output(&answer_list);
                }
@@ -1034,7 +1038,7 @@ sge_commit_job(lListElem *jep, lListElem *jatep, lListElem *jr, sge_commit_mode_
                ocs::ReportingFileWriter::create_queue_consumable_records(&answer_list, host, queue, jep, now);
                answer_list_output(&answer_list);
                /* this info is not spooled */
-               qinstance_add_event(queue, sgeE_QINSTANCE_MOD, gdi_session);
+               qinstance_add_delta_event(queue, sgeE_QINSTANCE_MOD, qinstance_utilization_field, gdi_session);
 
                if (ar_id == 0) {
                   /* debit resource quota set */
@@ -1584,7 +1588,8 @@ sge_clear_granted_resources(lListElem *job, lListElem *ja_task, int incslots, mo
             if (debit_host_consumable(job, ja_task, pe, global_host_ep, master_centry_list, -tmp_slot, master_task,
                                       do_per_global_host_booking, nullptr) > 0) {
                /* this info is not spooled */
-               sge_add_event(0, sgeE_EXECHOST_MOD, 0, 0, SGE_GLOBAL_NAME, nullptr, nullptr, global_host_ep, gdi_session);
+               sge_add_delta_event(0, sgeE_EXECHOST_MOD, 0, 0, SGE_GLOBAL_NAME, nullptr, nullptr, global_host_ep,
+                                   host_utilization_field, gdi_session);
                ocs::ReportingFileWriter::create_host_consumable_records(&answer_list, global_host_ep, job, now);
                answer_list_output(&answer_list);
             }
@@ -1592,7 +1597,8 @@ sge_clear_granted_resources(lListElem *job, lListElem *ja_task, int incslots, mo
             if (debit_host_consumable(job, ja_task, pe, host, master_centry_list, -tmp_slot, master_task,
                                       do_per_host_booking, nullptr) > 0) {
                /* this info is not spooled */
-               sge_add_event(0, sgeE_EXECHOST_MOD, 0, 0, queue_hostname, nullptr, nullptr, host, gdi_session);
+               sge_add_delta_event(0, sgeE_EXECHOST_MOD, 0, 0, queue_hostname, nullptr, nullptr, host,
+                                   host_utilization_field, gdi_session);
                ocs::ReportingFileWriter::create_host_consumable_records(&answer_list, host, job, now);
                answer_list_output(&answer_list);
             }
@@ -1600,7 +1606,7 @@ sge_clear_granted_resources(lListElem *job, lListElem *ja_task, int incslots, mo
                                        do_per_host_booking, nullptr);
             ocs::ReportingFileWriter::create_queue_consumable_records(&answer_list, host, queue, job, now);
             /* this info is not spooled */
-            qinstance_add_event(queue, sgeE_QINSTANCE_MOD, gdi_session);
+            qinstance_add_delta_event(queue, sgeE_QINSTANCE_MOD, qinstance_utilization_field, gdi_session);
 
             if (ar_id == 0) {
                /* undebit resource quota set */
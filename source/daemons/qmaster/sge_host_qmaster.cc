@@ -50,6 +50,7 @@
 #include "sgeobj/sge_feature.h"
 #include "sgeobj/sge_id.h"
 #include "sgeobj/sge_host.h"
+#include "sgeobj/sge_load.h"
 #include "sgeobj/sge_manop.h"
 #include "sgeobj/sge_answer.h"
 #include "sgeobj/sge_job.h"
@@ -91,6 +92,7 @@
 #include "sge_persistence_qmaster.h"
 #include "sge_advance_reservation_qmaster.h"
 #include "sge_job_enforce_limit.h"
+#include "sge_c_report.h"
 
 static void
 exec_host_change_queue_version(const char *exechost_name, u_long64 gdi_session);
@@ -682,13 +684,38 @@ sge_mark_unheard(lListElem *hep, u_long64 gdi_session) {
    DRETURN_VOID;
 }
 
+/* ----------------------------------------
+
+   sends the event and creates the reporting record for a host
+   with modified load values, or only remembers the host in
+   changed_hosts if this is not nullptr
+*/
+static void
+load_values_changed(lList **answer_list, lListElem *hep, bool statics_changed, u_long64 now,
+                    std::map<std::string, bool> *changed_hosts, u_long64 gdi_session) {
+   if (changed_hosts != nullptr) {
+      // a host is spooled if the static load values of one of its reports have changed
+      (*changed_hosts)[lGetHost(hep, EH_name)] |= statics_changed;
+   } else {
+      sge_event_spool(answer_list, 0, sgeE_EXECHOST_MOD,
+                      0, 0, lGetHost(hep, EH_name), nullptr, nullptr,
+                      hep, nullptr, nullptr, true, statics_changed, gdi_session);
+      ocs::ReportingFileWriter::create_host_records(answer_list, hep, now);
+   }
+}
+
 /* ----------------------------------------
 
    updates global and host specific load values
    using the load report list lp
+
+   if changed_hosts is not nullptr then the events and
+   reporting records for the modified hosts are not created here
+   but the hosts are added to changed_hosts and the caller
+   has to call sge_update_load_values_done()
 */
 void
-sge_update_load_values(const char *rhost, lList *lp, u_long64 gdi_session) {
+sge_update_load_values(const char *rhost, lList *lp, u_long64 gdi_session, std::map<std::string, bool> *changed_hosts) {
    lListElem *ep, **hepp = nullptr;
    lListElem *lep;
    lListElem *global_ep = nullptr;
@@ -749,10 +776,7 @@ sge_update_load_values(const char *rhost, lList *lp, u_long64 gdi_session) {
       if (*hepp == nullptr || sge_hostcmp(host, lGetHost(*hepp, EH_name)) != 0) {
          if (*hepp != nullptr) {
             /* we have a host change, send events for the previous one */
-            sge_event_spool(&answer_list, 0, sgeE_EXECHOST_MOD,
-                            0, 0, lGetHost(*hepp, EH_name), nullptr, nullptr,
-                            host_ep, nullptr, nullptr, true, statics_changed, gdi_session);
-            ocs::ReportingFileWriter::create_host_records(&answer_list, *hepp, now);
+            load_values_changed(&answer_list, *hepp, statics_changed, now, changed_hosts, gdi_session);
             statics_changed = false;
          }
 
@@ -787,8 +811,8 @@ sge_update_load_values(const char *rhost, lList *lp, u_long64 gdi_session) {
             }
          }
 
-         /* copy value */
-         lSetString(lep, HL_value, value);
+         /* copy value, numbers are parsed once here instead of in every scheduling run */
+         load_set_value(lep, value);
          lSetUlong64(lep, HL_last_update, now);
          lSetBool(lep, HL_is_static, is_static);
       }
@@ -798,20 +822,40 @@ sge_update_load_values(const char *rhost, lList *lp, u_long64 gdi_session) {
    ** if static load values (eg arch) have changed
    ** then spool
    */
-   if (hepp != nullptr && *hepp != nullptr) {
-      sge_event_spool(&answer_list, 0, sgeE_EXECHOST_MOD,
-                      0, 0, lGetHost(*hepp, EH_name), nullptr, nullptr,
-                      *hepp, nullptr, nullptr, true, statics_changed, gdi_session);
+   if (host_ep != nullptr) {
+      load_values_changed(&answer_list, host_ep, statics_changed, now, changed_hosts, gdi_session);
+   }
 
-      ocs::ReportingFileWriter::create_host_records(&answer_list, *hepp, now);
+   if (global_ep != nullptr) {
+      load_values_changed(&answer_list, global_ep, false, now, changed_hosts, gdi_session);
    }
+   answer_list_output(&answer_list);
+
+   DRETURN_VOID;
+}
+
+/* ----------------------------------------
 
-   if (global_ep) {
-      sge_event_spool(&answer_list, 0, sgeE_EXECHOST_MOD,
-                      0, 0, SGE_GLOBAL_NAME, nullptr, nullptr,
-                      global_ep, nullptr, nullptr, true, false, gdi_session);
-      ocs::ReportingFileWriter::create_host_records(&answer_list, global_ep, now);
+   sends one event and creates one reporting record per host
+   after the load values of a batch of load reports have been
+   applied with sge_update_load_values()
+*/
+void
+sge_update_load_values_done(std::map<std::string, bool> &changed_hosts, u_long64 gdi_session) {
+   lList *answer_list = nullptr;
+   const lList *master_ehost_list = *ocs::DataStore::get_master_list(SGE_TYPE_EXECHOST);
+   u_long64 now = sge_get_gmt64();
+
+   DENTER(TOP_LAYER);
+
+   for (const auto &[host, statics_changed] : changed_hosts) {
+      lListElem *hep = lGetElemHostRW(master_ehost_list, EH_name, host.c_str());
+
+      if (hep != nullptr) {
+         load_values_changed(&answer_list, hep, statics_changed, now, nullptr, gdi_session);
+      }
    }
+   changed_hosts.clear();
    answer_list_output(&answer_list);
 
    DRETURN_VOID;
@@ -1217,6 +1261,7 @@ sge_execd_startedup(ocs::gdi::Packet *packet, ocs::gdi::Task *task, lListElem *h
 
    lSetUlong(hep, EH_featureset_id, lGetUlong(host, EH_featureset_id));
    lSetUlong(hep, EH_report_seqno, 0);
+   sge_c_report_reset_seqno(lGetHost(hep, EH_name));
 
    /*
     * reinit state of all qinstances at this host according to initial_state
@@ -33,6 +33,9 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <map>
+#include <string>
+
 #include "uti/sge_monitor.h"
 
 #include "sgeobj/sge_daemonize.h"
@@ -69,7 +72,10 @@ void
 sge_gdi_kill_exechost(ocs::gdi::Packet *packet, ocs::gdi::Task *task);
 
 void
-sge_update_load_values(const char *rhost, lList *lp, u_long64 gdi_session);
+sge_update_load_values(const char *rhost, lList *lp, u_long64 gdi_session, std::map<std::string, bool> *changed_hosts);
+
+void
+sge_update_load_values_done(std::map<std::string, bool> &changed_hosts, u_long64 gdi_session);
 
 void
 sge_load_value_cleanup_handler(te_event_t anEvent, monitoring_t *monitor);
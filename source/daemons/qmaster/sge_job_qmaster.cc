@@ -276,6 +276,9 @@ sge_gdi_add_job(lListElem **jep, lList **alpp, lList **lpp,
                                                  master_userset_list, master_project_list, master_rqs_list,
                                                  true, packet->gdi_session);
 
+   // the event, the master job list and the mirrored data stores reference the same big sublists
+   job_mark_immutable_sublists_shared(*jep);
+
    // Handle job spooling and event
    if (!sge_event_spool(alpp, 0, sgeE_JOB_ADD,
                         lGetUlong(*jep, JB_job_number), 0, nullptr, nullptr, nullptr,
@@ -370,6 +373,7 @@ sge_gdi_del_job(const ocs::gdi::Packet *packet, ocs::gdi::Task *task,  lListElem
    int user_list_flag = false;
    const char *jid_str;
    lCondition *job_where = nullptr;
+   lCompiledWhere *job_filter = nullptr;
    lList *user_list = nullptr;
    int njobs = 0;
    u_long32 deleted_tasks = 0;
@@ -467,6 +471,7 @@ sge_gdi_del_job(const ocs::gdi::Packet *packet, ocs::gdi::Task *task,  lListElem
 
    job_list_filter(user_list_flag ? user_list : nullptr,
                    jid_flag ? jid_str : nullptr, &job_where);
+   job_filter = lCompileWhere(job_where, lGetListDescr(master_job_list));
 
    u_long64 start_time = sge_get_gmt64();
 
@@ -495,7 +500,7 @@ sge_gdi_del_job(const ocs::gdi::Packet *packet, ocs::gdi::Task *task,  lListElem
       nxt = lNextRW(job);
 #endif
 
-      if ((job_where != nullptr) && !lCompare(job, job_where)) {
+      if (!lCompareCompiled(job, job_filter)) {
          continue;
       }
       job_number = lGetUlong(job, JB_job_number);
@@ -515,11 +520,13 @@ sge_gdi_del_job(const ocs::gdi::Packet *packet, ocs::gdi::Task *task,  lListElem
                                            &deletion_time_reached);
 
       if (deletion_time_reached) {
+         lFreeCompiledWhere(&job_filter);
          lFreeWhere(&job_where);
          DRETURN(STATUS_OK);
       }
    }
 
+   lFreeCompiledWhere(&job_filter);
    lFreeWhere(&job_where);
 
    if (!njobs && !deleted_tasks) {
@@ -1280,6 +1287,9 @@ sge_gdi_mod_job(const ocs::gdi::Packet *packet, ocs::gdi::Task *task, lListElem
          bool dbret;
          lList *answer_list = nullptr;
 
+         // sublists replaced by qalter are private copies
+         job_mark_immutable_sublists_shared(new_job);
+
          // @todo CS-1156: Why not also for PRIO_EVENT, RECHAIN_JID_HOLD and RECHAIN_JA_AD_HOLD
          if (trigger & MOD_EVENT) {
             lSetUlong(new_job, JB_version, lGetUlong(new_job, JB_version) + 1);
@@ -35,9 +35,12 @@
 #include "sge_qmaster_process_message.h"
 
 #include <cstring>
+#include <set>
+#include <string>
 #include <unistd.h>
 
 #include "uti/sge_bootstrap.h"
+#include "uti/sge_fgl.h"
 #include "uti/sge_lock.h"
 #include "uti/sge_log.h"
 #include "uti/sge_rmon_macros.h"
@@ -48,6 +51,8 @@
 #include "sgeobj/sge_conf.h"
 #include "sgeobj/sge_job.h"
 #include "sgeobj/sge_cqueue.h"
+#include "sgeobj/sge_id.h"
+#include "sgeobj/sge_qinstance_state.h"
 #include "sgeobj/sge_answer.h"
 #include "sgeobj/sge_ack.h"
 #include "sgeobj/ocs_Version.h"
@@ -69,6 +74,8 @@
 #include "msg_common.h"
 #include "msg_daemons_common.h"
 
+// max number of queue instances that are reserved for a qmod request (see sge_c_gdi_add_fgl_reservations())
+#define GDI_FGL_MAX_QINSTANCES 64
 
 static void
 do_gdi_packet(ocs::gdi::ClientServerBase::struct_msg_t *aMsg, monitoring_t *monitor);
@@ -115,8 +122,10 @@ ocs_store_packet(const ocs::gdi::ClientServerBase::struct_msg_t *message, lList
                                 &data_list, nullptr, nullptr, nullptr, false);
    packet->append_task(task);
 
-   // Put the packet into the task queue so that workers can handle it
-   sge_tq_store_notify(GlobalRequestQueue, SGE_TQ_GDI_PACKET, packet);
+   // Put the packet into the task queue so that workers can handle it.
+   // Report packets are typed so that a worker can pick up further pending reports and handle them as a batch
+   sge_tq_type_t tq_type = type == PACKET_REPORT_REQUEST ? SGE_TQ_REPORT_PACKET : SGE_TQ_GDI_PACKET;
+   sge_tq_store_notify(GlobalRequestQueue, tq_type, packet);
 }
 
 /**
@@ -443,6 +452,7 @@ do_gdi_packet(ocs::gdi::ClientServerBase::struct_msg_t *aMsg, monitoring_t *moni
    }
 
    // handle errors that might have happened above and then exit
+   // e.g. a version mismatch: use the default format, older clients have to read the answer
    if (!local_ret) {
       init_packbuffer(&packet->pb, 0);
 
@@ -475,7 +485,8 @@ do_gdi_packet(ocs::gdi::ClientServerBase::struct_msg_t *aMsg, monitoring_t *moni
    bool ds_enabled = !mconf_get_disable_secondary_ds();
    if (ds_enabled && ds_type == ocs::DataStore::LISTENER) {
       // prepare packbuffer for the clients answer
-      init_packbuffer(&(packet->pb), 0);
+      // use the compact format only if the client announced that it can read it
+      init_packbuffer(&(packet->pb), 0, false, true, ocs::Version::is_compact_pack_supported(packet->version));
 
       lList *tmp_answer_list = nullptr;
       packet->pack_header(&tmp_answer_list, &packet->pb);
@@ -634,7 +645,8 @@ do_event_client_exit(ocs::gdi::ClientServerBase::struct_msg_t *aMsg, monitoring_
 /**
  * @brief handles an ACK request.
  *
- * Requires the global lock to get access to the main data store.
+ * Requires the global lock to get access to the main data store. Either in write mode or
+ * in LOCK_FGL mode together with the reservations of sge_c_ack_add_fgl_reservations().
  *
  * Handles:
  *    - an execd sends an ack for a received job
@@ -668,7 +680,6 @@ sge_c_ack(ocs::gdi::Packet *packet, ocs::gdi::Task *task, monitoring_t *monitor)
       break;
 
    case ACK_EVENT_DELIVERY:
-      // @TODO: is the global lock also here required?
       sge_handle_event_ack(ack_ulong2, (ev_event) ack_ulong);
       break;
    default:
@@ -678,6 +689,149 @@ sge_c_ack(ocs::gdi::Packet *packet, ocs::gdi::Task *task, monitoring_t *monitor)
    DRETURN_VOID;
 }
 
+/**
+ * @brief Registers the fine-grained lock reservations for an ACK request.
+ *
+ * Signal ACKs (ACK_SIGJOB, ACK_SIGQUEUE) touch one object of the main data store. For them
+ * the corresponding reservations are added with the fgl-API and the caller may
+ * handle the request with LOCK_FGL instead of an exclusive global lock.
+ *
+ * Reservations follow the rule that the containing master list is reserved read-only
+ * and the modified object itself is reserved read-write.
+ *
+ * @param task Pseudo GDI task containing the ACK list with one ACK element
+ * @return true if the reservations have been added, false if the request requires
+ *         the global lock in write mode
+ */
+bool
+sge_c_ack_add_fgl_reservations(const ocs::gdi::Task *task) {
+   DENTER(TOP_LAYER);
+
+   const lListElem *ack = lFirst(task->data_list);
+   if (ack == nullptr) {
+      DRETURN(false);
+   }
+
+   bool ret = true;
+   switch (lGetUlong(ack, ACK_type)) {
+      case ACK_SIGJOB:
+         fgl_add_r(SGE_TYPE_JOB, false);
+         fgl_add_u(SGE_TYPE_JOB, lGetUlong(ack, ACK_id), true);
+         break;
+      case ACK_SIGQUEUE:
+         if (lGetString(ack, ACK_str) == nullptr) {
+            ret = false;
+            break;
+         }
+         // the key references the ACK element which stays valid until the packet is deleted
+         fgl_add_r(SGE_TYPE_CQUEUE, false);
+         fgl_add_s(SGE_TYPE_QINSTANCE, lGetString(ack, ACK_str), true);
+         break;
+      default:
+         // event delivery ACKs never get here, the listener passes them to the event master
+         ret = false;
+         break;
+   }
+   DRETURN(ret);
+}
+
+/**
+ * @brief Registers the fine-grained lock reservations for a GDI request.
+ *
+ * Following requests are handled with LOCK_FGL:
+ * - submission of a single job without verification of its schedulability (qsub -w n).
+ *   Job, category and submit user lists change structurally and are reserved read-write,
+ *   the user list is reserved read-write for enforce_user auto.
+ * - disabling, enabling and clearing the error state of fully qualified queue
+ *   instances (qmod -d/-e/-c cq@host). The host names are resolved and written back to
+ *   the request so that the reservation matches the one of ACK_SIGQUEUE.
+ *
+ * Objects that are only read (configuration, queues, user sets, ...) are not reserved,
+ * they are only modified by requests that take the global lock in write mode.
+ * All other requests, e.g. qdel, return false.
+ *
+ * @param packet GDI packet, all tasks have to be capable of fine-grained locking
+ * @return true if the reservations have been added, false if the request requires
+ *         the global lock in write mode
+ */
+bool
+sge_c_gdi_add_fgl_reservations(ocs::gdi::Packet *packet) {
+   DENTER(TOP_LAYER);
+
+   if (packet->tasks.size() != 1) {
+      DRETURN(false);
+   }
+   ocs::gdi::Task *task = packet->tasks[0];
+
+   if (task->command == ocs::gdi::Command::SGE_GDI_ADD && task->target == ocs::gdi::Target::SGE_JB_LIST) {
+      const lListElem *jep = lFirst(task->data_list);
+
+      if (lGetNumberOfElem(task->data_list) != 1 || lGetUlong(jep, JB_verify_suitable_queues) != SKIP_VERIFY) {
+         DRETURN(false);
+      }
+      fgl_add_r(SGE_TYPE_CQUEUE, false);
+      fgl_add_r(SGE_TYPE_JOB, true);
+      fgl_add_r(SGE_TYPE_CATEGORY, true);
+      fgl_add_r(SGE_TYPE_USER, true);
+      fgl_add_r(SGE_TYPE_SUSER, true);
+      DRETURN(true);
+   }
+
+   if (task->command == ocs::gdi::Command::SGE_GDI_TRIGGER && task->target == ocs::gdi::Target::SGE_CQ_LIST) {
+      if (lGetNumberOfElem(task->data_list) == 0 || lGetNumberOfElem(task->data_list) > GDI_FGL_MAX_QINSTANCES) {
+         DRETURN(false);
+      }
+
+      std::set<std::string> qinstances;
+      dstring cqueue_name = DSTRING_INIT;
+      dstring host_name = DSTRING_INIT;
+      dstring full_name = DSTRING_INIT;
+      lListElem *idep;
+      bool ret = true;
+
+      for_each_rw(idep, task->data_list) {
+         u_long32 action = lGetUlong(idep, ID_action) & ~QUEUE_DO_ACTION;
+         const char *name = lGetString(idep, ID_str);
+         bool has_hostname = false;
+         bool has_domain = false;
+         char resolved_name[CL_MAXHOSTNAMELEN + 1];
+
+         // no job actions, no patterns and no host groups
+         if ((action != QI_DO_DISABLE && action != QI_DO_ENABLE && action != QI_DO_CLEARERROR) ||
+             name == nullptr || sge_is_expression(name) ||
+             !cqueue_name_split(name, &cqueue_name, &host_name, &has_hostname, &has_domain) ||
+             !has_hostname || has_domain || sge_dstring_strlen(&cqueue_name) == 0 ||
+             getuniquehostname(sge_dstring_get_string(&host_name), resolved_name, 0) != CL_RETVAL_OK) {
+            ret = false;
+            break;
+         }
+
+         // the same queue instance cannot be reserved twice
+         sge_dstring_sprintf(&full_name, "%s@%s", sge_dstring_get_string(&cqueue_name), resolved_name);
+         if (!qinstances.insert(sge_dstring_get_string(&full_name)).second) {
+            ret = false;
+            break;
+         }
+         lSetString(idep, ID_str, sge_dstring_get_string(&full_name));
+      }
+      sge_dstring_free(&cqueue_name);
+      sge_dstring_free(&host_name);
+      sge_dstring_free(&full_name);
+      if (!ret) {
+         DRETURN(false);
+      }
+
+      // the keys reference the ID elements which stay valid until the packet is deleted
+      fgl_add_r(SGE_TYPE_CQUEUE, false);
+      for_each_rw(idep, task->data_list) {
+         fgl_add_s(SGE_TYPE_QINSTANCE, lGetString(idep, ID_str), true);
+      }
+      DRETURN(true);
+   }
+
+   DRETURN(false);
+}
+
 /***************************************************************/
 static void
 sge_c_job_ack(const char *host, const char *commproc, u_long32 ack_tag,
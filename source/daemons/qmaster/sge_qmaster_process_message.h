@@ -44,3 +44,9 @@ sge_qmaster_process_message(monitoring_t *monitor);
 void
 sge_c_ack(ocs::gdi::Packet *packet, ocs::gdi::Task *task, monitoring_t *monitor);
 
+bool
+sge_c_ack_add_fgl_reservations(const ocs::gdi::Task *task);
+
+bool
+sge_c_gdi_add_fgl_reservations(ocs::gdi::Packet *packet);
+
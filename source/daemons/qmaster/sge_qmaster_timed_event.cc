@@ -158,6 +158,7 @@ te_delete_all_or_one_time_event(te_type_t aType, u_long32 aKey1, u_long32 aKey2,
       DPRINTF("%s: event list has been freed --> recreate \n", __func__);
 
       Event_Control.list = lCreateList("timed event list", TE_Type);
+      cull_hash_new_ordered(Event_Control.list, TE_when, false);
       res = n; /* all elements have been deleted */
    } else {
       res = n - lGetNumberOfElem(Event_Control.list);
@@ -763,6 +764,8 @@ void te_init() {
    DENTER(EVENT_LAYER);
 
    Event_Control.list = lCreateList("timed event list", TE_Type);
+   /* events are inserted sorted by TE_when, find the insert position via an ordered index */
+   cull_hash_new_ordered(Event_Control.list, TE_when, false);
    Event_Control.sort_order = lParseSortOrderVarArg(TE_Type, "%I+", TE_when);
 
    Handler_Tbl.list = (struct tbl_elem *) sge_malloc(TBL_INIT_SIZE * sizeof(struct tbl_elem));
@@ -51,6 +51,7 @@
 #include "sgeobj/ocs_DataStore.h"
 
 #include "sched/msg_schedd.h"
+#include "sched/ocs_DirtyTracker.h"
 #include "sched/sgeee.h"
 
 #include "evc/sge_event_client.h"
@@ -454,6 +455,84 @@ sge_process_global_config_event(sge_evc_class_t *evc, sge_object_type type,
    DRETURN(SGE_EMA_OK);
 }
 
+/****** qmaster/sge_sched_prepare_data/sge_process_dirty_event_before() *****
+*  NAME
+*     sge_process_dirty_event_before() -- track changes for incremental scheduling
+*
+*  SYNOPSIS
+*     sge_callback_result sge_process_dirty_event_before(sge_evc_class_t *evc,
+*     sge_object_type type, sge_event_action action, lListElem *event,
+*     void *clientdata)
+*
+*  FUNCTION
+*     Marks the hosts that changed with an event as dirty for the next
+*     scheduling run (see ocs::DirtyTracker). Called before the master lists
+*     are updated, jobs and tasks are still in the state before the event.
+*
+*     Events that only consume resources (new jobs, jobs being started, usage)
+*     do not mark anything. Changes of objects that are not bound to a single
+*     host mark everything dirty.
+*
+*  RESULT
+*     sge_callback_result - always SGE_EMA_OK
+*
+*  NOTES
+*     MT-NOTE: sge_process_dirty_event_before() is not MT safe
+*******************************************************************************/
+sge_callback_result
+sge_process_dirty_event_before(sge_evc_class_t *evc, sge_object_type type, sge_event_action action,
+                               lListElem *event, void *clientdata) {
+   DENTER(TOP_LAYER);
+
+   if (action == SGE_EMA_LIST) {
+      ocs::DirtyTracker::mark_all();
+      DRETURN(SGE_EMA_OK);
+   }
+
+   switch (type) {
+      case SGE_TYPE_EXECHOST:
+         ocs::DirtyTracker::mark_host(lGetString(event, ET_strkey));
+         break;
+
+      case SGE_TYPE_QINSTANCE:
+         ocs::DirtyTracker::mark_host(lGetString(event, ET_strkey2));
+         break;
+
+      case SGE_TYPE_JOB:
+      case SGE_TYPE_JATASK: {
+         u_long32 event_type = lGetUlong(event, ET_type);
+         u_long32 ja_task_id = lGetUlong(event, ET_intkey2);
+
+         if (action == SGE_EMA_ADD || event_type == sgeE_JOB_USAGE) {
+            // new jobs and started tasks do not release resources
+            break;
+         }
+         if (event_type == sgeE_JATASK_MOD) {
+            const lListElem *ja_task = lFirst(lGetList(event, ET_new_version));
+            u_long32 status = ja_task != nullptr ? lGetUlong(ja_task, JAT_status) : 0;
+
+            if (status == JTRANSFERING || status == JRUNNING) {
+               break;
+            }
+         } else if (event_type == sgeE_JOB_MOD) {
+            ja_task_id = 0;
+         }
+
+         const lListElem *job = lGetElemUlong(*ocs::DataStore::get_master_list(SGE_TYPE_JOB), JB_job_number,
+                                              lGetUlong(event, ET_intkey));
+         ocs::DirtyTracker::mark_job_hosts(job, ja_task_id, *ocs::DataStore::get_master_list(SGE_TYPE_EXECHOST),
+                                           *ocs::DataStore::get_master_list(SGE_TYPE_RQS));
+         break;
+      }
+
+      default:
+         ocs::DirtyTracker::mark_all();
+         break;
+   }
+
+   DRETURN(SGE_EMA_OK);
+}
+
 sge_callback_result
 sge_process_job_event_after(sge_evc_class_t *evc, sge_object_type type, sge_event_action action, lListElem *event, void *clientdata) {
    DENTER(TOP_LAYER);
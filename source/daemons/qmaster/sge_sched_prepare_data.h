@@ -105,6 +105,10 @@ sge_process_schedd_monitor_event(sge_evc_class_t *evc, sge_object_type type,
 sge_callback_result
 sge_process_category_event_before(sge_evc_class_t *evc, sge_object_type type, sge_event_action action, lListElem *event, void *clientdata);
 
+sge_callback_result
+sge_process_dirty_event_before(sge_evc_class_t *evc, sge_object_type type,
+                               sge_event_action action, lListElem *event, void *clientdata);
+
 #if 0
 sge_callback_result
 sge_process_userset_event_before(sge_evc_class_t *evc, 
@@ -128,16 +128,16 @@ subscribe_scheduler(sge_evc_class_t *evc, sge_where_what_t *where_what)
    DENTER(TOP_LAYER);
 
    /* subscribe event types for the mirroring interface */
-   sge_mirror_subscribe(evc, SGE_TYPE_AR,             nullptr, nullptr, nullptr, nullptr, nullptr);
-   sge_mirror_subscribe(evc, SGE_TYPE_CKPT,           nullptr, nullptr, nullptr, nullptr, nullptr);
-   sge_mirror_subscribe(evc, SGE_TYPE_CENTRY,         nullptr, nullptr, nullptr, nullptr, nullptr);
-   sge_mirror_subscribe(evc, SGE_TYPE_CQUEUE,         nullptr, nullptr, nullptr, where_what->where_cqueue, where_what->what_cqueue);
-   sge_mirror_subscribe(evc, SGE_TYPE_EXECHOST,       nullptr, nullptr, nullptr, where_what->where_host, where_what->what_host);
-   sge_mirror_subscribe(evc, SGE_TYPE_HGROUP,         nullptr, nullptr, nullptr, nullptr, nullptr);
-   sge_mirror_subscribe(evc, SGE_TYPE_CONFIG,         nullptr, sge_process_global_config_event, nullptr, where_what->where_config, where_what->what_config);
-   sge_mirror_subscribe(evc, SGE_TYPE_JOB,            nullptr, sge_process_job_event_after, nullptr, where_what->where_job, where_what->what_job);
-   sge_mirror_subscribe(evc, SGE_TYPE_JATASK,         nullptr, nullptr, nullptr, where_what->where_jat, where_what->what_jat);
-   sge_mirror_subscribe(evc, SGE_TYPE_PE,             nullptr, nullptr, nullptr, nullptr, where_what->what_pe);
+   sge_mirror_subscribe(evc, SGE_TYPE_AR,             sge_process_dirty_event_before, nullptr, nullptr, nullptr, nullptr);
+   sge_mirror_subscribe(evc, SGE_TYPE_CKPT,           sge_process_dirty_event_before, nullptr, nullptr, nullptr, nullptr);
+   sge_mirror_subscribe(evc, SGE_TYPE_CENTRY,         sge_process_dirty_event_before, nullptr, nullptr, nullptr, nullptr);
+   sge_mirror_subscribe(evc, SGE_TYPE_CQUEUE,         sge_process_dirty_event_before, nullptr, nullptr, where_what->where_cqueue, where_what->what_cqueue);
+   sge_mirror_subscribe(evc, SGE_TYPE_EXECHOST,       sge_process_dirty_event_before, nullptr, nullptr, where_what->where_host, where_what->what_host);
+   sge_mirror_subscribe(evc, SGE_TYPE_HGROUP,         sge_process_dirty_event_before, nullptr, nullptr, nullptr, nullptr);
+   sge_mirror_subscribe(evc, SGE_TYPE_CONFIG,         sge_process_dirty_event_before, sge_process_global_config_event, nullptr, where_what->where_config, where_what->what_config);
+   sge_mirror_subscribe(evc, SGE_TYPE_JOB,            sge_process_dirty_event_before, sge_process_job_event_after, nullptr, where_what->where_job, where_what->what_job);
+   sge_mirror_subscribe(evc, SGE_TYPE_JATASK,         sge_process_dirty_event_before, nullptr, nullptr, where_what->where_jat, where_what->what_jat);
+   sge_mirror_subscribe(evc, SGE_TYPE_PE,             sge_process_dirty_event_before, nullptr, nullptr, nullptr, where_what->what_pe);
    sge_mirror_subscribe(evc, SGE_TYPE_CATEGORY,       nullptr, nullptr, nullptr, nullptr, nullptr);
 
    /* we do *not* subscribe reduced elements for TYPE_PETASK:
@@ -146,14 +146,14 @@ subscribe_scheduler(sge_evc_class_t *evc, sge_where_what_t *where_what)
     */
    sge_mirror_subscribe(evc, SGE_TYPE_PETASK,         nullptr, nullptr, nullptr, nullptr, nullptr);
 
-   sge_mirror_subscribe(evc, SGE_TYPE_PROJECT,        nullptr, nullptr, nullptr, nullptr, nullptr);
-   sge_mirror_subscribe(evc, SGE_TYPE_QINSTANCE,      nullptr, nullptr, nullptr, where_what->where_all_queue, where_what->what_queue);
-   sge_mirror_subscribe(evc, SGE_TYPE_RQS,            nullptr, nullptr, nullptr, nullptr, nullptr);
-   sge_mirror_subscribe(evc, SGE_TYPE_SCHEDD_CONF,    nullptr, nullptr, nullptr, nullptr, nullptr);
+   sge_mirror_subscribe(evc, SGE_TYPE_PROJECT,        sge_process_dirty_event_before, nullptr, nullptr, nullptr, nullptr);
+   sge_mirror_subscribe(evc, SGE_TYPE_QINSTANCE,      sge_process_dirty_event_before, nullptr, nullptr, where_what->where_all_queue, where_what->what_queue);
+   sge_mirror_subscribe(evc, SGE_TYPE_RQS,            sge_process_dirty_event_before, nullptr, nullptr, nullptr, nullptr);
+   sge_mirror_subscribe(evc, SGE_TYPE_SCHEDD_CONF,    sge_process_dirty_event_before, nullptr, nullptr, nullptr, nullptr);
    sge_mirror_subscribe(evc, SGE_TYPE_SCHEDD_MONITOR, nullptr, sge_process_schedd_monitor_event, nullptr, nullptr, nullptr);
    sge_mirror_subscribe(evc, SGE_TYPE_SHARETREE,      nullptr, nullptr, nullptr, nullptr, nullptr);
    sge_mirror_subscribe(evc, SGE_TYPE_USER,           nullptr, nullptr, nullptr, nullptr, nullptr);
-   sge_mirror_subscribe(evc, SGE_TYPE_USERSET,        nullptr, nullptr, nullptr, nullptr, nullptr);
+   sge_mirror_subscribe(evc, SGE_TYPE_USERSET,        sge_process_dirty_event_before, nullptr, nullptr, nullptr, nullptr);
 
    set_job_flushing(evc);
 
@@ -165,6 +165,13 @@ subscribe_scheduler(sge_evc_class_t *evc, sge_where_what_t *where_what)
    evc->ec_set_flush(evc, sgeE_SCHEDDMONITOR, true, 0);
    evc->ec_set_flush(evc, sgeE_CONFIG_MOD, true, 0);
 
+   /* while a scheduling run is in progress only the latest state of an object is of interest */
+   evc->ec_set_coalesce(evc, sgeE_JOB_MOD, true);
+   evc->ec_set_coalesce(evc, sgeE_JOB_USAGE, true);
+   evc->ec_set_coalesce(evc, sgeE_JATASK_MOD, true);
+   evc->ec_set_coalesce(evc, sgeE_QINSTANCE_MOD, true);
+   evc->ec_set_coalesce(evc, sgeE_EXECHOST_MOD, true);
+
    DRETURN(true);
 }
 
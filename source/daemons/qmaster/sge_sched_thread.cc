@@ -77,8 +77,10 @@
 #include "sched/suspend_thresholds.h"
 #include "sched/sort_hosts.h"
 #include "sched/debit.h"
+#include "sched/ocs_MatchWorkers.h"
 
 #include "ocs_CategorySchedd.h"
+#include "ocs_DirtyTracker.h"
 #include "basis_types.h"
 #include "sge.h"
 #include "sge_follow.h"
@@ -644,7 +646,12 @@ static int dispatch_jobs(sge_evc_class_t *evc, scheduler_all_data_t *lists, orde
     */
    PROF_START_MEASUREMENT(SGE_PROF_CUSTOM3);
 
-   ocs::Job::sgeee_sort_jobs(splitted_job_lists[SPLIT_PENDING]);
+   // large job lists are sorted in parallel by the match workers
+   int match_threads = sconf_get_match_threads();
+   ocs::Job::sgeee_sort_jobs(splitted_job_lists[SPLIT_PENDING], match_threads > 1 ? match_threads : 1,
+                             [match_threads](size_t n, const ocs::MatchWorkers::task_t &task) {
+                                ocs::MatchWorkers::run(match_threads, n, 1, task);
+                             });
 
    if (prof_is_active(SGE_PROF_CUSTOM3)) {
       prof_stop_measurement(SGE_PROF_CUSTOM3, nullptr);
@@ -693,6 +700,17 @@ static int dispatch_jobs(sge_evc_class_t *evc, scheduler_all_data_t *lists, orde
 
    PROF_START_MEASUREMENT(SGE_PROF_CUSTOM4);
 
+   /*---------------------------------------------------------------------
+    * INCREMENTAL SCHEDULING
+    * Categories rejected by the previous run are rejected again or matched
+    * against the hosts that changed since then only.
+    * Not possible for reservations as they depend on time.
+    *---------------------------------------------------------------------*/
+   ocs::DirtyTracker::start_run(sconf_get_incremental_scheduling() && max_reserve == 0 &&
+                                lGetNumberOfElem(lists->ar_list) == 0,
+                                !evc->monitor_next_run && sconf_get_schedd_job_info() == SCHEDD_JOB_INFO_FALSE,
+                                lists->category_list, lists->host_list, lists->rqs_list);
+
    /*
     * loop over the jobs that are left in priority order
     */
@@ -922,6 +940,9 @@ static int dispatch_jobs(sge_evc_class_t *evc, scheduler_all_data_t *lists, orde
                      DPRINTF("SKIP JOB (N)" sge_u32 " of category '%s' (rc: " sge_u32 ")\n", job_id,
                              lGetString(cat, CT_str), lGetUlong(cat, CT_refcount));
                      ocs::CategorySchedd::job_reject_category(orig_job, is_reserve);
+                     if (is_start) {
+                        ocs::DirtyTracker::category_rejected(orig_job);
+                     }
                   }
                }
                /* fall through to DISPATCH_NEVER_JOB */
@@ -988,8 +1009,12 @@ static int dispatch_jobs(sge_evc_class_t *evc, scheduler_all_data_t *lists, orde
                    num_intermediate_jobs, num_intermediate_sends,
                    num_intermediate_sends > 0 ? min_intermediate_jobs : 0,
                    max_intermediate_jobs, avg_intermediate_jobs);
+         PROFILING("PROF: incremental scheduling rejected %d categories, matched %d categories against %d changed hosts",
+                   ocs::DirtyTracker::get_reused_categories(), ocs::DirtyTracker::get_restricted_categories(),
+                   ocs::DirtyTracker::get_dirty_hosts());
       }
    }
+   ocs::DirtyTracker::finish_run();
 
    if (prof_is_active(SGE_PROF_CUSTOM4)) {
       static bool first_time = true;
@@ -1079,6 +1104,7 @@ select_assign_debit(lList **queue_list, lList **dis_queue_list, lListElem *job,
    a.pi = pi;
    a.monitor_next_run = monitor_next_run;
    a.now = now;
+   a.is_dirty_hosts_only = ocs::DirtyTracker::is_dirty_hosts_only(job);
 
    /* in reservation scheduling mode a non-zero duration always must be defined */
    job_get_duration(&a.duration, job);
@@ -1228,6 +1254,9 @@ select_assign_debit(lList **queue_list, lList **dis_queue_list, lListElem *job,
    }
 
    if (result == DISPATCH_OK) {
+      // the hosts are dirty for the next run
+      ocs::DirtyTracker::job_dispatched(a.gdil);
+
       // create the granted resource list containing all granted consumables
       // including RSMAPs and the info which RSMAP ids were granted
       add_granted_resource_list(&a, ja_task, job, host_list);
@@ -34,6 +34,7 @@
 #include "uti/sge_time.h"
 
 #include "sgeobj/ocs_DataStore.h"
+#include "sgeobj/ocs_Version.h"
 
 #include "sge_thread_ctrl.h"
 
@@ -170,25 +171,27 @@ sge_reader_main(void *arg) {
 
       // handle the packet only if it is not nullptr and the shutdown has not started
       if (packet != nullptr && !sge_thread_has_shutdown_started()) {
-         bool is_only_read_request = true;
-
          DPRINTF("Request should be handled by thread type %d\n", packet->ds_type);
 
          thread_start_stop_profiling();
 
          /*
           * prepare buffer for sending an answer 
+          * use the compact format only if the client announced that it can read it
           */
          if (!packet->is_intern_request && packet->request_type == PACKET_GDI_REQUEST) {
-            init_packbuffer(&(packet->pb), 0);
+            init_packbuffer(&(packet->pb), 0, false, true, ocs::Version::is_compact_pack_supported(packet->version));
          }
 
          MONITOR_MESSAGES(p_monitor);
 
+#if defined (ENABLE_DEBUG_CHECKS)
+         /*
+          * requests routed to reader threads never modify the data store. Tasks that are not GET
+          * requests (permission checks, triggers) only use the event master or the thread management
+          */
+         bool is_only_read_request = true;
          if (packet->request_type == PACKET_GDI_REQUEST) {
-            /*
-             * test if a write lock is necessary
-             */
             for (auto *task : packet->tasks) {
                u_long32 command = task->command;
 
@@ -201,8 +204,6 @@ sge_reader_main(void *arg) {
             // PACKET_REPORT_REQUEST or PACKET_ACK_REQUEST
             is_only_read_request = false;
          }
-
-#if defined (ENABLE_DEBUG_CHECKS)
          if (!is_only_read_request) {
             CRITICAL("reader thread tries to execute write request");
             abort();
@@ -210,13 +211,11 @@ sge_reader_main(void *arg) {
 #endif
 
          /*
-          * acquire the correct lock
+          * pin the most recent version of the data store. the mirror thread applies new events
+          * to a different version, and reader threads do not modify the pinned version,
+          * so no lock is needed
           */
-         if (is_only_read_request) {
-            MONITOR_WAIT_TIME(SGE_LOCK(LOCK_READER, LOCK_READ), p_monitor);
-         } else {
-            MONITOR_WAIT_TIME(SGE_LOCK(LOCK_READER, LOCK_WRITE), p_monitor);
-         }
+         MONITOR_WAIT_TIME(ocs::DataStore::pin_version(), p_monitor);
 
 #ifdef WITH_PYTHON_IN_QMASTER
          // We need to open a new scope here so that at the end the GIL is released
@@ -256,7 +255,7 @@ sge_reader_main(void *arg) {
                   sge_c_gdi_process_in_worker(packet, task, &(task->answer_list), p_monitor, has_next);
                }
             } else if (packet->request_type == PACKET_REPORT_REQUEST) {
-               sge_c_report(packet, packet->tasks[0], packet->host, packet->commproc, packet->commproc_id, packet->tasks[0]->data_list, p_monitor);
+               sge_c_report(packet, packet->tasks[0], packet->host, packet->commproc, packet->commproc_id, packet->tasks[0]->data_list, p_monitor, REPORT_PART_ALL, nullptr);
             } else if (packet->request_type == PACKET_ACK_REQUEST) {
                sge_c_ack(packet, packet->tasks[0], p_monitor);
             } else {
@@ -286,13 +285,9 @@ sge_reader_main(void *arg) {
 
 
          /*
-          * do unlock
+          * release the pinned version
           */
-         if (is_only_read_request) {
-            SGE_UNLOCK(LOCK_READER, LOCK_READ);
-         } else {
-            SGE_UNLOCK(LOCK_READER, LOCK_WRITE);
-         }
+         ocs::DataStore::unpin_version();
 
          if (packet->request_type == PACKET_GDI_REQUEST) {
             /*
@@ -62,6 +62,7 @@
 
 #include "sched/sge_serf.h"
 #include "sched/schedd_monitor.h"
+#include "sched/ocs_MatchWorkers.h"
 
 #include "basis_types.h"
 #include "ocs_CategoryQmaster.h"
@@ -163,6 +164,13 @@ sge_scheduler_cleanup_event_client(void *arg) {
    DRETURN_VOID;
 }
 
+static void
+sge_scheduler_cleanup_match_workers([[maybe_unused]] void *arg) {
+   DENTER(TOP_LAYER);
+   ocs::MatchWorkers::shutdown();
+   DRETURN_VOID;
+}
+
 static void
 sge_scheduler_cleanup_where_what(void *where_what) {
    DENTER(TOP_LAYER);
@@ -539,6 +547,9 @@ sge_scheduler_main(void *arg) {
    // this thread will use the SCHEDULER data store
    ocs::DataStore::select_active_ds(ocs::DataStore::Id::SCHEDULER);
 
+   // scheduling runs create and free lots of temporary CULL elements, reuse their memory
+   lSetPoolMode(true);
+
    /*
     * prepare event client/mirror mechanism
     */
@@ -897,6 +908,9 @@ sge_scheduler_main(void *arg) {
          sge_schedd_block_until_orders_processed(nullptr);
          schedd_order_destroy();
 
+         /* give the memory of the temporary elements of this run back */
+         lReleasePool();
+
          /*
           * Stop profiling for "schedd run total" and the subcategories
           */
@@ -933,6 +947,7 @@ sge_scheduler_main(void *arg) {
       // sge_scheduler_cleanup_thread() is the last function which should be called, so it is pushed first
       do {
          pthread_cleanup_push(sge_scheduler_cleanup_thread, nullptr);
+         pthread_cleanup_push(sge_scheduler_cleanup_match_workers, nullptr);
          pthread_cleanup_push(sge_scheduler_cleanup_monitor, static_cast<void *>(&monitor));
          pthread_cleanup_push(sge_scheduler_cleanup_event_client, static_cast<void *>(evc));
          pthread_cleanup_push(sge_scheduler_cleanup_where_what, static_cast<void *>(&where_what));
@@ -941,6 +956,7 @@ sge_scheduler_main(void *arg) {
          pthread_cleanup_pop(execute);
          pthread_cleanup_pop(execute);
          pthread_cleanup_pop(execute);
+         pthread_cleanup_pop(execute);
          DPRINTF("passed cancellation point\n");
 
          if (do_shutdown) {
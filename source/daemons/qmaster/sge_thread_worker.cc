@@ -34,8 +34,12 @@
 
 #include <pthread.h>
 #include <cstring>
+#include <map>
+#include <string>
+#include <vector>
 
 #include "uti/sge_bootstrap.h"
+#include "uti/sge_fgl.h"
 #include "uti/sge_lock.h"
 #include "uti/sge_log.h"
 #include "uti/sge_os.h"
@@ -46,6 +50,7 @@
 #include "gdi/ocs_gdi_ClientServerBase.h"
 
 #include "sgeobj/ocs_Session.h"
+#include "sgeobj/ocs_Version.h"
 #include "sgeobj/ocs_DataStore.h"
 
 #include "sge_thread_ctrl.h"
@@ -69,11 +74,15 @@
 #include "sge_job_qmaster.h"
 #include "sge_advance_reservation_qmaster.h"
 #include "sge_c_report.h"
+#include "sge_host_qmaster.h"
 #include "sge_thread_main.h"
 #include "sge_thread_worker.h"
 #include "sge_qmaster_process_message.h"
 #include "msg_qmaster.h"
 
+// max number of report packets that are handled by a worker thread at once
+#define REPORT_BATCH_MAX 32
+
 static void
 sge_worker_cleanup_monitor(void *arg) {
    DENTER(TOP_LAYER);
@@ -211,7 +220,7 @@ sge_worker_main(void *arg) {
        * thread takes care that packet producers will be terminated 
        * before all worker threads so that this won't be a problem.
        */
-      MONITOR_IDLE_TIME(sge_tq_wait_for_task(GlobalRequestQueue, 1, SGE_TQ_GDI_PACKET, (void **) &packet),
+      MONITOR_IDLE_TIME(sge_tq_wait_for_task(GlobalRequestQueue, 1, SGE_TQ_UNKNOWN, (void **) &packet),
                         p_monitor, mconf_get_monitoring_options());
 
       MONITOR_SET_QLEN(p_monitor, sge_tq_get_task_count(GlobalRequestQueue));
@@ -219,6 +228,9 @@ sge_worker_main(void *arg) {
       // handle the packet only if it is not nullptr and the shutdown has not started
       if (packet != nullptr) {
          bool is_only_read_request = true;
+         sge_lockmode_t lock_mode = LOCK_WRITE;
+         std::vector<ocs::gdi::Packet *> reports;
+         std::vector<ocs::gdi::Packet *> job_reports;
 
          DPRINTF("Request should be handled by thread type %d\n", packet->ds_type);
 
@@ -226,9 +238,10 @@ sge_worker_main(void *arg) {
 
          /*
           * prepare buffer for sending an answer 
+          * use the compact format only if the client announced that it can read it
           */
          if (!packet->is_intern_request && packet->request_type == PACKET_GDI_REQUEST) {
-            init_packbuffer(&(packet->pb), 0);
+            init_packbuffer(&(packet->pb), 0, false, true, ocs::Version::is_compact_pack_supported(packet->version));
          }
 
          MONITOR_MESSAGES(p_monitor);
@@ -251,12 +264,75 @@ sge_worker_main(void *arg) {
          }
 
          /*
-          * acquire the correct lock
+          * requests that only touch single objects reserve those objects and share the
+          * global lock with other requests of that kind (fine-grained locking)
           */
          if (is_only_read_request) {
-            MONITOR_WAIT_TIME(SGE_LOCK(LOCK_GLOBAL, LOCK_READ), p_monitor);
-         } else {
-            MONITOR_WAIT_TIME(SGE_LOCK(LOCK_GLOBAL, LOCK_WRITE), p_monitor);
+            lock_mode = LOCK_READ;
+         } else if (packet->request_type == PACKET_ACK_REQUEST && mconf_get_enable_fine_grained_locking()) {
+            fgl_clear();
+            if (sge_c_ack_add_fgl_reservations(packet->tasks[0])) {
+               lock_mode = LOCK_FGL;
+            } else {
+               fgl_clear();
+            }
+         } else if (packet->request_type == PACKET_GDI_REQUEST && mconf_get_enable_fine_grained_locking()) {
+            // single job submissions and state changes of queue instances
+            fgl_clear();
+            if (sge_c_gdi_add_fgl_reservations(packet)) {
+               lock_mode = LOCK_FGL;
+            } else {
+               fgl_clear();
+            }
+         } else if (packet->request_type == PACKET_REPORT_REQUEST) {
+            reports.push_back(packet);
+
+            /*
+             * handle further pending reports in the same batch. Load reports of the same host
+             * are merged, and the batch is processed under one lock
+             */
+            if (mconf_get_enable_fine_grained_locking()) {
+               ocs::gdi::Packet *next_report = nullptr;
+
+               while (reports.size() < REPORT_BATCH_MAX) {
+                  sge_tq_get_task(GlobalRequestQueue, SGE_TQ_REPORT_PACKET, (void **) &next_report);
+                  if (next_report == nullptr) {
+                     break;
+                  }
+                  MONITOR_MESSAGES(p_monitor);
+                  reports.push_back(next_report);
+               }
+               sge_c_report_coalesce(reports);
+
+               lock_mode = LOCK_FGL;
+               for (const auto *report : reports) {
+                  if (!sge_c_report_is_fgl_capable(report)) {
+                     lock_mode = LOCK_WRITE;
+                     break;
+                  }
+               }
+            }
+
+            // coalescing might have removed the initial packet
+            packet = reports.front();
+         }
+
+         /*
+          * acquire the correct lock
+          */
+         MONITOR_WAIT_TIME(SGE_LOCK(LOCK_GLOBAL, lock_mode), p_monitor);
+         if (lock_mode == LOCK_FGL && packet->request_type == PACKET_REPORT_REQUEST) {
+            // report reservations require host lookups in the master list, and this is only possible with the lock
+            fgl_clear();
+            if (!sge_c_report_add_fgl_reservations(reports)) {
+               fgl_clear();
+               SGE_UNLOCK(LOCK_GLOBAL, lock_mode);
+               lock_mode = LOCK_WRITE;
+               MONITOR_WAIT_TIME(SGE_LOCK(LOCK_GLOBAL, lock_mode), p_monitor);
+            }
+         }
+         if (lock_mode == LOCK_FGL) {
+            MONITOR_WAIT_TIME(fgl_lock(), p_monitor);
          }
 
 #ifdef OBSERVE
@@ -276,7 +352,20 @@ sge_worker_main(void *arg) {
                sge_c_gdi_process_in_worker(packet, task, &(task->answer_list), p_monitor, has_next);
             }
          } else if (packet->request_type == PACKET_REPORT_REQUEST) {
-            sge_c_report(packet, packet->tasks[0], packet->host, packet->commproc, packet->commproc_id, packet->tasks[0]->data_list, p_monitor);
+            std::map<std::string, bool> changed_hosts;
+
+            // with LOCK_FGL only the host part is handled here, the job reports follow with the write lock
+            int parts = lock_mode == LOCK_FGL ? REPORT_PART_HOST : REPORT_PART_ALL;
+            for (auto *report : reports) {
+               if (sge_c_report(report, report->tasks[0], report->host, report->commproc, report->commproc_id,
+                                report->tasks[0]->data_list, p_monitor, parts, &changed_hosts) &&
+                   parts == REPORT_PART_HOST && sge_c_report_has_job_report(report)) {
+                  job_reports.push_back(report);
+               }
+            }
+
+            // one event per modified host and batch
+            sge_update_load_values_done(changed_hosts, packet->gdi_session);
          } else if (packet->request_type == PACKET_ACK_REQUEST) {
             sge_c_ack(packet, packet->tasks[0], p_monitor);
          } else {
@@ -302,9 +391,20 @@ sge_worker_main(void *arg) {
          /*
           * do unlock
           */
-         if (is_only_read_request) {
-            SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
-         } else {
+         if (lock_mode == LOCK_FGL) {
+            fgl_unlock();
+            fgl_clear();
+         }
+         SGE_UNLOCK(LOCK_GLOBAL, lock_mode);
+
+         // job reports of a batch handled with LOCK_FGL. Other workers might have applied newer
+         // job reports of the same hosts meanwhile, sge_c_report() skips the outdated ones then
+         if (!job_reports.empty()) {
+            MONITOR_WAIT_TIME(SGE_LOCK(LOCK_GLOBAL, LOCK_WRITE), p_monitor);
+            for (auto *report : job_reports) {
+               sge_c_report(report, report->tasks[0], report->host, report->commproc, report->commproc_id,
+                            report->tasks[0]->data_list, p_monitor, REPORT_PART_JOB, nullptr);
+            }
             SGE_UNLOCK(LOCK_GLOBAL, LOCK_WRITE);
          }
 
@@ -340,6 +440,10 @@ sge_worker_main(void *arg) {
                 */
                packet = nullptr;
             }
+         } else if (packet->request_type == PACKET_REPORT_REQUEST) {
+            for (auto *report : reports) {
+               delete report;
+            }
          } else {
             delete packet;
          }
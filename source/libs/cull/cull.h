@@ -44,6 +44,7 @@
 #include "cull/cull_dump_scan.h"
 #include "cull/cull_lerrno.h"
 #include "cull/cull_pack.h"
+#include "cull/cull_pool.h"
 #include "cull/cull_sort.h"
 #include "cull/cull_tree.h"
 #include "cull/cull_hash.h"
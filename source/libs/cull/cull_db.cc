@@ -35,18 +35,23 @@
 /*___INFO__MARK_END__*/
 
 #include <cstring>
+#include <unordered_set>
+#include <vector>
 
 /* do not compile in monitoring code */
 #ifndef NO_SGE_COMPILE_DEBUG
 #define NO_SGE_COMPILE_DEBUG
 #endif
 
+#include "uti/sge_hostname.h"
 #include "uti/sge_rmon_macros.h"
 #include "uti/sge_string.h"
 #include "uti/sge_profiling.h"
 
 #include "cull/cull_db.h"
 #include "cull/cull_where.h"
+#include "cull/cull_whereP.h"
+#include "cull/cull_parse.h"
 #include "cull/cull_listP.h"
 #include "cull/cull_whatP.h"
 #include "cull/cull_multitypeP.h"
@@ -307,6 +312,7 @@ lList *lJoin(const char *name, int nm0, const lList *lp0,
    int lp0_pos = 0, lp1_pos = 0;
    u_int i, j;
    int needed;
+   lCompiledWhere *compiled0, *compiled1;
 
    DENTER(CULL_LAYER);
 
@@ -345,11 +351,15 @@ lList *lJoin(const char *name, int nm0, const lList *lp0,
    /* free dp it has been copied by lCreateList */
    sge_free(&dp);
 
+   /* the conditions are evaluated for many elements, the second one even per pair */
+   compiled0 = lCompileWhere(cp0, lp0->descr);
+   compiled1 = lCompileWhere(cp1, lp1->descr);
+
    for (i = 0, ep0 = lp0->first; i < lp0->nelem; i++, ep0 = ep0->next) {
-      if (!lCompare(ep0, cp0))
+      if (!lCompareCompiled(ep0, compiled0))
          continue;
       for (j = 0, ep1 = lp1->first; j < lp1->nelem; j++, ep1 = ep1->next) {
-         if (!lCompare(ep1, cp1))
+         if (!lCompareCompiled(ep1, compiled1))
             continue;
          if (nm1 != NoName) {   /* in this case take it always */
             /* This is a comparison of the join fields nm0 , nm1 */
@@ -389,6 +399,8 @@ lList *lJoin(const char *name, int nm0, const lList *lp0,
                   break;
                default:
                   unknownType("lJoin");
+                  lFreeCompiledWhere(&compiled0);
+                  lFreeCompiledWhere(&compiled1);
                   DRETURN(nullptr);
             }
             if (!needed)
@@ -397,16 +409,22 @@ lList *lJoin(const char *name, int nm0, const lList *lp0,
          if (!(ep = lJoinCopyElem(dlp->descr, ep0, enp0, ep1, enp1))) {
             LERROR(LEJOINCOPYELEM);
             lFreeList(&dlp);
+            lFreeCompiledWhere(&compiled0);
+            lFreeCompiledWhere(&compiled1);
             DRETURN(nullptr);
          } else {
             if (lAppendElem(dlp, ep) == -1) {
                LERROR(LEAPPENDELEM);
                lFreeList(&dlp);
+               lFreeCompiledWhere(&compiled0);
+               lFreeCompiledWhere(&compiled1);
                DRETURN(nullptr);
             }
          }
       }
    }
+   lFreeCompiledWhere(&compiled0);
+   lFreeCompiledWhere(&compiled1);
 
    /* RETURN AN EMPTY LIST OR nullptr THAT'S THE QUESTION */
 
@@ -446,6 +464,7 @@ int lSplit(lList **slp, lList **ulp, const char *ulp_name,
 
    lListElem *ep, *next;
    int has_been_allocated = 0;
+   lCompiledWhere *compiled;
 
    DENTER(TOP_LAYER);
 
@@ -457,13 +476,15 @@ int lSplit(lList **slp, lList **ulp, const char *ulp_name,
       DRETURN(-1);
    }
 
+   compiled = lCompileWhere(cp, *slp != nullptr ? (*slp)->descr : nullptr);
    for (ep = lFirstRW(*slp); ep; ep = next) {
       next = ep->next;          /* this is important, cause the elem is dechained */
 
-      if (!lCompare(ep, cp)) {
+      if (!lCompareCompiled(ep, compiled)) {
          if (ulp && !*ulp) {
             *ulp = lCreateList(ulp_name ? ulp_name : "ulp", (*slp)->descr);
             if (!*ulp) {
+               lFreeCompiledWhere(&compiled);
                DRETURN(-1);
             }
             has_been_allocated = 1;
@@ -477,6 +498,8 @@ int lSplit(lList **slp, lList **ulp, const char *ulp_name,
       }
    }
 
+   lFreeCompiledWhere(&compiled);
+
    /* if no elements remain, free the list and return nullptr */
    if (*slp && lGetNumberOfElem(*slp) == 0) {
       lFreeList(slp);
@@ -794,6 +817,176 @@ lList *lSelectHashPack(const char *name, const lList *slp,
    DRETURN(ret);
 }
 
+/* appends the elements of lp having the value of an equality condition via the hash table of the field,
+   returns false if there is no hash table for the field */
+static bool
+lSelectIndexLookup(const lList *lp, const lCondition *cp, std::vector<lListElem *> &candidates) {
+   int pos = cp->operand.cmp.pos;
+   const void *key;
+   const void *iterator = nullptr;
+   char host_key[CL_MAXHOSTNAMELEN + 1];
+
+   if (cp->op != EQUAL || pos < 0 || pos >= lCountDescr(lp->descr) || lp->descr[pos].nm != cp->operand.cmp.nm ||
+       lp->descr[pos].ht == nullptr || mt_get_type(lp->descr[pos].mt) != mt_get_type(cp->operand.cmp.mt)) {
+      return false;
+   }
+
+   switch (mt_get_type(cp->operand.cmp.mt)) {
+      case lUlongT:
+         key = &(cp->operand.cmp.val.ul);
+         break;
+      case lUlong64T:
+         key = &(cp->operand.cmp.val.ul64);
+         break;
+      case lStringT:
+         key = cp->operand.cmp.val.str;
+         break;
+      case lHostT:
+         /* host keys are hashed case insensitive, lCompare() has the last word */
+         if (cp->operand.cmp.val.host == nullptr) {
+            return false;
+         }
+         sge_hostcpy(host_key, cp->operand.cmp.val.host);
+         sge_strtoupper(host_key, CL_MAXHOSTNAMELEN);
+         key = host_key;
+         break;
+      default:
+         return false;
+   }
+   if (key == nullptr) {
+      return false;
+   }
+
+   if (mt_is_unique(lp->descr[pos].mt)) {
+      /* unique hash tables have no chains to iterate */
+      lListElem *ep = cull_hash_first(lp->descr[pos].ht, key, true, &iterator);
+      if (ep != nullptr) {
+         candidates.push_back(ep);
+      }
+      return true;
+   }
+   for (lListElem *ep = cull_hash_first(lp->descr[pos].ht, key, false, &iterator);
+        ep != nullptr; ep = cull_hash_next(lp->descr[pos].ht, &iterator)) {
+      candidates.push_back(ep);
+   }
+   return true;
+}
+
+/* collects the elements of lp which might fulfill cp by using the hash tables of lp,
+   works for equalities on hashed fields, ORs of them and ANDs containing one of them,
+   returns false if cp cannot be answered this way */
+static bool
+lSelectIndexCandidates(const lList *lp, const lCondition *cp, std::vector<lListElem *> &candidates, int *lookups) {
+   size_t size = candidates.size();
+   int done = *lookups;
+
+   if (cp == nullptr) {
+      return false;
+   }
+
+   switch (cp->op) {
+      case AND:
+         if (lSelectIndexCandidates(lp, cp->operand.log.first, candidates, lookups)) {
+            return true;
+         }
+         return lSelectIndexCandidates(lp, cp->operand.log.second, candidates, lookups);
+      case OR:
+         if (lSelectIndexCandidates(lp, cp->operand.log.first, candidates, lookups) &&
+             lSelectIndexCandidates(lp, cp->operand.log.second, candidates, lookups)) {
+            return true;
+         }
+         candidates.resize(size);
+         *lookups = done;
+         return false;
+      default:
+         if (lSelectIndexLookup(lp, cp, candidates)) {
+            (*lookups)++;
+            return true;
+         }
+         return false;
+   }
+}
+
+/* returns true if the candidates are in list order */
+static bool
+lSelectIndexIsListOrder(const std::vector<lListElem *> &candidates) {
+   size_t next = 1;
+
+   for (const lListElem *ep = candidates[0]->next; ep != nullptr && next < candidates.size(); ep = ep->next) {
+      if (ep == candidates[next]) {
+         next++;
+      }
+   }
+   return next == candidates.size();
+}
+
+/****** cull/db/lSelectIndex() ************************************************
+*  NAME
+*     lSelectIndex() -- Find elements which might fulfill a condition
+*
+*  SYNOPSIS
+*     static bool lSelectIndex(const lList *lp, const lCondition *cp,
+*                              std::vector<lListElem *> &candidates)
+*
+*  FUNCTION
+*     Uses the hash tables of 'lp' to find the elements which might fulfill
+*     the condition 'cp' instead of comparing all elements. This is
+*     possible for equalities on fields having a hash table (e.g.
+*     JB_owner == "user"), ORs of such equalities and ANDs where one
+*     side is such a condition.
+*
+*     The candidates still have to be checked with the condition. They
+*     are returned in list order, like a scan would find them. The hash
+*     tables return them in the order they were added, which differs
+*     from the list order after inserting or sorting and for ORs. This
+*     is detected by walking from the first to the last candidate. Only
+*     then the order is restored by walking the list up to the last
+*     candidate. Both walks only compare pointers.
+*
+*  INPUTS
+*     const lList *lp                       - list
+*     const lCondition *cp                  - condition
+*     std::vector<lListElem *> &candidates  - gets the candidates
+*
+*  RESULT
+*     bool - false if the hash tables cannot be used, the list has
+*            to be scanned
+******************************************************************************/
+static bool
+lSelectIndex(const lList *lp, const lCondition *cp, std::vector<lListElem *> &candidates) {
+   int lookups = 0;
+
+   if (lp == nullptr || !lSelectIndexCandidates(lp, cp, candidates, &lookups)) {
+      return false;
+   }
+
+   /* different keys of an OR might have found the same elements */
+   if (lookups > 1) {
+      std::unordered_set<const lListElem *> seen;
+      size_t used = 0;
+
+      for (lListElem *ep : candidates) {
+         if (seen.insert(ep).second) {
+            candidates[used++] = ep;
+         }
+      }
+      candidates.resize(used);
+   }
+
+   /* the result has to be in list order */
+   if (candidates.size() > 1 && !lSelectIndexIsListOrder(candidates)) {
+      std::unordered_set<const lListElem *> wanted(candidates.begin(), candidates.end());
+      size_t used = 0;
+
+      for (lListElem *ep = lp->first; ep != nullptr && used < candidates.size(); ep = ep->next) {
+         if (wanted.count(ep) > 0) {
+            candidates[used++] = ep;
+         }
+      }
+   }
+   return true;
+}
+
 /****** cull_db/lSelectDPack() ************************************************
 *  NAME
 *     lSelectDPack() --  Extracts some elements fulfilling a condition 
@@ -829,6 +1022,10 @@ lList *lSelectDPack(const char *name, const lList *slp, const lCondition *cp,
    lListElem *ep, *new_ep;
    lList *dlp = nullptr;
    const lDescr *descr = nullptr;
+   lCompiledWhere *compiled;
+   std::vector<lListElem *> candidates;
+   bool use_index;
+   size_t next = 0;
 
    DENTER(CULL_LAYER);
 
@@ -845,20 +1042,34 @@ lList *lSelectDPack(const char *name, const lList *slp, const lCondition *cp,
    }
 
    /*
-      iterate through the source list call lCompare and add
-      depending on result of lCompare
+      iterate through the source list (or only the elements found via
+      hash tables) call lCompare and add depending on result of lCompare
     */
-   for (ep = slp->first; ep; ep = ep->next) {
-      new_ep = lSelectElemDPack(ep, cp, descr, enp, isHash, pb);
+   compiled = lCompileWhere(cp, slp->descr);
+   use_index = lSelectIndex(slp, cp, candidates);
+   auto next_elem = [&](lListElem *current) -> lListElem * {
+      if (use_index) {
+         return next < candidates.size() ? candidates[next++] : nullptr;
+      }
+      return current == nullptr ? slp->first : current->next;
+   };
+   for (ep = next_elem(nullptr); ep != nullptr; ep = next_elem(ep)) {
+      if (!lCompareCompiled(ep, compiled)) {
+         continue;
+      }
+      /* the condition is already checked */
+      new_ep = lSelectElemDPack(ep, nullptr, descr, enp, isHash, pb);
       if (new_ep != nullptr) {
          if (lAppendElem(dlp, new_ep) == -1) {
             LERROR(LEAPPENDELEM);
             lFreeElem(&new_ep);
             lFreeList(&dlp);
+            lFreeCompiledWhere(&compiled);
             DRETURN(nullptr);
          }
       }
    }
+   lFreeCompiledWhere(&compiled);
 
    // write 0 to the end of the list to indicate that there are no more elements
    if (pb != nullptr) {
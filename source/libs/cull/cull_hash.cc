@@ -35,6 +35,8 @@
 /*___INFO__MARK_END__*/
 
 #include <cstdio>
+#include <functional>
+#include <set>
 
 /* do not compile in monitoring code */
 #ifndef NO_SGE_COMPILE_DEBUG
@@ -148,9 +150,60 @@ struct _non_unique_hash {
    const void *data;
 };
 
+/* entry of an ordered index: the value of the field and the element */
+struct cull_ordered_entry {
+   lMultiType value;
+   const lListElem *ep;
+};
+
+/* field types an ordered index can be created for */
+static bool
+cull_ordered_is_supported(int type) {
+   return type == lUlongT || type == lUlong64T || type == lStringT || type == lHostT;
+}
+
+static int
+cull_ordered_compare(int type, const lMultiType &v0, const lMultiType &v1) {
+   switch (type) {
+      case lUlongT:
+         return ulongcmp(v0.ul, v1.ul);
+      case lUlong64T:
+         return ulong64cmp(v0.ul64, v1.ul64);
+      case lStringT:
+         return sge_strnullcmp(v0.str, v1.str);
+      case lHostT:
+         return sge_strnullcmp(v0.host, v1.host);
+      default:
+         return 0;
+   }
+}
+
+/* order by value like lSortCompare(), elements with the same value by address */
+struct cull_ordered_less {
+   int type;
+
+   bool operator()(const cull_ordered_entry &e0, const cull_ordered_entry &e1) const {
+      int cmp = cull_ordered_compare(type, e0.value, e1.value);
+
+      if (cmp != 0) {
+         return cmp < 0;
+      }
+      return std::less<const lListElem *>()(e0.ep, e1.ep);
+   }
+};
+
+struct cull_ordered_index {
+   int nm;          /* field name */
+   int pos;         /* position of the field, known with the first element */
+   std::set<cull_ordered_entry, cull_ordered_less> entries;
+
+   cull_ordered_index(int nm, int pos, int type) : nm(nm), pos(pos), entries(cull_ordered_less{type}) {}
+};
+
 struct _cull_htable {
    htable ht;       /* hashtable for keys */
    htable nuht;     /* hashtable for lookup of non unique object references */
+   cull_ordered_index *ordered; /* ordered index for CULL_ORDERED fields */
 };
 
 /****** cull/hash/cull_hash_create() *******************************************
@@ -231,12 +284,45 @@ cull_htable cull_hash_create(const lDescr *descr, int size) {
       } else {
          ret->ht = ht;
          ret->nuht = nuht;
+         ret->ordered = nullptr;
+         if (mt_is_ordered(descr->mt)) {
+            ret->ordered = new cull_ordered_index(descr->nm, -1, mt_get_type(descr->mt));
+         }
       }
    }
 
    return ret;
 }
 
+/* entry of ep in the ordered index of field pos */
+static cull_ordered_entry
+cull_ordered_entry_of(const lListElem *ep, int pos) {
+   return cull_ordered_entry{ep->cont[pos], ep};
+}
+
+static void
+cull_ordered_insert(cull_ordered_index *ordered, const lListElem *ep) {
+   if (ordered->pos < 0) {
+      ordered->pos = lGetPosInDescr(ep->descr, ordered->nm);
+   }
+   ordered->entries.insert(cull_ordered_entry_of(ep, ordered->pos));
+}
+
+void cull_hash_delete_non_unique_chain(htable table, const void *key, const void **data);
+
+/* frees a cull_htable and its tables */
+static void
+cull_hash_destroy(cull_htable *ht, bool unique) {
+   if (!unique) {
+      /* delete chain of non unique elements */
+      sge_htable_for_each_ep((*ht)->ht, cull_hash_delete_non_unique_chain);
+      sge_htable_destroy((*ht)->nuht);
+   }
+   sge_htable_destroy((*ht)->ht);
+   delete (*ht)->ordered;
+   sge_free(ht);
+}
+
 /****** cull/hash/cull_hash_create_hashtables() ********************************
 *  NAME
 *     cull_hash_create_hashtables() -- create all hashtables on a list
@@ -296,7 +382,16 @@ void cull_hash_create_hashtables(lList *lp) {
 *                           is to be hashed
 *******************************************************************************/
 void cull_hash_insert(const lListElem *ep, void *key, cull_htable ht, bool unique) {
-   if (ht == nullptr || ep == nullptr || key == nullptr) {
+   if (ht == nullptr || ep == nullptr) {
+      return;
+   }
+
+   /* the ordered index also contains elements without value */
+   if (ht->ordered != nullptr) {
+      cull_ordered_insert(ht->ordered, ep);
+   }
+
+   if (key == nullptr) {
       return;
    }
 
@@ -372,6 +467,10 @@ void cull_hash_remove(const lListElem *ep, const int pos) {
       return;
    }
 
+   if (ht->ordered != nullptr) {
+      ht->ordered->entries.erase(cull_ordered_entry_of(ep, pos));
+   }
+
    key = cull_hash_key(ep, pos, host_key);
    if (key != nullptr) {
       if (mt_is_unique(ep->descr[pos].mt)) {
@@ -635,16 +734,8 @@ void cull_hash_delete_non_unique_chain(htable table, const void *key,
 void cull_hash_free_descr(lDescr *descr) {
    int i;
    for (i = 0; mt_get_type(descr[i].mt) != lEndT; i++) {
-      cull_htable ht = descr[i].ht;
-
-      if (ht != nullptr) {
-         if (!mt_is_unique(descr[i].mt)) {
-            /* delete chain of non unique elements */
-            sge_htable_for_each_ep(ht->ht, cull_hash_delete_non_unique_chain);
-            sge_htable_destroy(ht->nuht);
-         }
-         sge_htable_destroy(ht->ht);
-         sge_free(&(descr[i].ht));
+      if (descr[i].ht != nullptr) {
+         cull_hash_destroy(&(descr[i].ht), mt_is_unique(descr[i].mt));
       }
    }
 }
@@ -781,6 +872,180 @@ int cull_hash_new(lList *lp, int nm, bool unique) {
    DRETURN(1);
 }
 
+/****** cull/hash/cull_hash_new_ordered() **************************************
+*  NAME
+*     cull_hash_new_ordered() -- create an ordered index for a list field
+*
+*  SYNOPSIS
+*     int cull_hash_new_ordered(lList *lp, int nm, bool unique)
+*
+*  FUNCTION
+*     Like cull_hash_new() but additionally keeps the elements of the list
+*     ordered by the value of the field 'nm' (like CULL_ORDERED in the
+*     object definition). The index is kept up to date when elements are
+*     added, removed or the field is modified and allows to find elements
+*     by value range with cull_hash_lower_bound() and to iterate in value
+*     order with cull_hash_ordered_first() and cull_hash_ordered_next()
+*     in O(log n).
+*
+*     Ordered indexes are available for lUlongT, lUlong64T, lStringT and
+*     lHostT fields. For fields of other types no index is created.
+*
+*  INPUTS
+*     lList *lp   - the list
+*     int nm      - field name id
+*     bool unique - unique values or not
+*
+*  RESULT
+*     int - 1 on success, else 0
+*
+*  SEE ALSO
+*     cull/hash/cull_hash_new()
+*     cull/hash/cull_hash_lower_bound()
+*******************************************************************************/
+int cull_hash_new_ordered(lList *lp, int nm, bool unique) {
+   int pos;
+
+   if (lp == nullptr || (pos = lGetPosInDescr(lp->descr, nm)) < 0 ||
+       !cull_ordered_is_supported(mt_get_type(lp->descr[pos].mt))) {
+      return 0;
+   }
+
+   lp->descr[pos].mt |= CULL_ORDERED;
+   if (lp->descr[pos].ht == nullptr) {
+      return cull_hash_new(lp, nm, unique);
+   }
+
+   /* a hash table already exists, add the ordered index to it */
+   if (lp->descr[pos].ht->ordered == nullptr) {
+      const lListElem *ep;
+
+      lp->descr[pos].ht->ordered = new cull_ordered_index(nm, pos, mt_get_type(lp->descr[pos].mt));
+      for_each_ep(ep, lp) {
+         cull_ordered_insert(lp->descr[pos].ht->ordered, ep);
+      }
+   }
+   return 1;
+}
+
+/* ordered index of field pos of a list or nullptr */
+static cull_ordered_index *
+cull_hash_ordered(const lList *lp, int pos) {
+   if (lp == nullptr || pos < 0 || lp->descr[pos].ht == nullptr) {
+      return nullptr;
+   }
+   return lp->descr[pos].ht->ordered;
+}
+
+/****** cull/hash/cull_hash_is_ordered() ***************************************
+*  NAME
+*     cull_hash_is_ordered() -- has a list field an ordered index
+*
+*  SYNOPSIS
+*     bool cull_hash_is_ordered(const lList *lp, int pos)
+*
+*  INPUTS
+*     const lList *lp - the list
+*     int pos         - position of the field
+*
+*  RESULT
+*     bool - true if there is an ordered index
+*******************************************************************************/
+bool cull_hash_is_ordered(const lList *lp, int pos) {
+   return cull_hash_ordered(lp, pos) != nullptr;
+}
+
+/****** cull/hash/cull_hash_lower_bound() **************************************
+*  NAME
+*     cull_hash_lower_bound() -- first element not lower than a value
+*
+*  SYNOPSIS
+*     lListElem *cull_hash_lower_bound(const lList *lp, int pos,
+*                                      const lListElem *key)
+*
+*  FUNCTION
+*     Returns the first element in the order of the ordered index of field
+*     'pos' whose value is not lower than the value of the same field in
+*     'key'. 'key' does not need to be part of the list, e.g. it can be a
+*     free element just holding the value to search for.
+*
+*     Elements having the same value are ordered by their address, not by
+*     their position in the list.
+*
+*  INPUTS
+*     const lList *lp      - the list
+*     int pos              - position of a field having an ordered index
+*     const lListElem *key - element holding the value
+*
+*  RESULT
+*     lListElem* - the element or nullptr if there is no such element or
+*                  no ordered index
+*******************************************************************************/
+lListElem *cull_hash_lower_bound(const lList *lp, int pos, const lListElem *key) {
+   cull_ordered_index *ordered = cull_hash_ordered(lp, pos);
+
+   if (ordered == nullptr || key == nullptr) {
+      return nullptr;
+   }
+
+   auto it = ordered->entries.lower_bound(cull_ordered_entry{key->cont[pos], nullptr});
+   return it != ordered->entries.end() ? const_cast<lListElem *>(it->ep) : nullptr;
+}
+
+/****** cull/hash/cull_hash_ordered_first() ************************************
+*  NAME
+*     cull_hash_ordered_first() -- element with the lowest value
+*
+*  SYNOPSIS
+*     lListElem *cull_hash_ordered_first(const lList *lp, int pos)
+*
+*  INPUTS
+*     const lList *lp - the list
+*     int pos         - position of a field having an ordered index
+*
+*  RESULT
+*     lListElem* - the element or nullptr
+*******************************************************************************/
+lListElem *cull_hash_ordered_first(const lList *lp, int pos) {
+   cull_ordered_index *ordered = cull_hash_ordered(lp, pos);
+
+   if (ordered == nullptr || ordered->entries.empty()) {
+      return nullptr;
+   }
+   return const_cast<lListElem *>(ordered->entries.begin()->ep);
+}
+
+/****** cull/hash/cull_hash_ordered_next() *************************************
+*  NAME
+*     cull_hash_ordered_next() -- next element in value order
+*
+*  SYNOPSIS
+*     lListElem *cull_hash_ordered_next(const lList *lp, int pos,
+*                                       const lListElem *ep)
+*
+*  FUNCTION
+*     Returns the element following 'ep' in the order of the ordered index
+*     of field 'pos'. 'ep' has to be part of the list.
+*
+*  INPUTS
+*     const lList *lp     - the list
+*     int pos             - position of a field having an ordered index
+*     const lListElem *ep - the current element
+*
+*  RESULT
+*     lListElem* - the next element or nullptr
+*******************************************************************************/
+lListElem *cull_hash_ordered_next(const lList *lp, int pos, const lListElem *ep) {
+   cull_ordered_index *ordered = cull_hash_ordered(lp, pos);
+
+   if (ordered == nullptr || ep == nullptr) {
+      return nullptr;
+   }
+
+   auto it = ordered->entries.upper_bound(cull_ordered_entry_of(ep, pos));
+   return it != ordered->entries.end() ? const_cast<lListElem *>(it->ep) : nullptr;
+}
+
 void *cull_hash_key(const lListElem *ep, int pos, char *host_key) {
    void *key = nullptr;
 
@@ -842,23 +1107,28 @@ void cull_hash_recreate_after_sort(lList *lp) {
    if (lp != nullptr) {
       lDescr *descr = lp->descr;
       int cleared_hash_index[32];
+      cull_ordered_index *ordered[32];
       int i, hash_index = 0;
 
       int size = hash_compute_size(lGetNumberOfElem(lp));
 
       /* at first free and recreated old non unique hashes */
       for (i = 0; mt_get_type(descr[i].mt) != lEndT; i++) {
-         cull_htable ht = descr[i].ht;
-         if (ht != nullptr) {
+         if (descr[i].ht != nullptr) {
             if (!mt_is_unique(descr[i].mt)) {
+               /* the value order does not depend on the list order, keep an ordered index */
+               ordered[hash_index] = descr[i].ht->ordered;
+               descr[i].ht->ordered = nullptr;
+
                /* free memory of non unique elements */
-               sge_htable_for_each_ep(ht->ht, cull_hash_delete_non_unique_chain);
-               sge_htable_destroy(ht->nuht);
-               sge_htable_destroy(ht->ht);
-               sge_free(&ht);
+               cull_hash_destroy(&(descr[i].ht), false);
 
                /* recreate empty hash */
                descr[i].ht = cull_hash_create(&descr[i], size);
+               if (descr[i].ht != nullptr) {
+                  delete descr[i].ht->ordered;
+                  descr[i].ht->ordered = nullptr;
+               }
 
                cleared_hash_index[hash_index] = i;
                hash_index++;
@@ -878,5 +1148,12 @@ void cull_hash_recreate_after_sort(lList *lp) {
             }
          }
       }
+      for (i = 0; i < hash_index; i++) {
+         if (descr[cleared_hash_index[i]].ht != nullptr) {
+            descr[cleared_hash_index[i]].ht->ordered = ordered[i];
+         } else {
+            delete ordered[i];
+         }
+      }
    }
 }
@@ -45,6 +45,16 @@ int cull_hash_new(lList *lp, int name, bool unique);
 
 int cull_hash_new_check(lList *lp, int nm, bool unique);
 
+int cull_hash_new_ordered(lList *lp, int nm, bool unique);
+
+bool cull_hash_is_ordered(const lList *lp, int pos);
+
+lListElem *cull_hash_lower_bound(const lList *lp, int pos, const lListElem *key);
+
+lListElem *cull_hash_ordered_first(const lList *lp, int pos);
+
+lListElem *cull_hash_ordered_next(const lList *lp, int pos, const lListElem *ep);
+
 void cull_hash_insert(const lListElem *ep, void *key, cull_htable ht, bool unique);
 
 void cull_hash_remove(const lListElem *ep, const int pos);
@@ -0,0 +1,195 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+/**
+ * @file
+ * @brief Inline CULL field accessors
+ *
+ * The names of the fields of a CULL type are consecutive enum values starting at the lower bound
+ * of the type (see LISTDEF headers in libs/sgeobj/cull). For elements having the complete
+ * (non-reduced) descriptor the position of a field is therefore the distance of its name to the
+ * name of the first field and can be computed without searching the descriptor.
+ *
+ * The functions in this file access the field directly in this case. Elements with a reduced
+ * descriptor, fields of a different type than expected, hashed fields (setters) and builds
+ * with OBSERVE fall back to the generic functions (lGetUlong() etc.) which also do the error
+ * handling.
+ *
+ * As the name is a compile time constant at nearly all call sites, the compiler reduces the
+ * access to a few instructions. Use these functions in the inner loops of the scheduler.
+ */
+
+#include "cull/cull_list.h"
+#include "cull/cull_listP.h"
+#include "cull/cull_multitype.h"
+#include "cull/cull_multitypeP.h"
+
+/**
+ * @brief Position of a field in an element having a non-reduced descriptor
+ *
+ * @param ep element
+ * @param nm field name
+ * @param type expected type of the field
+ * @return position of the field or -1 if the generic functions have to be used
+ */
+inline int
+lInlinePos(const lListElem *ep, int nm, int type) {
+   if (ep != nullptr) {
+      const lDescr *dp = ep->descr;
+
+      if ((dp->mt & CULL_IS_REDUCED) == 0) {
+         int pos = nm - dp->nm;
+
+         // ep->size is the length of the descriptor (see cull_pool_alloc_elem()), a name of a
+         // different type must not make us read behind its end
+         if (pos >= 0 && pos < static_cast<int>(ep->size) && dp[pos].nm == nm && mt_get_type(dp[pos].mt) == type) {
+            return pos;
+         }
+      }
+   }
+   return -1;
+}
+
+/**
+ * @brief Position of a field that can be modified without updating hash tables
+ *
+ * @param ep element
+ * @param nm field name
+ * @param type expected type of the field
+ * @return position of the field or -1 if the generic functions have to be used
+ */
+inline int
+lInlineSetPos(const lListElem *ep, int nm, int type) {
+#ifdef OBSERVE
+   return -1;
+#else
+   int pos = lInlinePos(ep, nm, type);
+
+   if (pos >= 0 && ep->descr[pos].ht != nullptr) {
+      pos = -1;
+   }
+   return pos;
+#endif
+}
+
+inline lUlong
+lGetUlongInline(const lListElem *ep, int nm) {
+   int pos = lInlinePos(ep, nm, lUlongT);
+   return pos >= 0 ? ep->cont[pos].ul : lGetUlong(ep, nm);
+}
+
+inline lUlong64
+lGetUlong64Inline(const lListElem *ep, int nm) {
+   int pos = lInlinePos(ep, nm, lUlong64T);
+   return pos >= 0 ? ep->cont[pos].ul64 : lGetUlong64(ep, nm);
+}
+
+inline lDouble
+lGetDoubleInline(const lListElem *ep, int nm) {
+   int pos = lInlinePos(ep, nm, lDoubleT);
+   return pos >= 0 ? ep->cont[pos].db : lGetDouble(ep, nm);
+}
+
+inline lBool
+lGetBoolInline(const lListElem *ep, int nm) {
+   int pos = lInlinePos(ep, nm, lBoolT);
+   return pos >= 0 ? ep->cont[pos].b : lGetBool(ep, nm);
+}
+
+inline const char *
+lGetStringInline(const lListElem *ep, int nm) {
+   int pos = lInlinePos(ep, nm, lStringT);
+   return pos >= 0 ? ep->cont[pos].str : lGetString(ep, nm);
+}
+
+inline const char *
+lGetHostInline(const lListElem *ep, int nm) {
+   int pos = lInlinePos(ep, nm, lHostT);
+   return pos >= 0 ? ep->cont[pos].host : lGetHost(ep, nm);
+}
+
+inline const lList *
+lGetListInline(const lListElem *ep, int nm) {
+   int pos = lInlinePos(ep, nm, lListT);
+   return pos >= 0 && (ep->cont[pos].glp == nullptr || ep->cont[pos].glp->packed == nullptr) ?
+          ep->cont[pos].glp : lGetList(ep, nm);
+}
+
+inline const lListElem *
+lGetObjectInline(const lListElem *ep, int nm) {
+   int pos = lInlinePos(ep, nm, lObjectT);
+   return pos >= 0 ? ep->cont[pos].obj : lGetObject(ep, nm);
+}
+
+inline int
+lSetUlongInline(lListElem *ep, int nm, lUlong value) {
+   int pos = lInlineSetPos(ep, nm, lUlongT);
+
+   if (pos < 0) {
+      return lSetUlong(ep, nm, value);
+   }
+   ep->cont[pos].ul = value;
+   return 0;
+}
+
+inline int
+lSetUlong64Inline(lListElem *ep, int nm, lUlong64 value) {
+   int pos = lInlineSetPos(ep, nm, lUlong64T);
+
+   if (pos < 0) {
+      return lSetUlong64(ep, nm, value);
+   }
+   ep->cont[pos].ul64 = value;
+   return 0;
+}
+
+inline int
+lSetDoubleInline(lListElem *ep, int nm, lDouble value) {
+   int pos = lInlineSetPos(ep, nm, lDoubleT);
+
+   if (pos < 0) {
+      return lSetDouble(ep, nm, value);
+   }
+   ep->cont[pos].db = value;
+   return 0;
+}
+
+inline int
+lAddDoubleInline(lListElem *ep, int nm, lDouble offset) {
+   int pos = lInlineSetPos(ep, nm, lDoubleT);
+
+   if (pos < 0) {
+      return lAddDouble(ep, nm, offset);
+   }
+   ep->cont[pos].db += offset;
+   return 0;
+}
+
+inline int
+lSetBoolInline(lListElem *ep, int nm, lBool value) {
+   int pos = lInlineSetPos(ep, nm, lBoolT);
+
+   if (pos < 0) {
+      return lSetBool(ep, nm, value);
+   }
+   ep->cont[pos].b = value;
+   return 0;
+}
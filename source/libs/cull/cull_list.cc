@@ -39,6 +39,8 @@
 #include <cstring>
 #include <cctype>
 #include <cstdarg>
+#include <algorithm>
+#include <vector>
 
 /* do not compile in monitoring code */
 #ifndef NO_SGE_COMPILE_DEBUG
@@ -62,6 +64,7 @@
 #include "cull/pack.h"
 #include "cull/cull_pack.h"
 #include "cull/cull_observe.h"
+#include "cull/cull_pool.h"
 
 #ifdef OBSERVE
 #  include "cull/cull_observe.h"
@@ -70,6 +73,7 @@
 #define CULL_BASIS_LAYER CULL_LAYER
 
 
+
 static void lWriteList_(const lList *lp, dstring *buffer, int nesting_level);
 
 static void lWriteElem_(const lListElem *lp, dstring *buffer, int nesting_level);
@@ -371,7 +375,7 @@ lCopySwitchPack(const lListElem *sep, lListElem *dep, int src_idx, int dst_idx,
          if (!sep->cont[src_idx].host)
             dep->cont[dst_idx].host = nullptr;
          else
-            dep->cont[dst_idx].host = strdup(sep->cont[src_idx].host);
+            dep->cont[dst_idx].host = cull_host_share(sep->cont[src_idx].host);
          break;
 
       case lDoubleT:
@@ -380,7 +384,17 @@ lCopySwitchPack(const lListElem *sep, lListElem *dep, int src_idx, int dst_idx,
       case lListT:
          if ((tlp = sep->cont[src_idx].glp) == nullptr)
             dep->cont[dst_idx].glp = nullptr;
-         else {
+         else if (lIsListShared(tlp) && pb == nullptr && (ep == nullptr || ep[0].pos == WHAT_ALL)) {
+            /* complete copy of a shared list: reference it instead */
+            dep->cont[dst_idx].glp = lShareList(tlp);
+         } else if (tlp->packed != nullptr && pb == nullptr && (ep == nullptr || ep[0].pos == WHAT_ALL)) {
+            /* complete copy of a list that was not unpacked yet: copy the packed elements */
+            dep->cont[dst_idx].glp = cull_copy_lazy_list(tlp);
+            if (dep->cont[dst_idx].glp == nullptr) {
+               dep->cont[dst_idx].glp = lSelectHashPack(tlp->listname, tlp, nullptr, ep, isHash, pb);
+            }
+         } else {
+            tlp = cull_unpack_lazy_list(tlp);
             dep->cont[dst_idx].glp = lSelectHashPack(tlp->listname, tlp, nullptr,
                                                      ep, isHash, pb);
          }
@@ -862,7 +876,7 @@ static void lWriteList_(const lList *lp, dstring *buffer, int nesting_level) {
 *     lListElem* - element pointer or nullptr
 ******************************************************************************/
 lListElem *lCreateElem(const lDescr *dp) {
-   int n, i;
+   int n;
    lListElem *ep;
 
    DENTER(CULL_LAYER);
@@ -872,37 +886,22 @@ lListElem *lCreateElem(const lDescr *dp) {
       DRETURN(nullptr);
    }
 
-   ep = (lListElem *) sge_malloc(sizeof(lListElem));
+   /* element and cont are one memory block, maybe reused from the pool */
+   ep = cull_pool_alloc_elem(n);
 
    if (ep == nullptr) {
       LERROR(LEMALLOC);
       DRETURN(nullptr);
    }
 
-   ep->next = nullptr;
-   ep->prev = nullptr;
-
-   ep->descr = (lDescr *) sge_malloc(sizeof(lDescr) * (n + 1));
+   /* free elements share the descriptor, it has no htables */
+   ep->descr = const_cast<lDescr *>(lInternDescr(dp));
    if (!ep->descr) {
-      LERROR(LEMALLOC);
-      sge_free(&ep);
+      cull_pool_free_elem(&ep);
       DRETURN(nullptr);
    }
-   memcpy(ep->descr, dp, sizeof(lDescr) * (n + 1));
-
-   /* new descr has no htables yet */
-   for (i = 0; i <= n; i++) {
-      ep->descr[i].ht = nullptr;
-      ep->descr[i].mt |= (dp->mt & CULL_IS_REDUCED);
-   }
 
    ep->status = FREE_ELEM;
-   if (!(ep->cont = (lMultiType *) calloc(1, sizeof(lMultiType) * n))) {
-      LERROR(LEMALLOC);
-      sge_free(&(ep->descr));
-      sge_free(&ep);
-      DRETURN(nullptr);
-   }
 
 #ifdef OBSERVE
       lObserveAdd(ep, nullptr, false);
@@ -988,6 +987,8 @@ lList *lCreateListHash(const char *listname, const lDescr *descr, bool hash) {
 
    lp->first = nullptr;
    lp->last = nullptr;
+   lp->ref_count.store(0, std::memory_order_relaxed);
+   lp->packed = nullptr;
    if (!(lp->descr = (lDescr *) sge_malloc(sizeof(lDescr) * (n + 1)))) {
       sge_free(&(lp->listname));
       sge_free(&lp);
@@ -1119,9 +1120,7 @@ void lFreeElem(lListElem **ep1) {
             break;
 
          case lHostT:
-            if (ep->cont[i].host != nullptr) {
-               sge_free(&(ep->cont[i].host));
-            }
+            cull_host_release(&(ep->cont[i].host));
             break;
 
          case lListT:
@@ -1142,21 +1141,14 @@ void lFreeElem(lListElem **ep1) {
       }
    }
 
-   /* lFreeElem is not responsible for list descriptor array */
-   if (ep->status == FREE_ELEM || ep->status == OBJECT_ELEM) {
-      cull_hash_free_descr(ep->descr);
-      sge_free(&(ep->descr));
-   }
-
-   if (ep->cont != nullptr) {
-      sge_free(&(ep->cont));
-   }
+   /* the descriptor belongs to the list or is shared (see lInternDescr()) */
 
 #ifdef OBSERVE
    lObserveRemove(*ep1);
 #endif
 
-   sge_free(ep1);
+   /* cont is part of the element memory */
+   cull_pool_free_elem(ep1);
    DRETURN_VOID;
 }
 
@@ -1168,7 +1160,8 @@ void lFreeElem(lListElem **ep1) {
 *     void lFreeList(lList **lp) 
 *
 *  FUNCTION
-*     Frees a list including all elements 
+*     Frees a list including all elements. Shared lists (see
+*     lMarkListShared()) are freed by the last owner.
 *
 *  INPUTS
 *     lList **lp - list 
@@ -1186,6 +1179,14 @@ void lFreeList(lList **lp) {
       DRETURN_VOID;
    }
 
+   /* shared lists are only released by the last owner,
+      acq_rel makes the modifications of all owners visible to the one that frees the list */
+   if ((*lp)->ref_count.load(std::memory_order_acquire) > 0 &&
+       (*lp)->ref_count.fetch_sub(1, std::memory_order_acq_rel) > 1) {
+      *lp = nullptr;
+      DRETURN_VOID;
+   }
+
    /* 
     * remove all hash tables, 
     * it is more efficient than removing it at the end 
@@ -1194,6 +1195,10 @@ void lFreeList(lList **lp) {
       cull_hash_free_descr((*lp)->descr);
    }
 
+   if ((*lp)->packed != nullptr) {
+      cull_free_lazy_list(*lp);
+   }
+
    while ((*lp)->first) {
       lListElem *elem = (*lp)->first;
       lRemoveElem(*lp, &elem);
@@ -1216,6 +1221,147 @@ void lFreeList(lList **lp) {
 }
 
 
+/****** cull/list/lMarkListShared() *******************************************
+*  NAME
+*     lMarkListShared() -- Marks a list as immutable shared list
+*
+*  SYNOPSIS
+*     void lMarkListShared(lList *lp)
+*
+*  FUNCTION
+*     Marks a list as shared. Complete copies of elements that contain
+*     this list as sublist (e.g. lCopyElem()) will reference the list
+*     instead of copying it. lFreeList() releases a shared list when
+*     the last owner frees it.
+*
+*     Accessors that allow modification of a sublist (lGetListRW(),
+*     lGetSubStrRW(), lAddSubStr(), lDelSubStr(), ...) create a private
+*     copy of a list that is shared with other owners (see
+*     lUnshareList()). Elements of a shared list must not be modified
+*     via lGetList(), e.g. with for_each_rw(ep, lGetList(...)).
+*
+*     qmaster marks the immutable job sublists in the GLOBAL data store
+*     (see job_mark_immutable_sublists_shared()). Events carry references
+*     to these lists, so the mirrored data stores (SCHEDULER, LISTENER and
+*     both READER versions) share them with the GLOBAL data store.
+*
+*  INPUTS
+*     lList *lp - list
+*
+*  NOTES
+*     MT-NOTE: lMarkListShared() is not MT safe. It has to be called
+*              by the only owner of the list.
+*
+*  SEE ALSO
+*     cull/list/lShareList()
+*     cull/list/lIsListShared()
+******************************************************************************/
+void lMarkListShared(lList *lp) {
+   if (lp != nullptr && lp->ref_count.load(std::memory_order_relaxed) == 0) {
+      lp->ref_count.store(1, std::memory_order_release);
+   }
+}
+
+/****** cull/list/lIsListShared() *********************************************
+*  NAME
+*     lIsListShared() -- Returns if a list is a shared list
+*
+*  SYNOPSIS
+*     bool lIsListShared(const lList *lp)
+*
+*  INPUTS
+*     const lList *lp - list
+*
+*  RESULT
+*     bool - true if lMarkListShared() was called for the list
+*
+*  NOTES
+*     MT-NOTE: lIsListShared() is MT safe
+******************************************************************************/
+bool lIsListShared(const lList *lp) {
+   return lp != nullptr && lp->ref_count.load(std::memory_order_acquire) > 0;
+}
+
+/****** cull/list/lShareList() ************************************************
+*  NAME
+*     lShareList() -- Returns an additional reference to a shared list
+*
+*  SYNOPSIS
+*     lList *lShareList(lList *lp)
+*
+*  FUNCTION
+*     Increases the number of owners of a list that has been marked
+*     with lMarkListShared(). Each owner has to release the list with
+*     lFreeList().
+*
+*  INPUTS
+*     lList *lp - shared list
+*
+*  RESULT
+*     lList * - the same list
+*
+*  NOTES
+*     MT-NOTE: lShareList() is MT safe
+*
+*  SEE ALSO
+*     cull/list/lMarkListShared()
+******************************************************************************/
+lList *lShareList(lList *lp) {
+   if (lp != nullptr) {
+      /* a list that was not marked before has one owner already,
+         the caller owns a reference, so the list cannot be freed meanwhile */
+      u_long32 expected = 0;
+      if (!lp->ref_count.compare_exchange_strong(expected, 2, std::memory_order_relaxed)) {
+         lp->ref_count.fetch_add(1, std::memory_order_relaxed);
+      }
+   }
+   return lp;
+}
+
+/****** cull/list/lUnshareList() **********************************************
+*  NAME
+*     lUnshareList() -- Makes a shared list private before modification
+*
+*  SYNOPSIS
+*     lList *lUnshareList(lList **lpp)
+*
+*  FUNCTION
+*     If the list referenced by "lpp" is shared with other owners then
+*     a private copy is created, the reference to the shared list is
+*     released and "lpp" is set to the copy. If the caller is the only
+*     owner then the list is no longer marked as shared, so neither this
+*     nor later modifications copy it.
+*
+*  INPUTS
+*     lList **lpp - reference to a list (e.g. the sublist of an element)
+*
+*  RESULT
+*     lList * - a list that can be modified by the caller
+*
+*  NOTES
+*     MT-NOTE: lUnshareList() is MT safe
+*
+*  SEE ALSO
+*     cull/list/lMarkListShared()
+******************************************************************************/
+lList *lUnshareList(lList **lpp) {
+   lList *lp = *lpp;
+
+   /* the caller gets the list itself, its elements have to be unpacked */
+   cull_unpack_lazy_list(lp);
+
+   if (lp != nullptr) {
+      if (lp->ref_count.load(std::memory_order_acquire) > 1) {
+         *lpp = lCopyList(lp->listname, lp);
+         lFreeList(&lp);
+      } else {
+         /* only the caller references the list, nobody else can share it meanwhile */
+         lp->ref_count.store(0, std::memory_order_relaxed);
+      }
+   }
+   return *lpp;
+}
+
 /****** cull/list/lAddSubList() ************************************************
 *  NAME
 *     lAddSubList() -- Append a list to the sublist of an element
@@ -1618,10 +1764,6 @@ int lInsertElem(lList *lp, lListElem *ep, lListElem *new_ep) {
       lp->first = new_ep;
    }
 
-   if (new_ep->status == FREE_ELEM) {
-      cull_hash_free_descr(new_ep->descr);
-      sge_free(&(new_ep->descr));
-   }
    new_ep->status = BOUND_ELEM;
    new_ep->descr = lp->descr;
 
@@ -1686,10 +1828,6 @@ int lAppendElem(lList *lp, lListElem *ep) {
       ep->prev = ep->next = nullptr;
    }
 
-   if (ep->status == FREE_ELEM) {
-      cull_hash_free_descr(ep->descr);
-      sge_free(&(ep->descr));
-   }
    ep->status = BOUND_ELEM;
    ep->descr = lp->descr;
 
@@ -1916,7 +2054,7 @@ lListElem *lDechainElem(lList *lp, lListElem *ep) {
 
    /* nullptr the ep next and previous pointers */
    ep->prev = ep->next = (lListElem *) nullptr;
-   ep->descr = lCopyDescr(ep->descr);
+   ep->descr = const_cast<lDescr *>(lInternDescr(ep->descr));
    ep->status = FREE_ELEM;
    lp->nelem--;
 
@@ -2266,6 +2404,93 @@ int lPSortList(lList *lp, const char *fmt, ...) {
    DRETURN(0);
 }
 
+/* an element and the value of its first sort field */
+struct lSortKey {
+   lMultiType key;
+   lListElem *ep;
+};
+
+/* lSortListParallel() sorts lists having at least this number of elements in parallel */
+#define CULL_PARALLEL_SORT_MIN 50000
+
+/* compares two elements like lSortCompare() using the cached value of the first sort field */
+static int
+lSortCompareKey(const lSortKey &k0, const lSortKey &k1, const lSortOrder *sp) {
+   int result;
+
+   switch (mt_get_type(sp[0].mt)) {
+      case lIntT:
+         result = intcmp(k0.key.i, k1.key.i);
+         break;
+      case lStringT:
+         result = sge_strnullcmp(k0.key.str, k1.key.str);
+         break;
+      case lHostT:
+         result = sge_strnullcmp(k0.key.host, k1.key.host);
+         break;
+      case lUlongT:
+         result = ulongcmp(k0.key.ul, k1.key.ul);
+         break;
+      case lUlong64T:
+         result = ulong64cmp(k0.key.ul64, k1.key.ul64);
+         break;
+      case lFloatT:
+         result = floatcmp(k0.key.fl, k1.key.fl);
+         break;
+      case lDoubleT:
+         result = doublecmp(k0.key.db, k1.key.db);
+         break;
+      case lLongT:
+         result = longcmp(k0.key.l, k1.key.l);
+         break;
+      case lBoolT:
+         result = boolcmp(k0.key.b, k1.key.b);
+         break;
+      case lCharT:
+         result = charcmp(k0.key.c, k1.key.c);
+         break;
+      default:
+         return lSortCompare(k0.ep, k1.ep, sp);
+   }
+   result *= sp[0].ad;
+
+   if (result == 0 && sp[1].nm != NoName) {
+      result = lSortCompare(k0.ep, k1.ep, sp + 1);
+   }
+   return result;
+}
+
+/* sorts a key array, large arrays are split into parts that are sorted by
+   the runner of the caller and merged afterwards, elements with the same keys
+   keep their order */
+static void
+lSortKeys(std::vector<lSortKey> &keys, const lSortOrder *sp, size_t parts, const lSortRunner &runner) {
+   auto less = [sp](const lSortKey &k0, const lSortKey &k1) {
+      return lSortCompareKey(k0, k1, sp) < 0;
+   };
+   size_t n = keys.size();
+
+   if (!runner || parts < 2 || n < CULL_PARALLEL_SORT_MIN) {
+      std::stable_sort(keys.begin(), keys.end(), less);
+      return;
+   }
+
+   size_t part_size = (n + parts - 1) / parts;
+   runner(parts, [&keys, &less, n, part_size](size_t begin, size_t end) {
+      for (size_t part = begin; part < end; part++) {
+         std::stable_sort(keys.begin() + std::min(part * part_size, n),
+                          keys.begin() + std::min((part + 1) * part_size, n), less);
+      }
+   });
+
+   for (size_t width = part_size; width < n; width *= 2) {
+      for (size_t lo = 0; lo + width < n; lo += 2 * width) {
+         std::inplace_merge(keys.begin() + lo, keys.begin() + lo + width,
+                            keys.begin() + std::min(lo + 2 * width, n), less);
+      }
+   }
+}
+
 /****** cull/list/lSortList() *************************************************
 *  NAME
 *     lSortList() -- Sort list according to sort order object 
@@ -2286,8 +2511,42 @@ int lPSortList(lList *lp, const char *fmt, ...) {
 *        -1 - Error
 ******************************************************************************/
 int lSortList(lList *lp, const lSortOrder *sp) {
+   return lSortListParallel(lp, sp, 1, nullptr);
+}
+
+/****** cull/list/lSortListParallel() *****************************************
+*  NAME
+*     lSortListParallel() -- Sort list, large lists in parallel
+*
+*  SYNOPSIS
+*     int lSortListParallel(lList *lp, const lSortOrder *sp, size_t parts,
+*                           const lSortRunner &runner)
+*
+*  FUNCTION
+*     Sort list according to sort order object like lSortList().
+*     Lists having at least 50000 elements are split into the given
+*     number of parts. The parts are sorted by the runner, which can use
+*     the threads of the caller, and merged afterwards. The sort is stable.
+*
+*  INPUTS
+*     lList *lp                   - list
+*     const lSortOrder *sp        - sort order object
+*     size_t parts                - number of parts
+*     const lSortRunner &runner   - calls task(begin, end) for the parts
+*                                   [0, parts) and returns when all parts
+*                                   are done
+*
+*  RESULT
+*     int - error state
+*         0 - OK
+*        -1 - Error
+*
+*  NOTES
+*     MT-NOTE: lSortListParallel() is MT safe if the runner is MT safe
+******************************************************************************/
+int lSortListParallel(lList *lp, const lSortOrder *sp, size_t parts, const lSortRunner &runner) {
    lListElem *ep;
-   lListElem **pointer;
+   bool changed = false;
    int i, n;
 
    DENTER(CULL_LAYER);
@@ -2297,7 +2556,8 @@ int lSortList(lList *lp, const lSortOrder *sp) {
    }
 
    /* 
-    * step 1: build up a pointer array for use of qsort
+    * step 1: build up a key array, the value of the first sort field
+    *         is read once per element instead of once per comparison
     */
 
    n = lGetNumberOfElem(lp);
@@ -2305,56 +2565,57 @@ int lSortList(lList *lp, const lSortOrder *sp) {
       DRETURN(0);                 /* ok list is sorted */
    }
 
-   if (!(pointer = (lListElem **) sge_malloc(sizeof(lListElem *) * n))) {
-      DRETURN(-1);                /* low memory */
-   }
+   std::vector<lSortKey> keys(n);
 
 #ifdef RANDOMIZE_QSORT_ELEMENTS
 
    for (i = 0, ep = lFirstRW(lp); ep; i++, ep = lNextRW(ep)) {
       int j = (int)((double)i*rand()/(RAND_MAX+1.0));
-      pointer[i] = pointer[j];
-      pointer[j] = ep;
+      keys[i] = keys[j];
+      keys[j] = lSortKey{ep->cont[sp[0].pos], ep};
    }
 
 #else
 
    for (i = 0, ep = lFirstRW(lp); ep; i++, ep = lNextRW(ep))
-      pointer[i] = ep;
+      keys[i] = lSortKey{ep->cont[sp[0].pos], ep};
 
 #endif
 
    /* 
-    * step 2: sort the pointer array using parsed sort order 
+    * step 2: sort the key array using parsed sort order 
     */
-   cull_state_set_global_sort_order(sp);
-   /* this is done to pass the sort order */
-   /* to the lSortCompare function called */
-   /* by lSortCompareUsingGlobal          */
-   qsort((void *) pointer, n, sizeof(lListElem *), lSortCompareUsingGlobal);
+   lSortKeys(keys, sp, parts, runner);
 
    /* 
-    * step 3: relink elements in list according pointer array
+    * step 3: relink elements in list according key array
     */
-   lp->first = pointer[0];
-   lp->last = pointer[n - 1];
+   for (i = 0, ep = lFirstRW(lp); ep; i++, ep = lNextRW(ep)) {
+      if (keys[i].ep != ep) {
+         changed = true;
+         break;
+      }
+   }
+   if (!changed) {
+      DRETURN(0);                 /* list was already sorted */
+   }
+
+   lp->first = keys[0].ep;
+   lp->last = keys[n - 1].ep;
 
    /* handle first element separatly */
-   pointer[0]->prev = nullptr;
-   pointer[n - 1]->next = nullptr;
+   keys[0].ep->prev = nullptr;
+   keys[n - 1].ep->next = nullptr;
 
-   if (n > 1) {
-      pointer[0]->next = pointer[1];
-      pointer[n - 1]->prev = pointer[n - 2];
-   }
+   keys[0].ep->next = keys[1].ep;
+   keys[n - 1].ep->prev = keys[n - 2].ep;
 
    for (i = 1; i < n - 1; i++) {
-      pointer[i]->prev = pointer[i - 1];
-      pointer[i]->next = pointer[i + 1];
+      keys[i].ep->prev = keys[i - 1].ep;
+      keys[i].ep->next = keys[i + 1].ep;
    }
 
-   sge_free(&pointer);
-
+   /* only the chains of non unique hashes follow the list order */
    cull_hash_recreate_after_sort(lp);
 
    DRETURN(0);
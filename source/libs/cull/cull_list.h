@@ -36,6 +36,7 @@
 /*___INFO__MARK_END__*/
 
 #include <cstdio>
+#include <functional>
 
 #include "basis_types.h"
 #include "cull/cull_hashP.h"
@@ -93,7 +94,7 @@ enum _enum_lMultiType {
 #define CULL_PRIMARY_KEY   0x00000100
 #define CULL_HASH          0x00000200
 #define CULL_UNIQUE        0x00000400
-#define CULL_UNUSED0       0x00000800
+#define CULL_ORDERED       0x00000800
 #define CULL_CONFIGURE     0x00001000
 #define CULL_SPOOL         0x00002000
 #define CULL_SUBLIST       0x00010000
@@ -254,6 +255,14 @@ void lFreeElem(lListElem **ep);
 
 void lFreeList(lList **ilp);
 
+void lMarkListShared(lList *lp);
+
+bool lIsListShared(const lList *lp);
+
+lList *lShareList(lList *lp);
+
+lList *lUnshareList(lList **lpp);
+
 int lAddList(lList *lp0, lList **lp1);
 
 int lAppendList(lList *lp0, lList *lp1);
@@ -298,6 +307,11 @@ int lPSortList(lList *lp, const char *fmt, ...);
 
 int lSortList(lList *lp, const lSortOrder *sp);
 
+/* calls task(begin, end) for the parts [0, n), possibly in parallel, and returns when all are done */
+typedef std::function<void(size_t n, const std::function<void(size_t begin, size_t end)> &task)> lSortRunner;
+
+int lSortListParallel(lList *lp, const lSortOrder *sp, size_t parts, const lSortRunner &runner);
+
 int lUniqStr(lList *lp, int keyfield);
 
 int lUniqHost(lList *lp, int keyfield);
@@ -327,7 +341,8 @@ lListElem *lFindFirstRW(const lList *lp, const lCondition *cp);
 lListElem *lFindLastRW(const lList *lp, const lCondition *cp);
 
 #define mt_get_type(mt) ((mt) & 0x000000FF)
-#define mt_do_hashing(mt) (((mt) & CULL_HASH) ? true : false)
+#define mt_do_hashing(mt) (((mt) & (CULL_HASH | CULL_ORDERED)) ? true : false)
+#define mt_is_ordered(mt) (((mt) & CULL_ORDERED) ? true : false)
 #define mt_is_unique(mt) (((mt) & CULL_UNIQUE) ? true : false)
 
 #define for_each_ep(ep, lp) for (ep=lFirst(lp);ep;ep=lNext(ep))
@@ -33,6 +33,8 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <atomic>
+
 #include "cull/cull_list.h"
 
 /****** cull/list/-Cull-List-defines ***************************************
@@ -66,10 +68,13 @@
 #define TRANS_BOUND_ELEM      (1<<2)
 #define OBJECT_ELEM           (1<<3)
 
+typedef struct _cull_packed_list cull_packed_list;
+
 struct _lListElem {
    lListElem *next;             /* next lList element                        */
    lListElem *prev;             /* previous lList element                    */
    lUlong status;               /* status: element in list/ element free     */
+   u_long32 size;               /* number of fields in cont (see cull_pool)  */
    lDescr *descr;               /* pointer to the descriptor array           */
    lMultiType *cont;            /* pointer to the lMultiType array           */
 };
@@ -80,4 +85,6 @@ struct _lList {
    lDescr *descr;               /* pointer to the descriptor array           */
    lListElem *first;            /* pointer to the first element of the list  */
    lListElem *last;             /* pointer to the last element of the list   */
+   std::atomic<u_long32> ref_count; /* owners of a shared list, 0 if not shared */
+   cull_packed_list *packed;    /* elements not unpacked yet (see cull_pack) */
 };
@@ -38,6 +38,11 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 
 /* do not compile in monitoring code */
 #ifndef NO_SGE_COMPILE_DEBUG
@@ -55,6 +60,7 @@
 #include "cull/cull_whatP.h"
 #include "cull/cull_lerrnoP.h"
 #include "cull/cull_hash.h"
+#include "cull/cull_pack.h"
 
 #ifdef OBSERVE
 #  include "cull/cull_observe.h"
@@ -439,6 +445,262 @@ lDescr *lCopyDescr(const lDescr *dp) {
    DRETURN(nullptr);
 }
 
+/* interned descriptors by content (see lInternDescr()), never freed */
+static std::mutex Intern_Descr_Mutex;
+static std::unordered_map<std::string, lDescr *> Intern_Descr_Map;
+
+/* per thread: descriptor passed to lInternDescr() => interned descriptor */
+static thread_local std::unordered_map<const lDescr *, const lDescr *> Intern_Descr_Cache;
+
+static bool
+intern_descr_equal(const lDescr *dp, const lDescr *interned, int reduced) {
+   int i;
+
+   for (i = 0; mt_get_type(dp[i].mt) != lEndT; i++) {
+      if (dp[i].nm != interned[i].nm || (dp[i].mt | reduced) != interned[i].mt) {
+         return false;
+      }
+   }
+   return mt_get_type(interned[i].mt) == lEndT;
+}
+
+/****** cull/multitype/lInternDescr() *****************************************
+*  NAME
+*     lInternDescr() -- Get the shared copy of a descriptor
+*
+*  SYNOPSIS
+*     const lDescr* lInternDescr(const lDescr *dp)
+*
+*  FUNCTION
+*     Returns a descriptor with the same names and types as 'dp' that is
+*     shared by all callers passing an equal descriptor. Elements which are
+*     not part of a list (free elements and sub objects) reference these
+*     descriptors instead of an own copy.
+*
+*     Like in lCreateElem() the CULL_IS_REDUCED flag of the first entry is
+*     applied to all entries. Hash tables of 'dp' are not referenced.
+*
+*  INPUTS
+*     const lDescr *dp - descriptor
+*
+*  RESULT
+*     const lDescr* - shared descriptor or nullptr in case of error.
+*                     It must neither be modified nor freed.
+*
+*  NOTES
+*     MT-NOTE: lInternDescr() is MT safe
+******************************************************************************/
+const lDescr *lInternDescr(const lDescr *dp) {
+   int reduced;
+
+   if (dp == nullptr) {
+      LERROR(LEDESCRNULL);
+      return nullptr;
+   }
+   reduced = dp->mt & CULL_IS_REDUCED;
+
+   /* fast path: the descriptor was interned before by this thread */
+   auto cached = Intern_Descr_Cache.find(dp);
+   if (cached != Intern_Descr_Cache.end() &&
+       (cached->second == dp || intern_descr_equal(dp, cached->second, reduced))) {
+      return cached->second;
+   }
+
+   int n = lCountDescr(dp);
+   if (n <= 0) {
+      LERROR(LECOUNTDESCR);
+      return nullptr;
+   }
+
+   std::string key;
+   key.reserve(sizeof(int) * 2 * n);
+   for (int i = 0; i < n; i++) {
+      int mt = dp[i].mt | reduced;
+      key.append(reinterpret_cast<const char *>(&dp[i].nm), sizeof(int));
+      key.append(reinterpret_cast<const char *>(&mt), sizeof(int));
+   }
+
+   lDescr *interned;
+   {
+      std::lock_guard<std::mutex> guard(Intern_Descr_Mutex);
+
+      auto it = Intern_Descr_Map.find(key);
+      if (it != Intern_Descr_Map.end()) {
+         interned = it->second;
+      } else {
+         interned = lCopyDescr(dp);
+         if (interned == nullptr) {
+            return nullptr;
+         }
+         for (int i = 0; i < n; i++) {
+            interned[i].mt |= reduced;
+         }
+         Intern_Descr_Map[key] = interned;
+      }
+   }
+
+   /* descriptors passed in might be temporary, don't let the cache grow endlessly */
+   if (Intern_Descr_Cache.size() > 1024) {
+      Intern_Descr_Cache.clear();
+   }
+   Intern_Descr_Cache[dp] = interned;
+   Intern_Descr_Cache[interned] = interned;
+   return interned;
+}
+
+/* interned host name: the header is stored in front of the name */
+struct cull_host_symbol {
+   std::atomic<u_long32> ref;
+   size_t hash;
+};
+
+#define CULL_HOST_SHARDS 16
+
+/* interned host names by name, the lock is sharded by the hash of the name */
+static struct {
+   std::mutex mutex;
+   std::unordered_map<std::string_view, cull_host_symbol *> map;
+} Intern_Host[CULL_HOST_SHARDS];
+
+static cull_host_symbol *
+cull_host_symbol_of(const char *host) {
+   return reinterpret_cast<cull_host_symbol *>(const_cast<char *>(host)) - 1;
+}
+
+/****** cull/multitype/cull_host_intern() *************************************
+*  NAME
+*     cull_host_intern() -- Get the interned copy of a host name
+*
+*  SYNOPSIS
+*     char *cull_host_intern(const char *host)
+*
+*  FUNCTION
+*     Values of lHostT fields are not copied for every element. There is
+*     one reference counted copy per distinct name which is shared by all
+*     elements. Equal host names of elements therefore have the same
+*     address and can be compared without a string compare
+*     (see sge_hostcmp()).
+*
+*     Returns the interned copy of 'host' and increments its reference
+*     count. The result must not be modified and has to be given back
+*     with cull_host_release().
+*
+*  INPUTS
+*     const char *host - host name or nullptr
+*
+*  RESULT
+*     char* - interned host name or nullptr if host is nullptr or
+*             there is not enough memory
+*
+*  NOTES
+*     MT-NOTE: cull_host_intern() is MT safe
+*
+*  SEE ALSO
+*     cull/multitype/cull_host_share()
+*     cull/multitype/cull_host_release()
+*******************************************************************************/
+char *
+cull_host_intern(const char *host) {
+   if (host == nullptr) {
+      return nullptr;
+   }
+
+   std::string_view key(host);
+   size_t hash = std::hash<std::string_view>{}(key);
+   auto &shard = Intern_Host[hash % CULL_HOST_SHARDS];
+   std::lock_guard<std::mutex> guard(shard.mutex);
+
+   auto it = shard.map.find(key);
+   if (it != shard.map.end()) {
+      it->second->ref++;
+      return reinterpret_cast<char *>(it->second + 1);
+   }
+
+   void *memory = malloc(sizeof(cull_host_symbol) + key.size() + 1);
+   if (memory == nullptr) {
+      return nullptr;
+   }
+   auto *symbol = new(memory) cull_host_symbol;
+   symbol->ref = 1;
+   symbol->hash = hash;
+   char *name = reinterpret_cast<char *>(symbol + 1);
+   memcpy(name, host, key.size() + 1);
+   shard.map.emplace(std::string_view(name, key.size()), symbol);
+   return name;
+}
+
+/****** cull/multitype/cull_host_share() **************************************
+*  NAME
+*     cull_host_share() -- Get another reference to an interned host name
+*
+*  SYNOPSIS
+*     char *cull_host_share(char *host)
+*
+*  FUNCTION
+*     Increments the reference count of a host name returned by
+*     cull_host_intern(), e.g. when an element is copied.
+*
+*  INPUTS
+*     char *host - interned host name or nullptr
+*
+*  RESULT
+*     char* - host
+*
+*  NOTES
+*     MT-NOTE: cull_host_share() is MT safe
+*******************************************************************************/
+char *
+cull_host_share(char *host) {
+   if (host != nullptr) {
+      cull_host_symbol_of(host)->ref++;
+   }
+   return host;
+}
+
+/****** cull/multitype/cull_host_release() ************************************
+*  NAME
+*     cull_host_release() -- Give back an interned host name
+*
+*  SYNOPSIS
+*     void cull_host_release(char **host)
+*
+*  FUNCTION
+*     Decrements the reference count of an interned host name and frees
+*     it when the last reference is gone. *host is set to nullptr.
+*
+*  INPUTS
+*     char **host - interned host name
+*
+*  NOTES
+*     MT-NOTE: cull_host_release() is MT safe
+*******************************************************************************/
+void
+cull_host_release(char **host) {
+   if (host == nullptr || *host == nullptr) {
+      return;
+   }
+
+   cull_host_symbol *symbol = cull_host_symbol_of(*host);
+   *host = nullptr;
+
+   /* other references remain, no need to lock */
+   u_long32 ref = symbol->ref;
+   while (ref > 1) {
+      if (symbol->ref.compare_exchange_weak(ref, ref - 1)) {
+         return;
+      }
+   }
+
+   /* the last reference might go away, cull_host_intern() could hand out a new one meanwhile */
+   auto &shard = Intern_Host[symbol->hash % CULL_HOST_SHARDS];
+   std::lock_guard<std::mutex> guard(shard.mutex);
+   if (--symbol->ref == 0) {
+      shard.map.erase(std::string_view(reinterpret_cast<char *>(symbol + 1)));
+      symbol->~cull_host_symbol();
+      free(symbol);
+   }
+}
+
 /****** cull/multitype/lWriteDescrTo() ****************************************
 *  NAME
 *     lWriteDescrTo() -- Writes a descriptor (for debugging purpose) 
@@ -610,6 +872,7 @@ lList **lGetListRef(const lListElem *ep, int name) {
    if (mt_get_type(ep->descr[pos].mt) != lListT)
       incompatibleType("lGetPosListRef");
 
+   lUnshareList(&(((lListElem *) ep)->cont[pos].glp));
    DRETURN(&(ep->cont[pos].glp));
 }
 
@@ -622,15 +885,6 @@ char **lGetPosStringRef(const lListElem *ep, int pos) {
    DRETURN(&(ep->cont[pos].str));
 }
 
-char **lGetPosHostRef(const lListElem *ep, int pos) {
-   DENTER(CULL_BASIS_LAYER);
-
-   if (mt_get_type(ep->descr[pos].mt) != lHostT)
-      incompatibleType("lGetPosHostRef");
-
-   DRETURN(&(ep->cont[pos].host));
-}
-
 
 /* 
    FOR THE lGet{Type} FUNCTIONS THERE IS NO REAL ERRORHANDLING
@@ -1060,7 +1314,7 @@ lList *lGetPosList(const lListElem *ep, int pos) {
    if (mt_get_type(ep->descr[pos].mt) != lListT)
       incompatibleType("lGetPosList");
 
-   DRETURN((lList *) ep->cont[pos].glp);
+   DRETURN(cull_unpack_lazy_list(ep->cont[pos].glp));
 }
 
 /****** cull/multitype/lGetObject() *********************************************
@@ -1092,6 +1346,16 @@ lListElem *lGetObject(const lListElem *ep, int name) {
    DRETURN((lListElem *) ep->cont[pos].obj);
 }
 
+/* returns the sublist at position pos for modification,
+   a list that is shared with other owners is copied before (see lUnshareList()) */
+static lList *
+lGetPosSubListRW(const lListElem *ep, int pos) {
+   lList **lpp = &(const_cast<lListElem *>(ep)->cont[pos].glp);
+
+   cull_unpack_lazy_list(*lpp);
+   return lUnshareList(lpp);
+}
+
 /****** cull/multitype/lGetList() *********************************************
 *  NAME
 *     lGetList() -- Returns the CULL list for a field name 
@@ -1120,11 +1384,22 @@ lList *lGetListRW(const lListElem *ep, int name) {
                         lNm2Str(name), multitypes[mt_get_type(ep->descr[pos].mt)]);
    }
 
-   DRETURN((lList *) ep->cont[pos].glp);
+   /* the caller might modify the list: shared lists have to be copied before */
+   DRETURN(lGetPosSubListRW(ep, pos));
 }
 
-const lList *lGetList(const lListElem *ep, int nm) {
-   return lGetListRW(ep, nm);
+const lList *lGetList(const lListElem *ep, int name) {
+   int pos;
+   DENTER(CULL_BASIS_LAYER);
+
+   pos = lGetPosViaElem(ep, name, SGE_DO_ABORT);
+
+   if (mt_get_type(ep->descr[pos].mt) != lListT) {
+      incompatibleType2(MSG_CULL_GETLIST_WRONGTYPEFORFIELDXY_SS,
+                        lNm2Str(name), multitypes[mt_get_type(ep->descr[pos].mt)]);
+   }
+
+   DRETURN(cull_unpack_lazy_list(ep->cont[pos].glp));
 }
 
 /****** cull/multitype/lGetOrCreateList() **************************************
@@ -2115,7 +2390,7 @@ int lSetPosHost(lListElem *ep, int pos, const char *value) {
    ** but most probably not neccessary and too expensive
    */
    str = ep->cont[pos].host;
-   if (value == nullptr && str == nullptr) {
+   if (value == str) {
       changed = 0;
    } else {
       if (value == nullptr || str == nullptr) {
@@ -2135,9 +2410,9 @@ int lSetPosHost(lListElem *ep, int pos, const char *value) {
          cull_hash_remove(ep, pos);
       }
 
-      /* strdup new string value */
+      /* get the interned copy of the new host value */
       if (value) {
-         if (!(str = strdup(value))) {
+         if (!(str = cull_host_intern(value))) {
             LERROR(LESTRDUP);
             DRETURN(-1);
          }
@@ -2145,8 +2420,8 @@ int lSetPosHost(lListElem *ep, int pos, const char *value) {
       else
          str = nullptr;               /* value is nullptr */
 
-      /* free old string value */
-      sge_free(&(ep->cont[pos].host));
+      /* release old host value */
+      cull_host_release(&(ep->cont[pos].host));
       ep->cont[pos].host = str;
 
       /* create entry in hash table */
@@ -2310,7 +2585,7 @@ int lSetHost(lListElem *ep, int name, const char *value) {
    ** but most probably not neccessary and too expensive
    */
    str = ep->cont[pos].host;
-   if (value == nullptr && str == nullptr) {
+   if (value == str) {
       changed = 0;
    } else {
       if (value == nullptr || str == nullptr) {
@@ -2329,17 +2604,17 @@ int lSetHost(lListElem *ep, int name, const char *value) {
       if (ep->descr[pos].ht != nullptr) {
          cull_hash_remove(ep, pos);
       }
-      /* strdup new string value */
-      /* do so before freeing the old one - they could point to the same object! */
+      /* get the interned copy of the new host value */
+      /* do so before releasing the old one - they could point to the same object! */
       if (value) {
-         if (!(str = strdup(value))) {
+         if (!(str = cull_host_intern(value))) {
             LERROR(LESTRDUP);
             DRETURN(-1);
          }
       } else {
          str = nullptr;               /* value is nullptr */
       }
-      sge_free(&(ep->cont[pos].host));
+      cull_host_release(&(ep->cont[pos].host));
       ep->cont[pos].host = str;
 
       /* create entry in hash table */
@@ -2520,9 +2795,15 @@ int lXchgString(lListElem *ep, int name, char **str) {
 #endif
 
    if (*str != ep->cont[pos].str) {
+      if (ep->descr[pos].ht != nullptr) {
+         cull_hash_remove(ep, pos);
+      }
       tmp = ep->cont[pos].str;
       ep->cont[pos].str = *str;
       *str = tmp;
+      if (ep->descr[pos].ht != nullptr) {
+         cull_hash_insert(ep, ep->cont[pos].str, ep->descr[pos].ht, mt_is_unique(ep->descr[pos].mt));
+      }
    }
 
    DRETURN(0);
@@ -2538,6 +2819,8 @@ int lXchgString(lListElem *ep, int name, char **str) {
 *
 *  FUNCTION
 *     Exchange the list pointer which has the given field name value. 
+*     A shared list that is returned in "lpp" is replaced by a private
+*     copy (see lUnshareList()).
 *
 *  INPUTS
 *     lListElem *ep - element 
@@ -2579,6 +2862,9 @@ int lXchgList(lListElem *ep, int name, lList **lpp) {
       tmp = ep->cont[pos].glp;
       ep->cont[pos].glp = *lpp;
       *lpp = tmp;
+
+      /* the caller might modify the list he got */
+      lUnshareList(lpp);
    }
 
    DRETURN(0);
@@ -3536,6 +3822,7 @@ lListElem *lAddSubStr(lListElem *ep, int nm, const char *str, int snm,
       DRETURN(nullptr);
    }
 
+   lUnshareList(&(ep->cont[sublist_pos].glp));
    ret = lAddElemStr(&(ep->cont[sublist_pos].glp), nm, str, dp);
 
    DRETURN(ret);
@@ -3589,6 +3876,7 @@ lListElem *lAddSubHost(lListElem *ep, int nm, const char *str, int snm,
       DRETURN(nullptr);
    }
 
+   lUnshareList(&(ep->cont[sublist_pos].glp));
    ret = lAddElemHost(&(ep->cont[sublist_pos].glp), nm, str, dp);
 
    DRETURN(ret);
@@ -3745,6 +4033,7 @@ int lDelSubStr(lListElem *ep, int nm, const char *str, int snm) {
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
+   lUnshareList(&(ep->cont[sublist_pos].glp));
    ret = lDelElemStr(&(ep->cont[sublist_pos].glp), nm, str);
 
    DRETURN(ret);
@@ -3832,7 +4121,7 @@ lListElem *lGetSubStrRW(const lListElem *ep, int nm, const char *str, int snm) {
       /* get position of sublist in ep */
       sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
-      ret = lGetElemStrRW(ep->cont[sublist_pos].glp, nm, str);
+      ret = lGetElemStrRW(lGetPosSubListRW(ep, sublist_pos), nm, str);
    }
 
    DRETURN(ret);
@@ -3840,7 +4129,10 @@ lListElem *lGetSubStrRW(const lListElem *ep, int nm, const char *str, int snm) {
 
 const lListElem *
 lGetSubStr(const lListElem *ep, int nm, const char *str, int snm) {
-   return lGetSubStrRW(ep, nm, str, snm);
+   if (ep == nullptr) {
+      return nullptr;
+   }
+   return lGetElemStr(cull_unpack_lazy_list(ep->cont[lGetPosViaElem(ep, snm, SGE_DO_ABORT)].glp), nm, str);
 }
 
 /****** cull/multitype/lGetElemStr() ******************************************
@@ -4168,6 +4460,7 @@ lListElem *lAddSubUlong(lListElem *ep, int nm, lUlong val, int snm,
       DRETURN(nullptr);
    }
 
+   lUnshareList(&(ep->cont[sublist_pos].glp));
    ret = lAddElemUlong(&(ep->cont[sublist_pos].glp), nm, val, dp);
 
    DRETURN(ret);
@@ -4259,6 +4552,7 @@ int lDelSubUlong(lListElem *ep, int nm, lUlong val, int snm) {
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
+   lUnshareList(&(ep->cont[sublist_pos].glp));
    ret = lDelElemUlong(&(ep->cont[sublist_pos].glp), nm, val);
 
    DRETURN(ret);
@@ -4343,13 +4637,13 @@ lListElem *lGetSubUlongRW(const lListElem *ep, int nm, lUlong val, int snm) {
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
-   ret = lGetElemUlongRW(ep->cont[sublist_pos].glp, nm, val);
+   ret = lGetElemUlongRW(lGetPosSubListRW(ep, sublist_pos), nm, val);
 
    DRETURN(ret);
 }
 
 const lListElem *lGetSubUlong(const lListElem *ep, int nm, lUlong val, int snm) {
-   return lGetSubUlongRW(ep, nm, val, snm);
+   return lGetElemUlong(cull_unpack_lazy_list(ep->cont[lGetPosViaElem(ep, snm, SGE_DO_ABORT)].glp), nm, val);
 }
 
 /****** cull/multitype/lGetElemUlong() ****************************************
@@ -4567,6 +4861,7 @@ lListElem *lAddSubUlong64(lListElem *ep, int nm, lUlong64 val, int snm,
       DRETURN(nullptr);
    }
 
+   lUnshareList(&(ep->cont[sublist_pos].glp));
    ret = lAddElemUlong64(&(ep->cont[sublist_pos].glp), nm, val, dp);
 
    DRETURN(ret);
@@ -4658,6 +4953,7 @@ int lDelSubUlong64(lListElem *ep, int nm, lUlong64 val, int snm) {
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
+   lUnshareList(&(ep->cont[sublist_pos].glp));
    ret = lDelElemUlong64(&(ep->cont[sublist_pos].glp), nm, val);
 
    DRETURN(ret);
@@ -4742,13 +5038,13 @@ lListElem *lGetSubUlong64RW(const lListElem *ep, int nm, lUlong64 val, int snm)
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
-   ret = lGetElemUlong64RW(ep->cont[sublist_pos].glp, nm, val);
+   ret = lGetElemUlong64RW(lGetPosSubListRW(ep, sublist_pos), nm, val);
 
    DRETURN(ret);
 }
 
 const lListElem *lGetSubUlong64(const lListElem *ep, int nm, lUlong64 val, int snm) {
-   return lGetSubUlong64RW(ep, nm, val, snm);
+   return lGetElemUlong64(cull_unpack_lazy_list(ep->cont[lGetPosViaElem(ep, snm, SGE_DO_ABORT)].glp), nm, val);
 }
 
 /****** cull/multitype/lGetElemUlong64() **************************************
@@ -4951,7 +5247,7 @@ lListElem *lGetSubCaseStr(const lListElem *ep, int nm, const char *str,
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
-   ret = lGetElemCaseStrRW(ep->cont[sublist_pos].glp, nm, str);
+   ret = lGetElemCaseStrRW(cull_unpack_lazy_list(ep->cont[sublist_pos].glp), nm, str);
 
    DRETURN(ret);
 }
@@ -5252,13 +5548,13 @@ lListElem *lGetSubHostRW(const lListElem *ep, int nm, const char *str, int snm)
    /* get position of sublist in ep */
    sublist_pos = lGetPosViaElem(ep, snm, SGE_DO_ABORT);
 
-   ret = lGetElemHostRW(ep->cont[sublist_pos].glp, nm, str);
+   ret = lGetElemHostRW(lGetPosSubListRW(ep, sublist_pos), nm, str);
 
    DRETURN(ret);
 }
 
 const lListElem *lGetSubHost(const lListElem *ep, int nm, const char *str, int snm) {
-   return lGetSubHostRW(ep, nm, str, snm);
+   return lGetElemHost(cull_unpack_lazy_list(ep->cont[lGetPosViaElem(ep, snm, SGE_DO_ABORT)].glp), nm, str);
 }
 
 /****** cull/multitype/lDelElemHost() ****************************************
@@ -60,6 +60,8 @@ int lCountDescr(const lDescr *dp);
 
 lDescr *lCopyDescr(const lDescr *dp);
 
+const lDescr *lInternDescr(const lDescr *dp);
+
 int lGetPosViaElem(const lListElem *element, int nm, int abort);
 
 void lInit(const lNameSpace *namev);
@@ -73,7 +75,6 @@ const char *lMt2Str(int mt);
 
 char **lGetPosStringRef(const lListElem *ep, int id);
 
-char **lGetPosHostRef(const lListElem *ep, int id);
 
 lList **lGetListRef(const lListElem *ep, int name);
 
@@ -54,3 +54,10 @@ union _lMultiType {
    lHost host;
    lCondition *cp;
 };
+
+/* values of lHostT fields are interned, see cull_host_intern() */
+char *cull_host_intern(const char *host);
+
+char *cull_host_share(char *host);
+
+void cull_host_release(char **host);
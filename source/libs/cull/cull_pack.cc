@@ -38,6 +38,12 @@
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 /* do not compile in monitoring code */
 #ifndef NO_SGE_COMPILE_DEBUG
@@ -56,6 +62,7 @@
 #include "cull/cull_whereP.h"
 #include "cull/cull_pack.h"
 #include "cull/cull_parse.h"
+#include "cull/cull_pool.h"
 
 #ifdef OBSERVE
 #  include "cull/cull_observe.h"
@@ -71,7 +78,7 @@ cull_pack_switch(sge_pack_buffer *pb, const lMultiType *src, lEnumeration *what,
 
 static int cull_unpack_descr(sge_pack_buffer *pb, lDescr **dpp);
 
-static int cull_unpack_cont(sge_pack_buffer *pb, lMultiType **mpp, const lDescr *dp, int flags);
+static int cull_unpack_cont(sge_pack_buffer *pb, lMultiType *cp, const lDescr *dp, int flags);
 
 static int
 cull_pack_cont(sge_pack_buffer *pb, const lMultiType *cp, const lDescr *dp,
@@ -81,6 +88,83 @@ static int cull_unpack_object(sge_pack_buffer *pb, lListElem **epp, int flags);
 
 static int cull_pack_object(sge_pack_buffer *pb, const lListElem *ep, int flags);
 
+static int cull_pack_shared_list(sge_pack_buffer *pb, const lList *lp);
+
+static bool cull_pack_lazy_list(sge_pack_buffer *pb, const lList *lp, int flags, int *ret);
+
+/* unpack sublists when they are accessed, set per thread, see lSetLazyUnpackMode() */
+static thread_local bool cull_unpack_lazy = false;
+
+static int cull_skip_list(sge_pack_buffer *pb, int flags);
+
+static int cull_unpack_list_lazy(sge_pack_buffer *pb, lList **lpp, int flags, bool lazy);
+
+struct _cull_pack_cache {
+   std::unordered_map<const lList *, std::string> packed_lists[2];   /* per format, see pb_is_compact() */
+};
+
+/*
+ * Descriptors of a packbuffer in compact format. A descriptor is packed
+ * completely the first time and later referenced by its number. The fields
+ * of a descriptor are stored as (nm, mt) pairs.
+ */
+struct _cull_descr_dict {
+   std::unordered_map<std::string, u_long32> ids;            /* packing: fields -> number */
+   std::shared_ptr<std::vector<std::string>> fields;         /* unpacking: number -> fields */
+   bool frozen = false;       /* the descriptors are known already (lazy unpacking) */
+   bool suspended = false;    /* pack descriptors without dictionary (pack cache) */
+};
+
+/* descriptor tags in compact format */
+#define CULL_DESCR_INLINE 0   /* descriptor follows, not added to the dictionary */
+#define CULL_DESCR_NEW    1   /* descriptor follows and gets the next number     */
+#define CULL_DESCR_REF    2   /* CULL_DESCR_REF + number of a known descriptor   */
+
+/* returns the dictionary of a compact packbuffer, it is created on first use */
+static cull_descr_dict_t *cull_descr_dict_get(sge_pack_buffer *pb) {
+   if (pb->descr_dict == nullptr) {
+      pb->descr_dict = new cull_descr_dict_t;
+      pb->descr_dict->fields = std::make_shared<std::vector<std::string>>();
+   }
+   return pb->descr_dict;
+}
+
+/* returns the fields of a descriptor as (nm, mt) pairs */
+static std::string cull_descr_fields(const lDescr *dp) {
+   std::string fields;
+
+   for (int i = 0; mt_get_type(dp[i].mt) != lEndT; i++) {
+      u_long32 field[2] = {static_cast<u_long32>(dp[i].nm), static_cast<u_long32>(dp[i].mt)};
+
+      fields.append(reinterpret_cast<const char *>(field), sizeof(field));
+   }
+   return fields;
+}
+
+/****** cull/pack/cull_descr_dict_free() **************************************
+*  NAME
+*     cull_descr_dict_free() -- free the descriptor dictionary of a packbuffer
+*
+*  SYNOPSIS
+*     void cull_descr_dict_free(cull_descr_dict_t **dict)
+*
+*  FUNCTION
+*     Frees the descriptors that were packed into or unpacked from a
+*     packbuffer in compact format. Called by clear_packbuffer().
+*
+*  INPUTS
+*     cull_descr_dict_t **dict - the dictionary, will be set to nullptr
+*
+*  NOTES
+*     MT-NOTE: cull_descr_dict_free() is MT safe
+******************************************************************************/
+void cull_descr_dict_free(cull_descr_dict_t **dict) {
+   if (dict != nullptr) {
+      delete *dict;
+      *dict = nullptr;
+   }
+}
+
 
 /* ------------------------------------------------------------
 
@@ -125,12 +209,20 @@ static int cull_unpack_switch(
          ret = unpackstr(pb, &(dst->str));
          break;
 
-      case lHostT:
-         ret = unpackstr(pb, &(dst->host));
+      case lHostT: {
+         char *host = nullptr;
+
+         ret = unpackstr(pb, &host);
+         dst->host = cull_host_intern(host);
+         if (host != nullptr && dst->host == nullptr) {
+            ret = PACK_ENOMEM;
+         }
+         sge_free(&host);
          break;
+      }
 
       case lListT:
-         ret = cull_unpack_list_partial(pb, &(dst->glp), flags);
+         ret = cull_unpack_list_lazy(pb, &(dst->glp), flags, cull_unpack_lazy);
          break;
 
       case lObjectT:
@@ -202,7 +294,11 @@ cull_pack_switch(sge_pack_buffer *pb, const lMultiType *src, lEnumeration *what,
          break;
 
       case lListT:
-         ret = cull_pack_list_partial(pb, src->glp, what, flags);
+         if (pb->pack_cache != nullptr && what == nullptr && flags == 0 && lIsListShared(src->glp)) {
+            ret = cull_pack_shared_list(pb, src->glp);
+         } else {
+            ret = cull_pack_list_partial(pb, src->glp, what, flags);
+         }
          break;
 
       case lObjectT:
@@ -252,13 +348,31 @@ static int cull_unpack_descr(
    u_long32 n = 0;
    u_long32 i = 0;
    u_long32 temp = 0;
+   u_long32 tag = CULL_DESCR_INLINE;
+   const std::string *known_fields = nullptr;
 
    DENTER(CULL_LAYER);
 
    *dpp = nullptr;
 
+   /* compact format: the descriptor might have been packed before */
+   if (pb_is_compact(pb)) {
+      if ((ret = unpackint(pb, &tag))) {
+         DRETURN(ret);
+      }
+      if (tag >= CULL_DESCR_REF) {
+         cull_descr_dict_t *dict = cull_descr_dict_get(pb);
+
+         if (tag - CULL_DESCR_REF >= dict->fields->size()) {
+            DRETURN(PACK_FORMAT);
+         }
+         known_fields = &(*dict->fields)[tag - CULL_DESCR_REF];
+         n = known_fields->size() / (2 * sizeof(u_long32));
+      }
+   }
+
    /* read in number of lDescr fields (without end mark) */
-   if ((ret = unpackint(pb, &n))) {
+   if (known_fields == nullptr && (ret = unpackint(pb, &n))) {
       DRETURN(ret);
    }
 
@@ -281,6 +395,16 @@ static int cull_unpack_descr(
 
    /* read in n lDescr fields */
    for (i = 0; i < n; i++) {
+      if (known_fields != nullptr) {
+         u_long32 field[2];
+
+         memcpy(field, known_fields->data() + i * sizeof(field), sizeof(field));
+         dp[i].nm = field[0];
+         dp[i].mt = field[1];
+         dp[i].ht = nullptr;
+         continue;
+      }
+
       if ((ret = unpackint(pb, &temp))) {
          sge_free(&dp);
          DRETURN(ret);
@@ -295,6 +419,15 @@ static int cull_unpack_descr(
       dp[i].ht = nullptr;
    }
 
+   /* remember a new descriptor, later ones refer to it by number */
+   if (tag == CULL_DESCR_NEW) {
+      cull_descr_dict_t *dict = cull_descr_dict_get(pb);
+
+      if (!dict->frozen) {
+         dict->fields->push_back(cull_descr_fields(dp));
+      }
+   }
+
    /* 
     * above we made the assumption that the unpacked descriptor was reduced
     * now we have to check that the assumption is correct 
@@ -395,6 +528,24 @@ int cull_pack_descr(sge_pack_buffer *pb, const lDescr *dp) {
 
    DENTER(CULL_LAYER);
 
+   /* compact format: pack a descriptor only once */
+   if (pb_is_compact(pb)) {
+      cull_descr_dict_t *dict = cull_descr_dict_get(pb);
+      u_long32 tag = CULL_DESCR_INLINE;
+
+      if (!dict->suspended) {
+         auto [id, is_new] = dict->ids.try_emplace(cull_descr_fields(dp), dict->ids.size());
+
+         if (!is_new) {
+            DRETURN(packint(pb, CULL_DESCR_REF + id->second));
+         }
+         tag = CULL_DESCR_NEW;
+      }
+      if ((ret = packint(pb, tag))) {
+         DRETURN(ret);
+      }
+   }
+
    /* pack the number of lDescr fields (without end mark) */
    if ((ret = packint(pb, lCountDescr(dp)))) {
       DRETURN(ret);
@@ -422,6 +573,11 @@ cull_pack_enum_as_descr(sge_pack_buffer *pb, const lEnumeration *what,
    DENTER(CULL_LAYER);
 
    PROF_START_MEASUREMENT(SGE_PROF_PACKING);
+   /* compact format: reduced descriptors are not added to the dictionary */
+   if (pb_is_compact(pb) && (ret = packint(pb, CULL_DESCR_INLINE))) {
+      PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
+      DRETURN(ret);
+   }
    /* pack the number of lDescr fields (without end mark) */
    if ((ret = packint(pb, lCountWhat(what, descr)))) {
       PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
@@ -516,7 +672,7 @@ cull_pack_cont(sge_pack_buffer *pb, const lMultiType *cp, const lDescr *dp,
  */
 static int cull_unpack_cont(
         sge_pack_buffer *pb,
-        lMultiType **mpp,
+        lMultiType *cp,
         const lDescr *dp,
         int flags
 ) {
@@ -528,16 +684,11 @@ static int cull_unpack_cont(
                                      * error happens */
    int last_error = PACK_SUCCESS;   /* error happend in last iteration 
                                      * or PACK_SUCCESS */
-   lMultiType *cp = nullptr;
 
    DENTER(CULL_LAYER);
 
-   *mpp = nullptr;
+   /* cp is part of the element memory and already zeroed */
    n = lCountDescr(dp);
-   if ((cp = (lMultiType *) calloc(1, sizeof(lMultiType) * (n + 1))) == nullptr) {
-      LERROR(LEMALLOC);
-      DRETURN(PACK_ENOMEM);
-   }
 
    for (i = 0; i < n; i++) {
       /* if flags are given, unpack only fields matching flags, e.g. CULL_SPOOL */
@@ -577,7 +728,6 @@ static int cull_unpack_cont(
        * Format errors should only be catched if they ocure at the en of 
        * the descriptor.
        */
-      sge_free(&cp);
       ret = (last_error != PACK_SUCCESS) ? last_error : PACK_FORMAT;
    } else {
       /*
@@ -585,7 +735,6 @@ static int cull_unpack_cont(
        */
       ret = PACK_SUCCESS;
    }
-   *mpp = cp;
    DRETURN(ret);
 }
 
@@ -674,26 +823,23 @@ int cull_unpack_elem(
 int cull_unpack_elem_partial(sge_pack_buffer *pb, lListElem **epp, const lDescr *dp, int flags) {
    int ret;
    lListElem *ep = nullptr;
+   u_long32 status;
+   lDescr *descr = nullptr;
 
    DENTER(CULL_LAYER);
 
    PROF_START_MEASUREMENT(SGE_PROF_PACKING);
    *epp = nullptr;
 
-   if ((ep = (lListElem *) calloc(1, sizeof(lListElem))) == nullptr) {
-      PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
-      DRETURN(PACK_ENOMEM);
-   }
-
-   if ((ret = unpackint(pb, &(ep->status))) != PACK_SUCCESS) {
-      sge_free(&ep);
+   if ((ret = unpackint(pb, &status)) != PACK_SUCCESS) {
       PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
       DRETURN(ret);
    }
 
-   if (ep->status == FREE_ELEM) {
-      if ((ret = cull_unpack_descr(pb, &(ep->descr))) != PACK_SUCCESS) {
-         sge_free(&ep);
+   if (status == FREE_ELEM) {
+      lDescr *unpacked_descr = nullptr;
+
+      if ((ret = cull_unpack_descr(pb, &unpacked_descr)) != PACK_SUCCESS) {
          PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
          DRETURN(ret);
       }
@@ -716,40 +862,40 @@ int cull_unpack_elem_partial(sge_pack_buffer *pb, lListElem **epp, const lDescr
        * in sgeobj header file and not cull.
        */
       if (dp != nullptr && dp[0].nm == 50) {
-         sge_free(&(ep->descr));
-         if ((ep->descr = lCopyDescr((lDescr *) dp)) == nullptr) {
-            sge_free(&ep);
-            PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
-            DRETURN(PACK_BADARG);
-         }
+         descr = const_cast<lDescr *>(lInternDescr(dp));
+      } else {
+         descr = const_cast<lDescr *>(lInternDescr(unpacked_descr));
+      }
+      sge_free(&unpacked_descr);
+      if (descr == nullptr) {
+         PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
+         DRETURN(PACK_BADARG);
       }
    } else {
       /* 
          if it is not a free element we need 
          a descriptor from outside 
        */
-      if ((ep->descr = (lDescr *) dp) == nullptr) {
-         sge_free(&ep);
+      if ((descr = (lDescr *) dp) == nullptr) {
          PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
          DRETURN(PACK_BADARG);
       }
    }
 
+   /* element and cont are one memory block, maybe reused from the pool */
+   if ((ep = cull_pool_alloc_elem(lCountDescr(descr))) == nullptr) {
+      PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
+      DRETURN(PACK_ENOMEM);
+   }
+   ep->status = status;
+   ep->descr = descr;
+
    /* This is a hack, to avoid aborts in lAppendElem */
    if (ep->status == BOUND_ELEM || ep->status == OBJECT_ELEM)
       ep->status = TRANS_BOUND_ELEM;
 
-   /* 
-      here after setting status correctly we got 
-      an element in a defined state - so we may
-      call lFreeElem() in case of errors 
-    */
-
-   if ((ret = cull_unpack_cont(pb, &(ep->cont), ep->descr, flags))) {
-      if (ep->status == FREE_ELEM || ep->status == OBJECT_ELEM) {
-         sge_free(&(ep->descr));
-      }
-      sge_free(&ep);
+   if ((ret = cull_unpack_cont(pb, ep->cont, ep->descr, flags))) {
+      cull_pool_free_elem(&ep);
       PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
       DRETURN(ret);
    }
@@ -831,6 +977,13 @@ int cull_pack_list_partial(sge_pack_buffer *pb, const lList *lp,
 
    PROF_START_MEASUREMENT(SGE_PROF_PACKING);
 
+   /* elements that were not unpacked yet can be copied in packed form */
+   if (lp != nullptr && pb != nullptr && what == nullptr && cull_pack_lazy_list(pb, lp, flags, &ret)) {
+      PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
+      DRETURN(ret);
+   }
+   lp = cull_unpack_lazy_list(lp);
+
    if (lp != nullptr && pb != nullptr) {
       if ((ret = packint(pb, 1)) != PACK_SUCCESS) {
          PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
@@ -888,6 +1041,444 @@ int cull_pack_list_partial(sge_pack_buffer *pb, const lList *lp,
    DRETURN(PACK_SUCCESS);
 }
 
+/****** cull/pack/cull_pack_cache_create() ************************************
+*  NAME
+*     cull_pack_cache_create() -- create a cache for packed shared lists
+*
+*  SYNOPSIS
+*     cull_pack_cache_t *cull_pack_cache_create()
+*
+*  FUNCTION
+*     Creates a cache that keeps the packed form of shared sublists (see
+*     lMarkListShared()). If a packbuffer references the cache in
+*     pack_cache then shared sublists that are packed more than once (e.g.
+*     the same event data for several event clients) are packed only once
+*     and afterwards copied into the packbuffer.
+*
+*     Shared lists must not be freed while they are part of the cache.
+*
+*  RESULT
+*     cull_pack_cache_t * - the new cache
+*
+*  NOTES
+*     MT-NOTE: cull_pack_cache_create() is MT safe
+*
+*  SEE ALSO
+*     cull/pack/cull_pack_cache_free()
+******************************************************************************/
+cull_pack_cache_t *cull_pack_cache_create() {
+   return new cull_pack_cache_t;
+}
+
+/****** cull/pack/cull_pack_cache_free() **************************************
+*  NAME
+*     cull_pack_cache_free() -- free a cache for packed shared lists
+*
+*  SYNOPSIS
+*     void cull_pack_cache_free(cull_pack_cache_t **cache)
+*
+*  INPUTS
+*     cull_pack_cache_t **cache - the cache, will be set to nullptr
+*
+*  NOTES
+*     MT-NOTE: cull_pack_cache_free() is MT safe
+******************************************************************************/
+void cull_pack_cache_free(cull_pack_cache_t **cache) {
+   if (cache != nullptr) {
+      delete *cache;
+      *cache = nullptr;
+   }
+}
+
+/* ------------------------------------------------------------
+
+   cull_pack_shared_list() - packs a shared list or copies the
+                             packed form of it from the cache
+
+   return values:
+   PACK_SUCCESS
+   PACK_ENOMEM
+   PACK_FORMAT
+
+ */
+static int cull_pack_shared_list(sge_pack_buffer *pb, const lList *lp) {
+   int ret;
+
+   DENTER(CULL_LAYER);
+
+   auto &packed_lists = pb->pack_cache->packed_lists[pb_is_compact(pb) ? 1 : 0];
+   auto packed_list = packed_lists.find(lp);
+   if (packed_list != packed_lists.end()) {
+      ret = packbuf(pb, packed_list->second.data(), packed_list->second.size());
+   } else {
+      size_t start = pb->bytes_used;
+      cull_descr_dict_t *dict = pb_is_compact(pb) ? cull_descr_dict_get(pb) : nullptr;
+      bool suspended = false;
+
+      /* the cached data is copied into other packbuffers, it must not refer to their dictionary */
+      if (dict != nullptr) {
+         suspended = dict->suspended;
+         dict->suspended = true;
+      }
+      ret = cull_pack_list_partial(pb, lp, nullptr, 0);
+      if (dict != nullptr) {
+         dict->suspended = suspended;
+      }
+      if (ret == PACK_SUCCESS && !pb->just_count) {
+         packed_lists.emplace(lp, std::string(pb->head_ptr + start, pb->bytes_used - start));
+      }
+   }
+
+   DRETURN(ret);
+}
+
+/* ------------------------------------------------------------
+
+   lazy unpacking of sublists
+
+   In lazy unpack mode the elements of sublists are not unpacked together
+   with the object containing the sublist. The packed form of the elements
+   is kept in the list and the elements are unpacked when the list is
+   accessed the first time (lGetList(), lGetListRW(), lGetPosList(), ...).
+   Sublists that are never accessed are never unpacked, when they are
+   packed again their packed form is copied.
+
+ */
+
+/* elements of a list that are kept in packed form */
+struct _cull_packed_list {
+   std::string data;            /* packed elements including the end mark */
+   int flags;                   /* flags used for unpacking the list      */
+   std::shared_ptr<std::vector<std::string>> descrs;  /* descriptor dictionary (compact format) */
+};
+
+/* lists can be read by several threads, their elements are unpacked once */
+static std::mutex cull_lazy_mutex;
+
+static cull_packed_list *
+cull_get_packed(const lList *lp, std::memory_order order) {
+   return std::atomic_ref<cull_packed_list *>(const_cast<lList *>(lp)->packed).load(order);
+}
+
+/****** cull/pack/lSetLazyUnpackMode() ****************************************
+*  NAME
+*     lSetLazyUnpackMode() -- unpack sublists on first access
+*
+*  SYNOPSIS
+*     void lSetLazyUnpackMode(bool enabled)
+*
+*  FUNCTION
+*     Enables or disables lazy unpacking of sublists for the calling
+*     thread. Lists unpacked by the thread while the mode is enabled keep
+*     the elements of their sublists in packed form. The elements are
+*     unpacked transparently when the sublist is accessed through the
+*     list accessor functions.
+*
+*     This makes unpacking of objects with large sublists (e.g. jobs with
+*     their environment, path and task lists) faster and cheaper in
+*     memory when the receiver needs only some of the sublists.
+*
+*  INPUTS
+*     bool enabled - true to enable lazy unpacking
+*
+*  NOTES
+*     MT-NOTE: lSetLazyUnpackMode() is MT safe
+*******************************************************************************/
+void lSetLazyUnpackMode(bool enabled) {
+   cull_unpack_lazy = enabled;
+}
+
+/****** cull/pack/lGetLazyUnpackMode() ****************************************
+*  NAME
+*     lGetLazyUnpackMode() -- is lazy unpacking enabled
+*
+*  SYNOPSIS
+*     bool lGetLazyUnpackMode()
+*
+*  RESULT
+*     bool - true if sublists are unpacked on first access
+*
+*  NOTES
+*     MT-NOTE: lGetLazyUnpackMode() is MT safe
+*******************************************************************************/
+bool lGetLazyUnpackMode() {
+   return cull_unpack_lazy;
+}
+
+/* skips a packed string */
+static int cull_skip_str(sge_pack_buffer *pb) {
+   size_t n;
+
+   if (pb->bytes_used >= pb->mem_size) {
+      return PACK_FORMAT;
+   }
+   n = strnlen(pb->cur_ptr, pb->mem_size - pb->bytes_used) + 1;
+   if (n + pb->bytes_used > pb->mem_size) {
+      return PACK_FORMAT;
+   }
+   pb->cur_ptr += n;
+   pb->bytes_used += n;
+   return PACK_SUCCESS;
+}
+
+/* skips the packed fields of an element, see cull_unpack_cont() */
+static int cull_skip_cont(sge_pack_buffer *pb, const lDescr *dp, int flags) {
+   int ret = PACK_SUCCESS;
+   u_long32 i32;
+   u_long64 i64;
+   double d;
+
+   for (int i = 0; ret == PACK_SUCCESS && mt_get_type(dp[i].mt) != lEndT; i++) {
+      if (flags != 0 && (dp[i].mt & flags) == 0) {
+         continue;
+      }
+      switch (mt_get_type(dp[i].mt)) {
+         case lBoolT:
+         case lUlongT:
+            ret = unpackint(pb, &i32);
+            break;
+         case lUlong64T:
+            ret = unpackint64(pb, &i64);
+            break;
+         case lStringT:
+         case lHostT:
+            ret = cull_skip_str(pb);
+            break;
+         case lListT:
+            ret = cull_skip_list(pb, flags);
+            break;
+         case lObjectT:
+            ret = unpackint(pb, &i32);
+            if (ret == PACK_SUCCESS && i32 != 0) {
+               lDescr *descr = nullptr;
+
+               if ((ret = cull_unpack_descr(pb, &descr)) == PACK_SUCCESS) {
+                  ret = unpackint(pb, &i32);
+                  if (ret == PACK_SUCCESS && i32 == FREE_ELEM) {
+                     ret = PACK_FORMAT;
+                  } else if (ret == PACK_SUCCESS) {
+                     ret = cull_skip_cont(pb, descr, flags);
+                  }
+                  sge_free(&descr);
+               }
+            }
+            break;
+         case lDoubleT:
+            ret = unpackdouble(pb, &d);
+            break;
+         case lRefT:
+            break;
+         default:
+            ret = PACK_FORMAT;
+            break;
+      }
+   }
+   return ret;
+}
+
+/* skips the packed elements of a list, see cull_unpack_elems() */
+static int cull_skip_elems(sge_pack_buffer *pb, const lDescr *dp, int flags) {
+   u_long32 has_more_elements = 0;
+   u_long32 status;
+   int ret;
+
+   if ((ret = unpackint(pb, &has_more_elements)) != PACK_SUCCESS) {
+      return ret;
+   }
+   while (has_more_elements) {
+      if ((ret = unpackint(pb, &status)) != PACK_SUCCESS) {
+         return ret;
+      }
+      /* free elements in lists are unusual, unpack them eagerly */
+      if (status == FREE_ELEM) {
+         return PACK_FORMAT;
+      }
+      if ((ret = cull_skip_cont(pb, dp, flags)) != PACK_SUCCESS) {
+         return ret;
+      }
+      if ((ret = unpackint(pb, &has_more_elements)) != PACK_SUCCESS) {
+         return ret;
+      }
+   }
+   return PACK_SUCCESS;
+}
+
+/* skips a packed list, see cull_unpack_list_partial() */
+static int cull_skip_list(sge_pack_buffer *pb, int flags) {
+   lDescr *descr = nullptr;
+   u_long32 i = 0;
+   int ret;
+
+   if ((ret = unpackint(pb, &i)) != PACK_SUCCESS || i == 0) {
+      return ret;
+   }
+   if ((ret = cull_skip_str(pb)) != PACK_SUCCESS) {
+      return ret;
+   }
+   if ((ret = cull_unpack_descr(pb, &descr)) != PACK_SUCCESS) {
+      return ret;
+   }
+   ret = cull_skip_elems(pb, descr, flags);
+   sge_free(&descr);
+   return ret;
+}
+
+/* unpacks the elements of a list and appends them to the list */
+static int cull_unpack_elems(sge_pack_buffer *pb, lList *lp, int flags) {
+   lListElem *ep;
+   u_long32 has_more_elements = 0;
+   int ret;
+
+   // as long as we find a 1 we have to unpack an element
+   if ((ret = unpackint(pb, &has_more_elements)) != PACK_SUCCESS) {
+      return ret;
+   }
+   while (has_more_elements) {
+      if ((ret = cull_unpack_elem_partial(pb, &ep, lp->descr, flags)) != PACK_SUCCESS) {
+         return ret;
+      }
+      lAppendElem(lp, ep);
+      // as long as we find a 1 we have to unpack an element
+      if ((ret = unpackint(pb, &has_more_elements)) != PACK_SUCCESS) {
+         return ret;
+      }
+   }
+   return PACK_SUCCESS;
+}
+
+/****** cull/pack/cull_unpack_lazy_list() *************************************
+*  NAME
+*     cull_unpack_lazy_list() -- unpack the elements of a lazy list
+*
+*  SYNOPSIS
+*     lList *cull_unpack_lazy_list(const lList *lp)
+*
+*  FUNCTION
+*     If the elements of the list have not been unpacked yet (see
+*     lSetLazyUnpackMode()) then they are unpacked now. Sublists of the
+*     elements are unpacked lazily again.
+*
+*     Called by the list accessor functions, the list pointer does not
+*     change.
+*
+*  INPUTS
+*     const lList *lp - list or nullptr
+*
+*  RESULT
+*     lList * - the list
+*
+*  NOTES
+*     MT-NOTE: cull_unpack_lazy_list() is MT safe
+*******************************************************************************/
+lList *cull_unpack_lazy_list(const lList *lp) {
+   auto *list = const_cast<lList *>(lp);
+
+   if (list == nullptr || cull_get_packed(list, std::memory_order_acquire) == nullptr) {
+      return list;
+   }
+
+   std::lock_guard<std::mutex> guard(cull_lazy_mutex);
+
+   cull_packed_list *packed = cull_get_packed(list, std::memory_order_relaxed);
+   if (packed != nullptr) {
+      sge_pack_buffer pb{};
+      bool lazy = cull_unpack_lazy;
+
+      cull_descr_dict_t dict;
+
+      pb.head_ptr = pb.cur_ptr = packed->data.data();
+      pb.mem_size = packed->data.size();
+      pb.version = CULL_VERSION;
+
+      /* descriptors may refer to the dictionary of the original packbuffer */
+      if (packed->descrs != nullptr) {
+         pb.version |= CULL_FORMAT_COMPACT;
+         dict.fields = packed->descrs;
+         dict.frozen = true;
+         pb.descr_dict = &dict;
+      }
+
+      cull_unpack_lazy = true;
+      if (cull_unpack_elems(&pb, list, packed->flags) != PACK_SUCCESS) {
+         LERROR(LEFORMAT);
+      }
+      cull_unpack_lazy = lazy;
+      cull_hash_create_hashtables(list);
+
+      std::atomic_ref<cull_packed_list *>(list->packed).store(nullptr, std::memory_order_release);
+      delete packed;
+   }
+
+   return list;
+}
+
+/****** cull/pack/cull_copy_lazy_list() ***************************************
+*  NAME
+*     cull_copy_lazy_list() -- copy a list that has not been unpacked
+*
+*  SYNOPSIS
+*     lList *cull_copy_lazy_list(const lList *lp)
+*
+*  FUNCTION
+*     Creates a copy of a list whose elements have not been unpacked yet
+*     by copying the packed elements.
+*
+*  INPUTS
+*     const lList *lp - list
+*
+*  RESULT
+*     lList * - the copy or nullptr if the elements of the list have
+*               already been unpacked
+*
+*  NOTES
+*     MT-NOTE: cull_copy_lazy_list() is MT safe
+*******************************************************************************/
+lList *cull_copy_lazy_list(const lList *lp) {
+   lList *copy = nullptr;
+
+   if (lp == nullptr || cull_get_packed(lp, std::memory_order_acquire) == nullptr) {
+      return nullptr;
+   }
+
+   std::lock_guard<std::mutex> guard(cull_lazy_mutex);
+
+   const cull_packed_list *packed = cull_get_packed(lp, std::memory_order_relaxed);
+   if (packed != nullptr && (copy = lCreateList(lp->listname, lp->descr)) != nullptr) {
+      /* hash tables are created when the elements are unpacked */
+      cull_hash_free_descr(copy->descr);
+      copy->packed = new cull_packed_list(*packed);
+   }
+   return copy;
+}
+
+/* frees the packed elements of a list, called by lFreeList() */
+void cull_free_lazy_list(lList *lp) {
+   delete lp->packed;
+   lp->packed = nullptr;
+}
+
+/* packs a list whose elements have not been unpacked by copying the packed elements,
+   returns false if the list has to be packed element by element */
+static bool cull_pack_lazy_list(sge_pack_buffer *pb, const lList *lp, int flags, int *ret) {
+   if (cull_get_packed(lp, std::memory_order_acquire) == nullptr) {
+      return false;
+   }
+
+   std::lock_guard<std::mutex> guard(cull_lazy_mutex);
+
+   /* packed data in compact format is only valid together with its dictionary */
+   const cull_packed_list *packed = cull_get_packed(lp, std::memory_order_relaxed);
+   if (packed == nullptr || packed->flags != flags || packed->descrs != nullptr || pb_is_compact(pb)) {
+      return false;
+   }
+   if ((*ret = packint(pb, 1)) == PACK_SUCCESS &&
+       (*ret = packstr(pb, lp->listname)) == PACK_SUCCESS &&
+       (*ret = cull_pack_descr(pb, lp->descr)) == PACK_SUCCESS) {
+      *ret = packbuf(pb, packed->data.data(), packed->data.size());
+   }
+   return true;
+}
+
 /* ------------------------------------------------------------
 
    cull_unpack_list() - unpacks a list 
@@ -908,9 +1499,13 @@ int cull_unpack_list(sge_pack_buffer *pb, lList **lpp) {
 }
 
 int cull_unpack_list_partial(sge_pack_buffer *pb, lList **lpp, int flags) {
+   return cull_unpack_list_lazy(pb, lpp, flags, false);
+}
+
+/* unpacks a list, with lazy set the elements are kept packed (sublists only) */
+static int cull_unpack_list_lazy(sge_pack_buffer *pb, lList **lpp, int flags, bool lazy) {
    int ret;
    lList *lp;
-   lListElem *ep;
 
    u_long32 i = 0;
 
@@ -952,28 +1547,30 @@ int cull_unpack_list_partial(sge_pack_buffer *pb, lList **lpp, int flags) {
    lObserveAdd(lp, nullptr, true);
 #endif
 
+   /* keep the elements packed till the list is accessed */
+   if (lazy) {
+      char *start_ptr = pb->cur_ptr;
+      size_t start = pb->bytes_used;
+
+      if (cull_skip_elems(pb, lp->descr, flags) == PACK_SUCCESS) {
+         lp->packed = new cull_packed_list{std::string(start_ptr, pb->bytes_used - start), flags,
+                                           pb_is_compact(pb) ? cull_descr_dict_get(pb)->fields : nullptr};
+         *lpp = lp;
+         PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
+         DRETURN(PACK_SUCCESS);
+      }
+
+      /* e.g. objects of an older version, unpack them now */
+      pb->cur_ptr = start_ptr;
+      pb->bytes_used = start;
+   }
+
    /* unpack each list element */
-   u_long32 has_more_elements = 0;
-   // as long as we find a 1 we have to unpack an element
-   if ((ret = unpackint(pb, &has_more_elements)) != PACK_SUCCESS) {
+   if ((ret = cull_unpack_elems(pb, lp, flags)) != PACK_SUCCESS) {
       lFreeList(&lp);
       PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
       DRETURN(ret);
    }
-   while (has_more_elements) {
-      if ((ret = cull_unpack_elem_partial(pb, &ep, lp->descr, flags)) != PACK_SUCCESS) {
-         lFreeList(&lp);
-         PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
-         DRETURN(ret);
-      }
-      lAppendElem(lp, ep);
-      // as long as we find a 1 we have to unpack an element
-      if ((ret = unpackint(pb, &has_more_elements)) != PACK_SUCCESS) {
-         lFreeList(&lp);
-         PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
-         DRETURN(ret);
-      }
-   }
 
    cull_hash_create_hashtables(lp);
 
@@ -1022,9 +1619,15 @@ static int cull_unpack_object(
       DRETURN(ret);
    }
 
+   /* sub objects use the shared descriptor */
+   const lDescr *interned = lInternDescr(descr);
+   sge_free(&descr);
+   if (interned == nullptr) {
+      DRETURN(PACK_BADARG);
+   }
+
    /* unpack each element */
-   if ((ret = cull_unpack_elem_partial(pb, &ep, descr, flags)) != PACK_SUCCESS) {
-      sge_free(&descr);
+   if ((ret = cull_unpack_elem_partial(pb, &ep, interned, flags)) != PACK_SUCCESS) {
       DRETURN(ret);
    }
 
@@ -1423,7 +2026,14 @@ int cull_unpack_cond(
          }
          cp->operand.cmp.nm = i;
 
-         if (mt_get_type(cp->operand.cmp.mt) != lListT) {
+         if (mt_get_type(cp->operand.cmp.mt) == lHostT) {
+            /* condition operands own a plain copy of the host name, see lFreeWhere() */
+            if ((ret = unpackstr(pb, &(cp->operand.cmp.val.host)))) {
+               lFreeWhere(&cp);
+               PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
+               DRETURN(ret);
+            }
+         } else if (mt_get_type(cp->operand.cmp.mt) != lListT) {
             if ((ret = cull_unpack_switch(pb, &(cp->operand.cmp.val), mt_get_type(cp->operand.cmp.mt), 0))) {
                lFreeWhere(&cp);
                PROF_STOP_MEASUREMENT(SGE_PROF_PACKING);
@@ -69,6 +69,22 @@ int cull_unpack_list_partial(sge_pack_buffer *pb, lList **lpp, int flags);
 int cull_pack_list_partial(sge_pack_buffer *pb, const lList *lp,
                            lEnumeration *what, int flags);
 
+cull_pack_cache_t *cull_pack_cache_create();
+
+void lSetLazyUnpackMode(bool enabled);
+
+bool lGetLazyUnpackMode();
+
+lList *cull_unpack_lazy_list(const lList *lp);
+
+lList *cull_copy_lazy_list(const lList *lp);
+
+void cull_free_lazy_list(lList *lp);
+
+void cull_pack_cache_free(cull_pack_cache_t **cache);
+
+void cull_descr_dict_free(cull_descr_dict_t **dict);
+
 /*
  *   lEnumeration
  */
@@ -0,0 +1,239 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdlib>
+#include <cstring>
+
+#include "cull/cull_listP.h"
+#include "cull/cull_multitypeP.h"
+#include "cull/cull_pool.h"
+
+/* elements with more fields are never cached */
+#define CULL_POOL_MAX_FIELDS 256
+
+/* upper limit for the memory a thread keeps in its free lists */
+#define CULL_POOL_MAX_CACHED (32 * 1024 * 1024)
+
+static_assert(sizeof(lListElem) % alignof(lMultiType) == 0, "lMultiType array would be misaligned");
+
+/* per thread free lists of elements, one per number of fields, chained by lListElem->next */
+struct cull_pool_t {
+   bool enabled{false};
+   size_t cached{0};
+   lListElem *free_list[CULL_POOL_MAX_FIELDS + 1]{};
+
+   ~cull_pool_t() {
+      release();
+   }
+
+   void release() {
+      for (lListElem *&first : free_list) {
+         while (first != nullptr) {
+            lListElem *ep = first;
+
+            first = ep->next;
+            free(ep);
+         }
+      }
+      cached = 0;
+   }
+};
+
+static thread_local cull_pool_t Cull_Pool;
+
+static size_t
+cull_pool_elem_size(u_long32 n) {
+   return sizeof(lListElem) + sizeof(lMultiType) * n;
+}
+
+/****** cull/pool/lSetPoolMode() **********************************************
+*  NAME
+*     lSetPoolMode() -- Enable or disable pooling of CULL elements
+*
+*  SYNOPSIS
+*     void lSetPoolMode(bool enabled)
+*
+*  FUNCTION
+*     Every element is allocated as one memory block holding the element
+*     and its lMultiType array. When the pool mode is enabled then
+*     the calling thread keeps blocks of freed elements in free lists
+*     (one per number of fields) and reuses them for new elements
+*     instead of calling malloc() and free() for each element.
+*
+*     Disabling the pool mode keeps the already cached blocks till
+*     lReleasePool() is called or the thread terminates.
+*
+*  INPUTS
+*     bool enabled - true to enable pooling for the calling thread
+*
+*  NOTES
+*     MT-NOTE: lSetPoolMode() is MT safe, the mode is thread local
+*
+*  SEE ALSO
+*     cull/pool/lReleasePool()
+*******************************************************************************/
+void
+lSetPoolMode(bool enabled) {
+   Cull_Pool.enabled = enabled;
+}
+
+/****** cull/pool/lGetPoolMode() **********************************************
+*  NAME
+*     lGetPoolMode() -- Is pooling of CULL elements enabled
+*
+*  SYNOPSIS
+*     bool lGetPoolMode()
+*
+*  RESULT
+*     bool - true if the calling thread pools elements
+*
+*  NOTES
+*     MT-NOTE: lGetPoolMode() is MT safe
+*******************************************************************************/
+bool
+lGetPoolMode() {
+   return Cull_Pool.enabled;
+}
+
+/****** cull/pool/lReleasePool() **********************************************
+*  NAME
+*     lReleasePool() -- Free all cached element blocks
+*
+*  SYNOPSIS
+*     void lReleasePool()
+*
+*  FUNCTION
+*     Frees all element blocks the calling thread keeps in its free lists.
+*     Threads doing a bunch of work with many temporary elements (e.g.
+*     a scheduling run) call it when the work is done to give the memory
+*     back. Elements which are still in use are not affected.
+*
+*  NOTES
+*     MT-NOTE: lReleasePool() is MT safe
+*******************************************************************************/
+void
+lReleasePool() {
+   Cull_Pool.release();
+}
+
+/****** cull/pool/lGetPoolSize() **********************************************
+*  NAME
+*     lGetPoolSize() -- Memory cached in the free lists
+*
+*  SYNOPSIS
+*     size_t lGetPoolSize()
+*
+*  RESULT
+*     size_t - number of bytes the calling thread keeps in its free lists
+*
+*  NOTES
+*     MT-NOTE: lGetPoolSize() is MT safe
+*******************************************************************************/
+size_t
+lGetPoolSize() {
+   return Cull_Pool.cached;
+}
+
+/****** cull/pool/cull_pool_alloc_elem() **************************************
+*  NAME
+*     cull_pool_alloc_elem() -- Allocate an element with n fields
+*
+*  SYNOPSIS
+*     lListElem *cull_pool_alloc_elem(int n)
+*
+*  FUNCTION
+*     Returns an element whose cont points to an array of n zeroed
+*     lMultiType values stored in the same memory block. next and prev
+*     are nullptr, status and descr have to be set by the caller.
+*
+*     The element has to be freed with cull_pool_free_elem().
+*
+*  INPUTS
+*     int n - number of fields
+*
+*  RESULT
+*     lListElem* - the element or nullptr if there is not enough memory
+*
+*  NOTES
+*     MT-NOTE: cull_pool_alloc_elem() is MT safe
+*******************************************************************************/
+lListElem *
+cull_pool_alloc_elem(int n) {
+   lListElem *ep = nullptr;
+
+   if (Cull_Pool.enabled && n <= CULL_POOL_MAX_FIELDS && Cull_Pool.free_list[n] != nullptr) {
+      ep = Cull_Pool.free_list[n];
+      Cull_Pool.free_list[n] = ep->next;
+      Cull_Pool.cached -= cull_pool_elem_size(n);
+   } else {
+      ep = (lListElem *) malloc(cull_pool_elem_size(n));
+      if (ep == nullptr) {
+         return nullptr;
+      }
+   }
+
+   ep->next = nullptr;
+   ep->prev = nullptr;
+   ep->size = n;
+   ep->cont = reinterpret_cast<lMultiType *>(ep + 1);
+   memset(ep->cont, 0, sizeof(lMultiType) * n);
+
+   return ep;
+}
+
+/****** cull/pool/cull_pool_free_elem() ***************************************
+*  NAME
+*     cull_pool_free_elem() -- Free the memory of an element
+*
+*  SYNOPSIS
+*     void cull_pool_free_elem(lListElem **ep)
+*
+*  FUNCTION
+*     Frees the memory block of an element allocated with
+*     cull_pool_alloc_elem() or keeps it in the free list of the
+*     calling thread when the pool mode is enabled. Attribute values
+*     have to be freed before. *ep is set to nullptr.
+*
+*     The element may have been allocated by a different thread.
+*
+*  INPUTS
+*     lListElem **ep - element
+*
+*  NOTES
+*     MT-NOTE: cull_pool_free_elem() is MT safe
+*******************************************************************************/
+void
+cull_pool_free_elem(lListElem **ep) {
+   if (ep == nullptr || *ep == nullptr) {
+      return;
+   }
+
+   u_long32 n = (*ep)->size;
+   size_t size = cull_pool_elem_size(n);
+
+   if (Cull_Pool.enabled && n <= CULL_POOL_MAX_FIELDS && Cull_Pool.cached + size <= CULL_POOL_MAX_CACHED) {
+      (*ep)->next = Cull_Pool.free_list[n];
+      Cull_Pool.free_list[n] = *ep;
+      Cull_Pool.cached += size;
+   } else {
+      free(*ep);
+   }
+   *ep = nullptr;
+}
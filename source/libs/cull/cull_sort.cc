@@ -45,6 +45,7 @@
 #include "uti/sge_string.h"
 
 #include "cull/cull_listP.h"
+#include "cull/cull_hash.h"
 #include "cull/cull_parse.h"
 #include "cull/cull_multitype.h"
 #include "cull/cull_sortP.h"
@@ -54,6 +55,10 @@
 
    insert ep into sorted list lp using so as sort order
 
+   if the list is sorted ascending by a single field having an
+   ordered index (CULL_ORDERED) the insert position is searched
+   in the index instead of walking through the list
+
  */
 int lInsertSorted(const lSortOrder *so, lListElem *ep, lList *lp) {
    lListElem *tmp;
@@ -64,8 +69,17 @@ int lInsertSorted(const lSortOrder *so, lListElem *ep, lList *lp) {
       DRETURN(-1);
    }
 
-   for_each_rw(tmp, lp)if (lSortCompare(ep, tmp, so) <= 0)
-         break;                    /* insert before tmp */
+   if (so[0].ad > 0 && mt_get_type(so[1].mt) == lEndT && cull_hash_is_ordered(lp, so[0].pos)) {
+      tmp = cull_hash_lower_bound(lp, so[0].pos, ep);
+
+      /* elements with the same value are ordered by address in the index */
+      while (tmp != nullptr && lPrev(tmp) != nullptr && lSortCompare(ep, lPrev(tmp), so) <= 0) {
+         tmp = lPrevRW(tmp);
+      }
+   } else {
+      for_each_rw(tmp, lp)if (lSortCompare(ep, tmp, so) <= 0)
+            break;                    /* insert before tmp */
+   }
 
    if (tmp) {
       /* insert before tmp */
@@ -828,5 +828,51 @@ int lWhatSetSubWhat(lEnumeration *what1, int nm, lEnumeration **what2) {
    DRETURN(ret);
 }
 
+/****** cull/what/lWhatContains() *********************************************
+*  NAME
+*     lWhatContains() -- does an enumeration select an attribute?
+*
+*  SYNOPSIS
+*     bool lWhatContains(const lEnumeration *what, int nm, bool *has_sub_what)
+*
+*  FUNCTION
+*     Checks if the attribute "nm" is part of the enumeration "what".
+*
+*  INPUTS
+*     const lEnumeration *what - enumeration
+*     int nm                   - attribute name
+*     bool *has_sub_what       - if not nullptr then it is set to true
+*                                when the attribute has a sub enumeration
+*
+*  RESULT
+*     bool - true if "nm" is selected by "what"
+*
+*  NOTES
+*     MT-NOTE: lWhatContains() is MT safe
+******************************************************************************/
+bool lWhatContains(const lEnumeration *what, int nm, bool *has_sub_what) {
+   bool ret = false;
+
+   if (has_sub_what != nullptr) {
+      *has_sub_what = false;
+   }
+   if (what != nullptr) {
+      if (what[0].pos == WHAT_ALL) {
+         ret = true;
+      } else if (what[0].pos != WHAT_NONE) {
+         for (int i = 0; mt_get_type(what[i].mt) != lEndT; i++) {
+            if (what[i].nm == nm) {
+               if (has_sub_what != nullptr) {
+                  *has_sub_what = what[i].ep != nullptr;
+               }
+               ret = true;
+               break;
+            }
+         }
+      }
+   }
+   return ret;
+}
+
 
 
@@ -61,3 +61,5 @@ void nm_set(int job_field[], int nm);
 int lMergeWhat(lEnumeration **what1, lEnumeration **what2);
 
 int lWhatSetSubWhat(lEnumeration *what1, int nm, lEnumeration **what2);
+
+bool lWhatContains(const lEnumeration *what, int nm, bool *has_sub_what);
@@ -39,6 +39,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <fnmatch.h>
+#include <string>
+#include <vector>
 
 /* do not compile in monitoring code */
 #ifndef NO_SGE_COMPILE_DEBUG
@@ -54,6 +56,7 @@
 #include "cull/cull_whereP.h"
 #include "cull/cull_parse.h"
 #include "cull/cull_lerrnoP.h"
+#include "cull/cull_pack.h"
 
 static lCondition *read_val(lDescr *dp, cull_parse_state *state, va_list *app);
 
@@ -1380,6 +1383,462 @@ int lCompare(const lListElem *ep, const lCondition *cp) {
    DRETURN(result);
 }
 
+/* instructions of a compiled condition, see lCompileWhere() */
+enum where_code {
+   WHERE_TRUE,                  /* acc = true                                */
+   WHERE_FALSE,                 /* acc = false                               */
+   WHERE_INT,                   /* acc = compare field with value            */
+   WHERE_ULONG,
+   WHERE_ULONG64,
+   WHERE_FLOAT,
+   WHERE_DOUBLE,
+   WHERE_LONG,
+   WHERE_CHAR,
+   WHERE_BOOL,
+   WHERE_REF,
+   WHERE_STRING,                /* string or host compare with strcmp()      */
+   WHERE_SUBLIST,               /* acc = sublist contains a matching element */
+   WHERE_STRCASE,
+   WHERE_HOSTNAME,
+   WHERE_PATTERN,               /* fnmatch() with the precompiled pattern    */
+   WHERE_LITERAL,               /* pattern without wildcards, plain strcmp() */
+   WHERE_BITMASK,
+   WHERE_INTERPRET,             /* acc = lCompare(), for unexpected input    */
+   WHERE_JUMP_FALSE,            /* jump if acc is false                      */
+   WHERE_JUMP_TRUE,             /* jump if acc is true                       */
+   WHERE_NOT                    /* acc = !acc                                */
+};
+
+struct where_instr {
+   where_code code;
+   int op;                      /* EQUAL, LOWER, ... for the compares        */
+   int pos;                     /* position of the field in the element      */
+   int jump;                    /* target of the jumps                       */
+   lMultiType val;              /* compare value                             */
+   std::string str;             /* compare string, hostname already resolved */
+   const lCondition *cp;        /* condition for WHERE_SUBLIST/_INTERPRET    */
+};
+
+struct _lCompiledWhere {
+   std::vector<where_instr> program;
+};
+
+/* result of compiling a sub condition: folded to a constant or emitted code */
+enum where_folded {
+   WHERE_FOLDED_FALSE,
+   WHERE_FOLDED_TRUE,
+   WHERE_FOLDED_CODE
+};
+
+static where_code
+where_code_of_type(int type) {
+   switch (type) {
+      case lIntT:
+         return WHERE_INT;
+      case lUlongT:
+         return WHERE_ULONG;
+      case lUlong64T:
+         return WHERE_ULONG64;
+      case lFloatT:
+         return WHERE_FLOAT;
+      case lDoubleT:
+         return WHERE_DOUBLE;
+      case lLongT:
+         return WHERE_LONG;
+      case lCharT:
+         return WHERE_CHAR;
+      case lBoolT:
+         return WHERE_BOOL;
+      case lRefT:
+         return WHERE_REF;
+      case lStringT:
+      case lHostT:
+         return WHERE_STRING;
+      case lListT:
+         return WHERE_SUBLIST;
+      default:
+         return WHERE_INTERPRET;
+   }
+}
+
+static void
+where_emit(std::vector<where_instr> &program, where_code code, const lCondition *cp) {
+   where_instr instr{};
+
+   instr.code = code;
+   instr.cp = cp;
+   if (cp != nullptr && code != WHERE_JUMP_FALSE && code != WHERE_JUMP_TRUE && code != WHERE_NOT) {
+      instr.op = cp->op;
+      instr.pos = cp->operand.cmp.pos;
+      instr.val = cp->operand.cmp.val;
+   }
+   program.push_back(instr);
+}
+
+/* does the field at the position of the condition have the expected name and type in dp */
+static bool
+where_field_matches(const lCondition *cp, const lDescr *dp) {
+   int pos = cp->operand.cmp.pos;
+
+   if (dp == nullptr || pos < 0 || pos >= lCountDescr(dp)) {
+      return false;
+   }
+   return dp[pos].nm == cp->operand.cmp.nm && mt_get_type(dp[pos].mt) == mt_get_type(cp->operand.cmp.mt);
+}
+
+static where_folded
+where_compile(std::vector<where_instr> &program, const lCondition *cp, const lDescr *dp) {
+   size_t start = program.size();
+   where_folded first;
+   where_folded second;
+
+   if (cp == nullptr) {
+      return WHERE_FOLDED_TRUE;
+   }
+
+   switch (cp->op) {
+      case AND:
+      case OR: {
+         bool is_and = cp->op == AND;
+         where_folded neutral = is_and ? WHERE_FOLDED_TRUE : WHERE_FOLDED_FALSE;
+
+         first = where_compile(program, cp->operand.log.first, dp);
+         if (first == WHERE_FOLDED_CODE) {
+            where_emit(program, is_and ? WHERE_JUMP_FALSE : WHERE_JUMP_TRUE, cp);
+         } else if (first != neutral) {
+            /* false && x, true || x */
+            return first;
+         }
+         size_t jump = program.size() - 1;
+         second = where_compile(program, cp->operand.log.second, dp);
+         if (first != WHERE_FOLDED_CODE) {
+            return second;
+         }
+         if (second == neutral) {
+            /* x && true, x || false: the result of x */
+            program.pop_back();
+            return WHERE_FOLDED_CODE;
+         }
+         if (second != WHERE_FOLDED_CODE) {
+            /* x && false, x || true: x has no side effects */
+            program.resize(start);
+            return second;
+         }
+         program[jump].jump = static_cast<int>(program.size());
+         return WHERE_FOLDED_CODE;
+      }
+      case NEG:
+         first = where_compile(program, cp->operand.log.first, dp);
+         if (first == WHERE_FOLDED_CODE) {
+            where_emit(program, WHERE_NOT, cp);
+            return WHERE_FOLDED_CODE;
+         }
+         return first == WHERE_FOLDED_TRUE ? WHERE_FOLDED_FALSE : WHERE_FOLDED_TRUE;
+      default:
+         break;
+   }
+
+   /* a leaf: fields which are not where the condition expects them are handled by lCompare() */
+   if (!where_field_matches(cp, dp)) {
+      where_emit(program, WHERE_INTERPRET, cp);
+      return WHERE_FOLDED_CODE;
+   }
+
+   int type = mt_get_type(cp->operand.cmp.mt);
+   const char *str = cp->operand.cmp.val.str;
+
+   switch (cp->op) {
+      case EQUAL:
+      case NOT_EQUAL:
+      case LOWER_EQUAL:
+      case LOWER:
+      case GREATER_EQUAL:
+      case GREATER:
+      case SUBSCOPE:
+         where_emit(program, where_code_of_type(type), cp);
+         if (type == lStringT || type == lHostT) {
+            if (str == nullptr) {
+               program.resize(start);
+               return WHERE_FOLDED_FALSE;
+            }
+            program.back().str = str;
+         }
+         return WHERE_FOLDED_CODE;
+      case STRCASECMP:
+      case HOSTNAMECMP:
+         if (type != lStringT && type != lHostT) {
+            break;
+         }
+         if (str == nullptr) {
+            return WHERE_FOLDED_FALSE;
+         }
+         if (cp->op == STRCASECMP) {
+            where_emit(program, WHERE_STRCASE, cp);
+            program.back().str = str;
+         } else {
+            char host[CL_MAXHOSTNAMELEN + 1];
+
+            sge_hostcpy(host, str);
+            where_emit(program, WHERE_HOSTNAME, cp);
+            program.back().str = host;
+         }
+         return WHERE_FOLDED_CODE;
+      case PATTERNCMP:
+         if (type != lStringT && type != lHostT) {
+            break;
+         }
+         if (str == nullptr) {
+            return WHERE_FOLDED_FALSE;
+         }
+         if (strcmp(str, "*") == 0) {
+            /* matches everything, also missing values */
+            return WHERE_FOLDED_TRUE;
+         }
+         where_emit(program, strpbrk(str, "*?[\\") == nullptr ? WHERE_LITERAL : WHERE_PATTERN, cp);
+         program.back().str = str;
+         return WHERE_FOLDED_CODE;
+      case BITMASK:
+         if (type != lUlongT) {
+            break;
+         }
+         where_emit(program, WHERE_BITMASK, cp);
+         return WHERE_FOLDED_CODE;
+      default:
+         break;
+   }
+
+   /* errors are reported by lCompare() */
+   where_emit(program, WHERE_INTERPRET, cp);
+   return WHERE_FOLDED_CODE;
+}
+
+/****** cull/where/lCompileWhere() ********************************************
+*  NAME
+*     lCompileWhere() -- Compile a condition for elements of a descriptor
+*
+*  SYNOPSIS
+*     lCompiledWhere *lCompileWhere(const lCondition *cp, const lDescr *dp)
+*
+*  FUNCTION
+*     Translates the condition tree into a linear program which can be
+*     evaluated with lCompareCompiled() without recursion, without
+*     type checks for every field access and without error tracing.
+*     Functions comparing many elements with the same condition
+*     (lSelect(), lSplit(), ...) compile the condition once.
+*
+*     During compilation field positions are verified against 'dp',
+*     constant parts are folded (e.g. a "*" pattern) and patterns
+*     without wildcards are turned into string compares.
+*
+*     The program references the condition, 'cp' has to stay valid
+*     as long as the program is used.
+*
+*  INPUTS
+*     const lCondition *cp - condition, nullptr matches all elements
+*     const lDescr *dp     - descriptor of the elements to be compared
+*
+*  RESULT
+*     lCompiledWhere* - program, has to be freed with lFreeCompiledWhere()
+*
+*  NOTES
+*     MT-NOTE: lCompileWhere() is MT safe
+*
+*  SEE ALSO
+*     cull/where/lCompareCompiled()
+*     cull/where/lFreeCompiledWhere()
+******************************************************************************/
+lCompiledWhere *lCompileWhere(const lCondition *cp, const lDescr *dp) {
+   auto *compiled = new lCompiledWhere;
+
+   switch (where_compile(compiled->program, cp, dp)) {
+      case WHERE_FOLDED_TRUE:
+         where_emit(compiled->program, WHERE_TRUE, nullptr);
+         break;
+      case WHERE_FOLDED_FALSE:
+         where_emit(compiled->program, WHERE_FALSE, nullptr);
+         break;
+      default:
+         break;
+   }
+   return compiled;
+}
+
+/****** cull/where/lFreeCompiledWhere() ***************************************
+*  NAME
+*     lFreeCompiledWhere() -- Free a compiled condition
+*
+*  SYNOPSIS
+*     void lFreeCompiledWhere(lCompiledWhere **compiled)
+*
+*  INPUTS
+*     lCompiledWhere **compiled - program, set to nullptr
+*
+*  NOTES
+*     MT-NOTE: lFreeCompiledWhere() is MT safe
+******************************************************************************/
+void lFreeCompiledWhere(lCompiledWhere **compiled) {
+   if (compiled != nullptr) {
+      delete *compiled;
+      *compiled = nullptr;
+   }
+}
+
+/* same interpretation of the compare result as in lCompare() */
+static inline bool
+where_compare_result(int op, int result) {
+   switch (op) {
+      case EQUAL:
+         return result == 0;
+      case NOT_EQUAL:
+         return result != 0;
+      case LOWER_EQUAL:
+         return result == -1 || result == 0;
+      case LOWER:
+         return result == -1;
+      case GREATER_EQUAL:
+         return result == 1 || result == 0;
+      case GREATER:
+         return result == 1;
+      default:
+         LERROR(LEOPUNKNOWN);
+         return false;
+   }
+}
+
+/****** cull/where/lCompareCompiled() *****************************************
+*  NAME
+*     lCompareCompiled() -- Decide if a element suffices a compiled condition
+*
+*  SYNOPSIS
+*     int lCompareCompiled(const lListElem *ep, const lCompiledWhere *compiled)
+*
+*  FUNCTION
+*     Same as lCompare() for the condition the program was compiled of.
+*     The element has to be of the descriptor given to lCompileWhere().
+*
+*  INPUTS
+*     const lListElem *ep              - element
+*     const lCompiledWhere *compiled   - program
+*
+*  RESULT
+*     int - result
+*         0 - false
+*         1 - true
+*
+*  NOTES
+*     MT-NOTE: lCompareCompiled() is MT safe
+******************************************************************************/
+int lCompareCompiled(const lListElem *ep, const lCompiledWhere *compiled) {
+   const where_instr *program;
+   size_t size;
+   bool acc = true;
+
+   if (ep == nullptr) {
+      LERROR(LEELEMNULL);
+      return 0;
+   }
+   if (compiled == nullptr) {
+      return 1;
+   }
+
+   program = compiled->program.data();
+   size = compiled->program.size();
+   for (size_t pc = 0; pc < size; pc++) {
+      const where_instr *instr = &program[pc];
+      const lMultiType *field = &ep->cont[instr->pos];
+      const char *str;
+
+      switch (instr->code) {
+         case WHERE_TRUE:
+            acc = true;
+            break;
+         case WHERE_FALSE:
+            acc = false;
+            break;
+         case WHERE_INT:
+            acc = where_compare_result(instr->op, intcmp(field->i, instr->val.i));
+            break;
+         case WHERE_ULONG:
+            acc = where_compare_result(instr->op, ulongcmp(field->ul, instr->val.ul));
+            break;
+         case WHERE_ULONG64:
+            acc = where_compare_result(instr->op, ulong64cmp(field->ul64, instr->val.ul64));
+            break;
+         case WHERE_FLOAT:
+            acc = where_compare_result(instr->op, floatcmp(field->fl, instr->val.fl));
+            break;
+         case WHERE_DOUBLE:
+            acc = where_compare_result(instr->op, doublecmp(field->db, instr->val.db));
+            break;
+         case WHERE_LONG:
+            acc = where_compare_result(instr->op, longcmp(field->l, instr->val.l));
+            break;
+         case WHERE_CHAR:
+            acc = where_compare_result(instr->op, charcmp(field->c, instr->val.c));
+            break;
+         case WHERE_BOOL:
+            acc = where_compare_result(instr->op, boolcmp(field->b, instr->val.b));
+            break;
+         case WHERE_REF:
+            acc = where_compare_result(instr->op, refcmp(field->ref, instr->val.ref));
+            break;
+         case WHERE_STRING:
+            if ((str = field->str) == nullptr) {
+               LERROR(LENULLSTRING);
+               acc = false;
+            } else {
+               acc = where_compare_result(instr->op, strcmp(str, instr->str.c_str()));
+            }
+            break;
+         case WHERE_SUBLIST:
+            acc = lFindFirstRW(cull_unpack_lazy_list(field->glp), instr->val.cp) != nullptr;
+            break;
+         case WHERE_STRCASE:
+         case WHERE_HOSTNAME:
+            if ((str = field->str) == nullptr) {
+               LERROR(LENULLSTRING);
+               acc = false;
+            } else if (instr->code == WHERE_STRCASE) {
+               acc = SGE_STRCASECMP(str, instr->str.c_str()) == 0;
+            } else {
+               char host[CL_MAXHOSTNAMELEN + 1];
+
+               sge_hostcpy(host, str);
+               acc = SGE_STRCASECMP(host, instr->str.c_str()) == 0;
+            }
+            break;
+         case WHERE_PATTERN:
+            str = field->str != nullptr ? field->str : "";
+            acc = fnmatch(instr->str.c_str(), str, 0) == 0;
+            break;
+         case WHERE_LITERAL:
+            str = field->str != nullptr ? field->str : "";
+            acc = strcmp(instr->str.c_str(), str) == 0;
+            break;
+         case WHERE_BITMASK:
+            acc = bitmaskcmp(field->ul, instr->val.ul) != 0;
+            break;
+         case WHERE_INTERPRET:
+            acc = lCompare(ep, instr->cp) != 0;
+            break;
+         case WHERE_JUMP_FALSE:
+            if (!acc) {
+               pc = instr->jump - 1;
+            }
+            break;
+         case WHERE_JUMP_TRUE:
+            if (acc) {
+               pc = instr->jump - 1;
+            }
+            break;
+         case WHERE_NOT:
+            acc = !acc;
+            break;
+      }
+   }
+   return acc ? 1 : 0;
+}
+
 /****** cull/where/lCopyWhere() ***********************************************
 *  NAME
 *     lCopyWhere() -- Copy a condition
@@ -33,8 +33,16 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+typedef struct _lCompiledWhere lCompiledWhere;
+
 int lCompare(const lListElem *ep, const lCondition *cp);
 
+lCompiledWhere *lCompileWhere(const lCondition *cp, const lDescr *dp);
+
+int lCompareCompiled(const lListElem *ep, const lCompiledWhere *compiled);
+
+void lFreeCompiledWhere(lCompiledWhere **compiled);
+
 void lWriteWhereTo(const lCondition *cp, FILE *fp);
 
 lCondition *lWhere(const char *fmt, ...);
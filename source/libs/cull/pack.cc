@@ -37,14 +37,9 @@
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
+#include <algorithm>
 #include <sys/types.h>
 #include <netinet/in.h>
-#include <rpc/rpc.h>
-#include <rpc/types.h>
-
-#if defined(LINUXRISCV64)
-#  include <rpc/xdr.h>
-#endif
 
 #if defined(SOLARIS) || defined(DARWIN)
 #define htobe64(x) htonll(x)
@@ -62,6 +57,7 @@
 #include "uti/sge_string.h"
 
 #include "cull/msg_cull.h"
+#include "cull/cull_pack.h"
 
 #include "basis_types.h"
 
@@ -83,6 +79,13 @@
 *     Data is written into a packbuffer. Individual data words
 *     are written in network byte order.
 *
+*     Packbuffers used for communication can use a compact format
+*     (see init_packbuffer()): integers are written as variable length
+*     zigzag encoded integers and descriptors are written only once per
+*     packbuffer (see cull_pack_descr()). The format is stored in the
+*     version information at the beginning of the packbuffer,
+*     init_packbuffer_from_buffer() accepts both formats.
+*
 *     Data in the packbuffer can be compressed.
 *
 *  NOTES
@@ -109,13 +112,13 @@ int pack_get_chunk() {
 *
 *  SYNOPSIS
 *     int init_packbuffer(sge_pack_buffer *pb, int initial_size, 
-*                         bool just_count, bool with_auth_info)
+*                         bool just_count, bool with_auth_info,
+*                         bool compact)
 *
 *  FUNCTION
 *     Initialize a packing buffer.
 *     Allocates the necessary memory. If more memory is needed during the use
-*     of the packbuffer, it will be reallocated increasing the size by 
-*     chunk_size (see function pack_set_chunk).
+*     of the packbuffer, it will be reallocated doubling its size.
 *
 *     Since version 6.0, version information is provided in the packbuffer and 
 *     is included in sent messages.
@@ -142,6 +145,10 @@ int pack_get_chunk() {
 *                           This is the case for all pack buffers which are used for
 *                           communication between components.
 *                           For spooling operations no auth_info is needed.
+*     bool compact        - if true, the compact format is used (CULL_FORMAT_COMPACT).
+*                           Use it only if the receiver is known to be of the
+*                           same version, spooled data always has to use the
+*                           default format.
 *
 *  RESULT
 *     int - PACK_SUCCESS on success
@@ -157,7 +164,7 @@ int pack_get_chunk() {
 *     gdi/request_internal/sge_gdi_packet_get_pb_size()
 *******************************************************************************/
 int
-init_packbuffer(sge_pack_buffer *pb, size_t initial_size, bool just_count, bool with_auth_info) {
+init_packbuffer(sge_pack_buffer *pb, size_t initial_size, bool just_count, bool with_auth_info, bool compact) {
    DENTER(PACK_LAYER);
 
    if (pb == nullptr) {
@@ -205,12 +212,17 @@ init_packbuffer(sge_pack_buffer *pb, size_t initial_size, bool just_count, bool
       pb->just_count = false;
       pb->version = CULL_VERSION;
       packint(pb, 0);              /* pad 0 byte -> error handing in former versions */
-      packint(pb, pb->version);      /* version information is included in buffer      */
+      packint(pb, pb->version | (compact ? CULL_FORMAT_COMPACT : 0)); /* version information is included in buffer */
       packstr(pb, pb->auth_info);
    } else {
       pb->just_count = true;
    }
 
+   /* everything after the version information is written in the requested format */
+   if (compact) {
+      pb->version = CULL_VERSION | CULL_FORMAT_COMPACT;
+   }
+
    DRETURN(PACK_SUCCESS);
 }
 
@@ -256,7 +268,7 @@ init_packbuffer_from_buffer(sge_pack_buffer *pb, char *buf, u_long32 buflen, boo
       }
       pb->auth_info = auth_info;
 
-      if (pad != 0 || version != CULL_VERSION) {
+      if (pad != 0 || (version & ~CULL_FORMAT_COMPACT) != CULL_VERSION) {
          ERROR(MSG_CULL_PACK_WRONG_VERSION_XX, (unsigned int) version, CULL_VERSION);
          DRETURN(PACK_VERSION);
       }
@@ -286,6 +298,7 @@ void clear_packbuffer(sge_pack_buffer *pb) {
       sge_free(&pb->head_ptr);
       sge_free(&pb->auth_info);
       sge_free(&pb->grp_array);
+      cull_descr_dict_free(&pb->descr_dict);
    }
 }
 
@@ -324,6 +337,120 @@ int pb_used(
 /*                                                           */
 /* --------------------------------------------------------- */
 
+/* ---------------------------------------------------------
+
+   pb_reserve() - makes room for n more bytes
+
+   The buffer grows geometrically, packing large objects
+   does not need a realloc for every CHUNK bytes.
+
+   return values:
+   PACK_SUCCESS
+   PACK_ENOMEM
+ */
+static int pb_reserve(sge_pack_buffer *pb, size_t n) {
+   DENTER(PACK_LAYER);
+
+   if (pb->bytes_used + n > pb->mem_size) {
+      size_t new_size = std::max(pb->mem_size * 2, pb->bytes_used + n);
+
+      DPRINTF("realloc(%d -> %d)\n", (int) pb->mem_size, (int) new_size);
+      pb->head_ptr = (char *) sge_realloc(pb->head_ptr, new_size, 0);
+      if (!pb->head_ptr) {
+         DRETURN(PACK_ENOMEM);
+      }
+      pb->mem_size = new_size;
+      pb->cur_ptr = &(pb->head_ptr[pb->bytes_used]);
+   }
+
+   DRETURN(PACK_SUCCESS);
+}
+
+/* ---------------------------------------------------------
+
+   pack_bytes() - copies n bytes into the buffer
+
+   return values:
+   PACK_SUCCESS
+   PACK_ENOMEM
+ */
+static int pack_bytes(sge_pack_buffer *pb, const char *buf, size_t n) {
+   if (!pb->just_count) {
+      int ret = pb_reserve(pb, n);
+
+      if (ret != PACK_SUCCESS) {
+         return ret;
+      }
+      memcpy(pb->cur_ptr, buf, n);
+      pb->cur_ptr = &(pb->cur_ptr[n]);
+   }
+   pb->bytes_used += n;
+
+   return PACK_SUCCESS;
+}
+
+/* ---------------------------------------------------------
+
+   compact format: variable length integers
+
+   7 bits per byte, least significant group first, the high bit
+   is set in all bytes but the last one. Integers are zigzag
+   encoded before, so that the frequently used values -1 (U_LONG32_MAX)
+   and U_LONG64_MAX take a single byte.
+
+ */
+static inline u_long32 zigzag_encode32(u_long32 i) {
+   return (i << 1) ^ (0U - (i >> 31));
+}
+
+static inline u_long32 zigzag_decode32(u_long32 i) {
+   return (i >> 1) ^ (0U - (i & 1));
+}
+
+static inline u_long64 zigzag_encode64(u_long64 i) {
+   return (i << 1) ^ (0ULL - (i >> 63));
+}
+
+static inline u_long64 zigzag_decode64(u_long64 i) {
+   return (i >> 1) ^ (0ULL - (i & 1));
+}
+
+static int pack_varint(sge_pack_buffer *pb, u_long64 i) {
+   char buf[10];
+   size_t n = 0;
+
+   while (i >= 0x80) {
+      buf[n++] = static_cast<char>((i & 0x7f) | 0x80);
+      i >>= 7;
+   }
+   buf[n++] = static_cast<char>(i);
+
+   return pack_bytes(pb, buf, n);
+}
+
+static int unpack_varint(sge_pack_buffer *pb, u_long64 *ip, int max_bytes) {
+   u_long64 i = 0;
+
+   for (int n = 0; ; n++) {
+      if (n == max_bytes || pb->bytes_used >= pb->mem_size) {
+         *ip = 0;
+         return PACK_FORMAT;
+      }
+
+      auto byte = static_cast<unsigned char>(pb->cur_ptr[0]);
+      pb->cur_ptr = &(pb->cur_ptr[1]);
+      pb->bytes_used++;
+
+      i |= static_cast<u_long64>(byte & 0x7f) << (7 * n);
+      if ((byte & 0x80) == 0) {
+         break;
+      }
+   }
+
+   *ip = i;
+   return PACK_SUCCESS;
+}
+
 /*
    return values:
    PACK_SUCCESS
@@ -335,32 +462,28 @@ int packint(sge_pack_buffer *pb, u_long32 i) {
 
    DENTER(PACK_LAYER);
 
-   if (!pb->just_count) {
-      if (pb->bytes_used + INTSIZE > pb->mem_size) {
-         DPRINTF("realloc(%d + %d)\n", pb->mem_size, CHUNK);
-         pb->mem_size += CHUNK;
-         pb->head_ptr = (char *) sge_realloc(pb->head_ptr, pb->mem_size, 0);
-         if (!pb->head_ptr) {
-            DRETURN(PACK_ENOMEM);
-         }
-         pb->cur_ptr = &(pb->head_ptr[pb->bytes_used]);
-      }
-
-      /* copy in packing buffer */
-      J = htonl(i);
-      memcpy(pb->cur_ptr, (((char *) &J) + INTOFF), INTSIZE);
-      pb->cur_ptr = &(pb->cur_ptr[INTSIZE]);
+   if (pb_is_compact(pb)) {
+      DRETURN(pack_varint(pb, zigzag_encode32(i)));
    }
-   pb->bytes_used += INTSIZE;
 
-   DRETURN(PACK_SUCCESS);
+   /* copy in packing buffer */
+   J = htonl(i);
+   DRETURN(pack_bytes(pb, ((char *) &J) + INTOFF, INTSIZE));
 }
 
+/*
+   overwrites an integer at the current position,
+   only possible with the fixed size integers of the default format
+ */
 int repackint(sge_pack_buffer *pb, u_long32 i) {
    u_long32 J = 0;
 
    DENTER(PACK_LAYER);
 
+   if (pb_is_compact(pb)) {
+      DRETURN(PACK_FORMAT);
+   }
+
    if (!pb->just_count) {
       J = htonl(i);
       memcpy(pb->cur_ptr, (((char *) &J) + INTOFF), INTSIZE);
@@ -375,76 +498,36 @@ int packint64(sge_pack_buffer *pb, u_long64 i) {
 
    DENTER(PACK_LAYER);
 
-   if (!pb->just_count) {
-      if (pb->bytes_used + (INTSIZE * 2) > pb->mem_size) {
-         DPRINTF("realloc(%d + %d)\n", pb->mem_size, CHUNK);
-         pb->mem_size += CHUNK;
-         pb->head_ptr = (char *) sge_realloc(pb->head_ptr, pb->mem_size, 0);
-         if (!pb->head_ptr) {
-            DRETURN(PACK_ENOMEM);
-         }
-         pb->cur_ptr = &(pb->head_ptr[pb->bytes_used]);
-      }
-
-      /* copy in packing buffer */
-      J = htobe64(i);
-      memcpy(pb->cur_ptr, (((char *) &J) + INTOFF), (INTSIZE * 2));
-      pb->cur_ptr = &(pb->cur_ptr[(INTSIZE * 2)]);
+   if (pb_is_compact(pb)) {
+      DRETURN(pack_varint(pb, zigzag_encode64(i)));
    }
-   pb->bytes_used += (INTSIZE * 2);
 
-   DRETURN(PACK_SUCCESS);
+   /* copy in packing buffer */
+   J = htobe64(i);
+   DRETURN(pack_bytes(pb, ((char *) &J) + INTOFF, INTSIZE * 2));
 }
 
 #define DOUBLESIZE 8
 
 /*
+   doubles are written as IEEE 754 double precision number in network
+   byte order, this is the representation XDR used in former versions
+
    return values:
    PACK_SUCCESS
    PACK_ENOMEM
    PACK_FORMAT
  */
 int packdouble(sge_pack_buffer *pb, double d) {
-/* CygWin does not know RPC u. XDR */
-   char buf[32];
-   XDR xdrs;
+   u_long64 J = 0;
 
    DENTER(PACK_LAYER);
 
-   if (!pb->just_count) {
-      if (pb->bytes_used + DOUBLESIZE > pb->mem_size) {
-         DPRINTF("realloc(%d + %d)\n", pb->mem_size, CHUNK);
-         pb->mem_size += CHUNK;
-         pb->head_ptr = (char *) sge_realloc(pb->head_ptr, pb->mem_size, 0);
-         if (!pb->head_ptr) {
-            DRETURN(PACK_ENOMEM);
-         }
-         pb->cur_ptr = &(pb->head_ptr[pb->bytes_used]);
-      }
-
-      /* copy in packing buffer */
-      xdrmem_create(&xdrs, (caddr_t) buf, sizeof(buf), XDR_ENCODE);
-
-      if (!(xdr_double(&xdrs, &d))) {
-         DPRINTF("error - XDR of double failed\n");
-         xdr_destroy(&xdrs);
-         DRETURN(PACK_FORMAT);
-      }
-
-      if (xdr_getpos(&xdrs) != DOUBLESIZE) {
-         DPRINTF("error - size of XDRed double is %d\n", xdr_getpos(&xdrs));
-         xdr_destroy(&xdrs);
-         DRETURN(PACK_FORMAT);
-      }
-
-      memcpy(pb->cur_ptr, buf, DOUBLESIZE);
-      pb->cur_ptr = &(pb->cur_ptr[DOUBLESIZE]);
-
-      xdr_destroy(&xdrs);
-   }
-   pb->bytes_used += DOUBLESIZE;
+   static_assert(sizeof(double) == DOUBLESIZE, "double has to be a 64 bit IEEE 754 number");
+   memcpy(&J, &d, DOUBLESIZE);
+   J = htobe64(J);
 
-   DRETURN(PACK_SUCCESS);
+   DRETURN(pack_bytes(pb, (char *) &J, DOUBLESIZE));
 }
 
 /* ---------------------------------------------------------
@@ -458,54 +541,12 @@ int packdouble(sge_pack_buffer *pb, double d) {
 int packstr(sge_pack_buffer *pb, const char *str) {
    DENTER(PACK_LAYER);
 
-   /* determine string length */
+   /* a nullptr string is packed as empty string */
    if (str == nullptr) {
-      if (!pb->just_count) {
-         /* is realloc necessary */
-         if ((pb->bytes_used + 1) > pb->mem_size) {
-
-            /* realloc */
-            DPRINTF("realloc(%d + %d)\n", pb->mem_size, CHUNK);
-            pb->mem_size += CHUNK;
-            pb->head_ptr = (char *) sge_realloc(pb->head_ptr, pb->mem_size, 0);
-            if (!pb->head_ptr) {
-               DRETURN(PACK_ENOMEM);
-            }
-
-            /* update cur_ptr */
-            pb->cur_ptr = &(pb->head_ptr[pb->bytes_used]);
-         }
-         pb->cur_ptr[0] = '\0';
-         /* update cur_ptr & bytes_packed */
-         pb->cur_ptr = &(pb->cur_ptr[1]);
-      }
-      pb->bytes_used++;
-   } else {
-      size_t n = strlen(str) + 1;
-
-      if (!pb->just_count) {
-         /* is realloc necessary */
-         if ((pb->bytes_used + n) > pb->mem_size) {
-            /* realloc */
-            DPRINTF("realloc(%d + %d)\n", pb->mem_size, CHUNK);
-            while ((pb->bytes_used + n) > pb->mem_size)
-               pb->mem_size += CHUNK;
-            pb->head_ptr = (char *) sge_realloc(pb->head_ptr, pb->mem_size, 0);
-            if (!pb->head_ptr) {
-               DRETURN(PACK_ENOMEM);
-            }
-
-            /* update cur_ptr */
-            pb->cur_ptr = &(pb->head_ptr[pb->bytes_used]);
-         }
-         memcpy(pb->cur_ptr, str, n);
-         /* update cur_ptr & bytes_packed */
-         pb->cur_ptr = &(pb->cur_ptr[n]);
-      }
-      pb->bytes_used += n;
+      DRETURN(pack_bytes(pb, "", 1));
    }
 
-   DRETURN(PACK_SUCCESS);
+   DRETURN(pack_bytes(pb, str, strlen(str) + 1));
 }
 
 /* ---------------------------------------------------------
@@ -521,32 +562,8 @@ int packbuf(
         const char *buf_ptr,
         u_long32 buf_size
 ) {
-
    DENTER(PACK_LAYER);
-
-   if (!pb->just_count) {
-      /* is realloc necessary */
-      if (buf_size + (u_long32) pb->bytes_used > (u_long32) pb->mem_size) {
-         /* realloc */
-         DPRINTF("realloc(%d + %d)\n", pb->mem_size, CHUNK);
-         pb->mem_size += CHUNK;
-         pb->head_ptr = (char *) sge_realloc(pb->head_ptr, pb->mem_size, 0);
-         if (!(pb->head_ptr)) {
-            DRETURN(PACK_ENOMEM);
-         }
-
-         /* update cur_ptr */
-         pb->cur_ptr = &(pb->head_ptr[pb->bytes_used]);
-      }
-
-      /* copy in packing buffer */
-      memcpy(pb->cur_ptr, buf_ptr, buf_size);
-      /* update cur_ptr & bytes_packed */
-      pb->cur_ptr = &(pb->cur_ptr[buf_size]);
-   }
-   pb->bytes_used += buf_size;
-
-   DRETURN(PACK_SUCCESS);
+   DRETURN(pack_bytes(pb, buf_ptr, buf_size));
 }
 
 
@@ -567,6 +584,17 @@ int packbuf(
 int unpackint(sge_pack_buffer *pb, u_long32 *ip) {
    DENTER(PACK_LAYER);
 
+   if (pb_is_compact(pb)) {
+      u_long64 i;
+      int ret = unpack_varint(pb, &i, 5);
+
+      if (ret == PACK_SUCCESS && i > U_LONG32_MAX) {
+         ret = PACK_FORMAT;
+      }
+      *ip = ret == PACK_SUCCESS ? zigzag_decode32(static_cast<u_long32>(i)) : 0;
+      DRETURN(ret);
+   }
+
    /* are there enough bytes ? */
    if (pb->bytes_used + INTSIZE > pb->mem_size) {
       *ip = 0;
@@ -596,6 +624,13 @@ int unpackint(sge_pack_buffer *pb, u_long32 *ip) {
 int unpackint64(sge_pack_buffer *pb, u_long64 *ip) {
    DENTER(PACK_LAYER);
 
+   if (pb_is_compact(pb)) {
+      int ret = unpack_varint(pb, ip, 10);
+
+      *ip = zigzag_decode64(*ip);
+      DRETURN(ret);
+   }
+
    /* are there enough bytes ? */
    if (pb->bytes_used + (INTSIZE * 2) > pb->mem_size) {
       *ip = 0;
@@ -623,8 +658,7 @@ int unpackint64(sge_pack_buffer *pb, u_long64 *ip) {
 
  */
 int unpackdouble(sge_pack_buffer *pb, double *dp) {
-   XDR xdrs;
-   char buf[32];
+   u_long64 J = 0;
 
    DENTER(PACK_LAYER);
 
@@ -635,27 +669,14 @@ int unpackdouble(sge_pack_buffer *pb, double *dp) {
    }
 
    /* copy double */
-
-   /* CygWin does not know RPC u. XDR */
-#if !defined(WIN32)                   /* XDR not called */
-   memcpy(buf, pb->cur_ptr, DOUBLESIZE);
-   xdrmem_create(&xdrs, buf, DOUBLESIZE, XDR_DECODE);
-   if (!(xdr_double(&xdrs, dp))) {
-      *dp = 0;
-      DPRINTF("error unpacking XDRed double\n");
-      xdr_destroy(&xdrs);
-      DRETURN(PACK_FORMAT);
-   }
-#endif /* WIN32 */
+   memcpy(&J, pb->cur_ptr, DOUBLESIZE);
+   J = be64toh(J);
+   memcpy(dp, &J, DOUBLESIZE);
 
    /* update cur_ptr & bytes_unpacked */
    pb->cur_ptr = &(pb->cur_ptr[DOUBLESIZE]);
    pb->bytes_used += DOUBLESIZE;
 
-#if !defined(WIN32)                   /* XDR not called */
-   xdr_destroy(&xdrs);
-#endif /* WIN32 */
-
    DRETURN(PACK_SUCCESS);
 }
 
@@ -83,6 +83,11 @@
 *                             Fixed a bug with packing of lObject type:
 *                             Descriptor was sent twice.
 *     
+*     CULL_FORMAT_COMPACT:    0x00000001
+*                             Set in the version information of packbuffers
+*                             using the compact format (variable length
+*                             integers, descriptor dictionary).
+*     
 *     Former  CULL_VERSIONs:  0x10010000
 *                             Added information about attribute changes.
 *                             0x10000000
@@ -94,9 +99,17 @@
 ****************************************************************************
 */
 #define CULL_VERSION 0x10021000
+#define CULL_FORMAT_COMPACT 0x00000001
 #include <uti/sge_uidgid.h>
 
 #define MAX_USER_GROUP 512
+
+/* serialized form of shared lists, see cull_pack_cache_create() */
+typedef struct _cull_pack_cache cull_pack_cache_t;
+
+/* descriptors of a packbuffer in compact format, see cull_pack_descr() */
+typedef struct _cull_descr_dict cull_descr_dict_t;
+
 typedef struct {
    char *head_ptr;
    char *cur_ptr;
@@ -111,11 +124,14 @@ typedef struct {
    char groupname[MAX_USER_GROUP];
    int grp_amount;
    ocs_grp_elem_t *grp_array;
+   cull_pack_cache_t *pack_cache;
+   cull_descr_dict_t *descr_dict;
 
 } sge_pack_buffer;
 
 int
-init_packbuffer(sge_pack_buffer *pb, size_t initial_size, bool just_count = false, bool with_auth_info = true);
+init_packbuffer(sge_pack_buffer *pb, size_t initial_size, bool just_count = false, bool with_auth_info = true,
+                bool compact = false);
 
 int
 init_packbuffer_from_buffer(sge_pack_buffer *pb, char *buf, u_long32 buflen, bool with_auth_info = true);
@@ -129,6 +145,10 @@ int pb_unused(sge_pack_buffer *pb);
 
 int pb_used(sge_pack_buffer *pb);
 
+inline bool pb_is_compact(const sge_pack_buffer *pb) {
+   return (pb->version & CULL_FORMAT_COMPACT) != 0;
+}
+
 bool pb_are_equivalent(sge_pack_buffer *pb1, sge_pack_buffer *pb2);
 
 void pb_print_to(sge_pack_buffer *pb, bool only_header, FILE *);
@@ -47,6 +47,8 @@
 
 #include "comm/commlib.h"
 
+#include "cull/cull_pack.h"
+
 #include "gdi/ocs_gdi_Client.h"
 #include "gdi/ocs_gdi_ClientBase.h"
 #include "gdi/ocs_gdi_ClientServerBase.h"
@@ -200,6 +202,31 @@
 ****************************************************************************
 */
 
+/****** Eventclient/-Coalescing ***************************************
+*
+*  NAME
+*     Coalescing -- Configuration of event coalescing
+*
+*  FUNCTION
+*     Objects are often modified several times between two deliveries
+*     of events to an event client. If coalescing is enabled for a modify
+*     event, qmaster only delivers the most recent of the modify events
+*     for the same object that have not been delivered yet. If an object
+*     is added and deleted again before the add event has been delivered
+*     then all events of the object are dropped, provided that coalescing
+*     is enabled for the add and the delete event and no other undelivered
+*     event refers to the object.
+*
+*     The remaining events keep their order and are numbered consecutively.
+*     Coalescing is switched off by default and can be enabled per event
+*     through ec_set_coalesce().
+*
+*  SEE ALSO
+*     Eventclient/Client/ec_set_coalesce()
+*     Eventclient/Client/ec_get_coalesce()
+****************************************************************************
+*/
+
 /****** Eventclient/-List filtering***************************************
 *
 *  NAME
@@ -605,6 +632,8 @@ typedef struct {
    lListElem *ec;
    u_long32 ec_reg_id;
    u_long32 next_event;
+   bool resumable;
+   u_long64 last_sequence;
    ec_control_t event_control;
 } sge_evc_t;
 
@@ -639,10 +668,14 @@ static int ec2_get_flush(sge_evc_class_t *thiz, ev_event event);
 static bool ec2_set_flush(sge_evc_class_t *thiz, ev_event event, bool flush, int interval);
 static bool ec2_unset_flush(sge_evc_class_t *thiz, ev_event event);
 static bool ec2_subscribe_flush(sge_evc_class_t *thiz, ev_event event, int flush);
+static bool ec2_get_coalesce(sge_evc_class_t *thiz, ev_event event);
+static bool ec2_set_coalesce(sge_evc_class_t *thiz, ev_event event, bool coalesce);
 static bool ec2_set_busy(sge_evc_class_t *thiz, int busy);
 static bool ec2_get_busy(sge_evc_class_t *thiz);
 static bool ec2_set_session(sge_evc_class_t *thiz, const char *session);
 static const char *ec2_get_session(sge_evc_class_t *thiz);
+static bool ec2_set_resumable(sge_evc_class_t *thiz, bool resumable);
+static bool ec2_get_resumable(sge_evc_class_t *thiz);
 static bool ec2_commit(sge_evc_class_t *thiz, lList **alpp);
 static bool ec2_commit_local(sge_evc_class_t *thiz, lList **alpp);
 static bool ec2_commit_multi(sge_evc_class_t *thiz, lList **malpp, ocs::gdi::Request *gdi_multi);
@@ -703,6 +736,8 @@ sge_evc_class_create(ev_registration_id reg_id, lList **alpp, const char *name)
    ret->ec_set_flush = ec2_set_flush;
    ret->ec_unset_flush = ec2_unset_flush;
    ret->ec_subscribe_flush = ec2_subscribe_flush;
+   ret->ec_get_coalesce = ec2_get_coalesce;
+   ret->ec_set_coalesce = ec2_set_coalesce;
    ret->ec_mod_subscription_where = ec2_mod_subscription_where;
    ret->ec_set_edtime = ec2_set_edtime;
    ret->ec_get_edtime = ec2_get_edtime;
@@ -714,6 +749,8 @@ sge_evc_class_create(ev_registration_id reg_id, lList **alpp, const char *name)
    ret->ec_get_busy = ec2_get_busy;
    ret->ec_set_session = ec2_set_session;
    ret->ec_get_session = ec2_get_session;
+   ret->ec_set_resumable = ec2_set_resumable;
+   ret->ec_get_resumable = ec2_get_resumable;
    ret->ec_get_id = ec2_get_id;
    ret->ec_commit_multi = ec2_commit_multi;
    ret->ec_mark4registration = ec2_mark4registration;
@@ -734,6 +771,8 @@ sge_evc_class_create(ev_registration_id reg_id, lList **alpp, const char *name)
    sge_evc->ec = nullptr;
    sge_evc->ec_reg_id = 0;
    sge_evc->next_event = 1;
+   sge_evc->resumable = false;
+   sge_evc->last_sequence = 0;
 
    ret->sge_evc_handle = sge_evc;
 
@@ -1305,6 +1344,7 @@ ec2_deregister_local(sge_evc_class_t *thiz) {
       sge_evc->need_register = true;
       sge_evc->ec_reg_id = 0;
       sge_evc->next_event = 1;
+      sge_evc->last_sequence = 0;
 
       ret = true;
    }
@@ -1453,6 +1493,9 @@ ec2_register(sge_evc_class_t *thiz, bool exit_on_qmaster_down, lList** alpp) {
       lSetUlong64(sge_evc->ec, EV_next_send_time, 0);
       lSetUlong(sge_evc->ec, EV_next_number, 0);
 
+      /* continue with the events we missed (see ec_set_resumable()) */
+      lSetUlong64(sge_evc->ec, EV_resume_sequence, sge_evc->resumable ? sge_evc->last_sequence : 0);
+
       lp = lCreateList("registration", EV_Type);
       lAppendElem(lp, lCopyElem(sge_evc->ec));
 
@@ -1613,6 +1656,7 @@ static bool ec2_deregister(sge_evc_class_t *thiz)
             sge_evc->need_register = true;
             sge_evc->ec_reg_id = 0;
             sge_evc->next_event = 1;
+            sge_evc->last_sequence = 0;
 
             ret = true;
          }
@@ -2219,6 +2263,105 @@ static bool ec2_subscribe_flush(sge_evc_class_t *thiz, ev_event event, int flush
    return ret;
 }
 
+/****** Eventclient/Client/ec_get_coalesce() **********************************
+*  NAME
+*     ec_get_coalesce() -- get coalescing information for an event
+*
+*  SYNOPSIS
+*     #include "evc/sge_event_client.h"
+*
+*     bool
+*     ec_get_coalesce(ev_event event)
+*
+*  FUNCTION
+*     Returns if events of the given id are coalesced by qmaster.
+*
+*  INPUTS
+*     ev_event event - the event id to query
+*
+*  RESULT
+*     bool - true if coalescing is enabled for the event
+*
+*  SEE ALSO
+*     Eventclient/-Coalescing
+*     Eventclient/Client/ec_set_coalesce()
+*******************************************************************************/
+static bool
+ec2_get_coalesce(sge_evc_class_t *thiz, ev_event event) {
+   DENTER(EVC_LAYER);
+   bool ret = false;
+   auto *sge_evc = (sge_evc_t *) thiz->sge_evc_handle;
+
+   if (sge_evc->ec == nullptr) {
+      ERROR(SFNMAX, MSG_EVENT_UNINITIALIZED_EC);
+   } else if (event < sgeE_ALL_EVENTS || event >= sgeE_EVENTSIZE) {
+      WARNING(MSG_EVENT_ILLEGALEVENTID_I, event);
+   } else {
+      const lListElem *sub_event = lGetElemUlong(lGetList(sge_evc->ec, EV_subscribed), EVS_id, event);
+
+      if (sub_event == nullptr) {
+         ERROR(SFNMAX, MSG_EVENT_UNINITIALIZED_EC);
+      } else {
+         ret = lGetBool(sub_event, EVS_coalesce);
+      }
+   }
+
+   DRETURN(ret);
+}
+
+/****** Eventclient/Client/ec_set_coalesce() **********************************
+*  NAME
+*     ec_set_coalesce() -- switch coalescing of an event on or off
+*
+*  SYNOPSIS
+*     #include "evc/sge_event_client.h"
+*
+*     bool
+*     ec_set_coalesce(ev_event event, bool coalesce)
+*
+*  FUNCTION
+*     Enables or disables coalescing for a subscribed event.
+*     sgeE_ALL_EVENTS configures all subscribed events.
+*
+*  INPUTS
+*     ev_event event - id of the event to configure
+*     bool coalesce  - true to enable coalescing
+*
+*  RESULT
+*     bool - true if the configuration was changed, else false
+*
+*  SEE ALSO
+*     Eventclient/-Coalescing
+*     Eventclient/Client/ec_get_coalesce()
+*******************************************************************************/
+static bool
+ec2_set_coalesce(sge_evc_class_t *thiz, ev_event event, bool coalesce) {
+   DENTER(EVC_LAYER);
+   bool ret = false;
+   auto *sge_evc = (sge_evc_t *) thiz->sge_evc_handle;
+
+   if (sge_evc->ec == nullptr) {
+      ERROR(SFNMAX, MSG_EVENT_UNINITIALIZED_EC);
+   } else if (event < sgeE_ALL_EVENTS || event >= sgeE_EVENTSIZE) {
+      WARNING(MSG_EVENT_ILLEGALEVENTID_I, event);
+   } else if (const lList *subscribed = lGetList(sge_evc->ec, EV_subscribed)) {
+      int first = event == sgeE_ALL_EVENTS ? sgeE_ALL_EVENTS + 1 : event;
+      int last = event == sgeE_ALL_EVENTS ? sgeE_EVENTSIZE - 1 : event;
+
+      for (int e = first; e <= last; e++) {
+         lListElem *sub_el = lGetElemUlongRW(subscribed, EVS_id, e);
+
+         if (sub_el != nullptr && lGetBool(sub_el, EVS_coalesce) != coalesce) {
+            lSetBool(sub_el, EVS_coalesce, coalesce);
+            lSetBool(sge_evc->ec, EV_changed, true);
+            ret = true;
+         }
+      }
+   }
+
+   DRETURN(ret);
+}
+
 /****** Eventclient/Client/ec_set_busy() **************************************
 *  NAME
 *     ec_set_busy() -- set the busy state
@@ -2377,6 +2520,64 @@ static const char *ec2_get_session(sge_evc_class_t *thiz) {
    DRETURN(ret);
 }
 
+/****** sge_event_client/ec_set_resumable() ************************************
+*  NAME
+*     ec_set_resumable() -- resume event delivery after a new registration
+*
+*  SYNOPSIS
+*     bool ec_set_resumable(bool resumable)
+*
+*  FUNCTION
+*     If set, the event client presents the sequence number of the last
+*     event it received when it registers again, e.g. after a timeout.
+*     If the event master still has all events that were generated since
+*     then, it delivers these events instead of a total update.
+*
+*     Only event clients which keep their data when they register again
+*     may use this.
+*
+*  INPUTS
+*     bool resumable - true = resume event delivery
+*
+*  RESULT
+*     bool - true = success, false = failed
+*
+*  SEE ALSO
+*     Eventclient/Client/ec_get_resumable()
+*     Eventclient/Client/ec_register()
+*******************************************************************************/
+static bool ec2_set_resumable(sge_evc_class_t *thiz, bool resumable) {
+   DENTER(EVC_LAYER);
+   auto *sge_evc = (sge_evc_t *) thiz->sge_evc_handle;
+
+   sge_evc->resumable = resumable;
+   if (!resumable) {
+      sge_evc->last_sequence = 0;
+   }
+
+   DRETURN(true);
+}
+
+/****** sge_event_client/ec_get_resumable() ************************************
+*  NAME
+*     ec_get_resumable() -- is event delivery resumed after a new registration
+*
+*  SYNOPSIS
+*     bool ec_get_resumable()
+*
+*  RESULT
+*     bool - true if event delivery is resumed
+*
+*  SEE ALSO
+*     Eventclient/Client/ec_set_resumable()
+*******************************************************************************/
+static bool ec2_get_resumable(sge_evc_class_t *thiz) {
+   DENTER(EVC_LAYER);
+   auto *sge_evc = (sge_evc_t *) thiz->sge_evc_handle;
+
+   DRETURN(sge_evc->resumable);
+}
+
 /****** sge_event_client/ec_get_id() *******************************************
 *  NAME
 *     ec_get_id() -- Return event client id.
@@ -2801,6 +3002,16 @@ ec2_get(sge_evc_class_t *thiz, lList **event_list, bool exit_on_qmaster_down) {
 
             DPRINTF("got %d events till " sge_u32 "\n", lGetNumberOfElem(new_events), sge_evc->next_event - 1);
 
+            if (sge_evc->resumable) {
+               const lListElem *event;
+               for_each_ep(event, new_events) {
+                  u_long64 sequence = lGetUlong64(event, ET_sequence);
+                  if (sequence > sge_evc->last_sequence) {
+                     sge_evc->last_sequence = sequence;
+                  }
+               }
+            }
+
             if (*event_list != nullptr) {
                lAddList(*event_list, &new_events);
             } else {
@@ -3064,10 +3275,15 @@ get_event_list(sge_evc_class_t *thiz, int sync, lList **report_list, int *commli
       }
       ret = false;
    } else {
+      // events carry complete objects but event clients mostly look at a few attributes,
+      // so sublists are only unpacked when they are accessed
+      bool lazy = lGetLazyUnpackMode();
+      lSetLazyUnpackMode(true);
       if (cull_unpack_list(&pb, report_list)) {
          ERROR(SFNMAX, MSG_LIST_FAILEDINCULLUNPACKREPORT);
          ret = false;
       }
+      lSetLazyUnpackMode(lazy);
       clear_packbuffer(&pb);
    }
    if (commlib_error != nullptr) {
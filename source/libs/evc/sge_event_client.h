@@ -86,6 +86,9 @@ struct sge_evc_class_str {
 
    bool (*ec_subscribe_flush)(sge_evc_class_t *thiz, ev_event event, int flush);
 
+   bool (*ec_get_coalesce)(sge_evc_class_t *thiz, ev_event event);
+   bool (*ec_set_coalesce)(sge_evc_class_t *thiz, ev_event event, bool coalesce);
+
    bool (*ec_mod_subscription_where)(sge_evc_class_t *thiz, ev_event event, const lListElem *what, const lListElem *where);
 
    bool (*ec_set_edtime)(sge_evc_class_t *thiz, u_long32 intval);
@@ -103,6 +106,9 @@ struct sge_evc_class_str {
    bool (*ec_set_session)(sge_evc_class_t *thiz, const char *session);
    const char *(*ec_get_session)(sge_evc_class_t *thiz);
 
+   bool (*ec_set_resumable)(sge_evc_class_t *thiz, bool resumable);
+   bool (*ec_get_resumable)(sge_evc_class_t *thiz);
+
    ev_registration_id (*ec_get_id)(sge_evc_class_t *thiz);
 
    bool (*ec_commit_multi)(sge_evc_class_t *thiz, lList **malp, ocs::gdi::Request *state);
@@ -39,7 +39,7 @@
 
 #define MSG_EVE_REINITEVENTCLIENT_S   _MESSAGE(66000, _("reinitialization of " SFQ))
 #define MSG_EVE_UNKNOWNEVCLIENT_US    _MESSAGE(66001, _("no event client known with id " sge_u32 " to %s"))
-#define MSG_EVE_CLIENTREREGISTERED_SSSU _MESSAGE(66002, _("event client " SFQ " (%s/%s/" sge_u32 ") reregistered - it will need a total update"))
+#define MSG_EVE_CLIENTREREGISTERED_SSSU _MESSAGE(66002, _("event client " SFQ " (%s/%s/" sge_u32 ") reregistered"))
 #define MSG_EVE_REG_SUU               _MESSAGE(66003, _(SFQ " registers as event client with id " sge_u32 " event delivery interval " sge_u32))
 #define MSG_EVE_UNREG_SU              _MESSAGE(66004, _("event client " SFQ " with id " sge_u32 " deregistered"))
 #define MSG_EVE_EVENTCLIENT           _MESSAGE(66005, _("event client"))
@@ -60,5 +60,6 @@
 #define MSG_SET_MAXDYNEVENTCLIENT_U       _MESSAGE(66018, _("max dynamic event clients is set to " sge_u32))
 #define MSG_EVE_INCOMPLETEEVENTCLIENT     _MESSAGE(66020, _("wrong event client version"))
 #define MSG_COM_ACKTIMEOUT4EV_SUSIS         _MESSAGE(66021, _("removing event client " SFN " with id " sge_u32 " (" SFN ":%d) on host " SFQ " after acknowledge timeout from event client list"))
+#define MSG_EVE_REPLAYEVENTS_SUI            _MESSAGE(66022, _("event client " SFQ " with id " sge_u32 " resumes with %d missed events instead of a total update"))
 
 // clang-format on
@@ -39,6 +39,13 @@
 #include <cstdlib>
 #include <cstring>
 #include <cerrno>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "uti/sge_bootstrap.h"
 #include "uti/ocs_cond.h"
@@ -49,6 +56,7 @@
 #include "uti/sge_profiling.h"
 #include "uti/sge_rmon_macros.h"
 #include "uti/sge_spool.h"
+#include "uti/sge_string.h"
 #include "uti/sge_thread_ctrl.h"
 #include "uti/sge_time.h"
 
@@ -73,6 +81,7 @@
 #include "sgeobj/sge_range.h"
 #include "sgeobj/sge_schedd_conf.h"
 #include "sgeobj/ocs_Session.h"
+#include "sgeobj/ocs_Version.h"
 #include "sgeobj/cull/sge_event_request_EVR_L.h"
 #include "sgeobj/msg_sgeobjlib.h"
 
@@ -131,11 +140,57 @@ typedef struct {
                                  /*   the total update is issued                */
       bool         flush;        /* true -> flush is set                      */
       u_long32     flush_time;   /* seconds how much the event can be delayed */
+      bool         coalesce;     /* true -> undelivered events are coalesced  */
       lCondition   *where;       /* where filter                              */
       lDescr       *descr;       /* target list descriptor                    */
       lEnumeration *what;        /* limits the target element                 */
+      char         *key;         /* textual form of where and what filter     */
 } subscription_t;
 
+/*
+ * Event data that has been built for one event and the distinct subscriptions
+ * of event clients. The lists are marked as shared (see lMarkListShared())
+ * and are referenced by the events of all event clients with the same key.
+ */
+typedef std::map<std::string, lList *> event_payload_cache_t;
+
+/*
+ * Add, delete and modify events of the same object type. sgeE_ALL_EVENTS
+ * marks a missing event (see coalesce_events()).
+ */
+typedef struct {
+   ev_event add;
+   ev_event del;
+   ev_event mod;
+} event_family_t;
+
+static const event_family_t EVENT_FAMILIES[] = {
+   {sgeE_ADMINHOST_ADD, sgeE_ADMINHOST_DEL, sgeE_ADMINHOST_MOD},
+   {sgeE_CALENDAR_ADD, sgeE_CALENDAR_DEL, sgeE_CALENDAR_MOD},
+   {sgeE_CKPT_ADD, sgeE_CKPT_DEL, sgeE_CKPT_MOD},
+   {sgeE_CENTRY_ADD, sgeE_CENTRY_DEL, sgeE_CENTRY_MOD},
+   {sgeE_CONFIG_ADD, sgeE_CONFIG_DEL, sgeE_CONFIG_MOD},
+   {sgeE_EXECHOST_ADD, sgeE_EXECHOST_DEL, sgeE_EXECHOST_MOD},
+   {sgeE_JATASK_ADD, sgeE_JATASK_DEL, sgeE_JATASK_MOD},
+   {sgeE_PETASK_ADD, sgeE_PETASK_DEL, sgeE_PETASK_MOD},
+   {sgeE_JOB_ADD, sgeE_JOB_DEL, sgeE_JOB_MOD},
+   {sgeE_ALL_EVENTS, sgeE_ALL_EVENTS, sgeE_JOB_USAGE},
+   {sgeE_JOB_SCHEDD_INFO_ADD, sgeE_JOB_SCHEDD_INFO_DEL, sgeE_JOB_SCHEDD_INFO_MOD},
+   {sgeE_MANAGER_ADD, sgeE_MANAGER_DEL, sgeE_MANAGER_MOD},
+   {sgeE_OPERATOR_ADD, sgeE_OPERATOR_DEL, sgeE_OPERATOR_MOD},
+   {sgeE_PE_ADD, sgeE_PE_DEL, sgeE_PE_MOD},
+   {sgeE_PROJECT_ADD, sgeE_PROJECT_DEL, sgeE_PROJECT_MOD},
+   {sgeE_CQUEUE_ADD, sgeE_CQUEUE_DEL, sgeE_CQUEUE_MOD},
+   {sgeE_QINSTANCE_ADD, sgeE_QINSTANCE_DEL, sgeE_QINSTANCE_MOD},
+   {sgeE_SUBMITHOST_ADD, sgeE_SUBMITHOST_DEL, sgeE_SUBMITHOST_MOD},
+   {sgeE_USER_ADD, sgeE_USER_DEL, sgeE_USER_MOD},
+   {sgeE_USERSET_ADD, sgeE_USERSET_DEL, sgeE_USERSET_MOD},
+   {sgeE_HGROUP_ADD, sgeE_HGROUP_DEL, sgeE_HGROUP_MOD},
+   {sgeE_RQS_ADD, sgeE_RQS_DEL, sgeE_RQS_MOD},
+   {sgeE_AR_ADD, sgeE_AR_DEL, sgeE_AR_MOD},
+   {sgeE_CATEGORY_ADD, sgeE_CATEGORY_DEL, sgeE_CATEGORY_MOD}
+};
+
 /****** Eventclient/Server/-Event_Client_Server_Defines ************************
 *  NAME
 *     Defines -- Constants used in the module
@@ -335,20 +390,77 @@ event_master_control_t Event_Master_Control = {
 
 static int event_master_control_cond_init_ret = ocs::uti::condition_initialize(&Event_Master_Control.cond_var);
 
+/*
+ * Event clients which subscribed an event type. Event clients using session
+ * filtering are stored per session. The index is protected by
+ * Event_Master_Control.mutex, the number of subscribers can be read without
+ * holding the mutex.
+ *
+ * SEE ALSO:
+ *    subscription_index_add()
+ *    subscription_index_get()
+ */
+typedef struct {
+   std::vector<lListElem *> clients;
+   std::unordered_map<std::string, std::vector<lListElem *>> session_clients;
+   std::atomic<int> subscribers;
+} subscription_index_t;
+
+static subscription_index_t Subscription_Index[sgeE_EVENTSIZE];
+
+/*
+ * Recent events for all event clients (EV_ID_ANY) in the order they were
+ * delivered. Event clients that register again get the events they missed
+ * from here instead of a total update. The log is protected by
+ * Event_Master_Control.mutex.
+ *
+ * Sequence numbers start with the qmaster start time in microseconds, so
+ * sequence numbers of a previous qmaster run are not found in the log.
+ * Every event for all event clients consumes a sequence number, also while
+ * the log is disabled, so that a gap in the log is always detected.
+ *
+ * SEE ALSO:
+ *    replay_log_append()
+ *    replay_log_skip()
+ *    replay_events()
+ */
+typedef struct {
+   lListElem *event;
+   std::string session;
+   bool has_session;
+   lList *changed_fields;
+} replay_log_entry_t;
+
+static std::deque<replay_log_entry_t> Replay_Log;
+static u_long64 Replay_Next_Sequence = 0;
+
 static void       init_send_events();
 static void       flush_events(lListElem*, int);
 static void       total_update(lListElem*, u_long64 gdi_session);
 static void       build_subscription(lListElem*);
+static void       subscription_index_add(lListElem *event_client);
+static void       subscription_index_remove(const lListElem *event_client);
+static void       subscription_index_get(ev_event type, const char *session, std::vector<lListElem *> &clients);
 static void       remove_event_client(lListElem **client, bool lock_event_master);
 static void       check_send_new_subscribed_list(const subscription_t*,
                                                  const subscription_t*, lListElem*,
                                                  ev_event event);
 static int        eventclient_subscribed(const lListElem *, ev_event, const char*);
 static int        purge_event_list(lList* aList, u_long32 event_number);
+static void       coalesce_events(lListElem *event_client);
+static u_long64   replay_log_next_sequence();
+static void       replay_log_append(lListElem **event, const char *session, const lList *changed_fields, int size);
+static bool       replay_log_skip(ev_event type);
+static bool       replay_events(lListElem *event_client, u_long64 sequence);
 
 static lListElem* sge_create_event(u_long32, u_long64, ev_event, u_long32, u_long32, const char*, const char*, lList*);
-static bool       add_list_event_for_client(u_long32, u_long64, ev_event, u_long32, u_long32, const char*, const char*, const char*, lList*, u_long64);
-static void       add_list_event_direct(lListElem *event_client, lListElem *event, bool copy_event);
+static bool       add_list_event_for_client(u_long32, u_long64, ev_event, u_long32, u_long32, const char*, const char*, const char*, lList*, u_long64,
+                                            const int changed_fields[] = nullptr);
+static void       add_list_event_direct(lListElem *event_client, lListElem *event, bool copy_event,
+                                        event_payload_cache_t *payload_cache, const lList *changed_fields);
+static lEnumeration *event_delta_what(const lDescr *descr, const lEnumeration *fields, const lList *changed_fields);
+static void       event_payload_key(const subscription_t *subscription, int type, bool internal_client,
+                                    std::string &key);
 static void       total_update_event(lListElem *event_client, ev_event type, bool new_subscription, u_long64 gdi_session);
 static bool       list_select(subscription_t*, int, lList**, lList*, const lCondition*, const lEnumeration*, const lDescr*, bool);
 static lListElem* elem_select(subscription_t*, lListElem*, const int[], const lCondition*, const lEnumeration*, const lDescr*, int);
@@ -391,6 +503,7 @@ void sge_cleanup_event_master_control(void *arg) {
    lFreeList(&Event_Master_Control.clients);
    lFreeList(&Event_Master_Control.client_ids);
    lFreeList(&Event_Master_Control.requests);
+   replay_log_append(nullptr, nullptr, nullptr, 0);
    pthread_cond_destroy(&Event_Master_Control.cond_var);
    pthread_mutex_destroy(&Event_Master_Control.cond_mutex);
    pthread_mutex_destroy(&Event_Master_Control.request_mutex);
@@ -560,6 +673,9 @@ int sge_add_event_client(const ocs::gdi::Packet *packet, lListElem *clio, lList
 #pragma GCC diagnostic pop
    lSetBool(clio, EV_changed, false);
 
+   /* the version of the registration request decides about the pack format of the event reports */
+   lSetUlong(ep, EV_version, packet->version);
+
    lAppendElem(Event_Master_Control.clients, ep);
 
    lSetUlong(ep, EV_next_number, 1);
@@ -583,9 +699,12 @@ int sge_add_event_client(const ocs::gdi::Packet *packet, lListElem *clio, lList
 
    /* Start with no pending events. */
    build_subscription(ep);
+   subscription_index_add(ep);
 
-   /* build events for total update */
-   total_update(ep, packet->gdi_session);
+   /* build events for total update unless the client can continue with the events it missed */
+   if (!replay_events(ep, lGetUlong64(ep, EV_resume_sequence))) {
+      total_update(ep, packet->gdi_session);
+   }
 
    /* flush initial list events */
    flush_events(ep, 0);
@@ -800,11 +919,13 @@ sge_event_master_process_mod_event_client(const lListElem *request, monitoring_t
 #endif
       lSetRef(event_client, EV_sub_array, new_sub);
       lSetRef(clio, EV_sub_array, nullptr);
+      subscription_index_add(event_client);
       if (old_sub) {
          int i;
          for (i=0; i<sgeE_EVENTSIZE; i++){
             lFreeWhere(&(old_sub[i].where));
             lFreeWhat(&(old_sub[i].what));
+            sge_free(&(old_sub[i].key));
             if (old_sub[i].descr){
                cull_hash_free_descr(old_sub[i].descr);
                sge_free(&(old_sub[i].descr));
@@ -1294,7 +1415,9 @@ sge_add_event(u_long64 timestamp, ev_event type, u_long32 intkey, u_long32 intke
 *     sge_add_event_for_client(u_long32 event_client_id, u_long64 timestamp, ev_event type,
 *                              u_long32 intkey, u_long32 intkey2,
 *                              const char *strkey, const char *strkey2,
-*                              const char *session, lListElem *element)
+*                              const char *session, lListElem *element,
+*                              u_long64 gdi_session,
+*                              const int changed_fields[] = nullptr)
 *
 *  FUNCTION
 *     Add an event for a given event client.
@@ -1309,6 +1432,9 @@ sge_add_event(u_long64 timestamp, ev_event type, u_long32 intkey, u_long32 intke
 *     const char *strkey2        - 2nd alphanumeric key
 *     const char *session        - event session
 *     lListElem *element         - object to be delivered with the event
+*     u_long64 gdi_session       - GDI session of the request causing the event
+*     const int changed_fields[] - changed attributes of a modify event
+*                                  (see sge_add_delta_event()) or nullptr
 *
 *  NOTES
 *     MT-NOTE: sge_add_event_for_client() is MT safe
@@ -1317,13 +1443,19 @@ sge_add_event(u_long64 timestamp, ev_event type, u_long32 intkey, u_long32 intke
 bool sge_add_event_for_client(u_long32 event_client_id, u_long64 timestamp, ev_event type,
                               u_long32 intkey, u_long32 intkey2,
                               const char *strkey, const char *strkey2,
-                              const char *session, lListElem *element, u_long64 gdi_session)
+                              const char *session, lListElem *element, u_long64 gdi_session,
+                              const int changed_fields[])
 {
    lList *lp = nullptr;
    bool ret = false;
 
    DENTER(TOP_LAYER);
 
+   /* nobody is interested in this event, don't copy the object */
+   if (event_client_id == EV_ID_ANY && replay_log_skip(type)) {
+      DRETURN(true);
+   }
+
    if (element != nullptr) {
       lList *temp_sub_lp = nullptr;
       int sub_list_elem = 0;
@@ -1352,11 +1484,63 @@ bool sge_add_event_for_client(u_long32 event_client_id, u_long64 timestamp, ev_e
    }
 
    ret = add_list_event_for_client(event_client_id, timestamp, type, intkey, intkey2,
-                                   strkey, strkey2, session, lp, gdi_session);
+                                   strkey, strkey2, session, lp, gdi_session, changed_fields);
 
    DRETURN(ret);
 }
 
+/****** Eventclient/Server/sge_add_delta_event() *******************************
+*  NAME
+*     sge_add_delta_event() -- add a modify event with the changed attributes
+*
+*  SYNOPSIS
+*     #include "evm/sge_event_master.h"
+*
+*     bool
+*     sge_add_delta_event(u_long64 timestamp, ev_event type,
+*                         u_long32 intkey, u_long32 intkey2,
+*                         const char *strkey, const char *strkey2,
+*                         const char *session, lListElem *element,
+*                         const int changed_fields[], u_long64 gdi_session)
+*
+*  FUNCTION
+*     Like sge_add_event() but the caller names the attributes of "element"
+*     that have been changed. Internal event clients (the mirror threads)
+*     only receive the primary key and these attributes and merge them into
+*     their copy of the object. Other event clients receive the complete
+*     object as with sge_add_event().
+*
+*  INPUTS
+*     u_long64 timestamp         - event creation time, 0 -> use current time
+*     ev_event type              - the event id (a modify event)
+*     u_long32 intkey            - additional data
+*     u_long32 intkey2           - additional data
+*     const char *strkey         - additional data
+*     const char *strkey2        - additional data
+*     const char *session        - events session key
+*     lListElem *element         - the modified object
+*     const int changed_fields[] - changed attributes, terminated by NoName
+*     u_long64 gdi_session       - GDI session of the request causing the event
+*
+*  RESULT
+*     bool - true on success
+*
+*  NOTES
+*     MT-NOTE: sge_add_delta_event() is MT safe
+*
+*  SEE ALSO
+*     Eventclient/Server/sge_add_event()
+*     sgeobj/object/object_apply_delta()
+*******************************************************************************/
+bool
+sge_add_delta_event(u_long64 timestamp, ev_event type, u_long32 intkey, u_long32 intkey2, const char *strkey,
+                    const char *strkey2, const char *session, lListElem *element, const int changed_fields[],
+                    u_long64 gdi_session)
+{
+   return sge_add_event_for_client(EV_ID_ANY, timestamp, type, intkey, intkey2, strkey, strkey2, session, element,
+                                   gdi_session, changed_fields);
+}
+
 /****** Eventclient/Server/sge_add_list_event() ********************************
 *  NAME
 *     sge_add_list_event() -- add a list as event
@@ -1396,6 +1580,11 @@ bool sge_add_list_event(u_long64 timestamp, ev_event type,
    bool ret;
    lList *lp = nullptr;
 
+   /* nobody is interested in this event, don't copy the list */
+   if (replay_log_skip(type)) {
+      return true;
+   }
+
    if (list != nullptr) {
       lListElem *element = nullptr;
 
@@ -1566,7 +1755,9 @@ add_list_event_for_client_after_commit(lListElem *evr, lList *evr_list, u_long64
 *     add_list_event_for_client(u_long32 event_client_id, u_long64 timestamp,
 *                               ev_event type, u_long32 intkey,
 *                               u_long32 intkey2, const char *strkey,
-*                               const char *session, lList *list)
+*                               const char *session, lList *list,
+*                               u_long64 gdi_session,
+*                               const int changed_fields[])
 *
 *  FUNCTION
 *     Adds a list of objects to the list of events to deliver, e.g. the
@@ -1584,6 +1775,8 @@ add_list_event_for_client_after_commit(lListElem *evr, lList *evr_list, u_long64
 *     const char *strkey      - additional data
 *     const char *session     - events session key
 *     lList *list             - the list to deliver as event
+*     u_long64 gdi_session    - GDI session of the request causing the event
+*     const int changed_fields[] - changed attributes of a modify event or nullptr
 *
 *  RESULTS
 *     Whether the event was added successfully.
@@ -1595,7 +1788,7 @@ add_list_event_for_client_after_commit(lListElem *evr, lList *evr_list, u_long64
 static bool
 add_list_event_for_client(u_long32 event_client_id, u_long64 timestamp, ev_event type, u_long32 intkey,
                           u_long32 intkey2, const char *strkey, const char *strkey2, const char *session,
-                          lList *list, u_long64 gdi_session) {
+                          lList *list, u_long64 gdi_session, const int changed_fields[]) {
    lListElem *evr = nullptr;        /* event request object */
    lList *etlp = nullptr;           /* event list */
    lListElem *etp = nullptr;        /* event object */
@@ -1616,6 +1809,12 @@ add_list_event_for_client(u_long32 event_client_id, u_long64 timestamp, ev_event
    etlp = lCreateListHash("Event_List", ET_Type, false);
    lSetList(evr, EVR_event_list, etlp);
 
+   if (changed_fields != nullptr) {
+      for (int i = 0; changed_fields[i] != NoName; i++) {
+         lAddSubUlong(evr, ULNG_value, changed_fields[i], EVR_changed_fields, ULNG_Type);
+      }
+   }
+
    /*
     * Create a new event elem (The event number is added when
     * qmaster adds the event to the event client data structure)
@@ -1649,42 +1848,56 @@ sge_event_master_process_send(const lListElem *request, monitoring_t *monitor) {
    lList *event_list = nullptr;
    u_long32 ec_id = 0;
    const char *session = nullptr;
+   const lList *changed_fields = nullptr;
    ev_event type = sgeE_ALL_EVENTS;
+   std::vector<lListElem *> receivers;
+   int replay_log_size = 0;
 
    DENTER(TOP_LAYER);
 
    ec_id = lGetUlong(request, EVR_event_client_id);
    session = lGetString(request, EVR_session);
    event_list = lGetListRW(request, EVR_event_list);
+   changed_fields = lGetList(request, EVR_changed_fields);
 
    MONITOR_EDT_NEW(monitor);
 
    if (ec_id == EV_ID_ANY) {
       DPRINTF("Processing event for all clients\n");
 
+      replay_log_size = mconf_get_event_replay_log_size();
+
       event = lFirstRW(event_list);
       while (event != nullptr) {
+         event_payload_cache_t payload_cache;
          bool added = false;
          event = lDechainElem(event_list, event);
          type = (ev_event)lGetUlong(event, ET_type);
 
          sge_mutex_lock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
-         for_each_rw (event_client, Event_Master_Control.clients) {
+         lSetUlong64(event, ET_sequence, replay_log_next_sequence());
+         subscription_index_get(type, session, receivers);
+         for (lListElem *receiver : receivers) {
+            event_client = receiver;
             ec_id = lGetUlong(event_client, EV_id);
 
             DPRINTF("Preparing event for client %ld\n", ec_id);
 
             if (eventclient_subscribed(event_client, type, session)) {
                added = true;
-               add_list_event_direct(event_client, event, true);
+               add_list_event_direct(event_client, event, true, &payload_cache, changed_fields);
                MONITOR_EDT_ADDED(monitor);
             }
-         } /* for_each */
+         } /* for */
+         replay_log_append(&event, session, changed_fields, replay_log_size);
          sge_mutex_unlock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
 
          if (!added) {
             MONITOR_EDT_SKIP(monitor);
          }
+         for (auto &payload : payload_cache) {
+            lFreeList(&payload.second);
+         }
          lFreeElem(&event);
          event = lFirstRW(event_list);
       } /* while */
@@ -1705,7 +1918,7 @@ sge_event_master_process_send(const lListElem *request, monitoring_t *monitor) {
             type = (ev_event)lGetUlong(event, ET_type);
 
             if (eventclient_subscribed(event_client, type, session)) {
-               add_list_event_direct(event_client, event, false);
+               add_list_event_direct(event_client, event, false, nullptr, changed_fields);
                MONITOR_EDT_ADDED(monitor);
                /* We can't free the event when we're done because it now belongs
                 * to send_events(). */
@@ -2058,6 +2271,7 @@ remove_event_client(lListElem **client, bool lock_event_master) {
       for (int i = 0; i < sgeE_EVENTSIZE; i++) {
          lFreeWhere(&old_sub[i].where);
          lFreeWhat(&old_sub[i].what);
+         sge_free(&(old_sub[i].key));
 
          if (old_sub[i].descr) {
             cull_hash_free_descr(old_sub[i].descr);
@@ -2073,6 +2287,7 @@ remove_event_client(lListElem **client, bool lock_event_master) {
       sge_mutex_lock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
    }
 
+   subscription_index_remove(*client);
    lRemoveElem(Event_Master_Control.clients, client);
    if (event_client_id >= EV_ID_FIRST_DYNAMIC) {
       lList *answer_list = nullptr;
@@ -2130,11 +2345,15 @@ sge_event_master_send_events(lListElem *report, lList *report_list, monitoring_t
    u_long32 ec_id = 0;
    event_client_update_func_t update_func = nullptr;
    void *update_func_arg = nullptr;
+   cull_pack_cache_t *pack_cache = nullptr;
 
    DENTER(TOP_LAYER);
 
    sge_mutex_lock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
 
+   /* event data that is shared between event clients is packed only once */
+   pack_cache = cull_pack_cache_create();
+
    u_long64 now = sge_get_gmt64();
    event_client = lFirstRW(Event_Master_Control.clients);
    while (event_client != nullptr) {
@@ -2243,6 +2462,8 @@ sge_event_master_send_events(lListElem *report, lList *report_list, monitoring_t
          if (!lGetUlong(event_client, EV_busy) || do_remove) {
             lList *lp = nullptr;
 
+            coalesce_events(event_client);
+
             /* put only pointer in report - dont copy */
             lXchgList(event_client, EV_events, &lp);
             lXchgList(report, REP_list, &lp);
@@ -2251,7 +2472,10 @@ sge_event_master_send_events(lListElem *report, lList *report_list, monitoring_t
                update_func(ec_id, nullptr, report_list, update_func_arg);
                ret = CL_RETVAL_OK;
             } else {
-               ret = ocs::gdi::ClientExecd::report_list_send(report_list, host, commproc, commid, 0);
+               /* use the compact format only if the event client announced that it can read it */
+               bool compact = ocs::Version::is_compact_pack_supported(lGetUlong(event_client, EV_version));
+               ret = ocs::gdi::ClientExecd::report_list_send(report_list, host, commproc, commid, 0, pack_cache,
+                                                             compact);
                MONITOR_MESSAGES_OUT(monitor);
             }
 
@@ -2276,6 +2500,9 @@ sge_event_master_send_events(lListElem *report, lList *report_list, monitoring_t
              * want to give failed clients a break before trying them again. */
             lSetUlong64(event_client, EV_next_send_time, now + sge_gmt32_to_gmt64(deliver_interval));
 
+            /* the client might have seen these events, they may not be coalesced anymore */
+            lSetUlong(event_client, EV_sent_number, lGetUlong(event_client, EV_next_number) - 1);
+
             /* don't delete sent events - deletion is triggerd by ack's */
             lXchgList(report, REP_list, &lp);
             lXchgList(event_client, EV_events, &lp);
@@ -2298,6 +2525,8 @@ sge_event_master_send_events(lListElem *report, lList *report_list, monitoring_t
       event_client = next_event_client;
    } /* while */
 
+   cull_pack_cache_free(&pack_cache);
+
    sge_mutex_unlock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
    DRETURN_VOID;
 } /* send_events() */
@@ -2447,18 +2676,27 @@ static void build_subscription(lListElem *event_el)
    for_each_ep(sub_el, subscription) {
       const lListElem *temp = nullptr;
       u_long32 event = lGetUlong(sub_el, EVS_id);
+      dstring key = DSTRING_INIT;
 
       sub_array[event].subscription = EV_SUBSCRIBED;
       sub_array[event].flush = lGetBool(sub_el, EVS_flush) ? true : false;
       sub_array[event].flush_time = lGetUlong(sub_el, EVS_interval);
+      sub_array[event].coalesce = lGetBool(sub_el, EVS_coalesce);
 
       if ((temp = lGetObject(sub_el, EVS_where))) {
          sub_array[event].where = lWhereFromElem(temp);
+         lWriteElemToStr(temp, &key);
       }
+      sge_dstring_append_char(&key, '|');
 
       if ((temp = lGetObject(sub_el, EVS_what))) {
          sub_array[event].what = lWhatFromElem(temp);
+         lWriteElemToStr(temp, &key);
       }
+
+      /* event clients with equal keys get the same event data (see event_payload_key()) */
+      sub_array[event].key = sge_strdup(nullptr, sge_dstring_get_string(&key));
+      sge_dstring_free(&key);
    }
 
    old_sub_array = (subscription_t *)lGetRef(event_el, EV_sub_array);
@@ -2467,6 +2705,7 @@ static void build_subscription(lListElem *event_el)
       for (int j = 0; j < sgeE_EVENTSIZE; j++) {
          lFreeWhere(&(old_sub_array[j].where));
          lFreeWhat(&(old_sub_array[j].what));
+         sge_free(&(old_sub_array[j].key));
          if (old_sub_array[j].descr){
             cull_hash_free_descr(old_sub_array[j].descr);
             sge_free(&(old_sub_array[j].descr));
@@ -2592,6 +2831,308 @@ static int eventclient_subscribed(const lListElem *event_client, ev_event event,
    DRETURN(0);
 }
 
+/****** evm/sge_event_master/replay_log_next_sequence() ************************
+*  NAME
+*     replay_log_next_sequence() -- get the sequence number of the next event
+*
+*  SYNOPSIS
+*     static u_long64 replay_log_next_sequence()
+*
+*  RESULT
+*     u_long64 - sequence number for an event for all event clients
+*
+*  NOTES
+*     MT-NOTE: Requires caller to hold Event_Master_Control.mutex.
+*******************************************************************************/
+static u_long64
+replay_log_next_sequence() {
+   if (Replay_Next_Sequence == 0) {
+      Replay_Next_Sequence = sge_get_gmt64();
+   }
+   return Replay_Next_Sequence++;
+}
+
+/****** evm/sge_event_master/replay_log_skip() *********************************
+*  NAME
+*     replay_log_skip() -- can an event nobody subscribed be dropped?
+*
+*  SYNOPSIS
+*     static bool replay_log_skip(ev_event type)
+*
+*  FUNCTION
+*     Events for all event clients that no event client subscribed need not
+*     be created. But event clients that register again later might have
+*     missed them. Therefore, such events are dropped only if the replay log
+*     is disabled. In this case the log is emptied and a sequence number is
+*     consumed, so that event clients cannot resume from a sequence number
+*     before the dropped event.
+*
+*  INPUTS
+*     ev_event type - the event id
+*
+*  RESULT
+*     bool - true if the event was dropped
+*
+*  NOTES
+*     MT-NOTE: replay_log_skip() is MT safe
+*
+*  SEE ALSO
+*     evm/sge_event_master/replay_events()
+*******************************************************************************/
+static bool
+replay_log_skip(ev_event type) {
+   if (Subscription_Index[type].subscribers > 0 || mconf_get_event_replay_log_size() > 0) {
+      return false;
+   }
+
+   sge_mutex_lock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
+   replay_log_next_sequence();
+   replay_log_append(nullptr, nullptr, nullptr, 0);
+   sge_mutex_unlock("event_master_mutex", __func__, __LINE__, &Event_Master_Control.mutex);
+   return true;
+}
+
+/****** evm/sge_event_master/replay_log_append() *******************************
+*  NAME
+*     replay_log_append() -- keep an event in the replay log
+*
+*  SYNOPSIS
+*     static void
+*     replay_log_append(lListElem **event, const char *session,
+*                       const lList *changed_fields, int size)
+*
+*  FUNCTION
+*     Appends an event that was delivered to all event clients to the replay
+*     log and removes the oldest events if the log contains more than "size"
+*     events. The log takes over the event. Called with size 0 the log is
+*     emptied and the event is not taken over, its sequence number is lost
+*     for the log.
+*
+*  INPUTS
+*     lListElem **event           - the event, it has to have a ET_sequence
+*     const char *session         - session of the event or nullptr
+*     const lList *changed_fields - changed attributes of a delta event
+*     int size                    - maximum number of events in the log
+*
+*  NOTES
+*     MT-NOTE: Requires caller to hold Event_Master_Control.mutex.
+*
+*  SEE ALSO
+*     evm/sge_event_master/replay_events()
+*******************************************************************************/
+static void
+replay_log_append(lListElem **event, const char *session, const lList *changed_fields, int size) {
+   if (size > 0 && event != nullptr && lGetUlong64(*event, ET_sequence) != 0) {
+      Replay_Log.push_back({*event, session != nullptr ? session : "", session != nullptr,
+                            lCopyList(nullptr, changed_fields)});
+      *event = nullptr;
+   }
+
+   while (!Replay_Log.empty() && Replay_Log.size() > static_cast<size_t>(size)) {
+      lFreeElem(&Replay_Log.front().event);
+      lFreeList(&Replay_Log.front().changed_fields);
+      Replay_Log.pop_front();
+   }
+}
+
+/****** evm/sge_event_master/replay_events() ***********************************
+*  NAME
+*     replay_events() -- deliver missed events to a registering event client
+*
+*  SYNOPSIS
+*     static bool replay_events(lListElem *event_client, u_long64 sequence)
+*
+*  FUNCTION
+*     An event client that registers again can present the sequence number
+*     (ET_sequence) of the last event it received. If all events following
+*     this event are still in the replay log, the event client gets the
+*     events it subscribed from the log.
+*
+*  INPUTS
+*     lListElem *event_client - the new registered event client
+*     u_long64 sequence       - EV_resume_sequence of the event client
+*
+*  RESULT
+*     bool - true if the events were replayed,
+*            false if the event client requires a total update
+*
+*  NOTES
+*     MT-NOTE: Requires caller to hold Event_Master_Control.mutex.
+*
+*  SEE ALSO
+*     evm/sge_event_master/replay_log_append()
+*******************************************************************************/
+static bool
+replay_events(lListElem *event_client, u_long64 sequence) {
+   u_long64 first_sequence = Replay_Next_Sequence;
+   int replayed = 0;
+
+   DENTER(TOP_LAYER);
+
+   if (!Replay_Log.empty()) {
+      first_sequence = lGetUlong64(Replay_Log.front().event, ET_sequence);
+   }
+
+   /* the missed events are not available (anymore) */
+   if (sequence == 0 || sequence >= Replay_Next_Sequence || sequence + 1 < first_sequence) {
+      DRETURN(false);
+   }
+
+   for (const auto &entry : Replay_Log) {
+      lListElem *event = entry.event;
+
+      if (lGetUlong64(event, ET_sequence) > sequence) {
+         ev_event type = (ev_event)lGetUlong(event, ET_type);
+         const char *session = entry.has_session ? entry.session.c_str() : nullptr;
+
+         if (eventclient_subscribed(event_client, type, session)) {
+            add_list_event_direct(event_client, event, true, nullptr, entry.changed_fields);
+            replayed++;
+         }
+      }
+   }
+
+   INFO(MSG_EVE_REPLAYEVENTS_SUI, lGetString(event_client, EV_name), lGetUlong(event_client, EV_id), replayed);
+   DRETURN(true);
+}
+
+/****** evm/sge_event_master/subscription_index_add() **************************
+*  NAME
+*     subscription_index_add() -- add an event client to the subscription index
+*
+*  SYNOPSIS
+*     static void subscription_index_add(lListElem *event_client)
+*
+*  FUNCTION
+*     Stores the event client in the subscription index for every event type
+*     it subscribed. Previous entries of the event client are removed,
+*     therefore the function has to be called whenever the subscription
+*     (EV_sub_array) of a registered event client changed.
+*
+*     The index allows delivering an event to the interested event clients
+*     without looking at all registered event clients.
+*
+*  INPUTS
+*     lListElem *event_client - registered event client
+*
+*  NOTES
+*     MT-NOTE: Requires caller to hold Event_Master_Control.mutex.
+*
+*  SEE ALSO
+*     evm/sge_event_master/subscription_index_get()
+*******************************************************************************/
+static void
+subscription_index_add(lListElem *event_client) {
+   const auto *subscription = (const subscription_t *)lGetRef(event_client, EV_sub_array);
+   const char *session = lGetString(event_client, EV_session);
+
+   subscription_index_remove(event_client);
+
+   if (subscription == nullptr) {
+      return;
+   }
+
+   for (int i = 0; i < sgeE_EVENTSIZE; i++) {
+      if (subscription[i].subscription == EV_SUBSCRIBED) {
+         if (session != nullptr) {
+            Subscription_Index[i].session_clients[session].push_back(event_client);
+         } else {
+            Subscription_Index[i].clients.push_back(event_client);
+         }
+         Subscription_Index[i].subscribers++;
+      }
+   }
+}
+
+static void
+remove_from_index(std::vector<lListElem *> &clients, const lListElem *event_client, std::atomic<int> &subscribers) {
+   for (auto it = clients.begin(); it != clients.end(); ++it) {
+      if (*it == event_client) {
+         clients.erase(it);
+         subscribers--;
+         return;
+      }
+   }
+}
+
+/****** evm/sge_event_master/subscription_index_remove() ***********************
+*  NAME
+*     subscription_index_remove() -- remove an event client from the index
+*
+*  SYNOPSIS
+*     static void subscription_index_remove(const lListElem *event_client)
+*
+*  FUNCTION
+*     Removes all entries of the event client from the subscription index.
+*     Has to be called before the event client is freed.
+*
+*  INPUTS
+*     const lListElem *event_client - registered event client
+*
+*  NOTES
+*     MT-NOTE: Requires caller to hold Event_Master_Control.mutex.
+*******************************************************************************/
+static void
+subscription_index_remove(const lListElem *event_client) {
+   for (int i = 0; i < sgeE_EVENTSIZE; i++) {
+      subscription_index_t &index = Subscription_Index[i];
+
+      remove_from_index(index.clients, event_client, index.subscribers);
+      for (auto it = index.session_clients.begin(); it != index.session_clients.end();) {
+         remove_from_index(it->second, event_client, index.subscribers);
+         if (it->second.empty()) {
+            it = index.session_clients.erase(it);
+         } else {
+            ++it;
+         }
+      }
+   }
+}
+
+/****** evm/sge_event_master/subscription_index_get() **************************
+*  NAME
+*     subscription_index_get() -- event clients which might receive an event
+*
+*  SYNOPSIS
+*     static void
+*     subscription_index_get(ev_event type, const char *session,
+*                            std::vector<lListElem *> &clients)
+*
+*  FUNCTION
+*     Returns the event clients which subscribed the event type and whose
+*     session filter does not exclude the event session. The caller still
+*     has to check eventclient_subscribed() as events can be blocked
+*     temporarily for an event client (e.g. during a total update).
+*
+*  INPUTS
+*     ev_event type                     - event type
+*     const char *session               - session of the event or nullptr
+*     std::vector<lListElem *> &clients - returns the event clients
+*
+*  NOTES
+*     MT-NOTE: Requires caller to hold Event_Master_Control.mutex.
+*
+*  SEE ALSO
+*     Eventclient/Server/eventclient_subscribed()
+*******************************************************************************/
+static void
+subscription_index_get(ev_event type, const char *session, std::vector<lListElem *> &clients) {
+   const subscription_index_t &index = Subscription_Index[type];
+
+   clients.assign(index.clients.begin(), index.clients.end());
+   if (session != nullptr) {
+      auto it = index.session_clients.find(session);
+      if (it != index.session_clients.end()) {
+         clients.insert(clients.end(), it->second.begin(), it->second.end());
+      }
+   } else if (IS_TOTAL_UPDATE_EVENT(type)) {
+      /* list events are delivered to event clients of all sessions */
+      for (const auto &session_clients : index.session_clients) {
+         clients.insert(clients.end(), session_clients.second.begin(), session_clients.second.end());
+      }
+   }
+}
+
 /****** evm/sge_event_master/purge_event_list() ********************************
 *  NAME
 *     purge_event_list() -- purge event list
@@ -2650,8 +3191,354 @@ static int purge_event_list(lList *event_list, u_long32 event_number)
    DRETURN(purged);
 } /* remove_events_from_client() */
 
+/* undelivered events of one object (see coalesce_events()) */
+typedef struct {
+   lListElem *add;                  /* add event or nullptr                  */
+   lListElem *mod;                  /* most recent modify event or nullptr   */
+   std::vector<lListElem *> events; /* all events of the object              */
+   bool blocked;                    /* another event refers to the object    */
+   bool interleaved;                /* dto. since the most recent modify     */
+   bool closed;                     /* the object has been deleted           */
+} event_chain_t;
+
+static int
+event_family(ev_event type) {
+   for (int i = 0; i < (int)(sizeof(EVENT_FAMILIES) / sizeof(EVENT_FAMILIES[0])); i++) {
+      if (EVENT_FAMILIES[i].add == type || EVENT_FAMILIES[i].del == type || EVENT_FAMILIES[i].mod == type) {
+         return i;
+      }
+   }
+   return -1;
+}
+
+/* does the data of event "later" contain all attributes of event "earlier"? */
+static bool
+event_data_covers(const lListElem *later, const lListElem *earlier) {
+   const lList *earlier_data = lGetList(earlier, ET_new_version);
+   const lList *later_data = lGetList(later, ET_new_version);
+
+   if (earlier_data == nullptr) {
+      return true;
+   }
+   if (later_data == nullptr) {
+      return false;
+   }
+
+   const lDescr *later_descr = lGetListDescr(later_data);
+   for (const lDescr *descr = lGetListDescr(earlier_data); descr->nm != NoName; descr++) {
+      if (lGetPosInDescr(later_descr, descr->nm) < 0) {
+         return false;
+      }
+   }
+   return true;
+}
+
+/****** evm/sge_event_master/coalesce_events() *********************************
+*  NAME
+*     coalesce_events() -- coalesce undelivered events of an event client
+*
+*  SYNOPSIS
+*     static void coalesce_events(lListElem *event_client)
+*
+*  FUNCTION
+*     Only events that have not been sent to the event client yet
+*     (ET_number > EV_sent_number) are looked at.
+*
+*     A modify event of an event type the client subscribed with
+*     coalescing replaces an earlier modify event of the same object if
+*     it contains at least the same attributes and no other event referring
+*     to the object (e.g. a task of a job) was generated in between. The
+*     earlier event is removed, the most recent state is delivered at the
+*     position of the most recent modification.
+*
+*     If an object was added and deleted again, and coalescing is enabled
+*     for both events, then the add, modify and delete events of the object
+*     are removed unless another undelivered event refers to the object
+*     (same intkey or strkey).
+*
+*     The remaining events are renumbered, so the numbers stay consecutive.
+*
+*  INPUTS
+*     lListElem *event_client - the event client
+*
+*  NOTES
+*     MT-NOTE: Requires caller to hold Event_Master_Control.mutex.
+*******************************************************************************/
+static void
+coalesce_events(lListElem *event_client) {
+   const auto *subscription = (const subscription_t *)lGetRef(event_client, EV_sub_array);
+   lList *event_list = lGetListRW(event_client, EV_events);
+   u_long32 sent_number = lGetUlong(event_client, EV_sent_number);
+   std::deque<event_chain_t> chains;
+   std::unordered_map<std::string, event_chain_t *> chain_by_key;
+   std::unordered_map<u_long32, std::vector<event_chain_t *>> chain_by_intkey;
+   std::unordered_map<std::string, std::vector<event_chain_t *>> chain_by_strkey;
+   std::unordered_set<const lListElem *> dropped;
+   lListElem *first = nullptr;
+   lListElem *event;
+
+   DENTER(TOP_LAYER);
+
+   if (subscription == nullptr || event_list == nullptr) {
+      DRETURN_VOID;
+   }
+
+   for_each_rw(event, event_list) {
+      if (lGetUlong(event, ET_number) > sent_number) {
+         first = event;
+         break;
+      }
+   }
+
+   for (event = first; event != nullptr; event = lNextRW(event)) {
+      auto type = (ev_event)lGetUlong(event, ET_type);
+      u_long32 intkey = lGetUlong(event, ET_intkey);
+      const char *strkey = lGetString(event, ET_strkey);
+      const char *strkey2 = lGetString(event, ET_strkey2);
+      int family = event_family(type);
+      std::string key = std::to_string(family) + '\n' + std::to_string(intkey) + '\n' +
+                        std::to_string(lGetUlong(event, ET_intkey2)) + '\n' +
+                        (strkey != nullptr ? strkey : "") + '\n' + (strkey2 != nullptr ? strkey2 : "");
+
+      auto own = chain_by_key.find(key);
+      event_chain_t *own_chain = own != chain_by_key.end() ? own->second : nullptr;
+
+      /* objects another event refers to cannot be dropped */
+      if (intkey != 0) {
+         auto it = chain_by_intkey.find(intkey);
+         if (it != chain_by_intkey.end()) {
+            for (auto *chain : it->second) {
+               if (own_chain != chain) {
+                  chain->blocked = true;
+                  chain->interleaved = true;
+               }
+            }
+         }
+      }
+      if (strkey != nullptr) {
+         auto it = chain_by_strkey.find(strkey);
+         if (it != chain_by_strkey.end()) {
+            for (auto *chain : it->second) {
+               if (own_chain != chain) {
+                  chain->blocked = true;
+                  chain->interleaved = true;
+               }
+            }
+         }
+      }
+
+      if (family < 0 || !subscription[type].coalesce || lGetNumberOfElem(lGetList(event, ET_new_version)) > 1) {
+         continue;
+      }
+
+      event_chain_t *chain = own_chain;
+      if (type == EVENT_FAMILIES[family].add || chain == nullptr || chain->closed) {
+         chains.push_back({nullptr, nullptr, {}, false, false, false});
+         chain = &chains.back();
+         chain_by_key[key] = chain;
+         if (intkey != 0) {
+            chain_by_intkey[intkey].push_back(chain);
+         }
+         if (strkey != nullptr) {
+            chain_by_strkey[strkey].push_back(chain);
+         }
+      }
+
+      if (type == EVENT_FAMILIES[family].add) {
+         chain->add = event;
+         chain->events.push_back(event);
+      } else if (type == EVENT_FAMILIES[family].mod) {
+         if (chain->mod != nullptr && !chain->interleaved && event_data_covers(event, chain->mod)) {
+            dropped.insert(chain->mod);
+         }
+         chain->mod = event;
+         chain->interleaved = false;
+         chain->events.push_back(event);
+      } else {
+         /* the client never saw the object */
+         if (chain->add != nullptr && !chain->blocked) {
+            dropped.insert(chain->events.begin(), chain->events.end());
+            dropped.insert(event);
+         }
+         chain->closed = true;
+      }
+   }
+
+   if (!dropped.empty()) {
+      /* the first undelivered event might have been dropped */
+      u_long32 number = lGetUlong(first, ET_number);
+      event = first;
+      while (event != nullptr) {
+         lListElem *next = lNextRW(event);
+
+         if (dropped.count(event) > 0) {
+            lRemoveElem(event_list, &event);
+         } else {
+            lSetUlong(event, ET_number, number++);
+         }
+         event = next;
+      }
+      DPRINTF("coalesced %d events of event client " sge_u32 "\n", (int)dropped.size(), lGetUlong(event_client, EV_id));
+      lSetUlong(event_client, EV_next_number, number);
+   }
+
+   DRETURN_VOID;
+}
+
+/****** Eventclient/Server/event_payload_key() *********************************
+*  NAME
+*     event_payload_key() -- key of the event data for an event client
+*
+*  SYNOPSIS
+*     static void
+*     event_payload_key(const subscription_t *subscription, int type,
+*                       bool internal_client, std::string &key)
+*
+*  FUNCTION
+*     Builds a key from all filters that are applied to the data of an event
+*     of the given type. Event clients with the same key receive the same
+*     event data, so it has to be built only once (see add_list_event_direct()).
+*
+*  INPUTS
+*     const subscription_t *subscription - subscription array of the client
+*     int type                           - event type
+*     bool internal_client               - is it an internal event client?
+*     std::string &key                   - the key is returned here
+*
+*  NOTES
+*     MT-NOTE: event_payload_key() is MT safe
+*******************************************************************************/
+static void
+event_payload_key(const subscription_t *subscription, int type, bool internal_client, std::string &key) {
+   key = internal_client ? "I" : "E";
+   if (subscription[type].key != nullptr) {
+      key += subscription[type].key;
+   }
+
+   /* filters of sub-lists (see list_select()) */
+   for (int entry_counter = 0; entry_counter < LIST_MAX; entry_counter++) {
+      for (int event_counter = 0; EVENT_LIST[entry_counter][event_counter] != -1; event_counter++) {
+         if (type == EVENT_LIST[entry_counter][event_counter]) {
+            for (int i = 0; SOURCE_LIST[entry_counter][i] != -1; i++) {
+               const char *sub_key = subscription[SOURCE_LIST[entry_counter][i]].key;
+
+               key += '#';
+               if (sub_key != nullptr) {
+                  key += sub_key;
+               }
+            }
+            return;
+         }
+      }
+   }
+}
+
+/****** Eventclient/Server/event_delta_what() **********************************
+*  NAME
+*     event_delta_what() -- enumeration of the changed attributes of an event
+*
+*  SYNOPSIS
+*     static lEnumeration *
+*     event_delta_what(const lDescr *descr, const lEnumeration *fields,
+*                      const lList *changed_fields)
+*
+*  FUNCTION
+*     Returns an enumeration of the primary key and the changed attributes
+*     of a modify event. Attributes the event client did not subscribe are
+*     left out.
+*
+*     nullptr is returned if the delta would not be smaller than the
+*     subscribed data or if a changed list is reduced by a sub enumeration
+*     of the subscription. Then the event client gets the complete object.
+*
+*  INPUTS
+*     const lDescr *descr         - descriptor of the event data
+*     const lEnumeration *fields  - what filter of the subscription or nullptr
+*     const lList *changed_fields - changed attributes (ULNG_Type)
+*
+*  RESULT
+*     lEnumeration * - enumeration to be freed by the caller or nullptr
+*
+*  NOTES
+*     MT-NOTE: event_delta_what() is MT safe
+*******************************************************************************/
+static lEnumeration *
+event_delta_what(const lDescr *descr, const lEnumeration *fields, const lList *changed_fields) {
+   int max_fields = lCountDescr(descr);
+   std::vector<int> nm_list;
+   const lListElem *changed;
+
+   nm_list.reserve(max_fields + 1);
+   for (int i = 0; descr[i].nm != NoName; i++) {
+      if (descr[i].mt & CULL_PRIMARY_KEY) {
+         nm_list.push_back(descr[i].nm);
+      }
+   }
+   for_each_ep(changed, changed_fields) {
+      int nm = (int)lGetUlong(changed, ULNG_value);
+      int pos = lGetPosInDescr(descr, nm);
+      bool has_sub_what = false;
+
+      if (pos < 0 || (descr[pos].mt & CULL_PRIMARY_KEY)) {
+         continue;
+      }
+      if (fields != nullptr) {
+         if (!lWhatContains(fields, nm, &has_sub_what)) {
+            continue;
+         }
+         if (has_sub_what) {
+            return nullptr;
+         }
+      }
+      nm_list.push_back(nm);
+   }
+   if ((int)nm_list.size() >= (fields != nullptr ? lCountWhat(fields, descr) : max_fields)) {
+      return nullptr;
+   }
+   nm_list.push_back(NoName);
+
+   return lIntVector2What(descr, nm_list.data());
+}
+
+/****** Eventclient/Server/add_list_event_direct() *****************************
+*  NAME
+*     add_list_event_direct() -- add an event to the event list of a client
+*
+*  SYNOPSIS
+*     static void
+*     add_list_event_direct(lListElem *event_client, lListElem *event,
+*                           bool copy_event,
+*                           event_payload_cache_t *payload_cache,
+*                           const lList *changed_fields)
+*
+*  FUNCTION
+*     Reduces the event data according to the subscription of the event
+*     client and appends the event to the events of the client.
+*
+*     Internal event clients only get the primary key and the changed
+*     attributes of modify events if "changed_fields" is given (see
+*     sge_add_delta_event()).
+*
+*     If "payload_cache" is given then event data that has already been
+*     built for another event client with equal filters is referenced
+*     instead of building it again. Newly built event data is added to the
+*     cache. The caller has to free the lists in the cache.
+*
+*  INPUTS
+*     lListElem *event_client              - the event client
+*     lListElem *event                     - the event (ET_Type)
+*     bool copy_event                      - copy the event or take it over
+*     event_payload_cache_t *payload_cache - event data of other clients
+*                                            or nullptr
+*     const lList *changed_fields          - changed attributes (ULNG_Type)
+*                                            or nullptr
+*
+*  NOTES
+*     MT-NOTE: Requires caller to hold Event_Master_Control.mutex.
+*******************************************************************************/
 static void add_list_event_direct(lListElem *event_client, lListElem *event,
-                                  bool copy_event)
+                                  bool copy_event, event_payload_cache_t *payload_cache,
+                                  const lList *changed_fields)
 {
    lList *lp = nullptr;
    lList *clp = nullptr;
@@ -2696,29 +3583,64 @@ static void add_list_event_direct(lListElem *event_client, lListElem *event,
     * did do this part with a nullptr list, the check for a clp with no
     * elements would kick us out. */
    if (lp != nullptr) {
+      std::string key;
+      bool is_cached = false;
+      lEnumeration *delta_what = nullptr;
+
       subscription = (subscription_t *)lGetRef(event_client, EV_sub_array);
       selection = subscription[type].where;
       fields = subscription[type].what;
 
+      /* internal event clients merge the changed attributes into their copy of the object */
+      if (internal_client && changed_fields != nullptr) {
+         delta_what = event_delta_what(lGetListDescr(lp), fields, changed_fields);
+      }
+
+      /* reuse the event data that was built for another client with the same filters */
+      if (payload_cache != nullptr) {
+         event_payload_key(subscription, type, internal_client, key);
+         if (delta_what != nullptr) {
+            key[0] = 'D';
+         }
+
+         auto payload = payload_cache->find(key);
+         if (payload != payload_cache->end()) {
+            clp = lShareList(payload->second);
+            is_cached = true;
+         }
+      }
+
 #if 0
       DPRINTF("deliver event: %d with where filter=%s and what filter=%s\n",
               type, selection?"true":"false", fields?"true":"false");
 #endif
 
-      if (fields) {
-         descr = getDescriptorL(subscription, lp, type);
+      if (fields || delta_what != nullptr) {
+         if (!is_cached) {
+            if (delta_what != nullptr) {
+               /* the where filter is applied to the complete object */
+               clp = lSelectHashPack("updating list", lp, selection, delta_what, internal_client, nullptr);
+            } else {
+               descr = getDescriptorL(subscription, lp, type);
 
 #if 0
-         DPRINTF("Reducing event data\n");
+               DPRINTF("Reducing event data\n");
 #endif
 
-         if (!list_select(subscription, type, &clp, lp, selection, fields,
-                          descr, internal_client)) {
-            clp = lSelectDPack("updating list", lp, selection, descr, fields, internal_client, nullptr);
+               if (!list_select(subscription, type, &clp, lp, selection, fields,
+                                descr, internal_client)) {
+                  clp = lSelectDPack("updating list", lp, selection, descr, fields, internal_client, nullptr);
+               }
+            }
          }
+         lFreeWhat(&delta_what);
 
          /* no elements in the event list, no need for an event */
          if (!SEND_EVENTS[type] && lGetNumberOfElem(clp) == 0) {
+            if (payload_cache != nullptr && !is_cached) {
+               (*payload_cache)[key] = clp;
+               clp = nullptr;
+            }
             if (clp != nullptr) {
                lFreeList(&clp);
             }
@@ -2745,7 +3667,9 @@ static void add_list_event_direct(lListElem *event_client, lListElem *event,
 #if 0
          DPRINTF("Copying event data\n");
 #endif
-         clp = lCopyListHash(lGetListName(lp), lp, internal_client);
+         if (!is_cached) {
+            clp = lCopyListHash(lGetListName(lp), lp, internal_client);
+         }
       } else {
          /* If there's no what clause, and we don't want to copy, we just reuse
           * the original list. */
@@ -2756,6 +3680,12 @@ static void add_list_event_direct(lListElem *event_client, lListElem *event,
          /* Make sure lp is clear for the next part. */
          lp = nullptr;
       }
+
+      /* the cache keeps a reference, the event of this client the other one */
+      if (payload_cache != nullptr && !is_cached) {
+         lMarkListShared(clp);
+         (*payload_cache)[key] = lShareList(clp);
+      }
    } /* if */
 
    /* If we're making a copy, copy the event and swap the orignial list
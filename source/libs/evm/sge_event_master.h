@@ -126,7 +126,19 @@ bool sge_add_event_for_client(u_long32 event_client_id,
                               const char *strkey2,
                               const char *session,
                               lListElem *element,
-                              u_long64 gdi_session);
+                              u_long64 gdi_session,
+                              const int changed_fields[] = nullptr);
+
+bool sge_add_delta_event(u_long64 timestamp,
+                         ev_event type,
+                         u_long32 intkey,
+                         u_long32 intkey2,
+                         const char *strkey,
+                         const char *strkey2,
+                         const char *session,
+                         lListElem *element,
+                         const int changed_fields[],
+                         u_long64 gdi_session);
                                     
 bool sge_add_list_event(u_long64 timestamp,
                         ev_event type, 
@@ -49,6 +49,15 @@ qinstance_add_event(lListElem *this_elem, ev_event type, u_long64 gdi_session)
    DRETURN_VOID;
 }
 
+void
+qinstance_add_delta_event(lListElem *this_elem, ev_event type, const int changed_fields[], u_long64 gdi_session)
+{
+   DENTER(TOP_LAYER);
+   sge_add_delta_event(0, type, 0, 0, lGetString(this_elem, QU_qname), lGetHost(this_elem, QU_qhostname), nullptr,
+                       this_elem, changed_fields, gdi_session);
+   DRETURN_VOID;
+}
+
 void
 cqueue_add_event(lListElem *this_elem, ev_event type, u_long64 gdi_session)
 {
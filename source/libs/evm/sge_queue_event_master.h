@@ -38,5 +38,8 @@
 void
 qinstance_add_event(lListElem *this_elem, ev_event type, u_long64 gdi_session);
 
+void
+qinstance_add_delta_event(lListElem *this_elem, ev_event type, const int changed_fields[], u_long64 gdi_session);
+
 void
 cqueue_add_event(lListElem *this_elem, ev_event type, u_long64 gdi_session);
@@ -179,7 +179,8 @@ int ocs::gdi::ClientExecd::gdi_get_merged_configuration(lList **conf_list) {
 *  SYNOPSIS
 *     int report_list_send(const lList *rlp, const char *rhost,
 *                          const char *commproc, int id,
-*                          int synchron, u_long32 *mid)
+*                          int synchron, cull_pack_cache_t *pack_cache,
+*                          bool compact)
 *
 *  FUNCTION
 *     Send a list of reports.
@@ -190,6 +191,10 @@ int ocs::gdi::ClientExecd::gdi_get_merged_configuration(lList **conf_list) {
 *     const char *commproc - Component name
 *     int id               - Component id
 *     int synchron         - true or false
+*     cull_pack_cache_t *pack_cache - packed shared lists or nullptr
+*                                     (see cull_pack_cache_create())
+*     bool compact         - use the compact pack format, the receiver
+*                            has to be of the same version
 *
 *  RESULT
 *     int - error state
@@ -202,7 +207,8 @@ int ocs::gdi::ClientExecd::gdi_get_merged_configuration(lList **conf_list) {
 *  NOTES
 *     MT-NOTE: report_list_send() is not MT safe (assumptions)
 *******************************************************************************/
-int ocs::gdi::ClientExecd::report_list_send(const lList *rlp, const char *rhost, const char *commproc, int id, int synchron) {
+int ocs::gdi::ClientExecd::report_list_send(const lList *rlp, const char *rhost, const char *commproc, int id, int synchron,
+                                            cull_pack_cache_t *pack_cache, bool compact) {
    sge_pack_buffer pb;
    int ret;
    lList *alp = nullptr;
@@ -210,7 +216,8 @@ int ocs::gdi::ClientExecd::report_list_send(const lList *rlp, const char *rhost,
    DENTER(TOP_LAYER);
 
    /* prepare packing buffer */
-   if ((ret = init_packbuffer(&pb, 1024)) == PACK_SUCCESS) {
+   if ((ret = init_packbuffer(&pb, 1024, false, true, compact)) == PACK_SUCCESS) {
+      pb.pack_cache = pack_cache;
       ret = cull_pack_list(&pb, rlp);
    }
 
@@ -44,6 +44,7 @@ namespace ocs::gdi {
 
       static int gdi_wait_for_conf(lList **conf_list);
 
-      static int report_list_send(const lList *rlp, const char *rhost, const char *commproc, int id, int synchron);
+      static int report_list_send(const lList *rlp, const char *rhost, const char *commproc, int id, int synchron,
+                                  cull_pack_cache_t *pack_cache = nullptr, bool compact = false);
    };
 }
\ No newline at end of file
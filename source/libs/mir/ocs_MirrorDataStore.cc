@@ -30,6 +30,7 @@
 #include "uti/sge_log.h"
 
 #include "sgeobj/sge_conf.h"
+#include "sgeobj/sge_job.h"
 
 #include "mir/sge_mirror.h"
 
@@ -41,14 +42,20 @@
  *
  * @param data_store_id Data store that will be filled with data.
  * @param lock_type Lock that should be used to secure the data store
+ * @param use_versions If true then the data store is kept in multiple versions. Readers pin the published
+ *                     version (DataStore::pin_version()) instead of using the lock and are not blocked
+ *                     while events are applied.
  */
-ocs::MirrorDataStore::MirrorDataStore(const DataStore::Id data_store_id, const sge_locktype_t lock_type) :
+ocs::MirrorDataStore::MirrorDataStore(const DataStore::Id data_store_id, const sge_locktype_t lock_type, const bool use_versions) :
         cond_var(PTHREAD_COND_INITIALIZER),
         triggered(false),
         new_events(nullptr),
         lock_type(lock_type),
         did_handle_initial_events(false),
         do_try_lock(false),
+        use_versions(use_versions),
+        replay_events(nullptr),
+        copy_version(false),
         mutex(PTHREAD_MUTEX_INITIALIZER),
         mutex_name("event_mirror_control_mutex"),
         data_store_id(data_store_id) {
@@ -59,6 +66,7 @@ ocs::MirrorDataStore::~MirrorDataStore() {
    pthread_mutex_destroy(&mutex);
    pthread_cond_destroy(&cond_var);
    lFreeList(&new_events);
+   lFreeList(&replay_events);
 }
 
 /**
@@ -211,10 +219,18 @@ ocs::MirrorDataStore::wait_for_event(lList **event_list) {
  *
  * Depending on the `do_try_lock` flag the lock will be tried to get without waiting or a regular lock will be requested.
  *
+ * If the data store is versioned then no lock is acquired. Instead, the unpublished version is selected. This
+ * only waits for readers that still use this version since it was published the last but one time.
+ *
  * @return true if lock was successful, false if not
  */
 bool
 ocs::MirrorDataStore::lock() {
+   if (use_versions) {
+      DataStore::select_unused_version();
+      return true;
+   }
+
    // acquire lock. first try to get the lock. Only if we have to wait to long we will enforce to get the lock
    if (do_try_lock) {
       return SGE_TRY_LOCK(lock_type, LOCK_WRITE);
@@ -225,13 +241,120 @@ ocs::MirrorDataStore::lock() {
 }
 
 /** @brief Unlock the data store.
- * @return
+ *
+ * If the data store is versioned then the modified version is published so that it is used by new readers.
  */
 void
 ocs::MirrorDataStore::unlock() {
+   if (use_versions) {
+      DataStore::publish_version();
+      return;
+   }
    SGE_UNLOCK(lock_type, LOCK_WRITE);
 }
 
+/**
+ * Returns true if the event replaces a whole master list (e.g. the initial events after registration).
+ *
+ * @param type event type (ET_type)
+ * @return true for total updates
+ */
+static bool
+is_total_update(u_long32 type) {
+   switch (type) {
+      case sgeE_ADMINHOST_LIST:
+      case sgeE_CALENDAR_LIST:
+      case sgeE_CKPT_LIST:
+      case sgeE_CENTRY_LIST:
+      case sgeE_CONFIG_LIST:
+      case sgeE_EXECHOST_LIST:
+      case sgeE_JOB_LIST:
+      case sgeE_JOB_SCHEDD_INFO_LIST:
+      case sgeE_MANAGER_LIST:
+      case sgeE_OPERATOR_LIST:
+      case sgeE_NEW_SHARETREE:
+      case sgeE_PE_LIST:
+      case sgeE_PROJECT_LIST:
+      case sgeE_CQUEUE_LIST:
+      case sgeE_SUBMITHOST_LIST:
+      case sgeE_USER_LIST:
+      case sgeE_USERSET_LIST:
+      case sgeE_HGROUP_LIST:
+      case sgeE_RQS_LIST:
+      case sgeE_AR_LIST:
+      case sgeE_CATEGORY_LIST:
+         return true;
+      default:
+         return false;
+   }
+}
+
+/** @brief Apply events to the data store.
+ *
+ * For versioned data stores the selected version did not see the events of the previous call. If they
+ * were incremental (add, modify, delete) then a copy of them is replayed first. If they contained a
+ * total update then the selected version is replaced by a copy of the published version instead
+ * (see DataStore::copy_published_version()) and no copy of the events is kept. Trigger events
+ * (shutdown, re-registration, ...) are not replayed.
+ *
+ * The versioned data store needs twice the memory of a single data store. Only the immutable job sublists
+ * (see job_mark_immutable_sublists_shared()) are shared between both versions. The copy of the
+ * incremental events exists for one call.
+ *
+ * @param event_list list of events
+ * @return result of sge_mirror_process_event_list()
+ */
+sge_mirror_error
+ocs::MirrorDataStore::process_events(lList *event_list) {
+   DENTER(TOP_LAYER);
+
+   if (use_versions) {
+      if (copy_version) {
+         DataStore::copy_published_version();
+         copy_version = false;
+      } else if (replay_events != nullptr) {
+         sge_mirror_error replay_ret = sge_mirror_process_event_list(evc, replay_events);
+         lFreeList(&replay_events);
+         if (replay_ret != SGE_EM_OK) {
+            DRETURN(replay_ret);
+         }
+      }
+
+      // the replayed copy of the events and both versions of the data store share the big job sublists
+      const lListElem *job_event;
+      for_each_ep(job_event, event_list) {
+         u_long32 type = lGetUlong(job_event, ET_type);
+
+         if (is_total_update(type)) {
+            copy_version = true;
+         }
+         if (type == sgeE_JOB_LIST || type == sgeE_JOB_ADD || type == sgeE_JOB_MOD) {
+            lListElem *job;
+            for_each_rw(job, lGetList(job_event, ET_new_version)) {
+               job_mark_immutable_sublists_shared(job);
+            }
+         }
+      }
+
+      if (!copy_version) {
+         replay_events = lCopyList(nullptr, event_list);
+         lListElem *event = lFirstRW(replay_events);
+         while (event != nullptr) {
+            lListElem *next = lNextRW(event);
+            u_long32 type = lGetUlong(event, ET_type);
+
+            if (type == sgeE_SHUTDOWN || type == sgeE_QMASTER_GOES_DOWN || type == sgeE_ACK_TIMEOUT ||
+                type == sgeE_SCHEDDMONITOR) {
+               lRemoveElem(replay_events, &event);
+            }
+            event = next;
+         }
+      }
+   }
+
+   DRETURN(sge_mirror_process_event_list(evc, event_list));
+}
+
 /**
  * Mirror threads main routine.
  *
@@ -253,6 +376,9 @@ ocs::MirrorDataStore::unlock() {
  * As soon as the thread gets the lock it will process the events to update the data store and notify the event
  * master about the processed events.
  *
+ * Versioned data stores are not locked. The events are applied to the version that is not used by readers
+ * and this version is published afterward (see MirrorDataStore::lock() and MirrorDataStore::unlock()).
+ *
  * After that it will pass the cancellation point and restart in the main loop.
  *
  * @param arg The usual void* argument of pthreads.
@@ -379,14 +505,15 @@ ocs::MirrorDataStore::main([[maybe_unused]] void *arg) {
                // find the biggest unique ID of the events that we have to process
                bool found_last_event = false;
                const lListElem *last_event = lLast(event_list);
-               u_long64 last_unique_id;
+               u_long64 last_unique_id = 0;
                if (last_event != nullptr) {
                   last_unique_id = lGetUlong64(last_event, ET_unique_id);
                   found_last_event = true;
                }
 
                // process the events
-               sge_mirror_error mirror_ret = sge_mirror_process_event_list(evc, event_list);
+               sge_mirror_error mirror_ret = process_events(event_list);
+               bool do_update_sessions = false;
                if (mirror_ret == SGE_EM_OK) {
                   // the first handling of non-empty event_list (== the initial list events)
                   // will cause the data store to be ready for other threads (listener, reader, scheduler, ...)
@@ -396,10 +523,7 @@ ocs::MirrorDataStore::main([[maybe_unused]] void *arg) {
 
                   did_handle_events = true;
 
-                  // update the sessions about the last event that we processed so that waiting requests can continue
-                  if (found_last_event) {
-                     update_sessions_and_move_requests(last_unique_id);
-                  }
+                  do_update_sessions = found_last_event;
                } else {
                   DPRINTF("error during event processing\n");
                }
@@ -407,6 +531,12 @@ ocs::MirrorDataStore::main([[maybe_unused]] void *arg) {
 
                // Unlock the data store
                unlock();
+
+               // update the sessions about the last event that we processed so that waiting requests can continue.
+               // this has to be done after unlock because a new version of the data store gets visible only then
+               if (do_update_sessions) {
+                  update_sessions_and_move_requests(last_unique_id);
+               }
             } else {
                // we did not get the lock. wait a short time before retry. if the max wait time is consumed
                // then continue with a hard lock instead of a try lock
@@ -28,6 +28,7 @@
 
 #include "basis_types.h"
 #include "evc/sge_event_client.h"
+#include "mir/sge_mirror.h"
 
 #include "ocs_thread_mirror.h"
 
@@ -40,6 +41,9 @@ namespace ocs {
       sge_locktype_t lock_type;                    ///< lock type used to secure the DS
       volatile bool did_handle_initial_events;     ///< true if the initial events have been handled and other threads can access the DS
       bool do_try_lock;                            ///< true if we should try to get the lock without waiting
+      const bool use_versions;                     ///< true if readers pin published versions of the DS instead of using the lock
+      lList *replay_events;                        ///< events not yet applied to the unpublished version of the DS
+      bool copy_version;                           ///< true if the unpublished version has to be copied from the published one
 
    protected:
       pthread_mutex_t mutex;                       ///< used to secure other attributes within this object
@@ -49,7 +53,7 @@ namespace ocs {
       sge_evc_class_t *evc = nullptr;              ///< event client that is used to subscribe to events
 
    public:
-      explicit MirrorDataStore(ocs::DataStore::Id data_store_id, sge_locktype_t lock_type);
+      explicit MirrorDataStore(ocs::DataStore::Id data_store_id, sge_locktype_t lock_type, bool use_versions = false);
       virtual ~MirrorDataStore();
 
       virtual void wait_for_event(lList **event_list);
@@ -63,6 +67,7 @@ namespace ocs {
       virtual void update_sessions_and_move_requests(u_long64 unique_id) = 0;
       virtual bool lock();
       virtual void unlock();
+      sge_mirror_error process_events(lList *event_list);
 
       static void event_mirror_update_func([[maybe_unused]] u_long32 ec_id, [[maybe_unused]] lList **answer_list, lList *event_list, void *arg);
 
@@ -36,6 +36,7 @@
 #include "uti/sge_rmon_macros.h"
 
 #include "sgeobj/sge_job.h"
+#include "sgeobj/sge_object.h"
 #include "sgeobj/ocs_DataStore.h"
 
 #include "mir/msg_mirlib.h"
@@ -191,7 +192,9 @@ job_update_master_list(sge_evc_class_t *evc, sge_object_type type,
           lListElem *modified_job;
 
           modified_job = lFirstRW(lGetList(event, ET_new_version));
-          if(job != nullptr && modified_job != nullptr) {
+          /* a job containing only the changed attributes is merged into the existing job (see
+           * sge_mirror_update_master_list()), ja_tasks, JB_host and JB_category are kept anyway */
+          if(job != nullptr && modified_job != nullptr && !object_is_delta(job, modified_job)) {
             /* we want to preserve the old ja_tasks, since job update events to not contain them */
             lXchgList(job, JB_ja_tasks, &ja_tasks);
             lSetHost(modified_job, JB_host, lGetHost(job, JB_host));
@@ -45,6 +45,7 @@
 #include "cull/cull_list.h"
 
 #include "sgeobj/sge_event.h"
+#include "sgeobj/sge_object.h"
 #include "sgeobj/sge_schedd_conf.h"
 #include "sgeobj/ocs_DataStore.h"
 
@@ -1691,7 +1692,8 @@ sge_mirror_error sge_mirror_update_master_list_host_key(lList **list, const lDes
 *     The following actions are performed (depending on parameter action):
 *     - SGE_EMA_LIST: an existing mirrored list is completely replaced
 *     - SGE_EMA_ADD:  a new element is added to the mirrored list
-*     - SGE_EMA_MOD:  a given element is modified
+*     - SGE_EMA_MOD:  a given element is modified, an element that only
+*                     contains the changed attributes is merged into it
 *     - SGE_EMA_DEL:  a given element is deleted
 *
 *  INPUTS
@@ -1755,9 +1757,17 @@ sge_mirror_update_master_list(lList **list, const lDescr *list_descr, lListElem
             ERROR("element " SFQ " does not exist\n", (key != nullptr) ?key:"nullptr");
             DRETURN(SGE_EM_KEY_NOT_FOUND);
          }
-         lRemoveElem(*list, &ep);
          data_list = lGetListRW(event, ET_new_version);
-         lAppendElem(*list, lDechainElem(data_list, lFirstRW(data_list)));
+         if (object_is_delta(ep, lFirst(data_list))) {
+            /* the event only contains the changed attributes */
+            if (!object_apply_delta(ep, lFirstRW(data_list))) {
+               ERROR("cannot apply modification of element " SFQ "\n", (key != nullptr) ?key:"nullptr");
+               DRETURN(SGE_EM_BAD_ARG);
+            }
+         } else {
+            lRemoveElem(*list, &ep);
+            lAppendElem(*list, lDechainElem(data_list, lFirstRW(data_list)));
+         }
          break;
       default:
          DRETURN(SGE_EM_BAD_ARG);
@@ -44,6 +44,7 @@
 #include "sgeobj/sge_schedd_conf.h"
 #include "sgeobj/sge_qinstance.h"
 #include "sgeobj/sge_job.h"
+#include "sgeobj/sge_load.h"
 #include "sgeobj/sge_ja_task.h"
 #include "sgeobj/cull/sge_resource_utilization_RUE_L.h"
 
@@ -193,7 +194,7 @@ correct_capacities(lList *host_list, const lList *centry_list)
             continue;
          }
         
-         if (!parse_ulong_val(&dval, nullptr, type, lGetString(ep, HL_value), nullptr, 0))
+         if (!load_get_double(ep, type, &dval))
             continue;
 
          /* do load scaling */
@@ -202,7 +203,7 @@ correct_capacities(lList *host_list, const lList *centry_list)
             sc_factor = lGetDouble(scaling, HS_value);
             dval *= sc_factor;
             snprintf(sval, sizeof(sval), "%8.3f", dval);
-            lSetString(ep, HL_value, sval);
+            load_set_value(ep, sval);
          }
 
          if (lGetUlong(cep, CE_consumable) == CONSUMABLE_NO)
@@ -0,0 +1,303 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+
+#include <unordered_set>
+
+#include "uti/sge.h"
+#include "uti/sge_hostname.h"
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_string.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+
+#include "ocs_DirtyTracker.h"
+
+namespace {
+   // set by the event processing, affects the next scheduling run
+   bool all_dirty = true;
+   std::unordered_set<std::string> dirty_hosts;
+
+   // categories rejected by the previous run and during the current run
+   std::unordered_set<std::string> rejected_categories;
+   std::unordered_set<std::string> run_rejected_categories;
+   bool is_recording = false;
+   bool is_stop_recording_on_dispatch = false;
+
+   // state of the current run
+   std::unordered_set<std::string> run_dirty_hosts;
+   std::unordered_set<std::string> restricted_categories;
+   int reused_categories = 0;
+   int restricted_category_count = 0;
+   int dirty_host_count = 0;
+}
+
+std::string
+ocs::DirtyTracker::host_key(const char *hostname) {
+   char key[CL_MAXHOSTNAMELEN + 1];
+
+   sge_hostcpy(key, hostname);
+   sge_strtoupper(key, CL_MAXHOSTNAMELEN);
+   return key;
+}
+
+/**
+ * @brief Something changed that can make resources available on all hosts
+ *
+ * E.g. the configuration, resource quotas or the global host changed.
+ */
+void
+ocs::DirtyTracker::mark_all() {
+   all_dirty = true;
+}
+
+/**
+ * @brief The state of a host or of its queue instances changed
+ *
+ * @param hostname name of the host, the global host marks everything dirty
+ */
+void
+ocs::DirtyTracker::mark_host(const char *hostname) {
+   if (hostname == nullptr || sge_hostcmp(hostname, SGE_GLOBAL_NAME) == 0) {
+      all_dirty = true;
+   } else {
+      dirty_hosts.insert(host_key(hostname));
+   }
+}
+
+/**
+ * @brief Resources of a job might have been released
+ *
+ * Marks the hosts the job (or one of its array tasks) was running on. If resources are
+ * booked independent of hosts (resource quotas or global consumables) everything is
+ * marked dirty.
+ *
+ * @param job the job before the change or nullptr if it is unknown
+ * @param ja_task_id the array task or 0 for all tasks of the job
+ * @param host_list the exec hosts
+ * @param rqs_list the resource quota sets
+ */
+void
+ocs::DirtyTracker::mark_job_hosts(const lListElem *job, u_long32 ja_task_id, const lList *host_list,
+                                  const lList *rqs_list) {
+   if (job == nullptr) {
+      all_dirty = true;
+      return;
+   }
+
+   bool is_global = has_global_resources(host_list, rqs_list);
+   const lListElem *ja_task;
+   for_each_ep(ja_task, lGetList(job, JB_ja_tasks)) {
+      if (ja_task_id != 0 && lGetUlong(ja_task, JAT_task_number) != ja_task_id) {
+         continue;
+      }
+
+      const lList *gdil = lGetList(ja_task, JAT_granted_destin_identifier_list);
+      if (gdil != nullptr && is_global) {
+         all_dirty = true;
+         return;
+      }
+
+      const lListElem *gdil_ep;
+      for_each_ep(gdil_ep, gdil) {
+         mark_host(lGetHost(gdil_ep, JG_qhostname));
+      }
+   }
+}
+
+/**
+ * @brief Are resources booked that do not belong to a single host?
+ *
+ * @param host_list the exec hosts
+ * @param rqs_list the resource quota sets
+ * @return true if there are global consumables or enabled resource quota sets
+ */
+bool
+ocs::DirtyTracker::has_global_resources(const lList *host_list, const lList *rqs_list) {
+   const lListElem *global_host = lGetElemHost(host_list, EH_name, SGE_GLOBAL_NAME);
+   if (global_host != nullptr && lGetNumberOfElem(lGetList(global_host, EH_consumable_config_list)) > 0) {
+      return true;
+   }
+
+   const lListElem *rqs;
+   for_each_ep(rqs, rqs_list) {
+      if (lGetBool(rqs, RQS_enabled)) {
+         return true;
+      }
+   }
+   return false;
+}
+
+/**
+ * @brief Apply the results of the previous run to the categories of this run
+ *
+ * Categories rejected in the previous run are rejected again if nothing is dirty.
+ * Otherwise, sequential jobs of these categories are matched against the dirty hosts only.
+ * Afterwards, the dirty state is reset and the rejections of this run are recorded.
+ *
+ * Has to be called before the jobs are dispatched, after the load correction was done.
+ *
+ * @param is_enabled incremental scheduling is enabled and possible for this run
+ * @param is_reuse the results of the previous run may be reused
+ * @param category_list categories of this run
+ * @param host_list the exec hosts (with load correction)
+ * @param rqs_list the resource quota sets
+ */
+void
+ocs::DirtyTracker::start_run(bool is_enabled, bool is_reuse, lList *category_list, const lList *host_list,
+                             const lList *rqs_list) {
+   DENTER(TOP_LAYER);
+
+   reused_categories = 0;
+   restricted_categories.clear();
+   run_rejected_categories.clear();
+
+   if (is_enabled && is_reuse && !all_dirty && !rejected_categories.empty()) {
+      lListElem *category;
+      for_each_rw(category, category_list) {
+         const char *category_str = lGetString(category, CT_str);
+
+         if (category_str != nullptr && rejected_categories.count(category_str) > 0) {
+            if (dirty_hosts.empty()) {
+               lSetBool(category, CT_rejected, true);
+               run_rejected_categories.insert(category_str);
+               reused_categories++;
+            } else {
+               restricted_categories.insert(category_str);
+            }
+         }
+      }
+   }
+   restricted_category_count = static_cast<int>(restricted_categories.size());
+   dirty_host_count = static_cast<int>(dirty_hosts.size());
+   run_dirty_hosts.swap(dirty_hosts);
+   rejected_categories.clear();
+   dirty_hosts.clear();
+   all_dirty = false;
+
+   // decaying load corrections make hosts less loaded in the next run
+   const lListElem *host;
+   for_each_ep(host, host_list) {
+      if (lGetUlong(host, EH_load_correction_factor) > 0) {
+         mark_host(lGetHost(host, EH_name));
+      }
+   }
+
+   is_recording = is_enabled;
+   is_stop_recording_on_dispatch = has_global_resources(host_list, rqs_list);
+
+   DPRINTF("incremental scheduling: %d categories rejected, %d restricted to %d dirty hosts\n",
+           reused_categories, restricted_category_count, dirty_host_count);
+   DRETURN_VOID;
+}
+
+/**
+ * @brief Can the job be dispatched to dirty hosts only?
+ *
+ * @param job the job
+ * @return true for sequential jobs of a category rejected by the previous run
+ */
+bool
+ocs::DirtyTracker::is_dirty_hosts_only(const lListElem *job) {
+   if (restricted_categories.empty() || lGetString(job, JB_pe) != nullptr) {
+      return false;
+   }
+
+   const auto *category = static_cast<const lListElem *>(lGetRef(job, JB_category));
+   const char *category_str = category != nullptr ? lGetString(category, CT_str) : nullptr;
+   return category_str != nullptr && restricted_categories.count(category_str) > 0;
+}
+
+/**
+ * @brief Did the host change since the previous run?
+ *
+ * @param hostname name of the host
+ * @return true if the host is dirty
+ */
+bool
+ocs::DirtyTracker::is_dirty_host(const char *hostname) {
+   return run_dirty_hosts.count(host_key(hostname)) > 0;
+}
+
+/**
+ * @brief A job was dispatched in the current run
+ *
+ * The hosts of the job are dirty in the next run, e.g. if the job could not be started.
+ * As long as resources are booked that do not belong to a host, the rejections after
+ * the first dispatched job are not recorded.
+ *
+ * @param gdil the granted queues (JG_Type)
+ */
+void
+ocs::DirtyTracker::job_dispatched(const lList *gdil) {
+   const lListElem *gdil_ep;
+   for_each_ep(gdil_ep, gdil) {
+      mark_host(lGetHost(gdil_ep, JG_qhostname));
+   }
+   if (is_stop_recording_on_dispatch) {
+      is_recording = false;
+   }
+}
+
+/**
+ * @brief The category of a job was rejected in the current run
+ *
+ * @param job the job
+ */
+void
+ocs::DirtyTracker::category_rejected(const lListElem *job) {
+   if (is_recording) {
+      const auto *category = static_cast<const lListElem *>(lGetRef(job, JB_category));
+      const char *category_str = category != nullptr ? lGetString(category, CT_str) : nullptr;
+
+      if (category_str != nullptr) {
+         run_rejected_categories.insert(category_str);
+      }
+   }
+}
+
+/**
+ * @brief Finish recording the current run
+ *
+ * The categories rejected in this run are reused by the next run.
+ */
+void
+ocs::DirtyTracker::finish_run() {
+   rejected_categories.swap(run_rejected_categories);
+   run_rejected_categories.clear();
+   restricted_categories.clear();
+   run_dirty_hosts.clear();
+   is_recording = false;
+}
+
+int
+ocs::DirtyTracker::get_reused_categories() {
+   return reused_categories;
+}
+
+int
+ocs::DirtyTracker::get_restricted_categories() {
+   return restricted_category_count;
+}
+
+int
+ocs::DirtyTracker::get_dirty_hosts() {
+   return dirty_host_count;
+}
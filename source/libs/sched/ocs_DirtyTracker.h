@@ -0,0 +1,89 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <string>
+
+#include "basis_types.h"
+
+#include "cull/cull.h"
+
+namespace ocs {
+   /**
+    * @brief Tracks the changes between scheduling runs
+    *
+    * Categories that could not be dispatched in a scheduling run are remembered. The event
+    * processing of the scheduler thread marks the hosts whose state changed since then
+    * (load reports, queue instance changes, finished jobs, hosts that got jobs) or the whole
+    * cluster if an object changed that affects all hosts (configuration, resource quotas,
+    * global resources, ...).
+    *
+    * Resources that did not change can only have become less available. Therefore, a
+    * category that was rejected in the previous run stays rejected if nothing is dirty, and
+    * jobs of a rejected sequential category need to be matched against the dirty hosts only.
+    *
+    * The tracker is used by the scheduler thread only and is not MT safe.
+    */
+   class DirtyTracker {
+   public:
+      static void
+      mark_all();
+
+      static void
+      mark_host(const char *hostname);
+
+      static void
+      mark_job_hosts(const lListElem *job, u_long32 ja_task_id, const lList *host_list, const lList *rqs_list);
+
+      static bool
+      has_global_resources(const lList *host_list, const lList *rqs_list);
+
+      static void
+      start_run(bool is_enabled, bool is_reuse, lList *category_list, const lList *host_list, const lList *rqs_list);
+
+      static bool
+      is_dirty_hosts_only(const lListElem *job);
+
+      static bool
+      is_dirty_host(const char *hostname);
+
+      static void
+      job_dispatched(const lList *gdil);
+
+      static void
+      category_rejected(const lListElem *job);
+
+      static void
+      finish_run();
+
+      static int
+      get_reused_categories();
+
+      static int
+      get_restricted_categories();
+
+      static int
+      get_dirty_hosts();
+
+   private:
+      static std::string
+      host_key(const char *hostname);
+   };
+}
@@ -0,0 +1,186 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <pthread.h>
+#include <vector>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "ocs_MatchWorkers.h"
+
+namespace {
+   // state of the current run, protected by mutex
+   pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+   pthread_cond_t work_cond = PTHREAD_COND_INITIALIZER;
+   pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;
+
+   // only one scheduler thread can use the workers at a time
+   pthread_mutex_t run_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+   std::vector<pthread_t> workers;
+   bool stop_workers = false;
+   unsigned long generation = 0;
+   const ocs::MatchWorkers::task_t *current_task = nullptr;
+   size_t current_n = 0;
+   size_t chunk_size = 0;
+   size_t chunk_count = 0;
+   size_t next_chunk = 0;
+   size_t done_chunks = 0;
+}
+
+/**
+ * @brief Process chunks of the current run till all of them are handed out
+ *
+ * Has to be called with the mutex locked, the mutex is released while a chunk is processed.
+ */
+void
+ocs::MatchWorkers::process_chunks() {
+   while (current_task != nullptr && next_chunk < chunk_count) {
+      const task_t *task = current_task;
+      size_t begin = next_chunk++ * chunk_size;
+      size_t end = begin + chunk_size < current_n ? begin + chunk_size : current_n;
+
+      pthread_mutex_unlock(&mutex);
+      (*task)(begin, end);
+      pthread_mutex_lock(&mutex);
+
+      if (++done_chunks == chunk_count) {
+         pthread_cond_signal(&done_cond);
+      }
+   }
+}
+
+void *
+ocs::MatchWorkers::main(void *arg) {
+   unsigned long seen_generation = 0;
+
+   pthread_mutex_lock(&mutex);
+   while (true) {
+      while (generation == seen_generation && !stop_workers) {
+         pthread_cond_wait(&work_cond, &mutex);
+      }
+      if (stop_workers) {
+         break;
+      }
+      seen_generation = generation;
+      process_chunks();
+   }
+   pthread_mutex_unlock(&mutex);
+   return nullptr;
+}
+
+/**
+ * @brief Process the range [0, n) with up to the given number of threads
+ *
+ * The range is split into chunks of at least min_chunk_size candidates. When the range is too
+ * small, threads is below 2 or the workers cannot be started the calling thread processes the
+ * whole range.
+ *
+ * @param threads number of threads including the calling thread
+ * @param n number of candidates
+ * @param min_chunk_size minimum number of candidates per chunk
+ * @param task function processing the candidates [begin, end)
+ * @return true if the range was processed in parallel
+ */
+bool
+ocs::MatchWorkers::run(int threads, size_t n, size_t min_chunk_size, const task_t &task) {
+   DENTER(TOP_LAYER);
+
+   size_t chunks = min_chunk_size > 0 ? n / min_chunk_size : n;
+   if (chunks > static_cast<size_t>(threads)) {
+      chunks = threads;
+   }
+   if (chunks < 2) {
+      task(0, n);
+      DRETURN(false);
+   }
+
+   pthread_mutex_lock(&run_mutex);
+   pthread_mutex_lock(&mutex);
+
+   // start missing workers, the calling thread is one of the threads
+   while (workers.size() < static_cast<size_t>(threads - 1)) {
+      pthread_t tid;
+
+      int ret = pthread_create(&tid, nullptr, main, nullptr);
+      if (ret != 0) {
+         DPRINTF("cannot start match worker: %d\n", ret);
+         break;
+      }
+      workers.push_back(tid);
+   }
+   if (workers.empty()) {
+      pthread_mutex_unlock(&mutex);
+      pthread_mutex_unlock(&run_mutex);
+      task(0, n);
+      DRETURN(false);
+   }
+
+   current_task = &task;
+   current_n = n;
+   chunk_size = (n + chunks - 1) / chunks;
+   chunk_count = (n + chunk_size - 1) / chunk_size;
+   next_chunk = 0;
+   done_chunks = 0;
+   generation++;
+   pthread_cond_broadcast(&work_cond);
+
+   process_chunks();
+   while (done_chunks < chunk_count) {
+      pthread_cond_wait(&done_cond, &mutex);
+   }
+   current_task = nullptr;
+
+   pthread_mutex_unlock(&mutex);
+   pthread_mutex_unlock(&run_mutex);
+
+   DRETURN(true);
+}
+
+/**
+ * @brief Stop the worker threads and wait for their termination
+ *
+ * Called by the scheduler thread when it exits. A later run() starts new workers.
+ */
+void
+ocs::MatchWorkers::shutdown() {
+   DENTER(TOP_LAYER);
+
+   pthread_mutex_lock(&run_mutex);
+
+   pthread_mutex_lock(&mutex);
+   stop_workers = true;
+   pthread_cond_broadcast(&work_cond);
+   pthread_mutex_unlock(&mutex);
+
+   for (pthread_t tid : workers) {
+      pthread_join(tid, nullptr);
+   }
+   DPRINTF("stopped %zu match workers\n", workers.size());
+
+   pthread_mutex_lock(&mutex);
+   workers.clear();
+   stop_workers = false;
+   pthread_mutex_unlock(&mutex);
+
+   pthread_mutex_unlock(&run_mutex);
+
+   DRETURN_VOID;
+}
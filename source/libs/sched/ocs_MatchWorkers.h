@@ -0,0 +1,54 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstddef>
+#include <functional>
+
+namespace ocs {
+   /**
+    * @brief Worker threads for matching the hosts and queues of a job
+    *
+    * The scheduler thread hands out a range of candidates [0, n) that is partitioned into
+    * contiguous chunks. The chunks are processed by the worker threads and by the calling
+    * thread itself, run() returns when all chunks are done. Each chunk writes its results
+    * to its own part of a result array, the caller evaluates them in the original order.
+    *
+    * The workers are started on first use and are shared by all callers. The scheduler
+    * thread stops them with shutdown() when it exits.
+    */
+   class MatchWorkers {
+   public:
+      using task_t = std::function<void(size_t begin, size_t end)>;
+
+      static bool
+      run(int threads, size_t n, size_t min_chunk_size, const task_t &task);
+
+      static void
+      shutdown();
+
+   private:
+      static void *
+      main(void *arg);
+
+      static void
+      process_chunks();
+   };
+}
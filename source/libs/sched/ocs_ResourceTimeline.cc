@@ -0,0 +1,182 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "sgeobj/cull/sge_resource_utilization_RDE_L.h"
+
+#include "ocs_ResourceTimeline.h"
+#include "sge_select_queue.h"
+
+/**
+ * @brief Create the timeline of a resource diagram
+ *
+ * @param diagram resource diagram (RDE_Type list sorted by RDE_time) or nullptr
+ */
+ocs::ResourceTimeline::ResourceTimeline(const lList *diagram) : leaves(1) {
+   size_t n = lGetNumberOfElem(diagram);
+
+   times.reserve(n);
+   amounts.reserve(n);
+
+   const lListElem *rde;
+   for_each_ep(rde, diagram) {
+      times.push_back(lGetUlong64(rde, RDE_time));
+      amounts.push_back(lGetDouble(rde, RDE_amount));
+   }
+
+   // padding leaves never become part of a result
+   while (leaves < n) {
+      leaves <<= 1;
+   }
+   max_tree.assign(2 * leaves, -HUGE_VAL);
+   min_tree.assign(2 * leaves, HUGE_VAL);
+   for (size_t i = 0; i < n; i++) {
+      max_tree[leaves + i] = amounts[i];
+      min_tree[leaves + i] = amounts[i];
+   }
+   for (size_t i = leaves - 1; i > 0; i--) {
+      max_tree[i] = std::max(max_tree[2 * i], max_tree[2 * i + 1]);
+      min_tree[i] = std::min(min_tree[2 * i], min_tree[2 * i + 1]);
+   }
+}
+
+/**
+ * @brief Number of points in time of the timeline
+ *
+ * @return number of elements of the diagram the timeline was created from
+ */
+size_t
+ocs::ResourceTimeline::size() const {
+   return times.size();
+}
+
+/**
+ * @brief Highest index below end having an amount above limit
+ *
+ * @param node node of the max tree covering the indices [lo, hi)
+ * @return the index or -1
+ */
+int
+ocs::ResourceTimeline::last_above(size_t node, size_t lo, size_t hi, size_t end, double limit) const {
+   if (lo >= end || max_tree[node] <= limit) {
+      return -1;
+   }
+   if (hi - lo == 1) {
+      return static_cast<int>(lo);
+   }
+
+   size_t mid = (lo + hi) / 2;
+   int ret = last_above(2 * node + 1, mid, hi, end, limit);
+   if (ret < 0) {
+      ret = last_above(2 * node, lo, mid, end, limit);
+   }
+   return ret;
+}
+
+/**
+ * @brief Highest index below end having an amount not above limit
+ *
+ * @param node node of the min tree covering the indices [lo, hi)
+ * @return the index or -1
+ */
+int
+ocs::ResourceTimeline::last_not_above(size_t node, size_t lo, size_t hi, size_t end, double limit) const {
+   if (lo >= end || min_tree[node] > limit) {
+      return -1;
+   }
+   if (hi - lo == 1) {
+      return static_cast<int>(lo);
+   }
+
+   size_t mid = (lo + hi) / 2;
+   int ret = last_not_above(2 * node + 1, mid, hi, end, limit);
+   if (ret < 0) {
+      ret = last_not_above(2 * node, lo, mid, end, limit);
+   }
+   return ret;
+}
+
+/**
+ * @brief Maximum utilization within a time frame
+ *
+ * Same result as walking through the diagram like utilization_max() does: The amount that is valid
+ * at start_time (0 before the first entry) and all amounts of entries starting before end_time.
+ *
+ * @param start_time start of the time frame
+ * @param end_time end of the time frame
+ * @return the maximum utilization
+ */
+double
+ocs::ResourceTimeline::max(u_long64 start_time, u_long64 end_time) const {
+   double ret = 0.0;
+
+   // entry valid at start_time
+   size_t first = std::upper_bound(times.begin(), times.end(), start_time) - times.begin();
+   if (first > 0) {
+      ret = amounts[first - 1];
+   }
+
+   // entries starting within the time frame
+   size_t last = std::lower_bound(times.begin(), times.end(), end_time) - times.begin();
+   for (size_t l = first + leaves, r = last + leaves; l < r; l >>= 1, r >>= 1) {
+      if (l & 1) {
+         ret = std::max(ret, max_tree[l++]);
+      }
+      if (r & 1) {
+         ret = std::max(ret, max_tree[--r]);
+      }
+   }
+   return ret;
+}
+
+/**
+ * @brief Earliest time the utilization is below a limit
+ *
+ * Same result as walking backwards through the diagram like utilization_below() does: The time of the
+ * last entry having an amount of at most max_util that follows an entry with an amount above max_util.
+ *
+ * @param max_util the utilization limit
+ * @return the time or DISPATCH_TIME_NOW if there is no such entry
+ */
+u_long64
+ocs::ResourceTimeline::below(double max_util) const {
+   size_t n = times.size();
+
+   int above = last_above(1, 0, leaves, n, max_util);
+   if (above < 0) {
+      return DISPATCH_TIME_NOW;
+   }
+   if (static_cast<size_t>(above) + 1 < n) {
+      return times[above + 1];
+   }
+
+   // the last entry is above the limit, search the transition before it
+   int not_above = last_not_above(1, 0, leaves, above, max_util);
+   if (not_above < 0) {
+      return DISPATCH_TIME_NOW;
+   }
+   above = last_above(1, 0, leaves, not_above, max_util);
+   if (above < 0) {
+      return DISPATCH_TIME_NOW;
+   }
+   return times[above + 1];
+}
@@ -0,0 +1,67 @@
+#pragma once
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <vector>
+
+#include "basis_types.h"
+
+#include "cull/cull.h"
+
+namespace ocs {
+   /**
+    * @brief Array based copy of a resource utilization diagram
+    *
+    * The points in time and the amounts of a resource diagram (list of RDE_Type elements) are
+    * stored in sorted arrays. Segment trees keep the maximum and the minimum amount of ranges
+    * of the diagram, so that the maximum utilization within a time frame and the earliest time
+    * the utilization falls below a limit are found in O(log n) instead of walking through the
+    * CULL list.
+    *
+    * The CULL list stays the authoritative data. A timeline is a snapshot that has to be
+    * rebuilt when the diagram is modified.
+    */
+   class ResourceTimeline {
+   private:
+      std::vector<u_long64> times;
+      std::vector<double> amounts;
+      size_t leaves;
+      std::vector<double> max_tree;
+      std::vector<double> min_tree;
+
+      int
+      last_above(size_t node, size_t lo, size_t hi, size_t end, double limit) const;
+
+      int
+      last_not_above(size_t node, size_t lo, size_t hi, size_t end, double limit) const;
+
+   public:
+      explicit ResourceTimeline(const lList *diagram);
+
+      size_t
+      size() const;
+
+      double
+      max(u_long64 start_time, u_long64 end_time) const;
+
+      u_long64
+      below(double max_util) const;
+   };
+}
@@ -240,7 +240,7 @@ get_attribute(const char *attrname, const lList *config_attr, const lList *actua
                char err_str[256];
                u_long32 dom_type = DOMINANT_TYPE_LOAD;
 
-               if (parse_ulong_val(&dval, nullptr, type, load_value, nullptr, 0)) {
+               if (load_get_double(load_el, type, &dval)) {
                   /* when nullptr is passed as load_adjustments, does it mean
                    * - we do not need to consider them
                    * - we always want to consider them and need to fetch them locally (old behaviour)
@@ -1111,6 +1111,56 @@ int compare_complexes(int slots, lListElem *req_cplx, lListElem *src_cplx, char
    DRETURN(0);
 }
 
+/****** sge_complex_schedd/get_host_attribute() ******************************
+*  NAME
+*     get_host_attribute() -- returns an attribute of a single host
+*
+*  SYNOPSIS
+*     lListElem* get_host_attribute(const lListElem *host, const char *attrname,
+*     const lList *centry_list, const lList *load_adjustments, u_long32 layer,
+*     u_long64 start_time, u_long64 duration)
+*
+*  FUNCTION
+*     Looks up the attribute in the consumable configuration, the resource
+*     utilization and the load values of the host. The load correction factor
+*     of the host is applied to load values. Unlike get_attribute_by_name()
+*     no other layer is taken into account.
+*
+*  INPUTS
+*     const lListElem *host        - the host (EH_Type), may also be the global host
+*     const char *attrname         - the attribute name one is looking for
+*     const lList *centry_list     - the system wide attribute config list
+*     const lList *load_adjustments - the load adjustments or nullptr
+*     u_long32 layer               - DOMINANT_LAYER_GLOBAL or DOMINANT_LAYER_HOST
+*     u_long64 start_time          - start of the time frame for consumables
+*     u_long64 duration            - length of the time frame for consumables
+*
+*  RESULT
+*     lListElem* - the element one is looking for (a copy) or nullptr.
+*
+*  SEE ALSO
+*     sge_complex_schedd/get_attribute_by_name()
+*******************************************************************************/
+lListElem *
+get_host_attribute(const lListElem *host, const char *attrname, const lList *centry_list,
+                   const lList *load_adjustments, u_long32 layer, u_long64 start_time, u_long64 duration)
+{
+   double lc_factor = 0;
+
+   DENTER(BASIS_LAYER);
+
+   /* is there a multiplier for load correction (may be not in qstat, qmon etc) */
+   if (lGetPosViaElem(host, EH_load_correction_factor, SGE_NO_ABORT) >= 0) {
+      if ((lc_factor=lGetUlong(host, EH_load_correction_factor)) != 0) {
+         lc_factor = ((double)lc_factor)/100;
+      }
+   }
+
+   DRETURN(get_attribute(attrname, lGetList(host, EH_consumable_config_list), lGetList(host, EH_resource_utilization),
+                         lGetList(host, EH_load_list), centry_list, load_adjustments, nullptr, layer, lc_factor,
+                         nullptr, false, start_time, duration));
+}
+
 /****** sge_select_queue/get_attribute_by_name() *******************************
 *  NAME
 *     get_attribute_by_name() -- returns an attribut by name
@@ -1146,43 +1196,20 @@ get_attribute_by_name(const lListElem *global, const lListElem *host, const lLis
    lListElem *host_el=nullptr;
    lListElem *queue_el=nullptr;
    lListElem *ret_el = nullptr;
-   const lList *load_attr = nullptr;
    const lList *config_attr = nullptr;
    const lList *actual_attr = nullptr;
 
    DENTER(BASIS_LAYER);
 
    if (global != nullptr) {
-      double lc_factor = 0;
-      load_attr = lGetList(global, EH_load_list);  
-      config_attr = lGetList(global, EH_consumable_config_list);
-      actual_attr = lGetList(global, EH_resource_utilization);
-
-      /* is there a multiplier for load correction (may be not in qstat, qmon etc) */
-      if (lGetPosViaElem(global, EH_load_correction_factor, SGE_NO_ABORT) >= 0) {
-         if ((lc_factor=lGetUlong(global, EH_load_correction_factor)) != 0) {
-            lc_factor = ((double)lc_factor)/100;
-         }   
-      }
-      global_el = get_attribute(attrname, config_attr, actual_attr, load_attr, centry_list, load_adjustments, nullptr,
-                                DOMINANT_LAYER_GLOBAL, lc_factor, nullptr, false, start_time, duration);
+      global_el = get_host_attribute(global, attrname, centry_list, load_adjustments, DOMINANT_LAYER_GLOBAL,
+                                     start_time, duration);
       ret_el = global_el;
    } 
 
    if (host != nullptr) {   
-      double lc_factor = 0;
-      load_attr = lGetList(host, EH_load_list); 
-      config_attr = lGetList(host, EH_consumable_config_list);
-      actual_attr = lGetList(host, EH_resource_utilization);
-
-      /* is there a multiplier for load correction (may be not in qstat, qmon etc) */
-      if (lGetPosViaElem(host, EH_load_correction_factor, SGE_NO_ABORT) >= 0) {
-         if ((lc_factor=lGetUlong(host, EH_load_correction_factor)) != 0) {
-            lc_factor = ((double)lc_factor)/100;
-         }
-      }
-      host_el = get_attribute(attrname, config_attr, actual_attr, load_attr, centry_list, load_adjustments,
-                              nullptr, DOMINANT_LAYER_HOST, lc_factor, nullptr, false, start_time, duration);
+      host_el = get_host_attribute(host, attrname, centry_list, load_adjustments, DOMINANT_LAYER_HOST,
+                                   start_time, duration);
       if (!global_el && host_el) {
          ret_el = host_el;
       } else if (global_el && host_el) {
@@ -45,6 +45,10 @@ lListElem *
 get_attribute_by_name(const lListElem *global, const lListElem *host, const lListElem *queue, const char *attrname,
                       const lList *centry_list, const lList *load_adjustments, u_long64 start_time, u_long64 duration);
 
+lListElem *
+get_host_attribute(const lListElem *host, const char *attrname, const lList *centry_list,
+                   const lList *load_adjustments, u_long32 layer, u_long64 start_time, u_long64 duration);
+
 int compare_complexes(int slots, lListElem *complex1, 
                       lListElem *complex2, char *availability_text, 
                       int is_threshold, int force_existence);
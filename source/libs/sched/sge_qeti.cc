@@ -65,6 +65,7 @@ struct sge_qeti_s {
    lList *cr_refs_global;
    lList *cr_refs_host;
    lList *cr_refs_queue;
+   bool has_timelines;
 };
 
 /*
@@ -181,6 +182,25 @@ sge_add_qeti_resource_container(lList **qeti_to_add, const lList* rue_list,
    DRETURN(0);
 }
 
+/* prepare or release the timelines of all referenced resource utilization entries */
+static void sge_qeti_timelines(sge_qeti_t *qeti, bool add)
+{
+   const lList *cref_lists[] = {qeti->cr_refs_pe, qeti->cr_refs_global, qeti->cr_refs_host, qeti->cr_refs_queue};
+
+   for (const lList *cref_lp : cref_lists) {
+      const lListElem *cr_ep;
+      for_each_ep(cr_ep, cref_lp) {
+         const auto *rue_ep = static_cast<const lListElem *>(lGetRef(cr_ep, QETI_resource_instance));
+         if (add) {
+            utilization_timeline_add(rue_ep);
+         } else {
+            utilization_timeline_remove(rue_ep);
+         }
+      }
+   }
+   qeti->has_timelines = add;
+}
+
 // used only in module test
 sge_qeti_t *sge_qeti_allocate2(lList *cr_list)
 {
@@ -277,6 +297,10 @@ sge_qeti_t *sge_qeti_allocate(sge_assignment_t *a)
    DPRINTF("QETI: P %d G %d H %d Q %d\n", lGetNumberOfElem(iter->cr_refs_pe), lGetNumberOfElem(iter->cr_refs_global),
            lGetNumberOfElem(iter->cr_refs_host), lGetNumberOfElem(iter->cr_refs_queue));
 
+   // the resource utilization entries are asked for each queue end time,
+   // use timelines instead of walking through the resource diagrams
+   sge_qeti_timelines(iter, true);
+
    DRETURN(iter);
 }
 
@@ -508,6 +532,9 @@ void sge_qeti_release(sge_qeti_t **qeti)
       return;
    }
 
+   if ((*qeti)->has_timelines) {
+      sge_qeti_timelines(*qeti, false);
+   }
    lFreeList(&((*qeti)->cr_refs_pe));
    lFreeList(&((*qeti)->cr_refs_global));
    lFreeList(&((*qeti)->cr_refs_host));
@@ -33,6 +33,7 @@
 /*___INFO__MARK_END__*/
 
 #include <cstring>
+#include <unordered_map>
 
 #include "uti/sge_log.h"
 #include "uti/sge_rmon_macros.h"
@@ -57,6 +58,7 @@
 #include "sgeobj/sge_advance_reservation.h"
 
 #include "debit.h"
+#include "ocs_ResourceTimeline.h"
 #include "sge_job_schedd.h"
 #include "sge_resource_utilization.h"
 #include "sge_select_queue.h"
@@ -87,6 +89,25 @@ static void set_utilization(lList *uti_list, u_long64 from, u_long64 till, doubl
 
 static lListElem *newResourceElem(u_long64 time, double amount);
 
+/* diagrams having at least this number of entries get an ordered index on RDE_time */
+#define RDE_ORDERED_INDEX_SIZE 64
+
+/* timelines of the resource utilization entries used by the running reservation search */
+struct utilization_timeline_t {
+   int refs;
+   bool valid;
+   const lList *utilized;
+   const lList *utilized_nonexclusive;
+   ocs::ResourceTimeline timeline;
+   ocs::ResourceTimeline timeline_nonexclusive;
+};
+
+static thread_local std::unordered_map<const lListElem *, utilization_timeline_t> utilization_timelines;
+
+static const utilization_timeline_t *utilization_timeline_get(const lListElem *cr);
+static void utilization_timeline_invalidate(const lListElem *cr);
+static void utilization_normalize_range(lList *diagram, lListElem *first, lListElem *last);
+
 static bool print_resource_utilization = getenv("SGE_PRINT_RESOURCE_UTILIZATION") == nullptr ? false : true;
 
 /****** sge_resource_utilization/utilization_print_to_dstring() ****************
@@ -315,6 +336,7 @@ int utilization_add(lListElem *cr, u_long64 start_time, u_long64 duration, doubl
       resource_diagram = lCreateList(name, RDE_Type);
       lSetList(cr, nm, resource_diagram);
    }
+   utilization_timeline_invalidate(cr);
 
    utilization_find_time_or_prevstart_or_prev(resource_diagram, start_time, &start, &prev);
 
@@ -365,7 +387,15 @@ int utilization_add(lListElem *cr, u_long64 start_time, u_long64 duration, doubl
    printf("this was before utilization_normalize()\n");
 #endif
 
-   utilization_normalize(resource_diagram);
+   /* large diagrams are searched by the ordered index and only normalized where they were modified */
+   if (cull_hash_is_ordered(resource_diagram, lGetPosInDescr(lGetListDescr(resource_diagram), RDE_time))) {
+      utilization_normalize_range(resource_diagram, lPrevRW(start), lNextRW(end));
+   } else {
+      utilization_normalize(resource_diagram);
+      if (lGetNumberOfElem(resource_diagram) >= RDE_ORDERED_INDEX_SIZE) {
+         cull_hash_new_ordered(resource_diagram, RDE_time, false);
+      }
+   }
    DRETURN(0);
 }
 
@@ -380,6 +410,24 @@ static void utilization_find_time_or_prevstart_or_prev(const lList *diagram, u_l
 { 
    lListElem *start, *thiz, *prev;
 
+   /* large diagrams have an ordered index */
+   int pos = lGetPosInDescr(lGetListDescr(diagram), RDE_time);
+   if (cull_hash_is_ordered(diagram, pos)) {
+      lListElem *key = lCreateElem(RDE_Type);
+      lSetUlong64(key, RDE_time, time);
+      thiz = cull_hash_lower_bound(diagram, pos, key);
+      lFreeElem(&key);
+
+      if (thiz != nullptr && lGetUlong64(thiz, RDE_time) == time) {
+         *hit = thiz;
+         *before = lPrevRW(thiz);
+      } else {
+         *hit = nullptr;
+         *before = thiz != nullptr ? lPrevRW(thiz) : lLastRW(diagram);
+      }
+      return;
+   }
+
    start = nullptr;
    thiz = lFirstRW(diagram); 
    prev = nullptr;
@@ -439,6 +487,51 @@ static void utilization_normalize(lList *diagram)
    return;
 }
 
+/* normalize the part of a normalized diagram from first till last that was modified
+
+   Note: first and last may be nullptr to denote the begin resp. the end of the diagram
+*/
+static void utilization_normalize_range(lList *diagram, lListElem *first, lListElem *last)
+{
+   lListElem *thiz, *next;
+
+   thiz = lFirstRW(diagram);
+   while (thiz && lGetDouble(thiz, RDE_amount) == 0.0) {
+      if (thiz == first) {
+         first = nullptr;
+      }
+      if (thiz == last) {
+         last = lNextRW(last);
+      }
+      lRemoveElem(diagram, &thiz);
+      thiz = lFirstRW(diagram);
+   }
+
+   if (first == nullptr) {
+      first = lFirstRW(diagram);
+   }
+   if (first == nullptr) {
+      return;
+   }
+
+   double util_prev = lGetDouble(first, RDE_amount);
+   thiz = lNextRW(first);
+   while (thiz != nullptr) {
+      bool is_last = thiz == last;
+
+      next = lNextRW(thiz);
+      if (util_prev == lGetDouble(thiz, RDE_amount)) {
+         lRemoveElem(diagram, &thiz);
+      } else {
+         util_prev = lGetDouble(thiz, RDE_amount);
+      }
+      if (is_last) {
+         break;
+      }
+      thiz = next;
+   }
+}
+
 /****** sge_resource_utilization/utilization_queue_end() ***********************
 *  NAME
 *     utilization_queue_end() -- Determine utilization at queue end time
@@ -550,6 +643,17 @@ double utilization_max(const lListElem *cr, u_long64 start_time, u_long64 durati
    utilization_print(cr, "the object");
 #endif
 
+   /* the reservation search prepared a timeline */
+   const utilization_timeline_t *tl = utilization_timeline_get(cr);
+   if (tl != nullptr) {
+      max = tl->timeline.max(start_time, end_time);
+      if (for_excl_request) {
+         max = MAX(max, tl->timeline_nonexclusive.max(start_time, end_time));
+      }
+      DPRINTF("returning(3) %f\n", max);
+      DRETURN(max);
+   }
+
    utilization_find_time_or_prevstart_or_prev(lGetList(cr, RUE_utilized), start_time, &start, &prev);
 
    if (start) {
@@ -635,6 +739,16 @@ u_long64 utilization_below(const lListElem *cr, double max_util, const char *obj
    utilization_print(cr, object_name);
 #endif
 
+   /* the reservation search prepared a timeline */
+   const utilization_timeline_t *tl = utilization_timeline_get(cr);
+   if (tl != nullptr) {
+      when = tl->timeline.below(max_util);
+      if (for_excl_request) {
+         when = MAX(when, tl->timeline_nonexclusive.below(max_util));
+      }
+      DRETURN(when);
+   }
+
    /* search backward starting at the diagrams end */
    for_each_rev (rde, lGetList(cr, RUE_utilized)) {
       util = lGetDouble(rde, RDE_amount);
@@ -670,6 +784,118 @@ u_long64 utilization_below(const lListElem *cr, double max_util, const char *obj
    DRETURN(when); 
 }
 
+/****** sge_resource_utilization/utilization_timeline_add() ********************
+*  NAME
+*     utilization_timeline_add() -- Use a timeline for a resource utilization
+*
+*  SYNOPSIS
+*     void utilization_timeline_add(const lListElem *cr)
+*
+*  FUNCTION
+*     Prepares an array based timeline (ocs::ResourceTimeline) of the
+*     resource diagrams of a resource utilization entry. Till the entry
+*     is removed with utilization_timeline_remove() utilization_max() and
+*     utilization_below() use the timeline instead of walking through
+*     the diagrams. This pays off when the same entries are asked again
+*     and again like during the reservation search for parallel jobs.
+*
+*     The timeline is rebuilt on demand when the diagrams are modified.
+*     Calls can be nested, each call needs a utilization_timeline_remove().
+*
+*  INPUTS
+*     const lListElem *cr - Resource utilization entry (RUE_Type)
+*
+*  NOTES
+*     MT-NOTE: utilization_timeline_add() is MT safe, timelines are
+*     MT-NOTE: thread local
+*
+*  SEE ALSO
+*     sge_resource_utilization/utilization_timeline_remove()
+*******************************************************************************/
+void utilization_timeline_add(const lListElem *cr)
+{
+   if (cr == nullptr) {
+      return;
+   }
+
+   auto it = utilization_timelines.find(cr);
+   if (it != utilization_timelines.end()) {
+      it->second.refs++;
+   } else {
+      utilization_timelines.emplace(cr, utilization_timeline_t{1, false, nullptr, nullptr,
+                                        ocs::ResourceTimeline(nullptr), ocs::ResourceTimeline(nullptr)});
+   }
+}
+
+/****** sge_resource_utilization/utilization_timeline_remove() *****************
+*  NAME
+*     utilization_timeline_remove() -- Release a timeline
+*
+*  SYNOPSIS
+*     void utilization_timeline_remove(const lListElem *cr)
+*
+*  FUNCTION
+*     Releases a timeline prepared with utilization_timeline_add().
+*
+*  INPUTS
+*     const lListElem *cr - Resource utilization entry (RUE_Type)
+*
+*  NOTES
+*     MT-NOTE: utilization_timeline_remove() is MT safe
+*
+*  SEE ALSO
+*     sge_resource_utilization/utilization_timeline_add()
+*******************************************************************************/
+void utilization_timeline_remove(const lListElem *cr)
+{
+   auto it = utilization_timelines.find(cr);
+   if (it != utilization_timelines.end() && --it->second.refs == 0) {
+      utilization_timelines.erase(it);
+   }
+}
+
+/* timeline of a resource utilization entry or nullptr if there is none */
+static const utilization_timeline_t *utilization_timeline_get(const lListElem *cr)
+{
+   if (utilization_timelines.empty()) {
+      return nullptr;
+   }
+
+   auto it = utilization_timelines.find(cr);
+   if (it == utilization_timelines.end()) {
+      return nullptr;
+   }
+
+   utilization_timeline_t &tl = it->second;
+   const lList *utilized = lGetList(cr, RUE_utilized);
+   const lList *utilized_nonexclusive = lGetList(cr, RUE_utilized_nonexclusive);
+
+   /* the diagrams were modified or replaced */
+   if (!tl.valid || tl.utilized != utilized || tl.utilized_nonexclusive != utilized_nonexclusive ||
+       tl.timeline.size() != static_cast<size_t>(lGetNumberOfElem(utilized)) ||
+       tl.timeline_nonexclusive.size() != static_cast<size_t>(lGetNumberOfElem(utilized_nonexclusive))) {
+      tl.utilized = utilized;
+      tl.utilized_nonexclusive = utilized_nonexclusive;
+      tl.timeline = ocs::ResourceTimeline(utilized);
+      tl.timeline_nonexclusive = ocs::ResourceTimeline(utilized_nonexclusive);
+      tl.valid = true;
+   }
+   return &tl;
+}
+
+/* the diagrams of a resource utilization entry will be modified */
+static void utilization_timeline_invalidate(const lListElem *cr)
+{
+   if (utilization_timelines.empty()) {
+      return;
+   }
+
+   auto it = utilization_timelines.find(cr);
+   if (it != utilization_timelines.end()) {
+      it->second.valid = false;
+   }
+}
+
 
 /****** sge_resource_utilization/add_job_utilization() *************************
 *  NAME
@@ -1300,6 +1526,7 @@ add_calendar_to_schedule(lList *queue_list, u_long64 now)
             slot_uti_list = lCreateList("slot_uti", RDE_Type);
             lSetList(slot_uti, RUE_utilized, slot_uti_list);
          }
+         utilization_timeline_invalidate(slot_uti);
 
          for_each_ep(queue_state, queue_states) {
             bool is_full = (lGetUlong(queue_state, CQU_state) != QI_DO_NOTHING)?true:false;
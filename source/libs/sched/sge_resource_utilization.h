@@ -44,6 +44,8 @@ int utilization_add(lListElem *cr, u_long64 start_time, u_long64 duration, doubl
    u_long32 job_id, u_long32 ja_taskid, u_long32 level, const char *object_name, const char *type, bool for_job, bool implicit_non_exclusive);
 double utilization_max(const lListElem *cr, u_long64 start_time, u_long64 duration, bool for_excl_request);
 u_long64 utilization_below(const lListElem *cr, double max_util, const char *object_name, bool for_excl_request);
+void utilization_timeline_add(const lListElem *cr);
+void utilization_timeline_remove(const lListElem *cr);
 
 int add_job_utilization(const sge_assignment_t *a, const char *type, bool for_job_scheduling);
 double utilization_queue_end(const lListElem *cr, bool for_excl_request);
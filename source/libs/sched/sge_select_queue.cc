@@ -36,6 +36,8 @@
 #include <cstdlib>
 #include <cfloat>
 #include <climits>
+#include <unordered_set>
+#include <vector>
 
 #include "uti/sge.h"
 #include "uti/sge_bitfield.h"
@@ -47,6 +49,7 @@
 #include "uti/sge_time.h"
 
 #include "cull/cull.h"
+#include "cull/cull_inline.h"
 
 #include "sgeobj/ocs_DataStore.h"
 #include "sgeobj/sge_range.h"
@@ -56,6 +59,7 @@
 #include "sgeobj/sge_ja_task.h"
 #include "sgeobj/sge_attr.h"
 #include "sgeobj/sge_host.h"
+#include "sgeobj/sge_load.h"
 #include "sgeobj/sge_job.h"
 #include "sgeobj/sge_cqueue.h"
 #include "sgeobj/sge_qinstance_type.h"
@@ -72,6 +76,8 @@
 #include "sgeobj/sge_resource_quota_service.h"
 
 #include "basis_types.h"
+#include "ocs_DirtyTracker.h"
+#include "ocs_MatchWorkers.h"
 #include "schedd_message.h"
 #include "schedd_monitor.h"
 #include "sge_complex_schedd.h"
@@ -213,7 +219,8 @@ static int
 resource_cmp(u_long32 relop, double req, double src_dl);
 
 static bool
-job_is_forced_centry_missing(const sge_assignment_t *a, const lListElem *queue_or_host, bool is_qinstance);
+job_is_forced_centry_missing(const sge_assignment_t *a, const lListElem *queue_or_host, bool is_qinstance,
+                             bool prematch);
 
 static void
 clear_resource_tags(lList *resources, u_long32 max_tag);
@@ -230,13 +237,118 @@ static lListElem
                   lListElem *queue_consumable, const char *limit);
 
 static int
-load_check_alarm(char *reason, size_t reason_size, const char *name, const char *load_value, const char *limit_value,
-                     u_long32 relop, u_long32 type, lListElem *hep, const lListElem *hlep, double lc_host,
-                     double lc_global, const lList *load_adjustments, int load_is_value);
+load_check_alarm(char *reason, size_t reason_size, const char *name, const char *load_value,
+                     const lListElem *load_el, const char *limit_value, u_long32 relop, u_long32 type,
+                     lListElem *hep, const lListElem *hlep, double lc_host, double lc_global,
+                     const lList *load_adjustments, int load_is_value);
 
 static int
 load_np_value_adjustment(const char* name, lListElem *hep, double *load_correction);
 
+/* ---- static matching of hosts and queues by the match workers ------------------------------ */
+
+/* minimum number of hosts and queues matched by one thread */
+#define STATIC_PREMATCH_CHUNK_SIZE 64
+
+static dispatch_t
+host_match_static(const sge_assignment_t *a, const lListElem *host, bool prematch);
+
+static dispatch_t
+queue_match_static(const sge_assignment_t *a, lListElem *queue, bool prematch);
+
+/* hosts and queues of the assignment that passed the static matching */
+static thread_local const sge_assignment_t *static_prematch_assignment = nullptr;
+static thread_local std::unordered_set<const lListElem *> static_prematch_ok;
+
+/****** sge_select_queue/static_prematch() *************************************
+*  NAME
+*     static_prematch() -- Static matching of all hosts and queues in parallel
+*
+*  SYNOPSIS
+*     static void static_prematch(const sge_assignment_t *a)
+*
+*  FUNCTION
+*     With the scheduler param MATCH_THREADS the static matching
+*     (host_match_static() and queue_match_static()) of all hosts and
+*     queue instances of an assignment is done by the match workers
+*     before the tagging. Hosts and queues that passed are remembered,
+*     sge_host_match_static() and sge_queue_match_static() return
+*     DISPATCH_OK for them without matching again.
+*
+*     The workers neither add scheduler messages nor modify hosts or
+*     queues. Everything that did not pass is matched again by the
+*     scheduler thread in the order of the tagging loops. This way the
+*     results and messages are identical to the sequential matching.
+*
+*     The remembered results have to be released with
+*     static_prematch_release() before the assignment changes.
+*
+*  INPUTS
+*     const sge_assignment_t *a - the assignment
+*
+*  NOTES
+*     MT-NOTE: static_prematch() is not MT safe
+*******************************************************************************/
+static void
+static_prematch(const sge_assignment_t *a)
+{
+   int threads = sconf_get_match_threads();
+   size_t n = lGetNumberOfElem(a->host_list) + lGetNumberOfElem(a->queue_list);
+
+   if (threads < 2 || a->is_dirty_hosts_only || n < 2 * STATIC_PREMATCH_CHUNK_SIZE) {
+      return;
+   }
+
+   DENTER(TOP_LAYER);
+
+   std::vector<lListElem *> candidates;
+   candidates.reserve(n);
+   lListElem *ep;
+   for_each_rw(ep, a->host_list) {
+      candidates.push_back(ep);
+   }
+   size_t hosts = candidates.size();
+   for_each_rw(ep, a->queue_list) {
+      candidates.push_back(ep);
+   }
+
+   std::vector<char> ok(candidates.size(), 0);
+   ocs::MatchWorkers::run(threads, candidates.size(), STATIC_PREMATCH_CHUNK_SIZE, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+         if (i < hosts) {
+            ok[i] = candidates[i] != a->gep && host_match_static(a, candidates[i], true) == DISPATCH_OK;
+         } else {
+            ok[i] = queue_match_static(a, candidates[i], true) == DISPATCH_OK;
+         }
+      }
+   });
+
+   static_prematch_ok.clear();
+   for (size_t i = 0; i < candidates.size(); i++) {
+      if (ok[i]) {
+         static_prematch_ok.insert(candidates[i]);
+      }
+   }
+   static_prematch_assignment = a;
+   DPRINTF("static prematch: %zu of %zu hosts and queues passed\n", static_prematch_ok.size(), candidates.size());
+
+   DRETURN_VOID;
+}
+
+static void
+static_prematch_release()
+{
+   static_prematch_assignment = nullptr;
+   static_prematch_ok.clear();
+}
+
+/* true if the host or queue passed the static matching for the assignment */
+static bool
+static_prematch_is_ok(const sge_assignment_t *a, const lListElem *ep)
+{
+   return static_prematch_assignment == a && static_prematch_ok.find(ep) != static_prematch_ok.end();
+}
+
 static void
 print_tagged4schedule(const lListElem *qinstance) {
    DENTER(TOP_LAYER);
@@ -1627,7 +1739,8 @@ get_soft_queue_list(const lListElem *job, const lList *&soft_queue_list) {
 *  NOTES
 *******************************************************************************/
 
-dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
+static dispatch_t
+queue_match_static(const sge_assignment_t *a, lListElem *queue, bool prematch)
 {
    DENTER(TOP_LAYER);
 
@@ -1639,14 +1752,18 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
 
       if (lGetSubStr(a->ar, QU_full_name, qinstance_name, AR_reserved_queues) == nullptr) {
          u_long32 ar_id = lGetUlong(a->ar, AR_id);
-         schedd_mes_add_global(a->monitor_alpp, a->monitor_next_run,
-                               SCHEDD_INFO_QINOTARRESERVED_SI, qinstance_name, ar_id);
+         if (!prematch) {
+            schedd_mes_add_global(a->monitor_alpp, a->monitor_next_run,
+                                  SCHEDD_INFO_QINOTARRESERVED_SI, qinstance_name, ar_id);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    } else {
       /* this is not advance reservation job, we have to drop queues in orphaned state */
       if (lGetUlong(queue, QU_state) == QI_ORPHANED) {
-         schedd_mes_add_global(a->monitor_alpp, a->monitor_next_run, SCHEDD_INFO_QUEUENOTAVAIL_, qinstance_name);
+         if (!prematch) {
+            schedd_mes_add_global(a->monitor_alpp, a->monitor_next_run, SCHEDD_INFO_QUEUENOTAVAIL_, qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -1654,9 +1771,11 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
    /* check if job owner has access rights to the queue */
    if (!sge_has_access(a->user, a->group, a->grp_list, queue, a->acl_list)) {
       DPRINTF("Job %d has no permission for queue %s\n", (int)a->job_id, qinstance_name);
-      schedd_mes_add(a->monitor_alpp, a->monitor_next_run,
-                     a->job_id, SCHEDD_INFO_HASNOPERMISSION_SS,
-                     "queue", qinstance_name);
+      if (!prematch) {
+         schedd_mes_add(a->monitor_alpp, a->monitor_next_run,
+                        a->job_id, SCHEDD_INFO_HASNOPERMISSION_SS,
+                        "queue", qinstance_name);
+      }
       DRETURN(DISPATCH_NEVER_CAT);
    }
 
@@ -1664,15 +1783,19 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
    const lList *projects;
    if ((projects = lGetList(queue, QU_projects))) {
       if (!a->project) {
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_HASNOPRJ_S,
-                        "queue", qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_HASNOPRJ_S,
+                           "queue", qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
       if ((!prj_list_locate(projects, a->project))) {
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_HASINCORRECTPRJ_SSS,
-                        a->project, "queue", qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_HASINCORRECTPRJ_SSS,
+                           a->project, "queue", qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -1680,9 +1803,11 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
    /* check if job can run in queue based on excluded projects */
    if ((projects = lGetList(queue, QU_xprojects))) {
       if (a->project && prj_list_locate(projects, a->project)) {
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_EXCLPRJ_SSS,
-                        a->project, "queue", qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_EXCLPRJ_SSS,
+                           a->project, "queue", qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -1694,8 +1819,10 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
    // if we have any queue request lists then check if queues may be requested at all
    if (global_hard_queue_list != nullptr || master_hard_queue_list != nullptr || slave_hard_queue_list != nullptr) {
       if (!centry_list_are_queues_requestable(a->centry_list)) {
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_QUEUENOTREQUESTABLE_S, qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_QUEUENOTREQUESTABLE_S, qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -1707,8 +1834,10 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
          DPRINTF("Queue " SFQ " is not contained in the global hard queue list (-q) "
                               "that was requested by job " sge_u32 "\n",
                               qinstance_name, a->job_id);
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_NOTINHARDQUEUELST_S, qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_NOTINHARDQUEUELST_S, qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    } else {
@@ -1723,6 +1852,10 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
             DPRINTF("Queue " SFQ " is not contained in the master hard queue list that was requested by job " sge_u32 "\n",
                     qinstance_name, a->job_id);
             can_be_master_queue = false;
+            if (prematch) {
+               // the queue has to be untagged, leave it to the regular matching
+               DRETURN(DISPATCH_NEVER_CAT);
+            }
             lClearUlongBitMask(queue, QU_tagged4schedule, TAG4SCHED_MASTER);
          }
       }
@@ -1741,8 +1874,10 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
 
       // if it can be neither master nor slave queue, then it is not a candidate at all
       if (!can_be_master_queue && !can_be_slave_queue) {
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_NOTINHARDQUEUELST_S, qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_NOTINHARDQUEUELST_S, qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -1754,8 +1889,10 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
    if (a->pe != nullptr) { /* parallel job */
       if (!qinstance_is_parallel_queue(queue)) {
          DPRINTF("Queue \"%s\" is not a parallel queue as requested by job %d\n", qinstance_name, (int)a->job_id);
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_NOTPARALLELQUEUE_S, qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_NOTPARALLELQUEUE_S, qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
 
@@ -1764,9 +1901,11 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
        */
       if (!qinstance_is_pe_referenced(queue, a->pe)) {
          DPRINTF("Queue " SFQ " does not reference PE " SFQ "\n", qinstance_name, lGetString(a->pe, PE_name));
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_NOTINQUEUELSTOFPE_SS,
-                        qinstance_name, lGetString(a->pe, PE_name));
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_NOTINQUEUELSTOFPE_SS,
+                           qinstance_name, lGetString(a->pe, PE_name));
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -1775,8 +1914,10 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
       /* is it a ckpt queue ? */
       if (!qinstance_is_checkpointing_queue(queue)) {
          DPRINTF("Queue \"%s\" is not a checkpointing queue as requested by job %d\n", qinstance_name, (int)a->job_id);
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_NOTACKPTQUEUE_SS, qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_NOTACKPTQUEUE_SS, qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
 
@@ -1785,9 +1926,11 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
        */
       if (!qinstance_is_ckpt_referenced(queue, a->ckpt)) {
          DPRINTF("Queue \"%s\" does not reference checkpointing object " SFQ "\n", qinstance_name, lGetString(a->ckpt, CK_name));
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_NOTINQUEUELSTOFCKPT_SS,
-                        qinstance_name, lGetString(a->ckpt, CK_name));
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_NOTINQUEUELSTOFCKPT_SS,
+                           qinstance_name, lGetString(a->ckpt, CK_name));
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -1796,8 +1939,10 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
    if (JOB_TYPE_IS_IMMEDIATE(lGetUlong(a->job, JB_type))) {
       if (!qinstance_is_interactive_queue(queue)) {
          DPRINTF("Queue \"%s\" is not an interactive queue as requested by job %d\n", qinstance_name, (int)a->job_id);
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_QUEUENOTINTERACTIVE_S, qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_QUEUENOTINTERACTIVE_S, qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -1806,8 +1951,10 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
       /* is it a batch or transfer queue */
       if (!qinstance_is_batch_queue(queue)) {
          DPRINTF("Queue \"%s\" is not a batch queue as requested by job %d\n", qinstance_name, (int)a->job_id);
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_NOTASERIALQUEUE_S, qinstance_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_NOTASERIALQUEUE_S, qinstance_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -1816,20 +1963,31 @@ dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
    if (a->ckpt && !a->pe && !JOB_TYPE_IS_IMMEDIATE(lGetUlong(a->job, JB_type)) &&
        qinstance_is_parallel_queue(queue) && !qinstance_is_batch_queue(queue)) {
       DPRINTF("Queue \"%s\" is not a serial queue as requested by job %d\n", qinstance_name, (int)a->job_id);
-      schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                     SCHEDD_INFO_NOTPARALLELJOB_S, qinstance_name);
+      if (!prematch) {
+         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                        SCHEDD_INFO_NOTPARALLELJOB_S, qinstance_name);
+      }
       DRETURN(DISPATCH_NEVER_CAT);
    }
 
-   if (job_is_forced_centry_missing(a, queue, true)) {
+   if (job_is_forced_centry_missing(a, queue, true, prematch)) {
       DRETURN(DISPATCH_NEVER_CAT);
    }
 
    DRETURN(DISPATCH_OK);
 }
 
+dispatch_t sge_queue_match_static(const sge_assignment_t *a, lListElem *queue)
+{
+   if (static_prematch_is_ok(a, queue)) {
+      return DISPATCH_OK;
+   }
+   return queue_match_static(a, queue, false);
+}
+
 static bool
-job_is_forced_centry_missing(const sge_assignment_t *a, const lListElem *queue_or_host, bool is_qinstance)
+job_is_forced_centry_missing(const sge_assignment_t *a, const lListElem *queue_or_host, bool is_qinstance,
+                             bool prematch)
 {
    DENTER(TOP_LAYER);
    bool ret = false;
@@ -1860,17 +2018,21 @@ job_is_forced_centry_missing(const sge_assignment_t *a, const lListElem *queue_o
          // if the centry was not requested then we need to complain about it if it is defined in the current object (queue or host)
          if (is_qinstance) {
             if (qinstance_is_centry_a_complex_value(queue_or_host, centry)) {
-               schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                              SCHEDD_INFO_NOTREQFORCEDRES_SS,
-                              name, lGetString(queue_or_host, QU_full_name));
+               if (!prematch) {
+                  schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                                 SCHEDD_INFO_NOTREQFORCEDRES_SS,
+                                 name, lGetString(queue_or_host, QU_full_name));
+               }
                ret = true;
                break;
             }
          } else {
             if (host_is_centry_a_complex_value(queue_or_host, centry)) {
-               schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                              SCHEDD_INFO_NOFORCEDRES_SS,
-                              name, lGetHost(queue_or_host, EH_name));
+               if (!prematch) {
+                  schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                                 SCHEDD_INFO_NOFORCEDRES_SS,
+                                 name, lGetHost(queue_or_host, EH_name));
+               }
                ret = true;
                break;
 
@@ -2002,8 +2164,8 @@ compute_soft_violations(const sge_assignment_t *a, lListElem *queue, int violati
 *          -1 assignment will never be possible for all jobs of that category
 *          -2 assignment will never be possible for that particular job
 *******************************************************************************/
-dispatch_t
-sge_host_match_static(const sge_assignment_t *a, const lListElem *host)
+static dispatch_t
+host_match_static(const sge_assignment_t *a, const lListElem *host, bool prematch)
 {
    const lList *projects;
    const char *eh_name;
@@ -2022,8 +2184,10 @@ sge_host_match_static(const sge_assignment_t *a, const lListElem *host)
          const lListElem *host = lGetSubHost(a->ar, EH_name, eh_name, AR_reserved_hosts);
          if (host == nullptr) {
             DPRINTF("Host \"%s\" was not reserved by advance reservation %d\n", eh_name, a->ar_id);
-            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                           SCHEDD_INFO_HNOTARRESERVED_SI, eh_name, a->ar_id);
+            if (!prematch) {
+               schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                              SCHEDD_INFO_HNOTARRESERVED_SI, eh_name, a->ar_id);
+            }
             DRETURN(DISPATCH_NEVER_CAT);
          }
       } else {
@@ -2036,8 +2200,10 @@ sge_host_match_static(const sge_assignment_t *a, const lListElem *host)
    if (!sge_has_access_(a->user, a->group, a->grp_list, lGetList(host, EH_acl),
          lGetList(host, EH_xacl), a->acl_list)) {
       DPRINTF("Job %d has no permission for host %s\n", (int)a->job_id, eh_name);
-      schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                     SCHEDD_INFO_HASNOPERMISSION_SS, "host", eh_name);
+      if (!prematch) {
+         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                        SCHEDD_INFO_HASNOPERMISSION_SS, "host", eh_name);
+      }
       DRETURN(DISPATCH_NEVER_CAT);
    }
 
@@ -2045,14 +2211,18 @@ sge_host_match_static(const sge_assignment_t *a, const lListElem *host)
    if ((projects = lGetList(host, EH_prj))) {
 
       if (!a->project) {
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_HASNOPRJ_S, "host", eh_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_HASNOPRJ_S, "host", eh_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
 
       if ((!prj_list_locate(projects, a->project))) {
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_HASINCORRECTPRJ_SSS, a->project, "host", eh_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_HASINCORRECTPRJ_SSS, a->project, "host", eh_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
@@ -2060,13 +2230,15 @@ sge_host_match_static(const sge_assignment_t *a, const lListElem *host)
    /* check if job can run on host based on excluded projects */
    if ((projects = lGetList(host, EH_xprj))) {
       if (a->project && prj_list_locate(projects, a->project)) {
-         schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                        SCHEDD_INFO_EXCLPRJ_SSS, a->project, "host", eh_name);
+         if (!prematch) {
+            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                           SCHEDD_INFO_EXCLPRJ_SSS, a->project, "host", eh_name);
+         }
          DRETURN(DISPATCH_NEVER_CAT);
       }
    }
 
-   if (job_is_forced_centry_missing(a, host, false)) {
+   if (job_is_forced_centry_missing(a, host, false, prematch)) {
       DRETURN(DISPATCH_NEVER_CAT);
    }
 
@@ -2084,8 +2256,10 @@ sge_host_match_static(const sge_assignment_t *a, const lListElem *host)
          if (lGetUlong(ruep, RU_job_number) == a->job_id
              && lGetUlong(ruep, RU_task_number) == task_id) {
             DPRINTF("RU: Job " sge_u32 "." sge_u32 " Host " SFN "\n", a->job_id, task_id, eh_name);
-            schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
-                           SCHEDD_INFO_CLEANUPNECESSARY_S, eh_name);
+            if (!prematch) {
+               schedd_mes_add(a->monitor_alpp, a->monitor_next_run, a->job_id,
+                              SCHEDD_INFO_CLEANUPNECESSARY_S, eh_name);
+            }
             DRETURN(DISPATCH_NEVER_JOB);
          }
       }
@@ -2094,6 +2268,15 @@ sge_host_match_static(const sge_assignment_t *a, const lListElem *host)
    DRETURN(DISPATCH_OK);
 }
 
+dispatch_t
+sge_host_match_static(const sge_assignment_t *a, const lListElem *host)
+{
+   if (static_prematch_is_ok(a, host)) {
+      return DISPATCH_OK;
+   }
+   return host_match_static(a, host, false);
+}
+
 /****** sge_select_queue/is_requested() ****************************************
 *  NAME
 *     is_requested() -- Returns true if specified resource is requested.
@@ -2148,8 +2331,9 @@ bool is_requested(const lListElem *job, const char *attr)
 }
 
 static int
-load_check_alarm(char *reason, size_t reason_size, const char *name, const char *load_value, const char *limit_value,
-                 u_long32 relop, u_long32 type, lListElem *hep, const lListElem *hlep, double lc_host, double lc_global,
+load_check_alarm(char *reason, size_t reason_size, const char *name, const char *load_value,
+                 const lListElem *load_el, const char *limit_value, u_long32 relop, u_long32 type,
+                 lListElem *hep, const lListElem *hlep, double lc_host, double lc_global,
                  const lList *load_adjustments, int load_is_value)
 {
    const lListElem *job_load;
@@ -2167,7 +2351,9 @@ load_check_alarm(char *reason, size_t reason_size, const char *name, const char
       case TYPE_MEM:
       case TYPE_BOO:
       case TYPE_DOUBLE:
-         if (!parse_ulong_val(&load, nullptr, type, load_value, nullptr, 0)) {
+         /* load_el is the load value element load_value was taken from, it contains the parsed value */
+         if (load_el != nullptr ? !load_get_double(load_el, type, &load)
+                                : !parse_ulong_val(&load, nullptr, type, load_value, nullptr, 0)) {
             if (reason)
                snprintf(reason, reason_size, MSG_SCHEDD_WHYEXCEEDINVALIDLOAD_SS, load_value, name);
             DRETURN(1);
@@ -2400,6 +2586,7 @@ sge_load_alarm(char *reason, size_t reason_size, const lListElem *qep, const lLi
    for_each_ep(tep, threshold) {
       const lListElem *hlep = nullptr;
       const lListElem *glep = nullptr;
+      const lListElem *load_el = nullptr;
       const lListElem *queue_ep = nullptr;
       lListElem *cep  = nullptr;
       bool need_free_cep = false;
@@ -2426,10 +2613,12 @@ sge_load_alarm(char *reason, size_t reason_size, const lListElem *qep, const lLi
       if (lGetUlong(cep, CE_consumable) == CONSUMABLE_NO) {
          if (hlep != nullptr) {
             load_value = lGetString(hlep, HL_value);
+            load_el = hlep;
             load_is_value = 0;
          } else if ((global_hep != nullptr) &&
                   ((glep = lGetSubStr(global_hep, HL_name, name, EH_load_list)) != nullptr)) {
                load_value = lGetString(glep, HL_value);
+               load_el = glep;
                load_is_value = 0;
          } else {
             queue_ep = lGetSubStr(qep, CE_name, name, QU_consumable_config_list);
@@ -2460,8 +2649,8 @@ sge_load_alarm(char *reason, size_t reason_size, const lListElem *qep, const lLi
       limit_value = lGetString(tep, CE_stringval);
       type = lGetUlong(cep, CE_valtype);
 
-      if (load_check_alarm(reason, reason_size, name, load_value, limit_value, relop, type, hep, hlep, lc_host,
-                           lc_global, load_adjustments, load_is_value)) {
+      if (load_check_alarm(reason, reason_size, name, load_value, load_el, limit_value, relop, type, hep, hlep,
+                           lc_host, lc_global, load_adjustments, load_is_value)) {
          if (need_free_cep) {
             lFreeElem(&cep);
          }
@@ -3359,12 +3548,12 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
       u_long64 tt_rqs = 0;
       const lListElem *hep;
 
-      qname = lGetString(qep, QU_full_name);
-      cqname = lGetString(qep, QU_qname);
-      eh_name = lGetHost(qep, QU_qhostname);
+      qname = lGetStringInline(qep, QU_full_name);
+      cqname = lGetStringInline(qep, QU_qname);
+      eh_name = lGetHostInline(qep, QU_qhostname);
 
       /* untag this queues */
-      lSetUlong(qep, QU_tag, 0);
+      lSetUlongInline(qep, QU_tag, 0);
 
       /* try to foreclose the cluster queue */
       if (lGetElemStr(a->skip_cqueue_list, CTI_name, cqname)) {
@@ -3385,6 +3574,11 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
          continue;
       }
 
+      // the category did not fit on any host in the previous run, only changed hosts can fit now
+      if (a->is_dirty_hosts_only && !ocs::DirtyTracker::is_dirty_host(eh_name)) {
+         continue;
+      }
+
       // @todo wouldn't it make sense to to the rqs matching (expensive) *after* the static matching?
       if (a->ar == nullptr) {
          bool is_global;
@@ -3500,16 +3694,16 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
 
       if (result == DISPATCH_OK) {
          u_long64 this_tt = 0, this_violations = 0;
-         lSetUlong(qep, QU_tag, 1); /* tag number of slots per queue and time when it will be available */
+         lSetUlongInline(qep, QU_tag, 1); /* tag number of slots per queue and time when it will be available */
 
 
          if (a->start == DISPATCH_TIME_QUEUE_END) {
             DPRINTF("    global " sge_u64" host " sge_u64" queue " sge_u64" rqs " sge_u64"\n",
                   tt_global, tt_host, tt_queue, tt_rqs);
-            lSetUlong64(qep, QU_available_at, this_tt = MAX(tt_queue, MAX(tt_host, MAX(tt_rqs, tt_global))));
+            lSetUlong64Inline(qep, QU_available_at, this_tt = MAX(tt_queue, MAX(tt_host, MAX(tt_rqs, tt_global))));
          }
          if (a->is_soft) {
-            this_violations = lGetUlong(qep, QU_soft_violation);
+            this_violations = lGetUlongInline(qep, QU_soft_violation);
          }
          DPRINTF("    set Q: %s number=1 when=" sge_u64" violations=" sge_u64 "\n", qname, this_tt, this_violations);
          best_queue_result = DISPATCH_OK;
@@ -3518,7 +3712,7 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
             if (!a->is_soft || this_violations == 0) {
                /* we found our queue */
                if (best_qep != nullptr) {
-                  lSetUlong(best_qep, QU_tag, 0);
+                  lSetUlongInline(best_qep, QU_tag, 0);
                }
                break;
             }
@@ -3528,7 +3722,7 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
             if (a->ar == nullptr && (tt_global >= MAX(MAX(tt_queue, tt_host), tt_rqs)) && !a->is_soft) {
                /* we found our queue */
                if (best_qep != nullptr) {
-                  lSetUlong(best_qep, QU_tag, 0);
+                  lSetUlongInline(best_qep, QU_tag, 0);
                }
                break;
             }
@@ -3538,23 +3732,23 @@ sequential_tag_queues_suitable4job(sge_assignment_t *a)
             if (!a->is_reservation) {
                /* check if this queue is better than our last best queue */
                if (this_violations < best_qep_violations) {
-                  lSetUlong(best_qep, QU_tag, 0);
+                  lSetUlongInline(best_qep, QU_tag, 0);
                   best_qep = qep;
                   best_qep_violations = this_violations;
                } else {
                   /* reset QU_tag because another queue is better */
-                  lSetUlong(qep, QU_tag, 0);
+                  lSetUlongInline(qep, QU_tag, 0);
                }
             } else {
                /* earlier start time has higher preference than lower soft violations */
                if (this_tt < best_qep_tt ||
                    (this_tt == best_qep_tt && this_violations < best_qep_violations)) {
-                  lSetUlong(best_qep, QU_tag, 0);
+                  lSetUlongInline(best_qep, QU_tag, 0);
                   best_qep = qep;
                   best_qep_tt = this_tt;
                   best_qep_violations = this_violations;
                } else {
-                  lSetUlong(qep, QU_tag, 0);
+                  lSetUlongInline(qep, QU_tag, 0);
                }
             }
          }
@@ -4605,6 +4799,7 @@ parallel_max_host_slots(sge_assignment_t *a, lListElem *host) {
          lListElem *centry = nullptr;
          const lListElem *cep;
          const lListElem *lv, *fv, *lc;
+         const lListElem *load_el = nullptr;
          const char *load_value, *limit_value, *adj_value;
          double load, threshold, adjustment;
          const char *name = lGetString(tr, CE_name);
@@ -4618,8 +4813,10 @@ parallel_max_host_slots(sge_assignment_t *a, lListElem *host) {
             }
             if ((lv=lGetSubStr(host, HL_name, name, EH_load_list)) != nullptr) {
                load_value = lGetString(lv, HL_value);
+               load_el = lv;
             } else if ((lv = lGetSubStr(a->gep, HL_name, name, EH_load_list)) != nullptr) {
                load_value = lGetString(lv, HL_value);
+               load_el = lv;
             } else {
                fv = lGetSubStr(qep, CE_name, name, QU_consumable_config_list);
                load_value = lGetString(fv, CE_stringval);
@@ -4663,7 +4860,8 @@ parallel_max_host_slots(sge_assignment_t *a, lListElem *host) {
             case TYPE_BOO:
             case TYPE_DOUBLE:
 
-               if (!parse_ulong_val(&load, nullptr, type, load_value, nullptr, 0) ||
+               if (!(load_el != nullptr ? load_get_double(load_el, type, &load)
+                                        : parse_ulong_val(&load, nullptr, type, load_value, nullptr, 0)) ||
                    !parse_ulong_val(&threshold, nullptr, type, limit_value, nullptr, 0) ||
                    !parse_ulong_val(&adjustment, nullptr, type, adj_value, nullptr, 0)) {
                    lFreeElem(&centry);
@@ -4803,7 +5001,9 @@ dispatch_t sge_sequential_assignment(sge_assignment_t *a)
       }
    }
 
+   static_prematch(a);
    result = sequential_tag_queues_suitable4job(a);
+   static_prematch_release();
 
    if (result == DISPATCH_OK) {
       const lListElem *qep;
@@ -5017,7 +5217,9 @@ parallel_assignment(sge_assignment_t *a, category_use_t *use_category, int *avai
    }
 
    /* depends on a correct host order */
+   static_prematch(a);
    ret = parallel_tag_queues_suitable4job(a, use_category, available_slots);
+   static_prematch_release();
 
    if (ret != DISPATCH_OK) {
       DRETURN(ret);
@@ -5114,9 +5316,9 @@ sequential_queue_time(u_long64 *start, const sge_assignment_t *a, int *violation
    dispatch_t result;
    u_long64 tmp_time = *start;
    lList *hard_requests = job_get_hard_resource_listRW(a->job);
-   const lList *config_attr = lGetList(qep, QU_consumable_config_list);
-   const lList *actual_attr = lGetList(qep, QU_resource_utilization);
-   const char *qname = lGetString(qep, QU_full_name);
+   const lList *config_attr = lGetListInline(qep, QU_consumable_config_list);
+   const lList *actual_attr = lGetListInline(qep, QU_resource_utilization);
+   const char *qname = lGetStringInline(qep, QU_full_name);
 
    DENTER(TOP_LAYER);
 
@@ -5204,14 +5406,14 @@ static dispatch_t
 sequential_host_time(u_long64 *start, const sge_assignment_t *a, int *violations, const lListElem *hep)
 {
    lList *hard_requests = job_get_hard_resource_listRW(a->job);
-   const lList *load_attr = lGetList(hep, EH_load_list);
-   const lList *config_attr = lGetList(hep, EH_consumable_config_list);
-   const lList *actual_attr = lGetList(hep, EH_resource_utilization);
+   const lList *load_attr = lGetListInline(hep, EH_load_list);
+   const lList *config_attr = lGetListInline(hep, EH_consumable_config_list);
+   const lList *actual_attr = lGetListInline(hep, EH_resource_utilization);
    double lc_factor = 0;
    u_long32 ulc_factor;
    dispatch_t result;
    u_long64 tmp_time = *start;
-   const char *eh_name = lGetHost(hep, EH_name);
+   const char *eh_name = lGetHostInline(hep, EH_name);
    dstring reason; char reason_buf[1024];
 
    DENTER(TOP_LAYER);
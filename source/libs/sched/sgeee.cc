@@ -53,6 +53,8 @@
 
 #include "comm/commlib.h"
 
+#include "cull/cull_inline.h"
+
 #include "sgeobj/ocs_ShareTree.h"
 #include "sgeobj/ocs_Usage.h"
 #include "sgeobj/ocs_UserProject.h"
@@ -433,16 +435,16 @@ static void task_ref_copy_to_ja_task(sge_task_ref_t *tref, lListElem *ja_task)
    ((ref)->ja_task ? (function)((ref)->ja_task, cull_attr) : (ref_attr))
  
 #define __REF_SET_ULONG(ref, cull_attr, ref_attr, value) \
-   __REF_SET_TYPE(ref, cull_attr, ref_attr, value, lSetUlong)
+   __REF_SET_TYPE(ref, cull_attr, ref_attr, value, lSetUlongInline)
  
 #define __REF_SET_DOUBLE(ref, cull_attr, ref_attr, value) \
-   __REF_SET_TYPE(ref, cull_attr, ref_attr, value, lSetDouble)
+   __REF_SET_TYPE(ref, cull_attr, ref_attr, value, lSetDoubleInline)
  
 #define __REF_GET_ULONG(ref, cull_attr, ref_attr) \
-   __REF_GET_TYPE(ref, cull_attr, ref_attr, lGetUlong)
+   __REF_GET_TYPE(ref, cull_attr, ref_attr, lGetUlongInline)
  
 #define __REF_GET_DOUBLE(ref, cull_attr, ref_attr) \
-   __REF_GET_TYPE(ref, cull_attr, ref_attr, lGetDouble)
+   __REF_GET_TYPE(ref, cull_attr, ref_attr, lGetDoubleInline)
  
 /* u_long32 REF_GET_JA_TASK_NUMBER(sge_ref_t *ref) */
  
@@ -1749,41 +1751,41 @@ static double calc_job_override_tickets( sge_ref_t *ref, int shared) {
 
    if (shared) {
       if (ref->user) {
-         job_cnt = lGetUlong(ref->user, UU_job_cnt);
-         if (((otickets = lGetUlong(ref->user, UU_oticket)) &&
+         job_cnt = lGetUlongInline(ref->user, UU_job_cnt);
+         if (((otickets = lGetUlongInline(ref->user, UU_oticket)) &&
              (job_cnt )))
             job_override_tickets += (otickets / job_cnt);
       }
 
       if (ref->project) {
-         job_cnt = lGetUlong(ref->project, PR_job_cnt);
-         if (((otickets = lGetUlong(ref->project, PR_oticket)) &&
+         job_cnt = lGetUlongInline(ref->project, PR_job_cnt);
+         if (((otickets = lGetUlongInline(ref->project, PR_oticket)) &&
              (job_cnt )))
             job_override_tickets += (otickets / job_cnt);
       }
 
       if (ref->dept) {
-         job_cnt = lGetUlong(ref->dept, US_job_cnt);
-         if (((otickets = lGetUlong(ref->dept, US_oticket)) &&
+         job_cnt = lGetUlongInline(ref->dept, US_job_cnt);
+         if (((otickets = lGetUlongInline(ref->dept, US_oticket)) &&
              (job_cnt )))
             job_override_tickets += (otickets / job_cnt);
       }
    }
    else {
       if (ref->user) {
-         job_override_tickets += lGetUlong(ref->user, UU_oticket);
+         job_override_tickets += lGetUlongInline(ref->user, UU_oticket);
       }
 
       if (ref->project) {
-         job_override_tickets += lGetUlong(ref->project, PR_oticket);
+         job_override_tickets += lGetUlongInline(ref->project, PR_oticket);
       }
 
       if (ref->dept) {
-         job_override_tickets += lGetUlong(ref->dept, US_oticket);
+         job_override_tickets += lGetUlongInline(ref->dept, US_oticket);
       }
    }
 
-   job_override_tickets += lGetUlong(ref->job, JB_override_tickets);
+   job_override_tickets += lGetUlongInline(ref->job, JB_override_tickets);
 
    REF_SET_OTICKET(ref, job_override_tickets);
 
@@ -1804,27 +1806,27 @@ static double calc_pjob_override_tickets_shared( sge_ref_t *ref) {
     *-------------------------------------------------------*/
 
    if (ref->user) {
-      if ((otickets = lGetUlong(ref->user, UU_oticket)) > 0) { 
-         job_cnt = lGetUlong(ref->user, UU_job_cnt) + 1;
+      if ((otickets = lGetUlongInline(ref->user, UU_oticket)) > 0) { 
+         job_cnt = lGetUlongInline(ref->user, UU_job_cnt) + 1;
          job_override_tickets += (otickets / job_cnt);
       }   
    }
 
    if (ref->project) {
-      if ((otickets = lGetUlong(ref->project, PR_oticket)) > 0) {
-         job_cnt = lGetUlong(ref->project, PR_job_cnt) + 1;      
+      if ((otickets = lGetUlongInline(ref->project, PR_oticket)) > 0) {
+         job_cnt = lGetUlongInline(ref->project, PR_job_cnt) + 1;      
          job_override_tickets += (otickets / job_cnt);
       }   
    }
 
    if (ref->dept) {
-      if ((otickets = lGetUlong(ref->dept, US_oticket)) > 0) {
-         job_cnt = lGetUlong(ref->dept, US_job_cnt) + 1;
+      if ((otickets = lGetUlongInline(ref->dept, US_oticket)) > 0) {
+         job_cnt = lGetUlongInline(ref->dept, US_job_cnt) + 1;
          job_override_tickets += (otickets / job_cnt);
       }   
    }
  
-   job_override_tickets += lGetUlong(ref->job, JB_override_tickets);
+   job_override_tickets += lGetUlongInline(ref->job, JB_override_tickets);
 
    REF_SET_OTICKET(ref, job_override_tickets);
 
@@ -1893,7 +1895,7 @@ calc_job_tickets ( sge_ref_t *ref )
          if (active_nslots > 0 && !active_subtasks(job, lGetString(granted_el, JG_qname)))
             slots = 0;
          else
-            slots = lGetUlong(granted_el, JG_slots);
+            slots = lGetUlongInline(granted_el, JG_slots);
          
          if (nslots > 0) {
             job_ftickets_per_slot = (double)(REF_GET_FTICKET(ref))/nslots;
@@ -1905,11 +1907,11 @@ calc_job_tickets ( sge_ref_t *ref )
             job_tickets_per_slot = 0;
          }
 
-         lSetDouble(granted_el, JG_fticket, job_ftickets_per_slot*slots + lGetDouble(granted_el, JG_jcfticket));
-         lSetDouble(granted_el, JG_oticket, job_otickets_per_slot*slots + lGetDouble(granted_el, JG_jcoticket));
-         lSetDouble(granted_el, JG_sticket, job_stickets_per_slot*slots);
-         lSetDouble(granted_el, JG_ticket, job_tickets_per_slot*slots +
-                   lGetDouble(granted_el, JG_jcoticket) + lGetDouble(granted_el, JG_jcfticket));
+         lSetDoubleInline(granted_el, JG_fticket, job_ftickets_per_slot*slots + lGetDoubleInline(granted_el, JG_jcfticket));
+         lSetDoubleInline(granted_el, JG_oticket, job_otickets_per_slot*slots + lGetDoubleInline(granted_el, JG_jcoticket));
+         lSetDoubleInline(granted_el, JG_sticket, job_stickets_per_slot*slots);
+         lSetDoubleInline(granted_el, JG_ticket, job_tickets_per_slot*slots +
+                   lGetDoubleInline(granted_el, JG_jcoticket) + lGetDoubleInline(granted_el, JG_jcfticket));
 
       }
    }
@@ -31,8 +31,12 @@
  *
  ************************************************************************/
 /*___INFO__MARK_END__*/
+#include <algorithm>
 #include <cstring>
 #include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #if !defined(DARWIN) && !defined(FREEBSD)
 #   include <malloc.h>
@@ -75,8 +79,43 @@ enum {
         LOAD_OP_XOR
 };
 
+/*
+ * A compiled load formula.
+ *
+ * + and - have the lowest precedence, all other operators are equal. The formula
+ * is therefore a sequence of terms delimited by + or - signs. Each term consists
+ * of an operand which is optionally combined with a second operand by one of the
+ * other operators. An operand is either a constant or the value of a complex
+ * attribute. The attribute names are collected in attrs, operands referencing an
+ * attribute contain the index into attrs.
+ */
+typedef struct {
+   int attr;                  /* index into load_formula_t::attrs or -1 */
+   double value;              /* constant value if attr is -1 */
+} load_operand_t;
+
+typedef struct {
+   int add_op;                /* LOAD_OP_NONE (first term), LOAD_OP_PLUS or LOAD_OP_MINUS */
+   load_operand_t left;
+   int op;                    /* LOAD_OP_NONE or the operator combining left and right */
+   load_operand_t right;
+} load_term_t;
+
+typedef struct {
+   bool valid;
+   std::vector<std::string> attrs;
+   std::vector<load_term_t> terms;
+} load_formula_t;
+
+/* compiled formulas are cached per thread, the limit protects against an ever growing cache */
+#define LOAD_FORMULA_CACHE_SIZE 64
+
 /* prototypes */
-static int get_load_value(double *dvalp, lListElem *global, lListElem *host, const lList *centry_list, const char *attrname);
+static const load_formula_t *load_formula_get(const char *formula);
+static void load_formula_compile(const char *formula, load_formula_t *lf);
+static void load_formula_operand(load_formula_t *lf, const char *str, const char **end, load_operand_t *operand);
+static void load_formula_evaluate(const load_formula_t *lf, const std::vector<double> &values, size_t n,
+                                  std::vector<double> &loads);
 
 /*************************************************************************
 
@@ -85,6 +124,10 @@ static int get_load_value(double *dvalp, lListElem *global, lListElem *host, con
    purpose:
       sort host list according to a load evaluation formula.
 
+      The formula is compiled once (see load_formula_get()). The values
+      of the attributes it references are collected for all hosts,
+      afterwards the formula is evaluated for all hosts at once.
+
    return values:
       0 on success; -1 otherwise
 
@@ -102,19 +145,69 @@ int sort_host_list(lList *hl, const lList *centry_list)
    lListElem *hlp = nullptr;
    lListElem *global = host_list_locate(hl, SGE_GLOBAL_NAME);
    const char *load_formula = sconf_get_load_formula();
-   double load;
+   const load_formula_t *lf = load_formula_get(load_formula);
+   std::vector<lListElem *> hosts;
 
    DENTER(TOP_LAYER);
 
+   hosts.reserve(lGetNumberOfElem(hl));
    for_each_rw (hlp, hl) {
-      if (hlp == global) {
-         continue;
+      if (hlp != global) {
+         hosts.push_back(hlp);
       }
+   }
+   size_t n = hosts.size();
+   std::vector<double> loads(n, ERROR_LOAD_VAL);
+
+   if (lf != nullptr && lf->valid) {
+      /* one column per attribute, hosts without a value for one of the attributes get ERROR_LOAD_VAL */
+      std::vector<double> values(lf->attrs.size() * n);
+      std::vector<bool> failed(n, false);
+
+      for (size_t a = 0; a < lf->attrs.size(); a++) {
+         const char *attrname = lf->attrs[a].c_str();
+         double *column = values.data() + a * n;
+
+         /* the global value does not depend on the host, look it up only once */
+         lListElem *global_el = nullptr;
+         if (global != nullptr) {
+            global_el = get_host_attribute(global, attrname, centry_list, nullptr, DOMINANT_LAYER_GLOBAL,
+                                           DISPATCH_TIME_NOW, 0);
+         }
 
-      /* build complexes for that host */
-      load = scaled_mixed_load(load_formula, global, hlp, centry_list);
-      lSetDouble(hlp, EH_sort_value, load);
-      DPRINTF("%s: %f\n", lGetHost(hlp, EH_name), load);
+         for (size_t i = 0; i < n; i++) {
+            lListElem *host_el = get_host_attribute(hosts[i], attrname, centry_list, nullptr, DOMINANT_LAYER_HOST,
+                                                    DISPATCH_TIME_NOW, 0);
+            /* same precedence as in get_attribute_by_name() */
+            const lListElem *cep = host_el;
+            if (global_el != nullptr && (host_el == nullptr || is_attr_prior(global_el, host_el))) {
+               cep = global_el;
+            }
+
+            if (cep == nullptr) {
+               /* neither load nor consumable available for that host */
+               failed[i] = true;
+            } else if (lGetUlong(cep, CE_pj_dominant) & DOMINANT_TYPE_VALUE) {
+               column[i] = lGetDouble(cep, CE_doubleval);
+            } else {
+               column[i] = lGetDouble(cep, CE_pj_doubleval);
+            }
+            lFreeElem(&host_el);
+         }
+         lFreeElem(&global_el);
+      }
+
+      load_formula_evaluate(lf, values, n, loads);
+      for (size_t i = 0; i < n; i++) {
+         if (failed[i]) {
+            loads[i] = ERROR_LOAD_VAL;
+         }
+      }
+   }
+
+   for (size_t i = 0; i < n; i++) {
+      lSetDouble(hosts[i], EH_sort_value, loads[i]);
+      DPRINTF("%s: %f\n", lGetHost(hosts[i], EH_name), loads[i]);
    }
    sge_free(&load_formula);
 
@@ -140,189 +233,280 @@ int sort_host_list(lList *hl, const lList *centry_list)
       loaded.
 
    input parameters:
-      load_list      : the host's load list  -> to be passed further
-      scaling_list   : the host's load scaling list   -> to be passed
-                       further
-      host_cplx      : the entries list of the host complex -> to be
-                       passed further
-      lc_factor      : factor that is used to implement load correction: 
-                       0 means no load correction, 
-                       n load correction for n new jobs
+      load_formula   : the load formula
+      global         : the global host
+      host           : the host the load is computed for
+      centry_list    : the complex entry list (CE_Type)
 *************************************************************************/
 double scaled_mixed_load(const char* load_formula, lListElem *global,
                          lListElem *host, const lList *centry_list)
 {
-   char *cp = nullptr;
-   char *tf = nullptr;
-   char *ptr = nullptr;
-   char *ptr2 = nullptr;
-   char *par_name = nullptr;
-   char *op_ptr=nullptr;
+   const load_formula_t *lf;
+
+   DENTER(TOP_LAYER);
+
+   if (load_formula == nullptr || (lf = load_formula_get(load_formula)) == nullptr || !lf->valid) {
+      DRETURN(ERROR_LOAD_VAL);
+   }
+
+   std::vector<double> values(lf->attrs.size());
+   for (size_t a = 0; a < lf->attrs.size(); a++) {
+      lListElem *cep = get_attribute_by_name(global, host, nullptr, lf->attrs[a].c_str(), centry_list, nullptr,
+                                             DISPATCH_TIME_NOW, 0);
+      if (cep == nullptr) {
+         /* neither load nor consumable available for that host */
+         DRETURN(ERROR_LOAD_VAL);
+      }
+
+      if (lGetUlong(cep, CE_pj_dominant) & DOMINANT_TYPE_VALUE) {
+         values[a] = lGetDouble(cep, CE_doubleval);
+      } else {
+         values[a] = lGetDouble(cep, CE_pj_doubleval);
+      }
+      lFreeElem(&cep);
+   }
+
+   std::vector<double> load(1);
+   load_formula_evaluate(lf, values, 1, load);
+
+   DRETURN(load[0]);
+}
+
+/***********************************************************************
+
+   load_formula_get
 
-   double val=0, val2=0;
-   double load=0;
-   int op_pos, next_op=LOAD_OP_NONE;
+   purpose:
+      return the compiled version of a load formula.
+
+      Formulas are compiled on first use and cached per thread. As the
+      formula string is the key, changing the load_formula in the
+      scheduler configuration results in a new compilation.
+
+   return value:
+      the compiled formula or nullptr if it could not be compiled.
+      formulas with syntax errors are returned with valid set to false.
+
+ ***********************************************************************/
+static const load_formula_t *load_formula_get(const char *formula)
+{
+   static thread_local std::unordered_map<std::string, load_formula_t> cache;
+
+   if (formula == nullptr) {
+      return nullptr;
+   }
+
+   auto it = cache.find(formula);
+   if (it == cache.end()) {
+      if (cache.size() >= LOAD_FORMULA_CACHE_SIZE) {
+         cache.clear();
+      }
+      it = cache.emplace(formula, load_formula_t{}).first;
+      load_formula_compile(formula, &it->second);
+   }
+
+   return &it->second;
+}
+
+/***********************************************************************
+
+   load_formula_compile
+
+   purpose:
+      split a load formula into its terms and operands.
+
+      The syntax is the same as accepted by the former interpreter:
+      the formula is tokenized at + and - signs. Only one operator is
+      evaluated per term, further characters of a term are ignored.
+      A '$' in front of an attribute name is skipped.
+
+ ***********************************************************************/
+static void load_formula_compile(const char *formula, load_formula_t *lf)
+{
+   char *tf = nullptr;
+   char *cp = nullptr;
    char *lasts = nullptr;
+   int next_op = LOAD_OP_NONE;
 
    DENTER(TOP_LAYER);
 
+   lf->valid = false;
+
    /* we'll use strtok ==> we need a safety copy */
-   if ((tf = strdup(load_formula)) == nullptr) {
-      DRETURN(ERROR_LOAD_VAL);
+   if ((tf = strdup(formula)) == nullptr) {
+      DRETURN_VOID;
    }
 
-   /* 
-    * + and - have the lowest precedence. all else are equal,
-    * thus formula is delimited by + or - signs
-    * if the load formula begins with a "-" we need to multiply the
-    * first load value with -1
-    */
+   /* if the load formula begins with a "-" we need to multiply the first load value with -1 */
    if (tf[0] == '-') {
       next_op = LOAD_OP_MINUS;
    }
 
-   for (cp=strtok_r(tf, "+-", &lasts); cp; cp = strtok_r(nullptr, "+-", &lasts)) {
-
-      /* ---------------------------------------- */
-      /* get scaled load value                    */
-      /* determine 1st components value           */
-      if (!(val = strtod(cp, &ptr)) && ptr == cp) {
-         /* it is not an integer ==> it's got to be a load value */
-         if (!(par_name = sge_delim_str(cp, &ptr, load_ops)) ||
-               get_load_value(&val, global, host, centry_list, par_name)) {
-            sge_free(&par_name);
-            sge_free(&tf);
+   for (cp = strtok_r(tf, "+-", &lasts); cp; cp = strtok_r(nullptr, "+-", &lasts)) {
+      load_term_t term = {next_op, {-1, 0}, LOAD_OP_NONE, {-1, 0}};
+      const char *ptr = nullptr;
 
-            DRETURN(ERROR_LOAD_VAL);
-         }
-         sge_free(&par_name);
-      }
+      load_formula_operand(lf, cp, &ptr, &term.left);
 
-      /* ---------------------------------------- */
-      /* for the load value                       */
-      /* *ptr now contains the delimiting character for val */
+      /* ptr now contains the delimiting character of the first operand */
       if (*ptr) {
          /* if the delimiter is not \0 it's got to be a operator -> find it */
-         if (!(op_ptr=strchr((char *)load_ops, (int) *ptr))) {
+         const char *op_ptr = strchr(load_ops, (int) *ptr);
+         if (op_ptr == nullptr) {
+            DPRINTF("load formula \"%s\": invalid operator '%c'\n", formula, *ptr);
             sge_free(&tf);
-            DRETURN(ERROR_LOAD_VAL);
-         }
-         op_pos = (int) (op_ptr - load_ops);
-
-         /* ------------------------------- */
-         /* look for a weightening factors  */
-         /* determine 2nd component's value */
-         ptr++;
-         if (!(val2 = strtod(ptr,&ptr2)) && ptr2 == ptr) {
-            /* it is not an integer ==> it's got to be a load value */
-            if (!(par_name = sge_delim_str(ptr,nullptr,load_ops)) ||
-               get_load_value(&val2, global, host, centry_list, par_name)) {
-               sge_free(&par_name);
-               sge_free(&tf);
-               DRETURN(ERROR_LOAD_VAL);
-            }
-            sge_free(&par_name);
+            DRETURN_VOID;
          }
+         term.op = (int) (op_ptr - load_ops);
 
-         /* ------------------------------- */
-         /*  apply according load operator  */
-         switch (op_pos) {
-            case LOAD_OP_TIMES:
-               val *= val2;
-               break;
-            case LOAD_OP_DIV:
-               val /= val2;
-               break;
-            case LOAD_OP_AND: {
-               u_long32 tmp;
-               tmp = (u_long32)val & (u_long32)val2;
-               val = (double)tmp;
-               break;
-            }
-            case LOAD_OP_OR: {
-               u_long32 tmp;
-               tmp = (u_long32)val | (u_long32)val2; 
-               val = (double)tmp;
-               break;
-            }
-            case LOAD_OP_XOR: {
-               u_long32 tmp;
-               tmp = (u_long32)val ^ (u_long32)val2;
-               val = (double)tmp;
-               break;
-            }
-         }     /* switch (op_pos) */
-      }     /* if (*ptr) */
-
-      /* now we have the intermediate result from the subexpression in
-       * between a + or - operator in val. next we've to add or
-       * subtract from the current result value.
-       */
-
-      /* next_op is the next operation from the last run of the while loop.
-       * thus next_op now is the operation to applied
-       */
-      switch (next_op) {
-         case LOAD_OP_NONE:
-            /* this is the first run -> just set load */
-            load = val;
-            break;
-         case LOAD_OP_PLUS:
-            load += val;
-            break;
-         case LOAD_OP_MINUS:
-            load -= val;
-            break;
+         load_formula_operand(lf, ptr + 1, nullptr, &term.right);
       }
+      lf->terms.push_back(term);
 
-      /* determine next_op from the safety copy of the stripped formula */
-      if (load_formula[cp-tf+strlen(cp)] == '+') {
+      /* determine next_op from the original formula */
+      if (formula[cp - tf + strlen(cp)] == '+') {
          next_op = LOAD_OP_PLUS;
-      }   
-      else {
+      } else {
          next_op = LOAD_OP_MINUS;
-      }   
+      }
    }
 
    sge_free(&tf);
+   lf->valid = true;
 
-   DRETURN(load);
+   DRETURN_VOID;
 }
 
-
-
 /***********************************************************************
 
-   get_load_value
+   load_formula_operand
+
+   purpose:
+      parse a constant or an attribute name. attribute names are
+      added to the attribute list of the formula once.
 
  ***********************************************************************/
-static int get_load_value(double *dvalp, lListElem *global, lListElem *host, const lList *centry_list, const char *attrname) 
+static void load_formula_operand(load_formula_t *lf, const char *str, const char **end, load_operand_t *operand)
 {
-   lListElem *cep;
+   char *ptr = nullptr;
 
-   DENTER(TOP_LAYER);
-   
-   /* search complex */
-   if (strchr(attrname, '$')) {
-      attrname++;
-   }
+   operand->attr = -1;
+   operand->value = strtod(str, &ptr);
+   if (operand->value == 0 && ptr == str) {
+      /* it is not a number ==> it's got to be a load value */
+      size_t len = strcspn(str, load_ops);
+      std::string name(str, len);
+
+      if (name.find('$') != std::string::npos) {
+         name.erase(0, 1);
+      }
 
-   if(!(cep = get_attribute_by_name(global, host, nullptr, attrname, centry_list, nullptr, DISPATCH_TIME_NOW, 0))){
-      /* neither load nor consumable available for that host */
-      DRETURN(1);
+      size_t a;
+      for (a = 0; a < lf->attrs.size(); a++) {
+         if (lf->attrs[a] == name) {
+            break;
+         }
+      }
+      if (a == lf->attrs.size()) {
+         lf->attrs.push_back(name);
+      }
+      operand->attr = (int) a;
+      operand->value = 0;
+      ptr = const_cast<char *>(str) + len;
    }
 
-   if (lGetUlong(cep, CE_pj_dominant) & DOMINANT_TYPE_VALUE) {
-      *dvalp = lGetDouble(cep, CE_doubleval);
-   } else {
-      *dvalp = lGetDouble(cep, CE_pj_doubleval);
+   if (end != nullptr) {
+      *end = ptr;
    }
+}
 
-   lFreeElem(&cep);
+/***********************************************************************
 
-   /*
-    * No value available.
-    */
+   load_formula_evaluate
 
-   DRETURN(0);
+   purpose:
+      evaluate a compiled load formula for n hosts.
+
+      values contains one column of n values per attribute of the
+      formula. The terms are evaluated one after the other for all
+      hosts, each step is a simple loop over the columns.
+
+ ***********************************************************************/
+static void load_formula_evaluate(const load_formula_t *lf, const std::vector<double> &values, size_t n,
+                                  std::vector<double> &loads)
+{
+   std::vector<double> left(n);
+   std::vector<double> right(n);
+
+   loads.assign(n, 0);
+
+   for (const load_term_t &term : lf->terms) {
+      double *l = left.data();
+      double *r = right.data();
+      double *load = loads.data();
+
+      if (term.left.attr >= 0) {
+         std::copy_n(values.data() + term.left.attr * n, n, l);
+      } else {
+         std::fill_n(l, n, term.left.value);
+      }
+
+      if (term.op != LOAD_OP_NONE) {
+         if (term.right.attr >= 0) {
+            std::copy_n(values.data() + term.right.attr * n, n, r);
+         } else {
+            std::fill_n(r, n, term.right.value);
+         }
+
+         /* apply according load operator */
+         switch (term.op) {
+            case LOAD_OP_TIMES:
+               for (size_t i = 0; i < n; i++) {
+                  l[i] *= r[i];
+               }
+               break;
+            case LOAD_OP_DIV:
+               for (size_t i = 0; i < n; i++) {
+                  l[i] /= r[i];
+               }
+               break;
+            case LOAD_OP_AND:
+               for (size_t i = 0; i < n; i++) {
+                  l[i] = (double)((u_long32)l[i] & (u_long32)r[i]);
+               }
+               break;
+            case LOAD_OP_OR:
+               for (size_t i = 0; i < n; i++) {
+                  l[i] = (double)((u_long32)l[i] | (u_long32)r[i]);
+               }
+               break;
+            case LOAD_OP_XOR:
+               for (size_t i = 0; i < n; i++) {
+                  l[i] = (double)((u_long32)l[i] ^ (u_long32)r[i]);
+               }
+               break;
+            default:
+               break;
+         }
+      }
+
+      /* add or subtract the term from the current result value */
+      switch (term.add_op) {
+         case LOAD_OP_NONE:
+            std::copy_n(l, n, load);
+            break;
+         case LOAD_OP_PLUS:
+            for (size_t i = 0; i < n; i++) {
+               load[i] += l[i];
+            }
+            break;
+         case LOAD_OP_MINUS:
+            for (size_t i = 0; i < n; i++) {
+               load[i] -= l[i];
+            }
+            break;
+         default:
+            break;
+      }
+   }
 }
@@ -79,6 +79,11 @@
 *    A list containing the new object(s). The list type depends on the event type.
 *    @todo we could split this into two fields, one for lists and one for individual objects
 *
+*    SGE_ULONG64(ET_sequence) - global sequence number
+*    Sequence number of events that were generated for all event clients.
+*    Event clients present the sequence number of the last event they received when they
+*    register again, to get the events they missed from the replay log instead of a total update.
+*
 */
 
 enum {
@@ -90,7 +95,8 @@ enum {
    ET_intkey2,
    ET_strkey,
    ET_strkey2,
-   ET_new_version
+   ET_new_version,
+   ET_sequence
 };
 
 LISTDEF(ET_Type)
@@ -103,6 +109,7 @@ LISTDEF(ET_Type)
    SGE_STRING(ET_strkey, CULL_DEFAULT)
    SGE_STRING(ET_strkey2, CULL_DEFAULT)
    SGE_LIST(ET_new_version, CULL_ANY_SUBTYPE, CULL_DEFAULT)
+   SGE_ULONG64(ET_sequence, CULL_DEFAULT)
 LISTEND
 
 NAMEDEF(ETN)
@@ -115,6 +122,7 @@ NAMEDEF(ETN)
    NAME("ET_strkey")
    NAME("ET_strkey2")
    NAME("ET_new_version")
+   NAME("ET_sequence")
 NAMEEND
 
 #define ET_SIZE sizeof(ETN)/sizeof(char *)
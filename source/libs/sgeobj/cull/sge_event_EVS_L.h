@@ -61,6 +61,11 @@
 *    Condition filtering objects to be sent.
 *    We can for example configure: Send only events for jobs of user xyz.
 *
+*    SGE_BOOL(EVS_coalesce) - Coalesce this Event
+*    Specifies if successive modify events for the same object that have not been delivered yet
+*    are collapsed into the most recent one. Added and deleted objects that have not been delivered
+*    yet are dropped together with their modify events.
+*
 */
 
 enum {
@@ -68,7 +73,8 @@ enum {
    EVS_flush,
    EVS_interval,
    EVS_what,
-   EVS_where
+   EVS_where,
+   EVS_coalesce
 };
 
 LISTDEF(EVS_Type)
@@ -77,6 +83,7 @@ LISTDEF(EVS_Type)
    SGE_ULONG(EVS_interval, CULL_DEFAULT)
    SGE_OBJECT(EVS_what, CULL_ANY_SUBTYPE, CULL_DEFAULT)
    SGE_OBJECT(EVS_where, CULL_ANY_SUBTYPE, CULL_DEFAULT)
+   SGE_BOOL(EVS_coalesce, CULL_DEFAULT)
 LISTEND
 
 NAMEDEF(EVSN)
@@ -85,6 +92,7 @@ NAMEDEF(EVSN)
    NAME("EVS_interval")
    NAME("EVS_what")
    NAME("EVS_where")
+   NAME("EVS_coalesce")
 NAMEEND
 
 #define EVS_SIZE sizeof(EVSN)/sizeof(char *)
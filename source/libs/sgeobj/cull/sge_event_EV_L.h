@@ -103,6 +103,19 @@
 *    Pointer that is passed to the update_function when it is called.
 *    The pointer can be specified during mirror/evc initialize.
 *
+*    SGE_ULONG(EV_sent_number) - last sent event number
+*    Serial number of the last event that was sent to the event client.
+*    Only events with higher numbers may be coalesced.
+*
+*    SGE_ULONG64(EV_resume_sequence) - resume after this event
+*    Sequence number (ET_sequence) of the last event an event client received before it registers again.
+*    If the following events are still in the replay log of the event master, they are delivered
+*    instead of a total update. 0 requests a total update.
+*
+*    SGE_ULONG(EV_version) - GDI version
+*    GDI version of the request that registered the event client.
+*    Set by the event master, it decides about the pack format of event reports.
+*
 */
 
 enum {
@@ -127,7 +140,10 @@ enum {
    EV_sub_array,
    EV_state,
    EV_update_function,
-   EV_update_function_arg
+   EV_update_function_arg,
+   EV_sent_number,
+   EV_resume_sequence,
+   EV_version
 };
 
 LISTDEF(EV_Type)
@@ -153,6 +169,9 @@ LISTDEF(EV_Type)
    SGE_ULONG(EV_state, CULL_DEFAULT)
    SGE_REF(EV_update_function, CULL_ANY_SUBTYPE, CULL_DEFAULT)
    SGE_REF(EV_update_function_arg, CULL_ANY_SUBTYPE, CULL_DEFAULT)
+   SGE_ULONG(EV_sent_number, CULL_DEFAULT)
+   SGE_ULONG64(EV_resume_sequence, CULL_DEFAULT)
+   SGE_ULONG(EV_version, CULL_DEFAULT)
 LISTEND
 
 NAMEDEF(EVN)
@@ -178,6 +197,9 @@ NAMEDEF(EVN)
    NAME("EV_state")
    NAME("EV_update_function")
    NAME("EV_update_function_arg")
+   NAME("EV_sent_number")
+   NAME("EV_resume_sequence")
+   NAME("EV_version")
 NAMEEND
 
 #define EV_SIZE sizeof(EVN)/sizeof(char *)
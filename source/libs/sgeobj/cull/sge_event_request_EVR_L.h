@@ -53,6 +53,10 @@
 *    SGE_LIST(EVR_event_list) - @todo add summary
 *    @todo add description
 *
+*    SGE_LIST(EVR_changed_fields) - Changed Attributes
+*    Attribute names of a modify event that have been changed.
+*    Internal event clients only receive these attributes and the primary key.
+*
 */
 
 enum {
@@ -62,7 +66,8 @@ enum {
    EVR_event_number,
    EVR_session,
    EVR_event_client,
-   EVR_event_list
+   EVR_event_list,
+   EVR_changed_fields
 };
 
 LISTDEF(EVR_Type)
@@ -73,6 +78,7 @@ LISTDEF(EVR_Type)
    SGE_STRING(EVR_session, CULL_DEFAULT)
    SGE_OBJECT(EVR_event_client, CULL_ANY_SUBTYPE, CULL_DEFAULT)
    SGE_LIST(EVR_event_list, ET_Type, CULL_DEFAULT)
+   SGE_LIST(EVR_changed_fields, ULNG_Type, CULL_DEFAULT)
 LISTEND
 
 NAMEDEF(EVRN)
@@ -83,6 +89,7 @@ NAMEDEF(EVRN)
    NAME("EVR_session")
    NAME("EVR_event_client")
    NAME("EVR_event_list")
+   NAME("EVR_changed_fields")
 NAMEEND
 
 #define EVR_SIZE sizeof(EVRN)/sizeof(char *)
@@ -49,13 +49,21 @@
 *     - mem_total
 *    static load values are spooled and therefore are available even if an execution host is down
 *
+*    SGE_DOUBLE(HL_doubleval) - numeric value of the load variable
+*    HL_value parsed as number when the load value is stored, see load_set_value()
+*
+*    SGE_BOOL(HL_is_numeric) - is HL_doubleval valid?
+*    true if HL_value could be parsed as number, else HL_value has to be parsed by the user
+*
 */
 
 enum {
    HL_name = HL_LOWERBOUND,
    HL_value,
    HL_last_update,
-   HL_is_static
+   HL_is_static,
+   HL_doubleval,
+   HL_is_numeric
 };
 
 LISTDEF(HL_Type)
@@ -63,6 +71,8 @@ LISTDEF(HL_Type)
    SGE_STRING(HL_value, CULL_SUBLIST)
    SGE_ULONG64(HL_last_update, CULL_DEFAULT)
    SGE_BOOL(HL_is_static, CULL_DEFAULT)
+   SGE_DOUBLE(HL_doubleval, CULL_DEFAULT)
+   SGE_BOOL(HL_is_numeric, CULL_DEFAULT)
 LISTEND
 
 NAMEDEF(HLN)
@@ -70,6 +80,8 @@ NAMEDEF(HLN)
    NAME("HL_value")
    NAME("HL_last_update")
    NAME("HL_is_static")
+   NAME("HL_doubleval")
+   NAME("HL_is_numeric")
 NAMEEND
 
 #define HL_SIZE sizeof(HLN)/sizeof(char *)
@@ -628,6 +628,9 @@ object_get_subtype(int nm)
       case EVR_event_list:
          ret = ET_Type;
          break;
+      case EVR_changed_fields:
+         ret = ULNG_Type;
+         break;
       case RTIC_tickets:
          ret = OR_Type;
          break;
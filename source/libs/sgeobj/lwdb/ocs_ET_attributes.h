@@ -37,7 +37,8 @@ enum {
    ET_intkey2,
    ET_strkey,
    ET_strkey2,
-   ET_new_version
+   ET_new_version,
+   ET_sequence
 };
 
 constexpr const int ET_Type[] = {
@@ -50,6 +51,7 @@ constexpr const int ET_Type[] = {
    ET_strkey,
    ET_strkey2,
    ET_new_version,
+   ET_sequence,
    AttributeStatic::END_OF_ATTRIBUTES
 };
 
@@ -62,7 +64,8 @@ constexpr const int ET_Type[] = {
    {ET_intkey2, "ET_intkey2", AttributeStatic::UINT32, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
    {ET_strkey, "ET_strkey", AttributeStatic::STRING, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
    {ET_strkey2, "ET_strkey2", AttributeStatic::STRING, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
-   {ET_new_version, "ET_new_version", AttributeStatic::LIST, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false} \
+   {ET_new_version, "ET_new_version", AttributeStatic::LIST, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
+   {ET_sequence, "ET_sequence", AttributeStatic::UINT64, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false} \
 
 } // end namespace
 
@@ -33,7 +33,8 @@ enum {
    EVS_flush,
    EVS_interval,
    EVS_what,
-   EVS_where
+   EVS_where,
+   EVS_coalesce
 };
 
 constexpr const int EVS_Type[] = {
@@ -42,6 +43,7 @@ constexpr const int EVS_Type[] = {
    EVS_interval,
    EVS_what,
    EVS_where,
+   EVS_coalesce,
    AttributeStatic::END_OF_ATTRIBUTES
 };
 
@@ -50,7 +52,8 @@ constexpr const int EVS_Type[] = {
    {EVS_flush, "EVS_flush", AttributeStatic::BOOL, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
    {EVS_interval, "EVS_interval", AttributeStatic::UINT32, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
    {EVS_what, "EVS_what", AttributeStatic::OBJECT, nullptr, 0, AttributeStatic::NO_HASH, false, false}, \
-   {EVS_where, "EVS_where", AttributeStatic::OBJECT, nullptr, 1, AttributeStatic::NO_HASH, false, false} \
+   {EVS_where, "EVS_where", AttributeStatic::OBJECT, nullptr, 1, AttributeStatic::NO_HASH, false, false}, \
+   {EVS_coalesce, "EVS_coalesce", AttributeStatic::BOOL, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false} \
 
 } // end namespace
 
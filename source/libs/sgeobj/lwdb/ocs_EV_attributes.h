@@ -50,7 +50,10 @@ enum {
    EV_sub_array,
    EV_state,
    EV_update_function,
-   EV_update_function_arg
+   EV_update_function_arg,
+   EV_sent_number,
+   EV_resume_sequence,
+   EV_version
 };
 
 constexpr const int EV_Type[] = {
@@ -76,6 +79,9 @@ constexpr const int EV_Type[] = {
    EV_state,
    EV_update_function,
    EV_update_function_arg,
+   EV_sent_number,
+   EV_resume_sequence,
+   EV_version,
    AttributeStatic::END_OF_ATTRIBUTES
 };
 
@@ -101,7 +107,10 @@ constexpr const int EV_Type[] = {
    {EV_sub_array, "EV_sub_array", AttributeStatic::REF, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
    {EV_state, "EV_state", AttributeStatic::UINT32, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
    {EV_update_function, "EV_update_function", AttributeStatic::REF, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
-   {EV_update_function_arg, "EV_update_function_arg", AttributeStatic::REF, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false} \
+   {EV_update_function_arg, "EV_update_function_arg", AttributeStatic::REF, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
+   {EV_sent_number, "EV_sent_number", AttributeStatic::UINT32, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
+   {EV_resume_sequence, "EV_resume_sequence", AttributeStatic::UINT64, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
+   {EV_version, "EV_version", AttributeStatic::UINT32, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false} \
 
 } // end namespace
 
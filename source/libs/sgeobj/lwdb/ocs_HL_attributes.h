@@ -32,7 +32,9 @@ enum {
    HL_name = 850,
    HL_value,
    HL_last_update,
-   HL_is_static
+   HL_is_static,
+   HL_doubleval,
+   HL_is_numeric
 };
 
 constexpr const int HL_Type[] = {
@@ -40,6 +42,8 @@ constexpr const int HL_Type[] = {
    HL_value,
    HL_last_update,
    HL_is_static,
+   HL_doubleval,
+   HL_is_numeric,
    AttributeStatic::END_OF_ATTRIBUTES
 };
 
@@ -47,7 +51,9 @@ constexpr const int HL_Type[] = {
    {HL_name, "HL_name", AttributeStatic::STRING, nullptr, AttributeStatic::NO_POS, AttributeStatic::UNORDERED_UNIQUE, true, false}, \
    {HL_value, "HL_value", AttributeStatic::STRING, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
    {HL_last_update, "HL_last_update", AttributeStatic::UINT64, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
-   {HL_is_static, "HL_is_static", AttributeStatic::BOOL, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false} \
+   {HL_is_static, "HL_is_static", AttributeStatic::BOOL, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
+   {HL_doubleval, "HL_doubleval", AttributeStatic::DOUBLE, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false}, \
+   {HL_is_numeric, "HL_is_numeric", AttributeStatic::BOOL, nullptr, AttributeStatic::NO_POS, AttributeStatic::NO_HASH, false, false} \
 
 } // end namespace
 
@@ -21,6 +21,7 @@
 #include <pthread.h>
 
 #include "uti/sge_log.h"
+#include "uti/sge_mtutil.h"
 #include "uti/sge_rmon_macros.h"
 
 #include "basis_types.h"
@@ -37,6 +38,7 @@ namespace ocs {
    /// thread local storage
    struct obj_thread_local_t {
       DataStore::Id ds_id; ///< default data store ID that should be used by a thread
+      int version;         ///< version of the data store that is accessed by a thread
    };
 
    /// data store structure. hold all master lists.
@@ -44,9 +46,18 @@ namespace ocs {
       lList *master_list[SGE_TYPE_ALL]; ///< master list
    };
 
+   /// version control of a data store (see DataStore::pin_version())
+   struct obj_version_state_t {
+      pthread_mutex_t mutex;                     ///< secures the other attributes
+      pthread_cond_t cond;                       ///< signalled when the last thread unpins a version
+      int active;                                ///< version that is pinned by new readers
+      int pinned[DataStore::MAX_VERSIONS];       ///< number of threads that currently use a version
+   };
+
    /// thread shared storage data type.
    struct obj_thread_shared_t {
-      obj_data_store_t data_store[DataStore::Id::MAX_ID]; ///< all data stores that are available
+      obj_data_store_t data_store[DataStore::Id::MAX_ID][DataStore::MAX_VERSIONS]; ///< all data stores that are available
+      obj_version_state_t version_state[DataStore::Id::MAX_ID]; ///< version control for each data store
    };
 
    /// thread shared storage. the instance that holds all data stores
@@ -66,8 +77,18 @@ namespace ocs {
 
       // initialize thread shared storage that hold all data stores (== master lists)
       for (int ds_id = DataStore::Id::GLOBAL; ds_id < DataStore::Id::MAX_ID; ds_id++) {
-         for (auto &master_list: obj_thread_shared.data_store[ds_id].master_list) {
-            master_list = nullptr;
+         for (auto &version : obj_thread_shared.data_store[ds_id]) {
+            for (auto &master_list: version.master_list) {
+               master_list = nullptr;
+            }
+         }
+
+         obj_version_state_t *version_state = &obj_thread_shared.version_state[ds_id];
+         pthread_mutex_init(&version_state->mutex, nullptr);
+         pthread_cond_init(&version_state->cond, nullptr);
+         version_state->active = 0;
+         for (auto &pinned : version_state->pinned) {
+            pinned = 0;
          }
       }
    }
@@ -95,6 +116,7 @@ namespace ocs {
       // as default each thread will access the OBJ_STATE_GLOBAL data store
       // if it does not change to a different one with ocs::DataStore::select_active_ds()
       state->ds_id = DataStore::Id::GLOBAL;
+      state->version = 0;
       DRETURN_VOID;
    }
 
@@ -109,6 +131,113 @@ namespace ocs {
       DENTER(DATA_STORE_LAYER);
       GET_SPECIFIC(obj_thread_local_t, obj_state, obj_state_init, obj_state_key);
       obj_state->ds_id = ds_id;
+      obj_state->version = 0;
+      DRETURN_VOID;
+   }
+
+   /**
+    * Pins the most recently published version of the active data store.
+    *
+    * Data stores that are filled by an event mirror thread can exist in multiple versions. The mirror thread
+    * applies new events to a version that is not used by any other thread and publishes it afterward
+    * (see DataStore::select_unused_version() and DataStore::publish_version()). Threads that only read
+    * the data store pin the published version instead of acquiring a lock, so that they are never blocked
+    * by the mirror thread. The pinned version stays unchanged till DataStore::unpin_version() is called.
+    */
+   void
+   DataStore::pin_version() {
+      DENTER(DATA_STORE_LAYER);
+      GET_SPECIFIC(obj_thread_local_t, obj_state, obj_state_init, obj_state_key);
+      obj_version_state_t *version_state = &obj_thread_shared.version_state[obj_state->ds_id];
+
+      sge_mutex_lock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+      obj_state->version = version_state->active;
+      version_state->pinned[obj_state->version]++;
+      sge_mutex_unlock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+      DRETURN_VOID;
+   }
+
+   /**
+    * Releases the version of the active data store that was pinned with DataStore::pin_version().
+    */
+   void
+   DataStore::unpin_version() {
+      DENTER(DATA_STORE_LAYER);
+      GET_SPECIFIC(obj_thread_local_t, obj_state, obj_state_init, obj_state_key);
+      obj_version_state_t *version_state = &obj_thread_shared.version_state[obj_state->ds_id];
+
+      sge_mutex_lock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+      version_state->pinned[obj_state->version]--;
+      if (version_state->pinned[obj_state->version] == 0) {
+         pthread_cond_broadcast(&version_state->cond);
+      }
+      sge_mutex_unlock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+      DRETURN_VOID;
+   }
+
+   /**
+    * Selects a version of the active data store that is currently not published and waits till
+    * the last thread that still uses this version called DataStore::unpin_version().
+    *
+    * Only one thread (the mirror thread of the data store) is allowed to modify versions.
+    */
+   void
+   DataStore::select_unused_version() {
+      DENTER(DATA_STORE_LAYER);
+      GET_SPECIFIC(obj_thread_local_t, obj_state, obj_state_init, obj_state_key);
+      obj_version_state_t *version_state = &obj_thread_shared.version_state[obj_state->ds_id];
+
+      sge_mutex_lock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+      obj_state->version = (version_state->active + 1) % MAX_VERSIONS;
+      while (version_state->pinned[obj_state->version] > 0) {
+         pthread_cond_wait(&version_state->cond, &version_state->mutex);
+      }
+      sge_mutex_unlock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+      DRETURN_VOID;
+   }
+
+   /**
+    * Publishes the version of the active data store that was selected with DataStore::select_unused_version()
+    * so that it will be pinned by subsequent calls of DataStore::pin_version().
+    */
+   void
+   DataStore::publish_version() {
+      DENTER(DATA_STORE_LAYER);
+      GET_SPECIFIC(obj_thread_local_t, obj_state, obj_state_init, obj_state_key);
+      obj_version_state_t *version_state = &obj_thread_shared.version_state[obj_state->ds_id];
+
+      sge_mutex_lock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+      version_state->active = obj_state->version;
+      sge_mutex_unlock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+      DRETURN_VOID;
+   }
+
+   /**
+    * Replaces all master lists of the version that was selected with DataStore::select_unused_version()
+    * by copies of the master lists of the published version.
+    *
+    * Sublists that are marked as shared (see lMarkListShared()) are not copied but shared by both versions.
+    */
+   void
+   DataStore::copy_published_version() {
+      DENTER(DATA_STORE_LAYER);
+      GET_SPECIFIC(obj_thread_local_t, obj_state, obj_state_init, obj_state_key);
+      obj_version_state_t *version_state = &obj_thread_shared.version_state[obj_state->ds_id];
+
+      sge_mutex_lock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+      int published = version_state->active;
+      sge_mutex_unlock("data_store_version_mutex", __func__, __LINE__, &version_state->mutex);
+
+      if (published != obj_state->version) {
+         auto &source = obj_thread_shared.data_store[obj_state->ds_id][published];
+         auto &target = obj_thread_shared.data_store[obj_state->ds_id][obj_state->version];
+         for (int type = SGE_TYPE_FIRST; type < SGE_TYPE_ALL; type++) {
+            lFreeList(&target.master_list[type]);
+            if (source.master_list[type] != nullptr) {
+               target.master_list[type] = lCopyList(nullptr, source.master_list[type]);
+            }
+         }
+      }
       DRETURN_VOID;
    }
 
@@ -149,7 +278,7 @@ namespace ocs {
 #endif
 
       lList **ret;
-      ret = &(obj_thread_shared.data_store[obj_state->ds_id].master_list[type]);
+      ret = &(obj_thread_shared.data_store[obj_state->ds_id][obj_state->version].master_list[type]);
 #ifdef OBSERVE
       DPRINTF("ds: %d, type: %d, list: %p\n", obj_state->ds_id, type, *ret);
       if (*obj_state->object_base[type].list) {
@@ -173,7 +302,7 @@ namespace ocs {
    }
 
    /**
-    * Free all master lists in the currently active data store of the thread.
+    * Free all master lists of all versions in the currently active data store of the thread.
     *
     * @todo nowhere used. would expect that at least one method should be called that releases the complete DS.
     * @todo correct place is either the event client (e.g. the scheduler) or the mirror thread that we will introduce.
@@ -182,8 +311,10 @@ namespace ocs {
    DataStore::free_all_master_lists() {
       DENTER(DATA_STORE_LAYER);
       GET_SPECIFIC(obj_thread_local_t, obj_state, obj_state_init, obj_state_key);
-      for (int type = SGE_TYPE_FIRST; type < SGE_TYPE_ALL; type++) {
-         lFreeList(get_master_list_rw(static_cast<sge_object_type>(type)));
+      for (auto &version : obj_thread_shared.data_store[obj_state->ds_id]) {
+         for (int type = SGE_TYPE_FIRST; type < SGE_TYPE_ALL; type++) {
+            lFreeList(&version.master_list[type]);
+         }
       }
       DRETURN_VOID;
    }
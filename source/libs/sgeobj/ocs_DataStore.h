@@ -37,9 +37,28 @@ namespace ocs {
          MAX_ID,       ///< Maximum amount of thread local storages
       };
 
+      /// number of versions that can exist for a data store. Each version holds its own copy of the objects,
+      /// only lists marked with lMarkListShared() (e.g. the immutable job sublists) exist once
+      static constexpr int MAX_VERSIONS = 2;
+
       static void
       select_active_ds(ocs::DataStore::Id ds_id);
 
+      static void
+      pin_version();
+
+      static void
+      unpin_version();
+
+      static void
+      select_unused_version();
+
+      static void
+      publish_version();
+
+      static void
+      copy_published_version();
+
       static lList **
       get_master_list_rw(sge_object_type type, bool for_read = false);
 
@@ -49,9 +49,13 @@
  * task priority, submit time and job number. The sorting is done in descending order
  * of task priority, and in ascending order of job number for jobs with the same priority.
  *
+ * Large job lists can be sorted in parallel, see lSortListParallel().
+ *
  * @param job_list Pointer to the list of jobs to be sorted.
+ * @param sort_parts Number of parts that are sorted in parallel
+ * @param sort_runner Runner of the caller that sorts the parts
  */
-void ocs::Job::sgeee_sort_jobs(lList **job_list) {
+void ocs::Job::sgeee_sort_jobs(lList **job_list, size_t sort_parts, const lSortRunner &sort_runner) {
    DENTER(TOP_LAYER);
 
    if (!job_list || !*job_list) {
@@ -85,7 +89,10 @@ void ocs::Job::sgeee_sort_jobs(lList **job_list) {
    }
 
    // Sort the temporary list according to the following criteria:
-   lPSortList(tmp_list, "%I- %I+ %I+", SGEJ_priority, SGEJ_submission_time, SGEJ_job_number);
+   lSortOrder *order = lParseSortOrderVarArg(lGetListDescr(tmp_list), "%I- %I+ %I+",
+                                             SGEJ_priority, SGEJ_submission_time, SGEJ_job_number);
+   lSortListParallel(tmp_list, order, sort_parts, sort_runner);
+   lFreeSortOrder(&order);
 
    // The job list is empty at this point, so we can just append the sorted jobs
    for_each_rw(job, tmp_list) {
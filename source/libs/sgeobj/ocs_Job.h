@@ -38,6 +38,6 @@
 namespace ocs {
    class Job {
    public:
-      static void sgeee_sort_jobs(lList **job_list);
+      static void sgeee_sort_jobs(lList **job_list, size_t sort_parts = 1, const lSortRunner &sort_runner = nullptr);
    };
 }
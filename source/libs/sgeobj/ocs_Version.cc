@@ -43,7 +43,10 @@
 
 const std::string OCS_VERSION_STRING{std::to_string(OCS_VERSION_MAJOR) + "."
          + std::to_string(OCS_VERSION_MINOR) + "." + std::to_string(OCS_VERSION_PATCH) + OCS_VERSION_SUFFIX};
-const uint32_t OCS_VERSION{0x10009001};
+const uint32_t OCS_VERSION{0x10009002};
+
+// first version that reads the compact pack format (CULL_FORMAT_COMPACT)
+const uint32_t OCS_COMPACT_PACK_VERSION{0x10009002};
 
 static const std::vector<std::tuple<uint32_t, std::string>> OCS_ALL_VERSIONS_VECTOR{
    { 0x10000000, "5.0"},
@@ -74,6 +77,7 @@ static const std::vector<std::tuple<uint32_t, std::string>> OCS_ALL_VERSIONS_VEC
    { 0x10003000, "8.0.x Univa"},
    { 0x10003001, "8.0.x Some Gridengine"},
    { 0x10009000, "9.0.x Gridware Cluster Scheduler"},
+   { 0x10009001, "9.1.0prealpha without compact packing"},
    { OCS_VERSION, OCS_VERSION_STRING},
 };
 
@@ -174,6 +178,18 @@ ocs::Version::do_versions_match(lList **alpp, const uint32_t version, const char
 }
 
 
+/** @brief Return true if a peer of the given version can read the compact pack format
+ *
+ * Packbuffers sent to a peer use the compact format (CULL_FORMAT_COMPACT) only if the peer announced a version
+ * that supports it. All other peers get the default format.
+ *
+ * @param version The version of the peer, e.g. the GDI version of a request
+ * @return true if the compact format may be used
+ */
+bool
+ocs::Version::is_compact_pack_supported(const uint32_t version) {
+   return version >= OCS_COMPACT_PACK_VERSION && version <= get_version();
+}
 
 #if !(ADD_COPYRIGHT || ADD_HPC_GRIDWARE_COPYRIGHT)
 extern const char SFLN_ELN[]{"\n\
@@ -37,6 +37,7 @@ namespace ocs {
       static std::string get_long_product_name();
 
       static bool do_versions_match(lList **alpp, uint32_t version, const char *host, const char *commproc, int id);
+      static bool is_compact_pack_supported(uint32_t version);
    };
 }
 
@@ -161,6 +161,12 @@ static bool disable_secondary_ds_execd = DEFAULT_DISABLE_SECONDARY_DS_EXECD;
 #define DEFAULT_DISABLE_AUTOMATIC_SESSIONS (false)
 static bool disable_automatic_sessions = DEFAULT_DISABLE_AUTOMATIC_SESSIONS;
 
+#define DEFAULT_ENABLE_FINE_GRAINED_LOCKING (false)
+static bool enable_fine_grained_locking = DEFAULT_ENABLE_FINE_GRAINED_LOCKING;
+
+#define DEFAULT_EVENT_REPLAY_LOG_SIZE (10000)
+static int event_replay_log_size = DEFAULT_EVENT_REPLAY_LOG_SIZE;
+
 static bool prof_listener_thrd = false;
 static bool prof_worker_thrd = false;
 static bool prof_signal_thrd = false;
@@ -691,6 +697,8 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
       disable_secondary_ds_reader = DEFAULT_DISABLE_SECONDARY_DS_READER;
       disable_secondary_ds_execd = DEFAULT_DISABLE_SECONDARY_DS_EXECD;
       disable_automatic_sessions = DEFAULT_DISABLE_AUTOMATIC_SESSIONS;
+      enable_fine_grained_locking = DEFAULT_ENABLE_FINE_GRAINED_LOCKING;
+      event_replay_log_size = DEFAULT_EVENT_REPLAY_LOG_SIZE;
       simulate_execds = false;
       simulate_jobs = false;
       prof_listener_thrd = false;
@@ -800,6 +808,18 @@ int merge_configuration(lList **answer_list, u_long32 progid, const char *cell_r
          if (parse_bool_param(s, "DISABLE_AUTOMATIC_SESSIONS", &disable_automatic_sessions)) {
             continue;
          }
+         if (parse_bool_param(s, "ENABLE_FINE_GRAINED_LOCKING", &enable_fine_grained_locking)) {
+            continue;
+         }
+         if (parse_int_param(s, "EVENT_REPLAY_LOG_SIZE", &event_replay_log_size, TYPE_INT)) {
+            if (event_replay_log_size < 0) {
+               event_replay_log_size = DEFAULT_EVENT_REPLAY_LOG_SIZE;
+               answer_list_add_sprintf(answer_list, STATUS_ESYNTAX, ANSWER_QUALITY_WARNING,
+                                       MSG_CONF_INVALIDPARAM_SSI, "qmaster_params", "EVENT_REPLAY_LOG_SIZE",
+                                       DEFAULT_EVENT_REPLAY_LOG_SIZE);
+            }
+            continue;
+         }
          if (parse_int_param(s, "MAX_DS_DEVIATION", &max_ds_deviation, TYPE_TIM)) {
             if (max_ds_deviation < 0 || max_ds_deviation > 5000) {
                max_ds_deviation = DEFAULT_DS_DEVIATION;
@@ -2402,6 +2422,30 @@ bool mconf_get_disable_automatic_session() {
    DRETURN(ret);
 }
 
+bool mconf_get_enable_fine_grained_locking() {
+   bool ret;
+
+   DENTER(BASIS_LAYER);
+   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
+
+   ret = enable_fine_grained_locking;
+
+   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
+   DRETURN(ret);
+}
+
+int mconf_get_event_replay_log_size() {
+   int ret;
+
+   DENTER(BASIS_LAYER);
+   SGE_LOCK(LOCK_MASTER_CONF, LOCK_READ);
+
+   ret = event_replay_log_size;
+
+   SGE_UNLOCK(LOCK_MASTER_CONF, LOCK_READ);
+   DRETURN(ret);
+}
+
 int mconf_get_scheduler_timeout() {
    int timeout;
 
@@ -1872,6 +1872,50 @@ void job_set_env_string(lListElem *job, const char* variable, const char* value)
    DRETURN_VOID; 
 }
 
+/****** sgeobj/job/job_mark_immutable_sublists_shared() **********************
+*  NAME
+*     job_mark_immutable_sublists_shared() -- share big job sublists
+*
+*  SYNOPSIS
+*     void job_mark_immutable_sublists_shared(lListElem *job)
+*
+*  FUNCTION
+*     Marks those sublists of "job" as shared lists (see lMarkListShared())
+*     that are specified at submit time and only replaced as a whole
+*     (e.g. by qalter). Copies of the job reference these lists instead of
+*     duplicating them.
+*
+*  INPUTS
+*     lListElem *job - JB_Type element
+*
+*  NOTES
+*     MT-NOTE: job_mark_immutable_sublists_shared() is not MT safe
+******************************************************************************/
+void job_mark_immutable_sublists_shared(lListElem *job) {
+   const int field[] = {
+      JB_env_list,
+      JB_job_args,
+      JB_context,
+      JB_shell_list,
+      JB_stdout_path_list,
+      JB_stderr_path_list,
+      JB_stdin_path_list,
+      JB_mail_list,
+      -1
+   };
+
+   if (job != nullptr) {
+      for (int i = 0; field[i] != -1; i++) {
+         /* modify events might only contain the changed attributes */
+         int pos = lGetPosViaElem(job, field[i], SGE_NO_ABORT);
+
+         if (pos >= 0) {
+            lMarkListShared(lGetPosList(job, pos));
+         }
+      }
+   }
+}
+
 /****** sgeobj/job/job_check_correct_id_sublists() ****************************
 *  NAME
 *     job_check_correct_id_sublists() -- test JB_ja_* sublists 
@@ -2572,7 +2616,7 @@ int job_resolve_host_for_path_list(const lListElem *job, lList **answer_list,
 
    DENTER(TOP_LAYER);
 
-   for_each_rw(ep, lGetList(job, name)){
+   for_each_rw(ep, lGetListRW(job, name)){
       int res = sge_resolve_host(ep, PN_host);
       DPRINTF("after sge_resolve_host() which returned %s\n", cl_get_error_text(res));
       if (res != CL_RETVAL_OK) { 
@@ -34,6 +34,7 @@
 
 #include <cstring>
 
+#include "uti/sge_parse_num_par.h"
 #include "uti/sge_rmon_macros.h"
 
 #include "sgeobj/sge_host.h"
@@ -73,3 +74,92 @@ load_list_get_nproc(const lList *load_list) {
 
    return nproc;
 }
+
+/****** sgeobj/load/load_set_value() *******************************************
+*  NAME
+*     load_set_value() -- set the value of a load value element
+*
+*  SYNOPSIS
+*     void load_set_value(lListElem *load_el, const char *value)
+*
+*  FUNCTION
+*     Stores the value as HL_value. If it is a number it is parsed once and
+*     stored additionally as HL_doubleval, so that users of the load value
+*     (especially the scheduler) do not have to parse the string again.
+*
+*     The parsed value does not depend on the type of the complex attribute:
+*     all numeric types are parsed by sge_parse_num_val().
+*
+*  INPUTS
+*     lListElem *load_el - load value element (HL_Type)
+*     const char *value  - the new value
+*
+*  NOTES
+*     MT-NOTE: load_set_value() is MT safe
+*
+*  SEE ALSO
+*     sgeobj/load/load_get_double()
+*******************************************************************************/
+void
+load_set_value(lListElem *load_el, const char *value) {
+   double dval = 0.0;
+   bool is_numeric = parse_ulong_val(&dval, nullptr, TYPE_DOUBLE, value, nullptr, 0) != 0;
+   int pos;
+
+   /* load values read from an old spooling database might not contain the numeric value */
+   if ((pos = lGetPosViaElem(load_el, HL_is_numeric, SGE_NO_ABORT)) >= 0) {
+      lSetPosBool(load_el, pos, is_numeric);
+      lSetDouble(load_el, HL_doubleval, is_numeric ? dval : 0.0);
+   }
+   lSetString(load_el, HL_value, value);
+}
+
+/****** sgeobj/load/load_get_double() ******************************************
+*  NAME
+*     load_get_double() -- numeric value of a load value element
+*
+*  SYNOPSIS
+*     bool load_get_double(const lListElem *load_el, u_long32 type,
+*                          double *dval)
+*
+*  FUNCTION
+*     Returns the value of a load value as number. The value parsed by
+*     load_set_value() is used if available, otherwise HL_value is parsed
+*     like parse_ulong_val() does.
+*
+*  INPUTS
+*     const lListElem *load_el - load value element (HL_Type)
+*     u_long32 type            - type of the complex attribute (TYPE_*)
+*     double *dval             - the numeric value
+*
+*  RESULT
+*     bool - true if the load value is a valid value of the given type
+*
+*  NOTES
+*     MT-NOTE: load_get_double() is MT safe
+*
+*  SEE ALSO
+*     sgeobj/load/load_set_value()
+*******************************************************************************/
+bool
+load_get_double(const lListElem *load_el, u_long32 type, double *dval) {
+   int pos;
+
+   switch (type) {
+      case TYPE_RSMAP:
+      case TYPE_INT:
+      case TYPE_TIM:
+      case TYPE_MEM:
+      case TYPE_BOO:
+      case TYPE_DOUBLE:
+         if ((pos = lGetPosViaElem(load_el, HL_is_numeric, SGE_NO_ABORT)) >= 0 && lGetPosBool(load_el, pos)) {
+            *dval = lGetDouble(load_el, HL_doubleval);
+            return true;
+         }
+         break;
+      default:
+         break;
+   }
+
+   return parse_ulong_val(dval, nullptr, type, lGetString(load_el, HL_value), nullptr, 0) != 0;
+}
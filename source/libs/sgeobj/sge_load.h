@@ -38,3 +38,9 @@ sge_is_static_load_value(const char *name);
 
 int
 load_list_get_nproc(const lList *load_list);
+
+void
+load_set_value(lListElem *load_el, const char *value);
+
+bool
+load_get_double(const lListElem *load_el, u_long32 type, double *dval);
@@ -1788,6 +1788,10 @@ object_replace_any_type(lListElem *this_elem, int name, lListElem *org_elem) {
       void *value = lGetPosRef(org_elem, in_pos);
 
       cull_ret = lSetPosRef(this_elem, out_pos, value);
+   } else if (type == lUlong64T) {
+      u_long64 value = lGetPosUlong64(org_elem, in_pos);
+
+      cull_ret = lSetPosUlong64(this_elem, out_pos, value);
    } else {
       /* not possible */
       cull_ret = -1;
@@ -1795,6 +1799,95 @@ object_replace_any_type(lListElem *this_elem, int name, lListElem *org_elem) {
    DRETURN(cull_ret == 0 ? true : false);
 }
 
+/****** sgeobj/object/object_is_delta() ****************************************
+*  NAME
+*     object_is_delta() -- is an element a delta of another one?
+*
+*  SYNOPSIS
+*     bool
+*     object_is_delta(const lListElem *this_elem, const lListElem *delta)
+*
+*  FUNCTION
+*     Modify events for internal event clients might only contain the
+*     primary key and the attributes that have been changed (see
+*     sge_add_delta_event()). Such an element has a reduced descriptor
+*     with less attributes than the complete object.
+*
+*  INPUTS
+*     const lListElem *this_elem - the complete object
+*     const lListElem *delta     - the object received with an event
+*
+*  RESULT
+*     bool - true if "delta" contains less attributes than "this_elem"
+*
+*  NOTES
+*     MT-NOTE: object_is_delta() is MT safe
+*
+*  SEE ALSO
+*     sgeobj/object/object_apply_delta()
+*******************************************************************************/
+bool
+object_is_delta(const lListElem *this_elem, const lListElem *delta) {
+   if (this_elem == nullptr || delta == nullptr) {
+      return false;
+   }
+   return lCountDescr(lGetElemDescr(delta)) < lCountDescr(lGetElemDescr(this_elem));
+}
+
+/****** sgeobj/object/object_apply_delta() *************************************
+*  NAME
+*     object_apply_delta() -- merge a delta into an object
+*
+*  SYNOPSIS
+*     bool
+*     object_apply_delta(lListElem *this_elem, lListElem *delta)
+*
+*  FUNCTION
+*     Copies all attributes of "delta" into "this_elem". Attributes that
+*     are not part of "delta" keep their value. Lists and objects are
+*     moved from "delta" to "this_elem", replaced lists are left in "delta".
+*     Attributes of "delta" that "this_elem" does not know are ignored.
+*
+*  INPUTS
+*     lListElem *this_elem - the complete object
+*     lListElem *delta     - the reduced object received with an event
+*
+*  RESULT
+*     bool - true on success
+*
+*  NOTES
+*     MT-NOTE: object_apply_delta() is MT safe
+*
+*  SEE ALSO
+*     sgeobj/object/object_is_delta()
+*******************************************************************************/
+bool
+object_apply_delta(lListElem *this_elem, lListElem *delta) {
+   bool ret = true;
+
+   DENTER(OBJECT_LAYER);
+   for (const lDescr *descr = lGetElemDescr(delta); ret && descr->nm != NoName; descr++) {
+      int nm = descr->nm;
+
+      if (lGetPosViaElem(this_elem, nm, SGE_NO_ABORT) < 0) {
+         continue;
+      }
+
+      switch (mt_get_type(descr->mt)) {
+         case lListT:
+            ret = lSwapList(this_elem, nm, delta, nm) == 0;
+            break;
+         case lObjectT:
+            ret = lSetObject(this_elem, nm, lDechainObject(delta, nm)) == 0;
+            break;
+         default:
+            ret = object_replace_any_type(this_elem, nm, delta);
+            break;
+      }
+   }
+   DRETURN(ret);
+}
+
 void
 object_get_any_type(const lListElem *this_elem, int name, void *value) {
    DENTER(OBJECT_LAYER);
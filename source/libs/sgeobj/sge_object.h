@@ -271,6 +271,12 @@ object_set_any_type(lListElem *this_elem, int name, void *value);
 bool
 object_replace_any_type(lListElem *this_elem, int name, lListElem *org_elem);
 
+bool
+object_is_delta(const lListElem *this_elem, const lListElem *delta);
+
+bool
+object_apply_delta(lListElem *this_elem, lListElem *delta);
+
 void
 object_get_any_type(const lListElem *this_elem, int name, void *value);
 
@@ -120,6 +120,7 @@
 #define DEFAULT_DURATION                    "INFINITY"     // the default_duration and default_duration_I have to be
 #define DEFAULT_DURATION_I                  600            // in sync. On is the string version of the other (based on seconds)
 #define DEFAULT_DURATION_OFFSET             60
+#define MAX_MATCH_THREADS                   256
 
 /**
  * multithreading support, thread local
@@ -303,6 +304,8 @@ typedef struct{
 static bool schedd_profiling = false;
 static bool current_serf_do_monitoring = false;
 static schedd_pe_algorithm  pe_algorithm = SCHEDD_PE_AUTO;
+static int match_threads = 0;
+static bool incremental_scheduling = false;
 
 static bool calc_pos();
 
@@ -331,6 +334,12 @@ sconf_eval_set_duration_offset(lList *param_list, lList **answer_list, const cha
 static bool 
 sconf_eval_set_pe_range_alg(lList *param_list, lList **answer_list, const char* param); 
 
+static bool
+sconf_eval_set_match_threads(lList *param_list, lList **answer_list, const char* param);
+
+static bool
+sconf_eval_set_incremental_scheduling(lList *param_list, lList **answer_list, const char* param);
+
 static char policy_hierarchy_enum2char(policy_type_t value);
 
 static policy_type_t policy_hierarchy_char2enum(char character);
@@ -361,6 +370,8 @@ const parameters_t params[] = {
    {"MONITOR",         sconf_eval_set_monitoring},
    {"DURATION_OFFSET", sconf_eval_set_duration_offset},
    {"PE_RANGE_ALG",    sconf_eval_set_pe_range_alg},
+   {"MATCH_THREADS",   sconf_eval_set_match_threads},
+   {"INCREMENTAL_SCHEDULING", sconf_eval_set_incremental_scheduling},
    {"NONE",            nullptr},
    {nullptr,           nullptr}
 };
@@ -2803,6 +2814,8 @@ bool sconf_validate_config_(lList **answer_list)
       current_serf_do_monitoring = false;
       pos.s_duration_offset = DEFAULT_DURATION_OFFSET; 
       pe_algorithm = SCHEDD_PE_AUTO;
+      match_threads = 0;
+      incremental_scheduling = false;
 
       if (sparams) {
          struct saved_vars_s *context = nullptr;
@@ -3535,6 +3548,97 @@ static bool sconf_eval_set_pe_range_alg(lList *param_list, lList **answer_list,
    DRETURN(false);
 }
 
+/****** sge_schedd_conf/sconf_eval_set_match_threads() ************************
+*  NAME
+*     sconf_eval_set_match_threads() -- parses the sched. param MATCH_THREADS
+*
+*  SYNOPSIS
+*     static bool sconf_eval_set_match_threads(lList *param_list, lList
+*     **answer_list, const char* param)
+*
+*  FUNCTION
+*     MATCH_THREADS=n lets the scheduler match the hosts and queues of a
+*     job with n threads. 0 and 1 disable the parallel matching.
+*
+*  RESULT
+*     static bool - true, if successful
+*
+*  NOTES
+*     MT-NOTE: sconf_eval_set_match_threads() is not MT safe, caller needs LOCK_SCHED_CONF(write)
+*
+*******************************************************************************/
+static bool sconf_eval_set_match_threads(lList *param_list, lList **answer_list, const char* param)
+{
+   u_long32 uval;
+   char *s;
+
+   if (!(s=strchr((char *)param, '=')) ||
+       !extended_parse_ulong_val(nullptr, &uval, TYPE_INT, ++s, nullptr, 0, 0, true) ||
+       uval > MAX_MATCH_THREADS) {
+      match_threads = 0;
+      return false;
+   }
+   match_threads = uval;
+
+   return true;
+}
+
+/****** sge_schedd_conf/sconf_eval_set_incremental_scheduling() ***************
+*  NAME
+*     sconf_eval_set_incremental_scheduling() -- parses the sched. param
+*                                                INCREMENTAL_SCHEDULING
+*
+*  SYNOPSIS
+*     static bool sconf_eval_set_incremental_scheduling(lList *param_list,
+*     lList **answer_list, const char* param)
+*
+*  FUNCTION
+*     INCREMENTAL_SCHEDULING=true lets the scheduler reuse the job categories
+*     rejected in the previous scheduling run as long as the hosts did not
+*     change.
+*
+*  RESULT
+*     static bool - true, if successful
+*
+*  NOTES
+*     MT-NOTE: sconf_eval_set_incremental_scheduling() is not MT safe, caller
+*              needs LOCK_SCHED_CONF(write)
+*
+*******************************************************************************/
+static bool sconf_eval_set_incremental_scheduling(lList *param_list, lList **answer_list, const char* param)
+{
+   bool ret = true;
+   lListElem *elem = nullptr;
+   const char inc_true[] = "INCREMENTAL_SCHEDULING=TRUE", inc_one[] = "INCREMENTAL_SCHEDULING=1";
+   const char inc_false[] = "INCREMENTAL_SCHEDULING=FALSE", inc_zero[] = "INCREMENTAL_SCHEDULING=0";
+
+   DENTER(TOP_LAYER);
+
+   incremental_scheduling = false;
+
+   if (!strncasecmp(param, inc_one, sizeof(inc_one)-1) ||
+       !strncasecmp(param, inc_true, sizeof(inc_true)-1)) {
+      incremental_scheduling = true;
+      elem = lCreateElem(PARA_Type);
+      lSetString(elem, PARA_name, "incremental_scheduling");
+      lSetString(elem, PARA_value, "true");
+   } else if (!strncasecmp(param, inc_zero, sizeof(inc_zero)-1) ||
+              !strncasecmp(param, inc_false, sizeof(inc_false)-1)) {
+      elem = lCreateElem(PARA_Type);
+      lSetString(elem, PARA_name, "incremental_scheduling");
+      lSetString(elem, PARA_value, "false");
+   } else {
+      snprintf(SGE_EVENT, SGE_EVENT_SIZE, MSG_INVALID_PARAM_SETTING_S, param);
+      answer_list_add(answer_list, SGE_EVENT, STATUS_ESYNTAX, ANSWER_QUALITY_ERROR);
+      ret = false;
+   }
+   if (elem) {
+      lAppendElem(param_list, elem);
+   }
+
+   DRETURN(ret);
+}
+
 /* 
    QS_STATE_FULL
       All debitations caused by running jobs are in effect.
@@ -3665,6 +3769,54 @@ u_long32 sconf_get_duration_offset()
    return offset;
 }
 
+/****** sge_schedd_conf/sconf_get_match_threads() ****************************
+*  NAME
+*     sconf_get_match_threads() -- number of threads for host/queue matching
+*
+*  SYNOPSIS
+*     int sconf_get_match_threads()
+*
+*  RESULT
+*     int - the MATCH_THREADS param, 0 if not set
+*
+*  NOTES
+*     MT-NOTE: sconf_get_match_threads() is MT safe
+*******************************************************************************/
+int sconf_get_match_threads()
+{
+   int threads;
+
+   sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
+   threads = match_threads;
+   sge_mutex_unlock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
+
+   return threads;
+}
+
+/****** sge_schedd_conf/sconf_get_incremental_scheduling() *********************
+*  NAME
+*     sconf_get_incremental_scheduling() -- reuse results of the previous run
+*
+*  SYNOPSIS
+*     bool sconf_get_incremental_scheduling()
+*
+*  RESULT
+*     bool - the INCREMENTAL_SCHEDULING param, false if not set
+*
+*  NOTES
+*     MT-NOTE: sconf_get_incremental_scheduling() is MT safe
+*******************************************************************************/
+bool sconf_get_incremental_scheduling()
+{
+   bool incremental;
+
+   sge_mutex_lock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
+   incremental = incremental_scheduling;
+   sge_mutex_unlock("Sched_Conf_Lock", "", __LINE__, &pos.mutex);
+
+   return incremental;
+}
+
 /****** sge_resource_utilization/serf_control() ********************************
 *  NAME
 *     serf_get_active() -- Retrieve whether SERF is active or not
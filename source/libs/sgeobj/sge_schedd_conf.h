@@ -212,6 +212,10 @@ void sconf_set_last_dispatch_type(int changed);
 
 u_long32  sconf_get_duration_offset();
 
+int sconf_get_match_threads();
+
+bool sconf_get_incremental_scheduling();
+
 bool serf_get_active();
 
 schedd_pe_algorithm sconf_best_pe_alg();
@@ -36,6 +36,7 @@
 #include <cstring>
 #include <unistd.h>
 #include <cerrno>
+#include <pthread.h>
 
 #include "uti/sge_log.h"
 #include "uti/sge_profiling.h"
@@ -106,6 +107,12 @@ static int job_remove_script_file(u_long32 job_id);
    existence of the task spool dir and is reinitialized */
 static char old_task_spool_dir[SGE_PATH_MAX] = "";
 
+/* Worker threads of qmaster may spool tasks of different jobs in parallel
+   (fine-grained locking). The cache is shared and therefore protected. */
+static pthread_mutex_t old_task_spool_dir_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void job_create_task_spool_dir(const char *task_spool_dir, sge_spool_flags_t flags);
+
 static lListElem *job_create_from_file(u_long32 job_id, u_long32 ja_task_id,
                                        sge_spool_flags_t flags)
 {
@@ -481,6 +488,15 @@ int job_write_common_part(lListElem *job, u_long32 ja_task_id,
 
 
 
+static void job_create_task_spool_dir(const char *task_spool_dir, sge_spool_flags_t flags) {
+   pthread_mutex_lock(&old_task_spool_dir_mutex);
+   if ((flags & SPOOL_WITHIN_EXECD) || strcmp(old_task_spool_dir, task_spool_dir)) {
+      strcpy(old_task_spool_dir, task_spool_dir);
+      sge_mkdir(task_spool_dir, 0755, false, false);
+   }
+   pthread_mutex_unlock(&old_task_spool_dir_mutex);
+}
+
 static int ja_task_write_to_disk(lListElem *ja_task, u_long32 job_id,
                                  const char *pe_task_id,
                                  sge_spool_flags_t flags)
@@ -504,11 +520,7 @@ static int ja_task_write_to_disk(lListElem *ja_task, u_long32 job_id,
       sge_get_file_path(tmp_task_spool_file, sizeof(tmp_task_spool_file), TASK_SPOOL_FILE, FORMAT_DOT_FILENAME, flags, job_id, ja_task_id, nullptr);
 
       /* create task spool directory if necessary */
-      if ((flags & SPOOL_WITHIN_EXECD) || 
-          strcmp(old_task_spool_dir, task_spool_dir)) {
-         strcpy(old_task_spool_dir, task_spool_dir);
-         sge_mkdir(task_spool_dir, 0755, false, false);
-      }
+      job_create_task_spool_dir(task_spool_dir, flags);
 
       /* spool ja_task */
       if (!(flags & SPOOL_ONLY_PETASK)) {
@@ -574,10 +586,7 @@ static int ja_task_write_to_disk(lListElem *ja_task, u_long32 job_id,
                         FORMAT_DOT_FILENAME, flags, job_id, lGetUlong(ja_task, JAT_task_number), nullptr);
 
       /* create task spool directory if necessary */
-      if ((flags & SPOOL_WITHIN_EXECD) || strcmp(old_task_spool_dir, task_spool_dir)) {
-         strcpy(old_task_spool_dir, task_spool_dir);
-         sge_mkdir(task_spool_dir, 0755, false, false);
-      }
+      job_create_task_spool_dir(task_spool_dir, flags);
 
       /* spool ja_task to temporary file */
       ret = lWriteElemToDisk(ja_task, tmp_task_spool_file, nullptr, "ja_task");
@@ -669,7 +678,9 @@ int job_remove_spool_file(u_long32 jobid, u_long32 ja_taskid,
           * a task spool directory has been removed: reinit 
           * old_task_spool_dir to ensure mkdir() is performed 
           */
+         pthread_mutex_lock(&old_task_spool_dir_mutex);
          old_task_spool_dir[0] = '\0';
+         pthread_mutex_unlock(&old_task_spool_dir_mutex);
       }
    }
 
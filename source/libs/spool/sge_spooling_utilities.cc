@@ -55,6 +55,7 @@
 #include "sgeobj/sge_schedd_conf.h"
 #include "sgeobj/sge_job.h"
 #include "sgeobj/sge_host.h"
+#include "sgeobj/sge_load.h"
 #include "sgeobj/sge_pe.h"
 #include "sgeobj/sge_qinstance.h"
 #include "sgeobj/sge_userset.h"
@@ -421,6 +422,7 @@ bool spool_default_validate_func(lList **answer_list,
             /* all spooled load values are static, therefore we tag them here */
             for_each_rw(load_value, lGetList(object, EH_load_list)) {
                lSetBool(load_value, HL_is_static, true);
+               load_set_value(load_value, lGetString(load_value, HL_value));
             }
 
             /* necessary to init double values of consumable configuration */
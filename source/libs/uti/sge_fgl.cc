@@ -292,7 +292,7 @@ void fgl_clear() {
    fgl_state_set_pos(0);
 }
 
-static void fgl_get_key_clear(int i, dstring *dstr, bool do_clear) {
+static void fgl_get_key_clear(int i, dstring *dstr, bool do_clear, bool with_mode) {
    // fetch current array and pos 
    fgl_t *requests = nullptr;
    u_long32 pos = 0;
@@ -307,7 +307,10 @@ static void fgl_get_key_clear(int i, dstring *dstr, bool do_clear) {
    if (do_clear) {
       sge_dstring_clear(dstr);
    }
-   sge_dstring_sprintf_append(dstr, "%s %u", requests[i].is_rw ? "RW" : "RO", requests[i].id_root);
+   if (with_mode) {
+      sge_dstring_sprintf_append(dstr, "%s ", requests[i].is_rw ? "RW" : "RO");
+   }
+   sge_dstring_sprintf_append(dstr, "%u", requests[i].id_root);
    switch (requests[i].type) {
       case FGL_ULONG:
          sge_dstring_sprintf_append(dstr, " %u", requests[i].u.id_ulong);
@@ -323,8 +326,9 @@ static void fgl_get_key_clear(int i, dstring *dstr, bool do_clear) {
    }
 }
 
+// RO and RW reservations of the same object have to use the same lock, therefore the mode is not part of the key
 static void fgl_get_key(int i, dstring *dstr) {
-   fgl_get_key_clear(i, dstr, true);
+   fgl_get_key_clear(i, dstr, true, false);
 }
 
 void fgl_dump(dstring *dstr) {
@@ -335,7 +339,7 @@ void fgl_dump(dstring *dstr) {
 
    // print each entry
    for (u_long32 i = 0; i < pos; i++) {
-      fgl_get_key_clear(i, dstr, false);
+      fgl_get_key_clear(i, dstr, false, true);
    }
 }
 
@@ -860,6 +860,11 @@ int sge_hostcmp(const char *h1, const char *h2) {
 
    DENTER(BASIS_LAYER);
 
+   /* host names of CULL elements are interned, equal names often have the same address */
+   if (h1 != nullptr && h1 == h2) {
+      DRETURN(0);
+   }
+
    if (h1 != nullptr && h2 != nullptr) {
       sge_hostcpy(h1_cpy, h1);
       sge_hostcpy(h2_cpy, h2);
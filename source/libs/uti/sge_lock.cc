@@ -131,6 +131,161 @@ static const char *locktype_names[NUM_OF_LOCK_TYPES] = {
         "master_config",   ///< LOCK_MASTER_CONF
 };
 
+/****** sge_lock/lock_group_t ****************************************************
+*  NAME
+*     lock_group_t -- separates LOCK_READ and LOCK_FGL holders
+*
+*  FUNCTION
+*     LOCK_READ and LOCK_FGL both acquire the underlying rw-lock in shared
+*     mode. LOCK_FGL holders additionally reserve the objects they modify with
+*     the fine-grained locking layer (sge_fgl) which readers do not respect.
+*     Therefore, a second barrier makes sure that readers and fine-grained
+*     writers never run at the same time whereas holders of the same mode
+*     still share the lock.
+*
+*     If threads of the other mode are waiting then new threads of the
+*     mode that currently owns the group have to wait, so that neither side
+*     can starve the other.
+*
+*     The barrier costs a mutex and a condition variable per lock call.
+*     Therefore it is only used for lock types where fine-grained locking
+*     has been enabled with sge_lock_set_fgl(). For other lock types
+*     LOCK_READ only acquires the rw-lock and LOCK_FGL falls back to an
+*     exclusive lock.
+*******************************************************************************/
+typedef struct {
+   pthread_mutex_t mutex;
+   pthread_cond_t cond;
+   sge_lockmode_t owner;           // mode of the current holders
+   int active;                     // number of current holders
+   int waiting[2];                 // waiting threads per mode (0 = LOCK_READ, 1 = LOCK_FGL)
+} lock_group_t;
+
+static lock_group_t Lock_Groups[NUM_OF_LOCK_TYPES];
+
+// only changed by holders of the exclusive lock, so it is stable while a lock is held
+static bool Lock_Group_Enabled[NUM_OF_LOCK_TYPES];
+
+static void
+lock_group_init(lock_group_t *group) {
+   pthread_mutex_init(&group->mutex, nullptr);
+   pthread_cond_init(&group->cond, nullptr);
+   group->owner = LOCK_READ;
+   group->active = 0;
+   group->waiting[0] = 0;
+   group->waiting[1] = 0;
+}
+
+static bool
+lock_group_enter(sge_locktype_t aType, sge_lockmode_t aMode, bool is_try) {
+   lock_group_t *group = &Lock_Groups[aType];
+   int mine = aMode == LOCK_FGL ? 1 : 0;
+   int other = 1 - mine;
+   bool ret = true;
+
+   pthread_mutex_lock(&group->mutex);
+   group->waiting[mine]++;
+   while (group->active > 0 && (group->owner != aMode || group->waiting[other] > 0)) {
+      if (is_try) {
+         ret = false;
+         break;
+      }
+      pthread_cond_wait(&group->cond, &group->mutex);
+   }
+   group->waiting[mine]--;
+   if (ret) {
+      group->owner = aMode;
+      group->active++;
+   }
+   pthread_mutex_unlock(&group->mutex);
+   return ret;
+}
+
+static void
+lock_group_leave(sge_locktype_t aType) {
+   lock_group_t *group = &Lock_Groups[aType];
+
+   pthread_mutex_lock(&group->mutex);
+   group->active--;
+   if (group->active == 0) {
+      pthread_cond_broadcast(&group->cond);
+   }
+   pthread_mutex_unlock(&group->mutex);
+}
+
+static int
+lock_rw_acquire(sge_locktype_t aType, bool shared, bool is_try) {
+#ifdef SGE_USE_LOCK_FIFO
+   if (is_try) {
+      return sge_fifo_try_lock(SGE_RW_Locks[aType], shared) ? 0 : 1;
+   }
+   return sge_fifo_lock(SGE_RW_Locks[aType], shared) ? 0 : 1;
+#else
+   if (shared) {
+      return is_try ? pthread_rwlock_tryrdlock(SGE_RW_Locks[aType]) : pthread_rwlock_rdlock(SGE_RW_Locks[aType]);
+   }
+   return is_try ? pthread_rwlock_trywrlock(SGE_RW_Locks[aType]) : pthread_rwlock_wrlock(SGE_RW_Locks[aType]);
+#endif
+}
+
+static int
+lock_rw_release(sge_locktype_t aType, bool shared) {
+#ifdef SGE_USE_LOCK_FIFO
+   return sge_fifo_ulock(SGE_RW_Locks[aType], shared) ? 0 : 1;
+#else
+   return pthread_rwlock_unlock(SGE_RW_Locks[aType]);
+#endif
+}
+
+/* acquires a lock in LOCK_READ or LOCK_FGL mode, returns 0 on success */
+static int
+lock_shared_acquire(sge_locktype_t aType, sge_lockmode_t aMode, bool is_try) {
+   while (true) {
+      int res = lock_rw_acquire(aType, true, is_try);
+
+      if (res != 0) {
+         return res;
+      }
+      if (Lock_Group_Enabled[aType]) {
+         if (!lock_group_enter(aType, aMode, is_try)) {
+            lock_rw_release(aType, true);
+            return 1;
+         }
+         return 0;
+      }
+      if (aMode == LOCK_READ) {
+         return 0;
+      }
+
+      // no barrier for this lock type, the reservations of LOCK_FGL holders need an exclusive lock
+      lock_rw_release(aType, true);
+      res = lock_rw_acquire(aType, false, is_try);
+      if (res != 0) {
+         return res;
+      }
+      if (!Lock_Group_Enabled[aType]) {
+         return 0;
+      }
+
+      // the barrier has been enabled in the meantime
+      lock_rw_release(aType, false);
+      if (is_try) {
+         return 1;
+      }
+   }
+}
+
+/* releases a lock acquired with lock_shared_acquire(), returns 0 on success */
+static int
+lock_shared_release(sge_locktype_t aType, sge_lockmode_t aMode) {
+   if (Lock_Group_Enabled[aType]) {
+      lock_group_leave(aType);
+   } else if (aMode == LOCK_FGL) {
+      return lock_rw_release(aType, false);
+   }
+   return lock_rw_release(aType, true);
+}
+
 static pthread_once_t lock_once = PTHREAD_ONCE_INIT;
 
 static void lock_once_init();
@@ -157,13 +312,9 @@ void sge_try_lock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func,
    }
 #endif
 
-   if (aMode == LOCK_READ) {
+   if (aMode == LOCK_READ || aMode == LOCK_FGL) {
       DPRINTF("%s() about to try lock rwlock \"%s\" for reading\n", func, locktype_names[aType]);
-#ifdef SGE_USE_LOCK_FIFO
-      res = sge_fifo_try_lock(SGE_RW_Locks[aType], true) ? 0 : 1;
-#else
-      res = pthread_rwlock_tryrdlock(SGE_RW_Locks[aType]);
-#endif
+      res = lock_shared_acquire(aType, aMode, true);
       DPRINTF("%s() try locked rwlock \"%s\" for reading\n", func, locktype_names[aType]);
    } else if (aMode == LOCK_WRITE) {
       DPRINTF("%s() about to try lock rwlock \"%s\" for writing\n", func, locktype_names[aType]);
@@ -212,12 +363,8 @@ bool sge_try_lock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func,
    gettimeofday(&before, nullptr);
 #endif
 
-   if (aMode == LOCK_READ) {
-#ifdef SGE_USE_LOCK_FIFO
-      res = sge_fifo_try_lock(SGE_RW_Locks[aType], true);
-#else
-      res = (pthread_rwlock_tryrdlock(SGE_RW_Locks[aType]) == 0);
-#endif
+   if (aMode == LOCK_READ || aMode == LOCK_FGL) {
+      res = (lock_shared_acquire(aType, aMode, true) == 0);
    } else if (aMode == LOCK_WRITE) {
 #ifdef SGE_USE_LOCK_FIFO
       res = sge_fifo_try_lock(SGE_RW_Locks[aType], false);
@@ -302,13 +449,9 @@ void sge_lock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sge_
    }   
 #endif   
 
-   if (aMode == LOCK_READ) {
+   if (aMode == LOCK_READ || aMode == LOCK_FGL) {
       DPRINTF("%s() about to lock rwlock \"%s\" for reading\n", func, locktype_names[aType]);
-#ifdef SGE_USE_LOCK_FIFO
-      res = sge_fifo_lock(SGE_RW_Locks[aType], true) ? 0 : 1;
-#else
-      res = pthread_rwlock_rdlock(SGE_RW_Locks[aType]);
-#endif
+      res = lock_shared_acquire(aType, aMode, false);
       DPRINTF("%s() locked rwlock \"%s\" for reading\n", func, locktype_names[aType]);
    } else if (aMode == LOCK_WRITE) {
        DPRINTF("%s() about to lock rwlock \"%s\" for writing\n", func, locktype_names[aType]);
@@ -357,12 +500,8 @@ void sge_lock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sge_
    gettimeofday(&before, nullptr);
 #endif
 
-   if (aMode == LOCK_READ) {
-#ifdef SGE_USE_LOCK_FIFO
-      res = sge_fifo_lock(SGE_RW_Locks[aType], true) ? 0 : 1;
-#else
-      res = pthread_rwlock_rdlock(SGE_RW_Locks[aType]);
-#endif
+   if (aMode == LOCK_READ || aMode == LOCK_FGL) {
+      res = lock_shared_acquire(aType, aMode, false);
    } else if (aMode == LOCK_WRITE) {
 #ifdef SGE_USE_LOCK_FIFO
       res = sge_fifo_lock(SGE_RW_Locks[aType], false) ? 0 : 1;
@@ -440,11 +579,12 @@ void sge_unlock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sg
    DENTER(BASIS_LAYER);
 
    pthread_once(&lock_once, lock_once_init);
-#ifdef SGE_USE_LOCK_FIFO
-   res = sge_fifo_ulock(SGE_RW_Locks[aType], (bool)(aMode == LOCK_READ)) ? 0 : 1;
-#else
-   res = pthread_rwlock_unlock(SGE_RW_Locks[aType]);
-#endif
+
+   if (aMode == LOCK_READ || aMode == LOCK_FGL) {
+      res = lock_shared_release(aType, aMode);
+   } else {
+      res = lock_rw_release(aType, false);
+   }
    if (res != 0) {
       DPRINTF(MSG_LCK_RWLOCKUNLOCKFAILED_SSS, func, locktype_names[aType], strerror(res));
       abort();
@@ -470,11 +610,11 @@ void sge_unlock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sg
 
    pthread_once(&lock_once, lock_once_init);
 
-#ifdef SGE_USE_LOCK_FIFO
-   res = sge_fifo_ulock(SGE_RW_Locks[aType], (bool) (aMode == LOCK_READ)) ? 0 : 1;
-#else
-   res = pthread_rwlock_unlock(SGE_RW_Locks[aType]);
-#endif
+   if (aMode == LOCK_READ || aMode == LOCK_FGL) {
+      res = lock_shared_release(aType, aMode);
+   } else {
+      res = lock_rw_release(aType, false);
+   }
    if (res != 0) {
       DPRINTF(MSG_LCK_RWLOCKUNLOCKFAILED_SSS, func, locktype_names[aType], strerror(res));
       abort();
@@ -518,6 +658,32 @@ sge_locker_t sge_locker_id() {
    return id;
 } /* sge_locker_id */
 
+/****** sge_lock/sge_lock_set_fgl() *******************************************
+*  NAME
+*     sge_lock_set_fgl() -- enable fine-grained locking for a lock type
+*
+*  SYNOPSIS
+*     void sge_lock_set_fgl(sge_locktype_t aType, bool enabled)
+*
+*  FUNCTION
+*     Enables or disables the barrier between LOCK_READ and LOCK_FGL
+*     holders of the lock 'aType' (see lock_group_t). Without the barrier
+*     LOCK_READ holders only share the rw-lock and LOCK_FGL is treated
+*     like LOCK_WRITE.
+*
+*  INPUTS
+*     sge_locktype_t aType - lock type
+*     bool enabled         - true if LOCK_FGL holders may share the lock
+*
+*  NOTES
+*     MT-NOTE: sge_lock_set_fgl() is MT safe if the caller holds 'aType'
+*     MT-NOTE: in LOCK_WRITE mode or if no other thread uses the lock yet
+*******************************************************************************/
+void sge_lock_set_fgl(sge_locktype_t aType, bool enabled) {
+   pthread_once(&lock_once, lock_once_init);
+   Lock_Group_Enabled[aType] = enabled;
+}
+
 /****** libs/lck/lock_once_init() **************************
 *  NAME
 *     lock_once_init() -- setup lock service 
@@ -546,6 +712,9 @@ sge_locker_t sge_locker_id() {
 *
 *******************************************************************************/
 static void lock_once_init() {
+   for (int i = 0; i < NUM_OF_LOCK_TYPES; i++) {
+      lock_group_init(&Lock_Groups[i]);
+   }
 #ifdef SGE_USE_LOCK_FIFO
    sge_fifo_lock_init(&Global_Lock);
    sge_fifo_lock_init(&Scheduler_Lock);
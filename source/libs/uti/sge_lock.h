@@ -52,7 +52,8 @@
 
 typedef enum {
    LOCK_READ = 1, /* shared  */
-   LOCK_WRITE = 2  /* exclusive */
+   LOCK_WRITE = 2, /* exclusive */
+   LOCK_FGL = 3   /* shared with other LOCK_FGL holders but exclusive to LOCK_READ holders (see sge_fgl) */
 } sge_lockmode_t;
 
 typedef u_long64 sge_locker_t;
@@ -80,6 +81,9 @@ sge_unlock(sge_locktype_t aType, sge_lockmode_t aMode, const char *func, sge_loc
 sge_locker_t
 sge_locker_id();
 
+void
+sge_lock_set_fgl(sge_locktype_t aType, bool enabled);
+
 #define SGE_TRY_LOCK(type, mode) sge_try_lock(type, mode, __func__, sge_locker_id())
 #define SGE_LOCK(type, mode) sge_lock(type, mode, __func__, sge_locker_id())
 #define SGE_UNLOCK(type, mode) sge_unlock(type, mode, __func__, sge_locker_id())
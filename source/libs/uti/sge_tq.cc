@@ -524,6 +524,63 @@ sge_tq_wait_for_task(sge_tq_queue_t *queue, int seconds,
    DRETURN(ret);
 }
 
+/****** uti/tq/sge_tq_get_task() ***********************************************
+*  NAME
+*     sge_tq_get_task() -- Get a task without waiting
+*
+*  SYNOPSIS
+*     bool
+*     sge_tq_get_task(sge_tq_queue_t *queue, sge_tq_type_t type, void **data);
+*
+*  FUNCTION
+*     This function returns the first task of 'type' that is stored in the
+*     queue. In contrast to sge_tq_wait_for_task() it does not block if
+*     there is no such task. In that case nullptr will be returned in 'data'.
+*
+*  INPUTS
+*     sge_tq_queue_t *queue - task queue
+*     sge_tq_type_t type    - type of the task that should be returned
+*     void **data           - nullptr if there is no task or the data
+*                             pointer of the task
+*
+*  RESULT
+*     bool - error state
+*        true  - success
+*        false - error
+*
+*  NOTES
+*     MT-NOTE: sge_tq_get_task() is MT safe
+*
+*  SEE ALSO
+*     uti/tq/sge_tq_wait_for_task()
+*******************************************************************************/
+bool
+sge_tq_get_task(sge_tq_queue_t *queue, sge_tq_type_t type, void **data) {
+   bool ret = true;
+
+   DENTER(TQ_LAYER);
+   if (queue != nullptr && data != nullptr) {
+      sge_sl_elem_t *elem = nullptr;
+      sge_tq_task_t key{};
+
+      key.type = type;
+      *data = nullptr;
+
+      sge_mutex_lock(TQ_MUTEX_NAME, __func__, __LINE__, sge_sl_get_mutex(queue->list));
+      ret = sge_sl_elem_search(queue->list, &elem, &key, sge_tq_task_compare_type, SGE_SL_FORWARD);
+      if (ret && elem != nullptr) {
+         ret = sge_sl_dechain(queue->list, elem);
+         if (ret) {
+            auto *task = (sge_tq_task_t *)sge_sl_elem_data(elem);
+            *data = task->data;
+            ret = sge_sl_elem_destroy(&elem, (sge_sl_destroy_f) sge_tq_task_destroy);
+         }
+      }
+      sge_mutex_unlock(TQ_MUTEX_NAME, __func__, __LINE__, sge_sl_get_mutex(queue->list));
+   }
+   DRETURN(ret);
+}
+
 /** @brief Move all elements from src to dst if cmp_func returns true
  *
  * This function moves all elements from src to dst if cmp_func returns true.
@@ -54,6 +54,7 @@ enum sge_tq_type_t {
    SGE_TQ_UNKNOWN = 0,
 
    SGE_TQ_GDI_PACKET,    /* GDI packets */
+   SGE_TQ_REPORT_PACKET, /* report packets of execution daemons */
 
    SGE_TQ_TYPE1,  /* used for module tests */
    SGE_TQ_TYPE2   /* used for module tests */
@@ -85,5 +86,8 @@ sge_tq_wakeup_waiting(sge_tq_queue_t *queue);
 bool
 sge_tq_wait_for_task(sge_tq_queue_t *queue, int seconds, sge_tq_type_t type, void **data);
 
+bool
+sge_tq_get_task(sge_tq_queue_t *queue, sge_tq_type_t type, void **data);
+
 int
 sge_tq_move_from_to_if(sge_tq_queue_t *src, sge_tq_queue_t *dst, sge_sl_compare_f cmp_func);
@@ -53,6 +53,7 @@
 #include "cull/cull.h"
 
 #include "uti/sge_profiling.h"
+#include "uti/sge_string.h"
 
 #include <sge_log.h>
 
@@ -95,6 +96,15 @@ lNameSpace my_nmv[] = {
 };
 #endif
 
+/* a field type that cannot have an ordered index */
+enum {
+   TEST_double = 1
+};
+
+LISTDEF(TEST_DoubleType)
+                SGE_DOUBLE (TEST_double, CULL_DEFAULT)
+LISTEND
+
 static void usage(const char *argv0) {
    fprintf(stderr, "usage: %s [<num_objects> <num_names> <uh> <nuh>]\n", argv0);
    fprintf(stderr, "<num_objects> = number of objects to be created\n");
@@ -311,6 +321,175 @@ static void do_test(bool unique_hash, bool non_unique_hash,
    lFreeList(&lp);
 }
 
+/* lSelect() answers equalities on hashed fields through the hash tables,
+   the result has to be the same (and in the same order) as when scanning a list without hash tables */
+static bool check_select_index(int num_objects, int num_names) {
+   lList *hashed = lCreateListHash("hashed", DESCR, false);
+   lList *plain = lCreateListHash("plain", DESCR, false);
+   lCondition *conditions[4];
+   lEnumeration *what = lWhat("%T(ALL)", DESCR);
+   bool ret = true;
+   int i;
+
+   for (i = 0; i < num_objects; i++) {
+      lListElem *ep = lCreateElem(DESCR);
+      lSetUlong(ep, NM_ULONG, i);
+      lSetString(ep, NM_STRING, names[i % num_names]);
+      lAppendElem(plain, lCopyElem(ep));
+      lAppendElem(hashed, ep);
+   }
+   cull_hash_new(hashed, NM_ULONG, true);
+   cull_hash_new(hashed, NM_STRING, false);
+
+   /* elements inserted at the front are at the end of the hash chains */
+   for (i = num_objects; i < num_objects + num_names; i++) {
+      lListElem *ep = lCreateElem(DESCR);
+      lSetUlong(ep, NM_ULONG, i);
+      lSetString(ep, NM_STRING, names[i % num_names]);
+      lInsertElem(plain, nullptr, lCopyElem(ep));
+      lInsertElem(hashed, nullptr, ep);
+   }
+
+   conditions[0] = lWhere("%T(%I == %s)", DESCR, NM_STRING, names[0]);
+   conditions[1] = lWhere("%T(%I == %s || %I == %s || %I == %s)", DESCR,
+                          NM_STRING, names[1], NM_STRING, names[num_names - 1], NM_STRING, names[1]);
+   conditions[2] = lWhere("%T(%I == %u && %I == %s)", DESCR, NM_ULONG, num_objects / 2,
+                          NM_STRING, names[(num_objects / 2) % num_names]);
+   conditions[3] = lWhere("%T(%I == %s && %I < %u)", DESCR, NM_STRING, names[0], NM_ULONG, num_objects / 2);
+
+   for (i = 0; i < 4; i++) {
+      lList *from_hash = lSelect("from_hash", hashed, conditions[i], what);
+      lList *from_scan = lSelect("from_scan", plain, conditions[i], what);
+      const lListElem *ep1 = lFirst(from_hash);
+      const lListElem *ep2 = lFirst(from_scan);
+
+      if (lGetNumberOfElem(from_hash) != lGetNumberOfElem(from_scan) || lGetNumberOfElem(from_scan) == 0) {
+         printf("condition %d: %d elements selected via hash, %d via scan\n", i,
+                lGetNumberOfElem(from_hash), lGetNumberOfElem(from_scan));
+         ret = false;
+      }
+      for (; ep1 != nullptr && ep2 != nullptr; ep1 = lNext(ep1), ep2 = lNext(ep2)) {
+         if (lGetUlong(ep1, NM_ULONG) != lGetUlong(ep2, NM_ULONG)) {
+            printf("condition %d: different elements selected via hash\n", i);
+            ret = false;
+            break;
+         }
+      }
+      lFreeList(&from_hash);
+      lFreeList(&from_scan);
+      lFreeWhere(&conditions[i]);
+   }
+
+   lFreeWhat(&what);
+   lFreeList(&hashed);
+   lFreeList(&plain);
+   return ret;
+}
+
+/* checks that the ordered index returns the elements in value order after
+   inserts, modifications and removals */
+static bool check_ordered_order(const lList *lp, int pos) {
+   const lListElem *ep;
+   u_int n = 0;
+   u_long32 last = 0;
+
+   for (ep = cull_hash_ordered_first(lp, pos); ep != nullptr; ep = cull_hash_ordered_next(lp, pos, ep)) {
+      if (lGetPosUlong(ep, pos) < last) {
+         printf("ordered index: %d follows %d\n", (int)lGetPosUlong(ep, pos), (int)last);
+         return false;
+      }
+      last = lGetPosUlong(ep, pos);
+      n++;
+   }
+   if (n != lGetNumberOfElem(lp)) {
+      printf("ordered index: %u elements in index, %u in list\n", n, lGetNumberOfElem(lp));
+      return false;
+   }
+   return true;
+}
+
+/* lInsertSorted() finds the insert position via an ordered index,
+   the result has to be the same as when walking through a list without index */
+static bool check_ordered_index(int num_objects, int num_names) {
+   lList *ordered = lCreateList("ordered", DESCR);
+   lList *plain = lCreateList("plain", DESCR);
+   lSortOrder *so = lParseSortOrderVarArg(DESCR, "%I+", NM_ULONG);
+   int pos = lGetPosInDescr(DESCR, NM_ULONG);
+   lListElem *ep;
+   lListElem *next;
+   const lListElem *ep2;
+   bool ret = true;
+   int i;
+
+   cull_hash_new_ordered(ordered, NM_ULONG, false);
+
+   /* unsupported field types are rejected */
+   {
+      lList *doubles = lCreateList("doubles", TEST_DoubleType);
+      int double_pos = lGetPosInDescr(TEST_DoubleType, TEST_double);
+      if (cull_hash_new_ordered(doubles, TEST_double, false) != 0 ||
+          mt_is_ordered(lGetListDescr(doubles)[double_pos].mt)) {
+         printf("ordered index was created for a double field\n");
+         ret = false;
+      }
+      lFreeList(&doubles);
+   }
+
+   for (i = 0; i < num_objects; i++) {
+      ep = lCreateElem(DESCR);
+      lSetUlong(ep, NM_ULONG, rand() % (num_objects / 4 + 1));
+      lSetString(ep, NM_STRING, names[i % num_names]);
+      lInsertSorted(so, lCopyElem(ep), plain);
+      lInsertSorted(so, ep, ordered);
+   }
+
+   for (ep = lFirstRW(ordered), ep2 = lFirst(plain); ep != nullptr && ep2 != nullptr; ep = lNextRW(ep), ep2 = lNext(ep2)) {
+      if (lGetUlong(ep, NM_ULONG) != lGetUlong(ep2, NM_ULONG) ||
+          sge_strnullcmp(lGetString(ep, NM_STRING), lGetString(ep2, NM_STRING)) != 0) {
+         printf("lInsertSorted() inserted at a different position with ordered index\n");
+         ret = false;
+         break;
+      }
+   }
+   ret = ret && check_ordered_order(ordered, pos);
+
+   /* modify and remove elements, the index has to follow */
+   i = 0;
+   for (ep = lFirstRW(ordered); ep != nullptr; ep = next) {
+      next = lNextRW(ep);
+      if (i % 3 == 0) {
+         lSetUlong(ep, NM_ULONG, rand() % (num_objects / 4 + 1));
+      } else if (i % 3 == 1) {
+         lRemoveElem(ordered, &ep);
+      }
+      i++;
+   }
+   ret = ret && check_ordered_order(ordered, pos);
+
+   /* lower bound of a value returns the first element not lower than the value */
+   ep = lCreateElem(DESCR);
+   lSetUlong(ep, NM_ULONG, num_objects / 8);
+   ep2 = cull_hash_lower_bound(ordered, pos, ep);
+   if (ep2 != nullptr && lGetUlong(ep2, NM_ULONG) < lGetUlong(ep, NM_ULONG)) {
+      printf("lower bound returned a lower value\n");
+      ret = false;
+   }
+   for (const lListElem *ep3 = lFirst(ordered); ep3 != nullptr; ep3 = lNext(ep3)) {
+      u_long32 value = lGetUlong(ep3, NM_ULONG);
+      if (value >= lGetUlong(ep, NM_ULONG) && (ep2 == nullptr || value < lGetUlong(ep2, NM_ULONG))) {
+         printf("lower bound missed value %d\n", (int)value);
+         ret = false;
+         break;
+      }
+   }
+   lFreeElem(&ep);
+
+   lFreeSortOrder(&so);
+   lFreeList(&ordered);
+   lFreeList(&plain);
+   return ret;
+}
+
 int main(int argc, char *argv[]) {
    int num_objects;
    int num_names;
@@ -358,6 +537,12 @@ int main(int argc, char *argv[]) {
 
    /* do tests */
    do_test(uh, nuh, num_objects, num_names);
+   if (!check_select_index(num_objects, num_names)) {
+      return EXIT_FAILURE;
+   }
+   if (!check_ordered_index(num_objects, num_names)) {
+      return EXIT_FAILURE;
+   }
 
    /* free names */
    for (i = 0; i < num_names; i++) {
@@ -34,11 +34,15 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
 
 #define __SGE_GDI_LIBRARY_HOME_OBJECT_FILE__
 
 #include "cull/cull.h"
 #include "cull/cull_list.h"
+#include "cull/cull_inline.h"
 
 enum {
    TEST_int = 1,
@@ -168,6 +172,313 @@ int main(int argc, char *argv[]) {
    lFreeElem(&copy);
    lFreeWhat(&enp);
 
+   /* test shared sub lists */
+   {
+      lListElem *shared = lCreateElem(TEST_Type);
+      lAddSubStr(shared, TEST_string, "shared sub list element", TEST_list, TEST_Type);
+      lMarkListShared(lGetListRW(shared, TEST_list));
+
+      /* a complete copy references the shared list */
+      copy = lCopyElem(shared);
+      if (lGetList(copy, TEST_list) != lGetList(shared, TEST_list)) {
+         printf("copy of element does not reference the shared list\n");
+         return EXIT_FAILURE;
+      }
+
+      /* modification of the copy must not be visible in the original */
+      lAddSubStr(copy, TEST_string, "private sub list element", TEST_list, TEST_Type);
+      if (lGetList(copy, TEST_list) == lGetList(shared, TEST_list) ||
+          lGetNumberOfElem(lGetList(shared, TEST_list)) != 1 ||
+          lGetNumberOfElem(lGetList(copy, TEST_list)) != 2) {
+         printf("modification of a shared list is visible in other owners\n");
+         return EXIT_FAILURE;
+      }
+      lFreeElem(&copy);
+
+      /* elements of a shared list are only writable in a private copy */
+      copy = lCopyElem(shared);
+      if (lGetSubStr(copy, TEST_string, "shared sub list element", TEST_list) == nullptr ||
+          lGetList(copy, TEST_list) != lGetList(shared, TEST_list)) {
+         printf("read access to a shared list created a copy\n");
+         return EXIT_FAILURE;
+      }
+      lSetString(lGetSubStrRW(copy, TEST_string, "shared sub list element", TEST_list), TEST_string, "modified");
+      if (lGetList(copy, TEST_list) == lGetList(shared, TEST_list) ||
+          lGetSubStr(shared, TEST_string, "shared sub list element", TEST_list) == nullptr) {
+         printf("modification of a shared list element is visible in other owners\n");
+         return EXIT_FAILURE;
+      }
+      lFreeElem(&copy);
+
+      /* a shared list taken out of an element is a private copy */
+      {
+         lList *taken = nullptr;
+
+         copy = lCopyElem(shared);
+         lXchgList(copy, TEST_list, &taken);
+         if (taken == lGetList(shared, TEST_list) || lGetNumberOfElem(taken) != 1) {
+            printf("lXchgList returned a list that is still shared\n");
+            return EXIT_FAILURE;
+         }
+         lFreeList(&taken);
+         lFreeElem(&copy);
+      }
+
+      /* the last owner frees the shared list */
+      copy = lCopyElem(shared);
+      lFreeElem(&shared);
+      if (lGetNumberOfElem(lGetList(copy, TEST_list)) != 1) {
+         printf("shared list was freed while it is still referenced\n");
+         return EXIT_FAILURE;
+      }
+
+      /* the only owner modifies the list in place and it is no longer shared */
+      {
+         const lList *sole = lGetList(copy, TEST_list);
+         if (lGetListRW(copy, TEST_list) != sole || lIsListShared(sole)) {
+            printf("the only owner of a shared list got a copy or the list is still shared\n");
+            return EXIT_FAILURE;
+         }
+      }
+      lFreeElem(&copy);
+   }
+
+   /* free elements share the interned descriptor */
+   {
+      lListElem *first = lCreateElem(TEST_Type);
+      lListElem *second = lCreateElem(TEST_Type);
+      lList *lp = lCreateList("interned", TEST_Type);
+
+      if (lGetElemDescr(first) != lGetElemDescr(second) || lGetElemDescr(first) != lInternDescr(TEST_Type)) {
+         printf("free elements do not share the descriptor\n");
+         return EXIT_FAILURE;
+      }
+
+      /* bound elements use the descriptor of the list, dechained ones the shared one again */
+      lAppendElem(lp, first);
+      if (lGetElemDescr(first) != lGetListDescr(lp)) {
+         printf("bound element does not use the list descriptor\n");
+         return EXIT_FAILURE;
+      }
+      first = lDechainElem(lp, first);
+      if (lGetElemDescr(first) != lGetElemDescr(second)) {
+         printf("dechained element does not use the shared descriptor\n");
+         return EXIT_FAILURE;
+      }
+      lFreeElem(&first);
+      lFreeElem(&second);
+      lFreeList(&lp);
+   }
+
+   /* equal host names are interned */
+   {
+      lListElem *first = lCreateElem(TEST_Type);
+      lListElem *second = lCreateElem(TEST_Type);
+      lListElem *copy;
+      char name[] = "interned.host";
+
+      lSetHost(first, TEST_host, name);
+      lSetHost(second, TEST_host, name);
+      copy = lCopyElem(first);
+      if (lGetHost(first, TEST_host) == name || lGetHost(first, TEST_host) != lGetHost(second, TEST_host) ||
+          lGetHost(copy, TEST_host) != lGetHost(first, TEST_host)) {
+         printf("host names are not interned\n");
+         return EXIT_FAILURE;
+      }
+
+      /* the interned name lives as long as it is referenced */
+      lFreeElem(&first);
+      lSetHost(second, TEST_host, "other.host");
+      if (strcmp(lGetHost(copy, TEST_host), "interned.host") != 0) {
+         printf("interned host name was freed while it is still referenced\n");
+         return EXIT_FAILURE;
+      }
+      lFreeElem(&second);
+      lFreeElem(&copy);
+   }
+
+   /* compiled conditions give the same results as lCompare() */
+   {
+      lList *lp = lCreateList("where", TEST_Type);
+      const char *strings[] = {"alpha", "beta", "Gamma", nullptr};
+      lCondition *conditions[8];
+      int n = 0;
+
+      for (int i = 0; i < 8; i++) {
+         lListElem *elem = lAddElemUlong(&lp, TEST_ulong, i, TEST_Type);
+         lSetInt(elem, TEST_int, i - 4);
+         lSetString(elem, TEST_string, strings[i % 4]);
+         lSetHost(elem, TEST_host, strings[(i + 1) % 4]);
+      }
+
+      conditions[n++] = lWhere("%T(%I > %u && %I != %d)", TEST_Type, TEST_ulong, 2, TEST_int, 1);
+      conditions[n++] = lWhere("%T(%I == %s || %I <= %d)", TEST_Type, TEST_string, "beta", TEST_int, -3);
+      conditions[n++] = lWhere("%T(!(%I p= %s))", TEST_Type, TEST_string, "*a*");
+      conditions[n++] = lWhere("%T(%I p= %s && %I m= %u)", TEST_Type, TEST_host, "*", TEST_ulong, 1);
+      conditions[n++] = lWhere("%T(%I p= %s || %I c= %s)", TEST_Type, TEST_string, "beta", TEST_string, "gamma");
+      conditions[n++] = lWhere("%T(%I h= %s)", TEST_Type, TEST_host, "ALPHA");
+      conditions[n++] = lWhere("%T(%I < %s)", TEST_Type, TEST_string, "beta");
+      conditions[n++] = nullptr;
+
+      for (int c = 0; c < n; c++) {
+         if (conditions[c] == nullptr && c != n - 1) {
+            printf("condition %d could not be parsed\n", c);
+            return EXIT_FAILURE;
+         }
+      }
+      for (int c = 0; c < n; c++) {
+         lCompiledWhere *compiled = lCompileWhere(conditions[c], lGetListDescr(lp));
+         const lListElem *elem;
+
+         for_each_ep(elem, lp) {
+            if (lCompare(elem, conditions[c]) != lCompareCompiled(elem, compiled)) {
+               printf("compiled condition %d differs for element " sge_u32 "\n", c, lGetUlong(elem, TEST_ulong));
+               return EXIT_FAILURE;
+            }
+         }
+         lFreeCompiledWhere(&compiled);
+         lFreeWhere(&conditions[c]);
+      }
+      lFreeList(&lp);
+   }
+
+   /* pooled elements reuse the memory of freed elements */
+   {
+      lListElem *first;
+      lListElem *second;
+      const void *memory;
+
+      lSetPoolMode(true);
+      first = lCreateElem(TEST_Type);
+      lSetString(first, TEST_string, "pooled");
+      memory = first;
+      lFreeElem(&first);
+      if (lGetPoolSize() == 0) {
+         printf("freed element was not kept in the pool\n");
+         return EXIT_FAILURE;
+      }
+
+      second = lCreateElem(TEST_Type);
+      if (second != memory || lGetString(second, TEST_string) != nullptr || lGetPoolSize() != 0) {
+         printf("pooled element was not reused or not initialized\n");
+         return EXIT_FAILURE;
+      }
+
+      /* releasing the pool does not affect elements in use */
+      lFreeElem(&second);
+      lReleasePool();
+      if (lGetPoolSize() != 0) {
+         printf("pool was not released\n");
+         return EXIT_FAILURE;
+      }
+      lSetPoolMode(false);
+   }
+
+   /* inline accessors return the same values as the generic ones, also for reduced elements */
+   {
+      lEnumeration *what = lWhat("%T(%I %I)", TEST_Type, TEST_string, TEST_ulong);
+      lListElem *full = lCreateElem(TEST_Type);
+      lListElem *reduced;
+
+      lSetUlongInline(full, TEST_ulong, 42);
+      lSetDoubleInline(full, TEST_double, 1.5);
+      lAddDoubleInline(full, TEST_double, 1.0);
+      lSetString(full, TEST_string, "inline");
+      reduced = lSelectElemPack(full, nullptr, what, false, nullptr);
+
+      if (lGetUlongInline(full, TEST_ulong) != 42 || lGetUlong(full, TEST_ulong) != 42 ||
+          lGetDoubleInline(full, TEST_double) != 2.5 ||
+          strcmp(lGetStringInline(full, TEST_string), "inline") != 0 ||
+          lGetUlongInline(reduced, TEST_ulong) != 42 ||
+          strcmp(lGetStringInline(reduced, TEST_string), "inline") != 0) {
+         printf("inline accessors return wrong values\n");
+         return EXIT_FAILURE;
+      }
+      lSetUlongInline(reduced, TEST_ulong, 43);
+      if (lGetUlong(reduced, TEST_ulong) != 43) {
+         printf("inline setter failed for reduced element\n");
+         return EXIT_FAILURE;
+      }
+      /* names behind the end of the descriptor are not looked up */
+      if (lInlinePos(full, TEST_ref + 1, lUlongT) != -1 || lInlinePos(full, TEST_ref + 100, lUlongT) != -1) {
+         printf("inline position found for a name of a different type\n");
+         return EXIT_FAILURE;
+      }
+      lFreeElem(&reduced);
+      lFreeElem(&full);
+      lFreeWhat(&what);
+   }
+
+   /* sorting large lists (in parallel) keeps elements having the same key in their order */
+   for (int parallel = 0; parallel < 2; parallel++) {
+      lList *lp = lCreateList("sort", TEST_Type);
+      const char *strings[] = {"alpha", "beta", "gamma", "delta"};
+      const lListElem *elem;
+      const lListElem *prev = nullptr;
+      const void *iterator = nullptr;
+      int n = 60000;
+      int found = 0;
+
+      cull_hash_new(lp, TEST_string, false);
+      for (int i = 0; i < n; i++) {
+         lListElem *new_elem = lAddElemUlong(&lp, TEST_ulong, i, TEST_Type);
+         lSetInt(new_elem, TEST_int, (i * 7919) % 13);
+         lSetString(new_elem, TEST_string, strings[i % 4]);
+      }
+
+      if (parallel) {
+         /* the runner of the caller sorts the parts, here one thread per part */
+         lSortOrder *order = lParseSortOrderVarArg(lGetListDescr(lp), "%I+%I-", TEST_int, TEST_string);
+         int parts = 0;
+         lSortListParallel(lp, order, 3, [&parts](size_t n, const std::function<void(size_t, size_t)> &task) {
+            std::vector<std::thread> threads;
+            for (size_t part = 0; part < n; part++) {
+               threads.emplace_back(task, part, part + 1);
+            }
+            for (auto &thread : threads) {
+               thread.join();
+            }
+            parts = n;
+         });
+         lFreeSortOrder(&order);
+         if (parts != 3) {
+            printf("runner sorted %d parts, expected 3\n", parts);
+            return EXIT_FAILURE;
+         }
+      } else {
+         lPSortList(lp, "%I+%I-", TEST_int, TEST_string);
+      }
+      for_each_ep(elem, lp) {
+         if (prev != nullptr &&
+             (lGetInt(prev, TEST_int) > lGetInt(elem, TEST_int) ||
+              (lGetInt(prev, TEST_int) == lGetInt(elem, TEST_int) &&
+               (strcmp(lGetString(prev, TEST_string), lGetString(elem, TEST_string)) < 0 ||
+                (strcmp(lGetString(prev, TEST_string), lGetString(elem, TEST_string)) == 0 &&
+                 lGetUlong(prev, TEST_ulong) > lGetUlong(elem, TEST_ulong)))))) {
+            printf("list is not sorted at element " sge_u32 "\n", lGetUlong(elem, TEST_ulong));
+            return EXIT_FAILURE;
+         }
+         prev = elem;
+      }
+
+      /* the non unique hash follows the new list order */
+      prev = nullptr;
+      for (elem = lGetElemStrFirst(lp, TEST_string, "beta", &iterator); elem != nullptr;
+           elem = lGetElemStrNext(lp, TEST_string, "beta", &iterator)) {
+         if (prev != nullptr && lGetInt(prev, TEST_int) > lGetInt(elem, TEST_int)) {
+            printf("non unique hash does not follow the list order\n");
+            return EXIT_FAILURE;
+         }
+         prev = elem;
+         found++;
+      }
+      if (found != n / 4) {
+         printf("found %d elements via hash after sorting, expected %d\n", found, n / 4);
+         return EXIT_FAILURE;
+      }
+      lFreeList(&lp);
+   }
+
    /* test reducing of elements */
 
    /* cleanup and exit */
@@ -294,6 +294,221 @@ int main(int argc, char *argv[]) {
 #endif
    lFreeElem(&copy);
 
+   /* test packing of shared lists with a pack cache */
+   {
+      cull_pack_cache_t *pack_cache = cull_pack_cache_create();
+      sge_pack_buffer cached_pb;
+
+      lMarkListShared(lGetListRW(ep, TEST_list));
+      if ((pack_ret = init_packbuffer(&pb, 100)) != PACK_SUCCESS ||
+          (pack_ret = cull_pack_elem(&pb, ep)) != PACK_SUCCESS) {
+         printf("packing element failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+
+      // the second packbuffer gets the shared list from the cache
+      for (int i = 0; i < 2; i++) {
+         if ((pack_ret = init_packbuffer(&cached_pb, 100)) != PACK_SUCCESS) {
+            printf("initializing packbuffer failed: %s\n", cull_pack_strerror(pack_ret));
+            return EXIT_FAILURE;
+         }
+         cached_pb.pack_cache = pack_cache;
+         if ((pack_ret = cull_pack_elem(&cached_pb, ep)) != PACK_SUCCESS) {
+            printf("packing element with pack cache failed: %s\n", cull_pack_strerror(pack_ret));
+            return EXIT_FAILURE;
+         }
+         if (cached_pb.bytes_used != pb.bytes_used ||
+             memcmp(cached_pb.head_ptr, pb.head_ptr, pb.bytes_used) != 0) {
+            printf("packing element with pack cache returned different data\n");
+            return EXIT_FAILURE;
+         }
+         clear_packbuffer(&cached_pb);
+      }
+      clear_packbuffer(&pb);
+      cull_pack_cache_free(&pack_cache);
+   }
+
+   /* test the compact format */
+   {
+      size_t default_size;
+
+      if ((pack_ret = init_packbuffer(&pb, 100)) != PACK_SUCCESS ||
+          (pack_ret = cull_pack_elem(&pb, ep)) != PACK_SUCCESS) {
+         printf("packing element failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      default_size = pb.bytes_used;
+      clear_packbuffer(&pb);
+
+      if ((pack_ret = init_packbuffer(&pb, 100, true, true, true)) != PACK_SUCCESS ||
+          (pack_ret = cull_pack_elem(&pb, ep)) != PACK_SUCCESS) {
+         printf("counting element in compact format failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      counted_size = pb.bytes_used;
+      clear_packbuffer(&pb);
+
+      if ((pack_ret = init_packbuffer(&pb, 100, false, true, true)) != PACK_SUCCESS ||
+          (pack_ret = cull_pack_elem(&pb, ep)) != PACK_SUCCESS) {
+         printf("packing element in compact format failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      if (counted_size + 2 * INTSIZE + strlen(pb.auth_info) + 1 != pb.bytes_used) {
+         printf("just_count does not work in compact format, reported " sge_u32 ", expected " sge_u32 "\n",
+                counted_size, static_cast<u_long32>(pb.bytes_used));
+         return EXIT_FAILURE;
+      }
+      if (pb.bytes_used >= default_size) {
+         printf("compact format uses " sge_u32 " bytes, default format " sge_u32 " bytes\n",
+                static_cast<u_long32>(pb.bytes_used), static_cast<u_long32>(default_size));
+         return EXIT_FAILURE;
+      }
+      printf("compact format uses " sge_u32 " kb\n", static_cast<u_long32>(pb.bytes_used / 1024));
+
+      buffer = sge_malloc(pb.bytes_used);
+      SGE_ASSERT(buffer != nullptr);
+      memcpy(buffer, pb.head_ptr, pb.bytes_used);
+      if ((pack_ret = init_packbuffer_from_buffer(&copy_pb, buffer, pb.bytes_used)) != PACK_SUCCESS ||
+          (pack_ret = cull_unpack_elem(&copy_pb, &copy, TEST_Type)) != PACK_SUCCESS) {
+         printf("unpacking element in compact format failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      if (!compare_objects(ep, copy)) {
+         return EXIT_FAILURE;
+      }
+      clear_packbuffer(&pb);
+      clear_packbuffer(&copy_pb);
+      lFreeElem(&copy);
+
+      // integers at the limits of the variable length encoding
+      const u_long32 values32[] = {0, 1, 63, 64, 127, 128, 0x7fffffff, 0x80000000, U_LONG32_MAX};
+      const u_long64 values64[] = {0, 1, 0x7fffffffffffffffULL, 0x8000000000000000ULL, U_LONG64_MAX};
+      const double doubles[] = {0.0, -1.5, 3.1, 1e300};
+
+      init_packbuffer(&pb, 0, false, false, true);
+      for (auto value : values32) {
+         packint(&pb, value);
+      }
+      for (auto value : values64) {
+         packint64(&pb, value);
+      }
+      for (auto value : doubles) {
+         packdouble(&pb, value);
+      }
+      buffer = sge_malloc(pb.bytes_used);
+      SGE_ASSERT(buffer != nullptr);
+      memcpy(buffer, pb.head_ptr, pb.bytes_used);
+      init_packbuffer_from_buffer(&copy_pb, buffer, pb.bytes_used, false);
+      for (auto value : values32) {
+         u_long32 unpacked;
+         if (unpackint(&copy_pb, &unpacked) != PACK_SUCCESS || unpacked != value) {
+            printf("unpacking integer " sge_u32 " in compact format failed\n", value);
+            return EXIT_FAILURE;
+         }
+      }
+      for (auto value : values64) {
+         u_long64 unpacked;
+         if (unpackint64(&copy_pb, &unpacked) != PACK_SUCCESS || unpacked != value) {
+            printf("unpacking integer " sge_u64 " in compact format failed\n", value);
+            return EXIT_FAILURE;
+         }
+      }
+      for (auto value : doubles) {
+         double unpacked;
+         if (unpackdouble(&copy_pb, &unpacked) != PACK_SUCCESS || unpacked != value) {
+            printf("unpacking double %f in compact format failed\n", value);
+            return EXIT_FAILURE;
+         }
+      }
+      clear_packbuffer(&pb);
+      clear_packbuffer(&copy_pb);
+   }
+
+   /* test lazy unpacking of sublists, in both formats */
+   for (int compact = 0; compact < 2; compact++) {
+      sge_pack_buffer lazy_pb;
+      lListElem *lazy_copy;
+
+      if ((pack_ret = init_packbuffer(&pb, 100, false, true, compact == 1)) != PACK_SUCCESS ||
+          (pack_ret = cull_pack_elem(&pb, ep)) != PACK_SUCCESS) {
+         printf("packing element failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      buffer = sge_malloc(pb.bytes_used);
+      SGE_ASSERT(buffer != nullptr);
+      memcpy(buffer, pb.head_ptr, pb.bytes_used);
+      if ((pack_ret = init_packbuffer_from_buffer(&copy_pb, buffer, pb.bytes_used)) != PACK_SUCCESS) {
+         printf("initializing packbuffer from packed data failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      lSetLazyUnpackMode(true);
+      pack_ret = cull_unpack_elem(&copy_pb, &copy, TEST_Type);
+      lSetLazyUnpackMode(false);
+      if (pack_ret != PACK_SUCCESS) {
+         printf("lazy unpacking element failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      clear_packbuffer(&copy_pb);
+
+      // a copy of the element keeps the sublist packed as well
+      lazy_copy = lCopyElem(copy);
+
+      // packing the element again copies the packed sublist
+      if ((pack_ret = init_packbuffer(&lazy_pb, 100, false, true, compact == 1)) != PACK_SUCCESS ||
+          (pack_ret = cull_pack_elem(&lazy_pb, copy)) != PACK_SUCCESS) {
+         printf("packing lazily unpacked element failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      if (lazy_pb.bytes_used != pb.bytes_used || memcmp(lazy_pb.head_ptr, pb.head_ptr, pb.bytes_used) != 0) {
+         printf("packing lazily unpacked element returned different data\n");
+         return EXIT_FAILURE;
+      }
+      clear_packbuffer(&lazy_pb);
+      clear_packbuffer(&pb);
+
+      // the sublist is unpacked on access
+      if (!compare_objects(ep, copy) || !compare_objects(ep, lazy_copy)) {
+         printf("lazily unpacked element differs\n");
+         return EXIT_FAILURE;
+      }
+      if (lGetElemHost(lGetList(lazy_copy, TEST_list), TEST_host, lGetHost(lLast(lGetList(ep, TEST_list)), TEST_host)) == nullptr) {
+         printf("hash access to lazily unpacked sublist failed\n");
+         return EXIT_FAILURE;
+      }
+      lFreeElem(&lazy_copy);
+      lFreeElem(&copy);
+   }
+
+   /* test packing of a where condition with a host operand */
+   {
+      lCondition *where = lWhere("%T(%I h= %s)", TEST_Type, TEST_host, "test_host");
+      lCondition *where_copy = nullptr;
+
+      if ((pack_ret = init_packbuffer(&pb, 100)) != PACK_SUCCESS ||
+          (pack_ret = cull_pack_cond(&pb, where)) != PACK_SUCCESS) {
+         printf("packing where condition failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      buffer = sge_malloc(pb.bytes_used);
+      SGE_ASSERT(buffer != nullptr);
+      memcpy(buffer, pb.head_ptr, pb.bytes_used);
+      if ((pack_ret = init_packbuffer_from_buffer(&copy_pb, buffer, pb.bytes_used)) != PACK_SUCCESS ||
+          (pack_ret = cull_unpack_cond(&copy_pb, &where_copy)) != PACK_SUCCESS) {
+         printf("unpacking where condition failed: %s\n", cull_pack_strerror(pack_ret));
+         return EXIT_FAILURE;
+      }
+      if (!lCompare(ep, where_copy)) {
+         printf("unpacked where condition does not match\n");
+         return EXIT_FAILURE;
+      }
+      clear_packbuffer(&pb);
+      clear_packbuffer(&copy_pb);
+
+      // the host operand of the unpacked condition is freed like the one of lWhere()
+      lFreeWhere(&where_copy);
+      lFreeWhere(&where);
+   }
+
    /* test partial packing */
    if ((pack_ret = init_packbuffer(&pb, 100)) != PACK_SUCCESS) {
       printf("initializing packbuffer failed: %s\n", cull_pack_strerror(pack_ret));
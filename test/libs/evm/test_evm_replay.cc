@@ -0,0 +1,215 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
+#include "uti/sge.h"
+#include "uti/sge_monitor.h"
+#include "uti/sge_rmon_macros.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_answer.h"
+#include "sgeobj/sge_conf.h"
+#include "sgeobj/sge_event.h"
+#include "sgeobj/sge_report.h"
+
+#include "gdi/ocs_gdi_Packet.h"
+
+#include "evm/sge_event_master.h"
+
+// An event client receives events, disconnects and registers again presenting the sequence number
+// of the last event it received. Events created while it was gone, when nobody subscribed them,
+// have to be replayed or a total update has to be done.
+
+static monitoring_t monitor;
+static lList *report_list = nullptr;
+static lListElem *report = nullptr;
+
+// events received by the test event client
+static std::set<u_long32> added_jobs;
+static int list_events = 0;
+static u_long64 last_sequence = 0;
+static u_long32 last_number = 0;
+
+static void
+update_func(u_long32 id, lList **alpp, lList *event_report_list, void *arg) {
+   const lListElem *rep;
+   for_each_ep(rep, event_report_list) {
+      const lListElem *event;
+      for_each_ep(event, lGetList(rep, REP_list)) {
+         u_long32 type = lGetUlong(event, ET_type);
+
+         if (type == sgeE_JOB_ADD) {
+            added_jobs.insert(lGetUlong(event, ET_intkey));
+         } else if (type == sgeE_JOB_LIST) {
+            list_events++;
+         }
+         if (lGetUlong64(event, ET_sequence) > last_sequence) {
+            last_sequence = lGetUlong64(event, ET_sequence);
+         }
+         last_number = lGetUlong(event, ET_number);
+      }
+   }
+}
+
+static void
+deliver() {
+   sge_event_master_process_requests(&monitor);
+   sge_event_master_send_events(report, report_list, &monitor);
+
+   // acknowledge the events, otherwise they are delivered again
+   if (sge_has_event_client(EV_ID_SCHEDD)) {
+      sge_handle_event_ack(EV_ID_SCHEDD, last_number);
+      sge_event_master_process_requests(&monitor);
+   }
+}
+
+static void
+set_replay_log_size(int size) {
+   lList *answer_list = nullptr;
+   char value[64];
+   lListElem *global = lCreateElem(CONF_Type);
+
+   snprintf(value, sizeof(value), "EVENT_REPLAY_LOG_SIZE=%d", size);
+   lSetHost(global, CONF_name, SGE_GLOBAL_NAME);
+   lListElem *entry = lAddSubStr(global, CF_name, "qmaster_params", CONF_entries, CF_Type);
+   lSetString(entry, CF_value, value);
+   merge_configuration(&answer_list, QMASTER, "/tmp", global, nullptr, nullptr);
+   lFreeList(&answer_list);
+   lFreeElem(&global);
+}
+
+static void
+register_client(u_long64 resume_sequence) {
+   lList *answer_list = nullptr;
+   ocs::gdi::Packet packet;
+   lListElem *clio = lCreateElem(EV_Type);
+
+   strcpy(packet.user, "test");
+   strcpy(packet.host, "localhost");
+
+   lSetUlong(clio, EV_id, EV_ID_SCHEDD);
+   lSetString(clio, EV_name, "test_evm_replay");
+   lSetHost(clio, EV_host, "localhost");
+   lSetString(clio, EV_commproc, "test_evm_replay");
+   lSetUlong(clio, EV_commid, 1);
+   lSetUlong(clio, EV_d_time, 1);
+   lSetBool(clio, EV_changed, true);
+   lSetUlong64(clio, EV_resume_sequence, resume_sequence);
+   for (u_long32 type : {sgeE_JOB_LIST, sgeE_JOB_ADD}) {
+      lListElem *sub = lAddSubUlong(clio, EVS_id, type, EV_subscribed, EVS_Type);
+      lSetBool(sub, EVS_flush, true);
+      lSetUlong(sub, EVS_interval, 0);
+   }
+
+   added_jobs.clear();
+   list_events = 0;
+   sge_add_event_client(&packet, clio, &answer_list, nullptr, update_func, nullptr);
+   lFreeList(&answer_list);
+   lFreeElem(&clio);
+
+   deliver();
+}
+
+static void
+unregister_client() {
+   sge_remove_event_client(EV_ID_SCHEDD);
+   deliver();
+}
+
+static void
+add_job(u_long32 job_id) {
+   lListElem *job = lCreateElem(JB_Type);
+   lSetUlong(job, JB_job_number, job_id);
+   sge_add_event(0, sgeE_JOB_ADD, job_id, 0, nullptr, nullptr, nullptr, job, 0);
+   lFreeElem(&job);
+   deliver();
+}
+
+static int
+check(bool condition, const char *message) {
+   if (!condition) {
+      printf("failed: %s\n", message);
+      return 1;
+   }
+   return 0;
+}
+
+int main(int argc, char *argv[]) {
+   DENTER_MAIN(TOP_LAYER, "test_evm_replay");
+   int errors = 0;
+
+   lInit(nmv);
+   sge_monitor_init(&monitor, "test_evm_replay", EMAT_EXT, NO_WARNING, NO_ERROR, nullptr);
+   sge_event_master_init();
+
+   report_list = lCreateListHash("report list", REP_Type, false);
+   report = lCreateElem(REP_Type);
+   lSetUlong(report, REP_type, NUM_REP_REPORT_EVENTS);
+   lSetHost(report, REP_host, "localhost");
+   lAppendElem(report_list, report);
+
+   // the first registration gets a total update
+   register_client(0);
+   errors += check(list_events == 1, "no total update at the first registration");
+   add_job(1);
+   errors += check(added_jobs.count(1) == 1 && last_sequence > 0, "job 1 not delivered with a sequence number");
+
+   // nobody subscribed job 2, it has to be replayed
+   unregister_client();
+   add_job(2);
+   register_client(last_sequence);
+   errors += check(list_events == 0, "total update although the events are in the replay log");
+   errors += check(added_jobs.count(2) == 1, "job 2 not replayed");
+   errors += check(added_jobs.count(1) == 0, "job 1 replayed twice");
+
+   // job 3 is dropped while the log is disabled, the client has to get a total update
+   unregister_client();
+   set_replay_log_size(0);
+   add_job(3);
+   set_replay_log_size(100);
+   register_client(last_sequence);
+   errors += check(list_events == 1, "no total update after events were dropped");
+
+   // events delivered while the log is disabled make the log incomplete
+   add_job(4);
+   u_long64 sequence = last_sequence;
+   set_replay_log_size(0);
+   add_job(5);
+   unregister_client();
+   set_replay_log_size(100);
+   add_job(6);
+   register_client(sequence);
+   errors += check(list_events == 1, "no total update after the log was disabled");
+   errors += check(added_jobs.count(6) == 0, "events replayed from an incomplete log");
+
+   unregister_client();
+   sge_cleanup_event_master_control(nullptr);
+   lFreeList(&report_list);
+   sge_monitor_free(&monitor);
+
+   if (errors == 0) {
+      printf("event replay ok\n");
+   }
+   DRETURN(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
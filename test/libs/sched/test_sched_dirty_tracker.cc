@@ -0,0 +1,185 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "sgeobj/sge_answer.h"
+#include "sgeobj/sge_schedd_conf.h"
+#include "sgeobj/cull/sge_all_listsL.h"
+
+#include "ocs_DirtyTracker.h"
+
+static lList *category_list = nullptr;
+static lList *host_list = nullptr;
+static lList *rqs_list = nullptr;
+
+static int
+check(bool condition, const char *message) {
+   if (!condition) {
+      printf("failed: %s\n", message);
+      return 1;
+   }
+   return 0;
+}
+
+// simulates a scheduling run where the jobs of the given category get rejected
+static void
+run(bool is_reuse, lListElem *job, bool is_rejected) {
+   lListElem *category;
+   for_each_rw(category, category_list) {
+      lSetBool(category, CT_rejected, false);
+   }
+
+   ocs::DirtyTracker::start_run(true, is_reuse, category_list, host_list, rqs_list);
+   if (is_rejected) {
+      ocs::DirtyTracker::category_rejected(job);
+   }
+}
+
+static lList *
+create_gdil(const char *hostname) {
+   lList *gdil = nullptr;
+   lAddElemHost(&gdil, JG_qhostname, hostname, JG_Type);
+   return gdil;
+}
+
+static int
+test_incremental_scheduling_param(const char *params, bool expected) {
+   lList *answer_list = nullptr;
+   lList *schedd_list = lCreateList("schedd_conf", SC_Type);
+   lListElem *schedd_conf = sconf_create_default();
+
+   lSetString(schedd_conf, SC_params, params);
+   lAppendElem(schedd_list, schedd_conf);
+   sconf_set_config(&schedd_list, &answer_list);
+   lFreeList(&answer_list);
+
+   bool enabled = sconf_get_incremental_scheduling();
+   if (enabled != expected) {
+      printf("failed: params %s result in incremental scheduling %d, expected %d\n", params, enabled, expected);
+      return 1;
+   }
+   return 0;
+}
+
+int main(int argc, char *argv[]) {
+   DENTER_MAIN(TOP_LAYER, "test_sched_dirty_tracker");
+   int errors = 0;
+
+   lInit(nmv);
+
+   lAddElemHost(&host_list, EH_name, "global", EH_Type);
+   lAddElemHost(&host_list, EH_name, "host1", EH_Type);
+   lAddElemHost(&host_list, EH_name, "host2", EH_Type);
+   lListElem *category = lAddElemStr(&category_list, CT_str, "-l h_vmem=100G", CT_Type);
+   lListElem *job = lCreateElem(JB_Type);
+   lSetRef(job, JB_category, category);
+
+   // the first run has to evaluate everything
+   run(true, job, true);
+   errors += check(!lGetBool(category, CT_rejected), "category rejected by the first run");
+   ocs::DirtyTracker::finish_run();
+
+   // nothing changed: the category is rejected again without dispatching
+   run(true, job, false);
+   errors += check(lGetBool(category, CT_rejected), "category not reused");
+   errors += check(ocs::DirtyTracker::get_reused_categories() == 1, "wrong number of reused categories");
+   ocs::DirtyTracker::finish_run();
+
+   // no reuse if it is not allowed (e.g. schedd_job_info), but rejections are recorded
+   run(false, job, true);
+   errors += check(!lGetBool(category, CT_rejected), "category reused although not allowed");
+   ocs::DirtyTracker::finish_run();
+
+   // a changed host: the jobs have to be matched against this host only
+   ocs::DirtyTracker::mark_host("host1");
+   run(true, job, true);
+   errors += check(!lGetBool(category, CT_rejected), "category reused with a dirty host");
+   errors += check(ocs::DirtyTracker::is_dirty_hosts_only(job), "job not restricted to dirty hosts");
+   errors += check(ocs::DirtyTracker::is_dirty_host("host1"), "host1 is not dirty");
+   errors += check(!ocs::DirtyTracker::is_dirty_host("host2"), "host2 is dirty");
+   errors += check(ocs::DirtyTracker::get_dirty_hosts() == 1, "wrong number of dirty hosts");
+   ocs::DirtyTracker::finish_run();
+
+   // parallel jobs are never restricted to the dirty hosts
+   ocs::DirtyTracker::mark_host("host2");
+   lSetString(job, JB_pe, "mpi");
+   run(true, job, true);
+   errors += check(!ocs::DirtyTracker::is_dirty_hosts_only(job), "parallel job restricted to dirty hosts");
+   lSetString(job, JB_pe, nullptr);
+   ocs::DirtyTracker::finish_run();
+
+   // a changed global object invalidates everything
+   ocs::DirtyTracker::mark_all();
+   run(true, job, true);
+   errors += check(!lGetBool(category, CT_rejected), "category reused after mark_all");
+   errors += check(!ocs::DirtyTracker::is_dirty_hosts_only(job), "job restricted after mark_all");
+   ocs::DirtyTracker::finish_run();
+
+   // the global host invalidates everything, too
+   ocs::DirtyTracker::mark_host("global");
+   run(true, job, false);
+   errors += check(!lGetBool(category, CT_rejected), "category reused after a change of the global host");
+   ocs::DirtyTracker::finish_run();
+
+   // without global resources rejections after a dispatched job are still valid
+   run(true, job, false);
+   lList *gdil = create_gdil("host2");
+   ocs::DirtyTracker::job_dispatched(gdil);
+   ocs::DirtyTracker::category_rejected(job);
+   ocs::DirtyTracker::finish_run();
+   run(true, job, false);
+   errors += check(!lGetBool(category, CT_rejected), "category reused although a host got a job");
+   errors += check(ocs::DirtyTracker::is_dirty_host("host2"), "host of the dispatched job is not dirty");
+   ocs::DirtyTracker::finish_run();
+
+   // with resource quotas a dispatched job can affect all other jobs
+   lListElem *rqs = lAddElemStr(&rqs_list, RQS_name, "max_slots", RQS_Type);
+   lSetBool(rqs, RQS_enabled, true);
+   run(true, job, false);
+   ocs::DirtyTracker::job_dispatched(gdil);
+   ocs::DirtyTracker::category_rejected(job);
+   ocs::DirtyTracker::finish_run();
+   run(true, job, false);
+   errors += check(!lGetBool(category, CT_rejected), "rejection after a dispatched job was recorded");
+   ocs::DirtyTracker::finish_run();
+   errors += check(ocs::DirtyTracker::has_global_resources(host_list, rqs_list), "resource quota not detected");
+   lSetBool(rqs, RQS_enabled, false);
+   errors += check(!ocs::DirtyTracker::has_global_resources(host_list, rqs_list), "disabled resource quota detected");
+
+   errors += test_incremental_scheduling_param("INCREMENTAL_SCHEDULING=true", true);
+   errors += test_incremental_scheduling_param("NONE", false);
+   errors += test_incremental_scheduling_param("INCREMENTAL_SCHEDULING=1", true);
+   errors += test_incremental_scheduling_param("INCREMENTAL_SCHEDULING=false", false);
+
+   lFreeList(&gdil);
+   lFreeElem(&job);
+   lFreeList(&category_list);
+   lFreeList(&host_list);
+   lFreeList(&rqs_list);
+
+   if (errors == 0) {
+      printf("dirty tracker ok\n");
+   }
+   DRETURN(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
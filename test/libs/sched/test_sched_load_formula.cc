@@ -32,11 +32,16 @@
  ************************************************************************/
 /*___INFO__MARK_END__*/
 
+#include <cstring>
+
+#include "uti/sge.h"
 #include "uti/sge_bootstrap.h"
 #include "uti/sge_rmon_macros.h"
 
 #include "sgeobj/sge_centry.h"
 #include "sgeobj/sge_answer.h"
+#include "sgeobj/sge_host.h"
+#include "sgeobj/sge_schedd_conf.h"
 #include "sgeobj/cull/sge_all_listsL.h"
 
 #include "sort_hosts.h"
@@ -46,6 +51,87 @@ typedef struct {
    double value;
 } filter_test_t;
 
+static lListElem *
+create_host(lList *host_list, const char *name, const lListElem *centry, double num_proc)
+{
+   lListElem *host = lAddElemHost(&host_list, EH_name, name, EH_Type);
+
+   if (centry != nullptr) {
+      lList *config_list = lCreateList("", CE_Type);
+      lListElem *config = lCopyElem(centry);
+
+      lSetDouble(config, CE_doubleval, num_proc);
+      lAppendElem(config_list, config);
+      lSetList(host, EH_consumable_config_list, config_list);
+   }
+   return host;
+}
+
+/*
+ * sort_host_list() evaluates the load formula of the scheduler configuration
+ * for all hosts at once. The result has to be the same as the one of
+ * scaled_mixed_load() for each host.
+ */
+static int
+test_sort_host_list(const lList *centry_list, const lListElem *centry)
+{
+   int failed = 0;
+   lList *answer_list = nullptr;
+   lList *schedd_list = lCreateList("schedd_conf", SC_Type);
+   lListElem *schedd_conf = sconf_create_default();
+   lList *host_list = lCreateList("hosts", EH_Type);
+   const char *expected_order[] = {"host_b", "host_a", "host_c", "host_d"};
+   int i = 0;
+
+   lSetString(schedd_conf, SC_load_formula, "-num_proc*2+100");
+   lAppendElem(schedd_list, schedd_conf);
+   if (!sconf_set_config(&schedd_list, &answer_list)) {
+      answer_list_output(&answer_list);
+      lFreeList(&schedd_list);
+      return 1;
+   }
+
+   create_host(host_list, SGE_GLOBAL_NAME, nullptr, 0);
+   create_host(host_list, "host_a", centry, 4);
+   create_host(host_list, "host_b", centry, 8);
+   create_host(host_list, "host_c", centry, 2);
+   create_host(host_list, "host_d", nullptr, 0);
+
+   if (sort_host_list(host_list, centry_list) != 0) {
+      printf("sort_host_list failed\n");
+      failed++;
+   }
+
+   const lListElem *global = host_list_locate(host_list, SGE_GLOBAL_NAME);
+   const lListElem *host;
+   for_each_ep(host, host_list) {
+      if (host == global) {
+         continue;
+      }
+      const char *name = lGetHost(host, EH_name);
+      double expected = scaled_mixed_load("-num_proc*2+100", const_cast<lListElem *>(global),
+                                          const_cast<lListElem *>(host), centry_list);
+
+      if (lGetDouble(host, EH_sort_value) != expected) {
+         printf("%s: sort value %f differs from scaled_mixed_load() %f\n", name, lGetDouble(host, EH_sort_value),
+                expected);
+         failed++;
+      }
+      if (i < 4 && strcmp(name, expected_order[i]) != 0) {
+         printf("expected %s at position %d but got %s\n", expected_order[i], i, name);
+         failed++;
+      }
+      i++;
+   }
+   if (lGetDouble(host_list_locate(host_list, "host_d"), EH_sort_value) != ERROR_LOAD_VAL) {
+      printf("host without num_proc did not get ERROR_LOAD_VAL\n");
+      failed++;
+   }
+
+   lFreeList(&host_list);
+   return failed;
+}
+
 int main(int argc, char *argv[])
 {
    int pos_tests_failed = 0;
@@ -64,6 +150,16 @@ int main(int argc, char *argv[])
       {"$num_proc-2", 2}, 
       {"$num_proc+0.1", 4.1}, 
       {"1+$num_proc+0.1", 5.1}, 
+      {"-num_proc+10", 6},
+      {nullptr, 0}
+   };
+
+   /* operators which are not accepted by validate_load_formula() but evaluated by scaled_mixed_load() */
+   filter_test_t eval_test[] = {
+      {"num_proc&6", 4},
+      {"num_proc|1", 5},
+      {"num_proc^5", 1},
+      {"num_proc/num_proc-num_proc", -3},
       {nullptr, 0}
    };
 
@@ -125,6 +221,22 @@ int main(int argc, char *argv[])
       lFreeList(&answer_list);
    }
 
+   for (i=0; eval_test[i].formula != nullptr; i++) {
+      double val = scaled_mixed_load(eval_test[i].formula, nullptr, host, centry_list);
+      if (val != eval_test[i].value) {
+         printf("%s: got %f, but expected %f\n", eval_test[i].formula, val, eval_test[i].value);
+         pos_tests_failed++;
+      }
+   }
+
+   /* unknown attributes result in ERROR_LOAD_VAL */
+   if (scaled_mixed_load("num_proc+unknown", nullptr, host, centry_list) != ERROR_LOAD_VAL) {
+      printf("unknown attribute did not result in ERROR_LOAD_VAL\n");
+      pos_tests_failed++;
+   }
+
+   pos_tests_failed += test_sort_host_list(centry_list, centry);
+
    lFreeList(&centry_list);
    lFreeElem(&host);
 
@@ -0,0 +1,427 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#if defined(LINUX)
+#include <dirent.h>
+#endif
+
+#include "uti/sge_dstring.h"
+#include "uti/sge_rmon_macros.h"
+
+#include "sgeobj/ocs_DataStore.h"
+#include "sgeobj/sge_answer.h"
+#include "sgeobj/sge_attr.h"
+#include "sgeobj/sge_centry.h"
+#include "sgeobj/sge_host.h"
+#include "sgeobj/sge_job.h"
+#include "sgeobj/sge_pe.h"
+#include "sgeobj/sge_qinstance.h"
+#include "sgeobj/sge_schedd_conf.h"
+#include "sgeobj/sge_userset.h"
+#include "sgeobj/cull/sge_all_listsL.h"
+
+#include "ocs_MatchWorkers.h"
+#include "sge_schedd_text.h"
+#include "sge_select_queue.h"
+
+// every candidate has to be processed exactly once
+static int
+test_run(int threads, size_t n, size_t min_chunk_size, bool expect_parallel) {
+   int errors = 0;
+   std::vector<std::atomic<int>> visits(n);
+
+   bool parallel = ocs::MatchWorkers::run(threads, n, min_chunk_size, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+         visits[i]++;
+      }
+   });
+
+   if (parallel != expect_parallel) {
+      printf("failed: run(%d, %zu, %zu) returned %d, expected %d\n", threads, n, min_chunk_size, parallel,
+             expect_parallel);
+      errors++;
+   }
+   for (size_t i = 0; i < n; i++) {
+      if (visits[i] != 1) {
+         printf("failed: run(%d, %zu, %zu) processed candidate %zu %d times\n", threads, n, min_chunk_size, i,
+                visits[i].load());
+         errors++;
+         break;
+      }
+   }
+   return errors;
+}
+
+#if defined(LINUX)
+static int
+count_threads() {
+   int count = 0;
+   DIR *dir = opendir("/proc/self/task");
+
+   if (dir != nullptr) {
+      const struct dirent *entry;
+      while ((entry = readdir(dir)) != nullptr) {
+         if (entry->d_name[0] != '.') {
+            count++;
+         }
+      }
+      closedir(dir);
+   }
+   return count;
+}
+#endif
+
+// shutdown() joins the workers, a later run starts new ones
+static int
+test_shutdown() {
+   int errors = 0;
+
+   ocs::MatchWorkers::shutdown();
+#if defined(LINUX)
+   int threads = count_threads();
+#endif
+   errors += test_run(4, 1000, 64, true);
+   ocs::MatchWorkers::shutdown();
+#if defined(LINUX)
+   if (count_threads() != threads) {
+      printf("failed: %d threads are running after shutdown, expected %d\n", count_threads(), threads);
+      errors++;
+   }
+#endif
+   errors += test_run(3, 1000, 64, true);
+   ocs::MatchWorkers::shutdown();
+   return errors;
+}
+
+static int
+test_match_threads_param(const char *params, int expected) {
+   lList *answer_list = nullptr;
+   lList *schedd_list = lCreateList("schedd_conf", SC_Type);
+   lListElem *schedd_conf = sconf_create_default();
+
+   lSetString(schedd_conf, SC_params, params);
+   lAppendElem(schedd_list, schedd_conf);
+   sconf_set_config(&schedd_list, &answer_list);
+   lFreeList(&answer_list);
+
+   int threads = sconf_get_match_threads();
+   if (threads != expected) {
+      printf("failed: params %s result in %d match threads, expected %d\n", params, threads, expected);
+      return 1;
+   }
+   return 0;
+}
+
+// hosts host000 ... host079 with one instance of all.q and other.q each, enough for the static prematch
+#define MATCH_HOSTS 80
+
+// the first hosts reject the job in all.q, in the order of the tagging loops
+#define MATCH_REJECTING_HOSTS 70
+
+static lList *match_host_list = nullptr;
+static lList *match_queue_list = nullptr;
+static lList *match_centry_list = nullptr;
+static lList *match_acl_list = nullptr;
+static lList *match_pe_list = nullptr;
+
+static void
+set_schedd_params(const char *params) {
+   lList *answer_list = nullptr;
+   lList *schedd_list = lCreateList("schedd_conf", SC_Type);
+   lListElem *schedd_conf = sconf_create_default();
+
+   lSetString(schedd_conf, SC_params, params);
+   lAppendElem(schedd_list, schedd_conf);
+   sconf_set_config(&schedd_list, &answer_list);
+   lFreeList(&answer_list);
+}
+
+static lListElem *
+create_slots(const char *value) {
+   lListElem *slots = lCreateElem(CE_Type);
+   lSetString(slots, CE_name, SGE_ATTR_SLOTS);
+   lSetString(slots, CE_stringval, value);
+   lSetDouble(slots, CE_doubleval, atof(value));
+   return slots;
+}
+
+static void
+create_cqueue(const char *name) {
+   lList **cqueue_list = ocs::DataStore::get_master_list_rw(SGE_TYPE_CQUEUE);
+   lListElem *cq = lAddElemStr(cqueue_list, CQ_name, name, CQ_Type);
+
+   lAddSubHost(cq, APRJLIST_href, HOSTREF_DEFAULT, CQ_projects, APRJLIST_Type);
+   lAddSubHost(cq, APRJLIST_href, HOSTREF_DEFAULT, CQ_xprojects, APRJLIST_Type);
+   lAddSubHost(cq, AUSRLIST_href, HOSTREF_DEFAULT, CQ_acl, AUSRLIST_Type);
+   lAddSubHost(cq, AUSRLIST_href, HOSTREF_DEFAULT, CQ_xacl, AUSRLIST_Type);
+   lListElem *pe_list = lAddSubHost(cq, ASTRLIST_href, HOSTREF_DEFAULT, CQ_pe_list, ASTRLIST_Type);
+   lAddSubStr(pe_list, ST_name, "mype", ASTRLIST_value, ST_Type);
+}
+
+static lListElem *
+create_queue(const char *cqname, const char *hostname, u_long32 seq_no) {
+   lListElem *queue = lCreateElem(QU_Type);
+   dstring full_name = DSTRING_INIT;
+
+   lSetString(queue, QU_full_name, sge_dstring_sprintf(&full_name, "%s@%s", cqname, hostname));
+   lSetString(queue, QU_qname, cqname);
+   lSetHost(queue, QU_qhostname, hostname);
+   lSetUlong(queue, QU_seq_no, seq_no);
+   lSetUlong(queue, QU_qtype, BQ);
+   lSetUlong(queue, QU_job_slots, 2);
+   lAddSubStr(queue, ST_name, "mype", QU_pe_list, ST_Type);
+   lAppendElem(lGetOrCreateList(queue, QU_consumable_config_list, "slots", CE_Type), create_slots("2"));
+   lAddSubStr(queue, RUE_name, SGE_ATTR_SLOTS, QU_resource_utilization, RUE_Type);
+   lAppendElem(match_queue_list, queue);
+   sge_dstring_free(&full_name);
+   return queue;
+}
+
+// the rejections of the static matching are spread over the hosts and queues:
+// host access lists, queue access lists and projects of all.q; other.q is rejected by the hard queue list
+static void
+create_match_objects() {
+   lListElem *ep;
+
+   match_centry_list = lCreateList("centries", CE_Type);
+   ep = lAddElemStr(&match_centry_list, CE_name, SGE_ATTR_SLOTS, CE_Type);
+   lSetString(ep, CE_shortcut, "s");
+   lSetUlong(ep, CE_valtype, TYPE_INT);
+   lSetUlong(ep, CE_relop, CMPLXLE_OP);
+   lSetUlong(ep, CE_requestable, REQU_YES);
+   lSetUlong(ep, CE_consumable, CONSUMABLE_YES);
+   lSetString(ep, CE_defaultval, "1");
+   ep = lAddElemStr(&match_centry_list, CE_name, SGE_ATTR_QNAME, CE_Type);
+   lSetString(ep, CE_shortcut, "q");
+   lSetUlong(ep, CE_valtype, TYPE_RESTR);
+   lSetUlong(ep, CE_relop, CMPLXEQ_OP);
+   lSetUlong(ep, CE_requestable, REQU_YES);
+   lSetUlong(ep, CE_consumable, CONSUMABLE_NO);
+
+   ep = lAddElemStr(&match_acl_list, US_name, "deny_users", US_Type);
+   lSetUlong(ep, US_type, US_ACL);
+   lAddSubStr(ep, UE_name, "somebody", US_entries, UE_Type);
+
+   ep = lAddElemStr(&match_pe_list, PE_name, "mype", PE_Type);
+   lSetUlong(ep, PE_slots, 1000);
+   lSetString(ep, PE_allocation_rule, "$round_robin");
+   lSetBool(ep, PE_job_is_first_task, true);
+   lSetString(ep, PE_urgency_slots, "min");
+   pe_set_slots_used(ep, 0);
+
+   create_cqueue("all.q");
+   create_cqueue("other.q");
+
+   match_host_list = lCreateList("hosts", EH_Type);
+   lAddElemHost(&match_host_list, EH_name, SGE_GLOBAL_NAME, EH_Type);
+   match_queue_list = lCreateList("queues", QU_Type);
+   for (int i = 0; i < MATCH_HOSTS; i++) {
+      char hostname[32];
+      snprintf(hostname, sizeof(hostname), "host%03d", i);
+
+      lListElem *host = lAddElemHost(&match_host_list, EH_name, hostname, EH_Type);
+      lSetDouble(host, EH_sort_value, i);
+
+      lListElem *queue = create_queue("all.q", hostname, 0);
+      create_queue("other.q", hostname, 1);
+
+      if (i < MATCH_REJECTING_HOSTS) {
+         switch (i % 3) {
+            case 0:
+               lAddSubStr(queue, US_name, "deny_users", QU_acl, US_Type);
+               break;
+            case 1:
+               lAddSubStr(queue, PR_name, "proj", QU_projects, PR_Type);
+               break;
+            default:
+               lAddSubStr(host, US_name, "deny_users", EH_acl, US_Type);
+               break;
+         }
+      }
+   }
+}
+
+static lListElem *
+create_match_job(bool parallel) {
+   lListElem *job = lCreateElem(JB_Type);
+   lList *queue_list = nullptr;
+
+   lSetUlong(job, JB_job_number, 1);
+   lSetString(job, JB_owner, "tester");
+   lSetString(job, JB_group, "staff");
+   lAddSubUlong(job, JAT_task_number, 1, JB_ja_tasks, JAT_Type);
+
+   lAddElemStr(&queue_list, QR_name, "all.q", QR_Type);
+   lAddElemStr(&queue_list, QR_name, "other.q@host077", QR_Type);
+
+   if (!parallel) {
+      job_set_hard_queue_list(job, queue_list);
+   } else {
+      // the master queue has to be one of the last hosts, slave tasks can run in the same queues as sequential jobs
+      job_set_hard_queue_list(job, queue_list, JRS_SCOPE_SLAVE);
+
+      lList *range_list = nullptr;
+      lListElem *range = lAddElemUlong(&range_list, RN_min, 4, RN_Type);
+      lSetUlong(range, RN_max, 4);
+      lSetUlong(range, RN_step, 1);
+      lSetString(job, JB_pe, "mype");
+      lSetList(job, JB_pe_range, range_list);
+
+      queue_list = nullptr;
+      lAddElemStr(&queue_list, QR_name, "all.q@host075", QR_Type);
+      job_set_master_hard_queue_list(job, queue_list);
+   }
+   return job;
+}
+
+// runs an assignment on copies of the hosts and queues, returns the tagged queues, the assignment and the messages
+static std::string
+run_assignment(const char *params, bool parallel) {
+   DENTER(TOP_LAYER);
+   std::string result;
+   lList *monitor_list = nullptr;
+   lList *host_list = lCopyList(nullptr, match_host_list);
+   lList *queue_list = lCopyList(nullptr, match_queue_list);
+   lListElem *job = create_match_job(parallel);
+   sge_assignment_t a = SGE_ASSIGNMENT_INIT;
+   dispatch_t ret;
+
+   set_schedd_params(params);
+
+   assignment_init(&a, job, lFirstRW(lGetList(job, JB_ja_tasks)), nullptr);
+   a.host_list = host_list;
+   a.queue_list = queue_list;
+   a.centry_list = match_centry_list;
+   a.acl_list = match_acl_list;
+   a.gep = host_list_locate(host_list, SGE_GLOBAL_NAME);
+   a.monitor_alpp = &monitor_list;
+   a.start = DISPATCH_TIME_NOW;
+   a.duration = 60;
+   if (parallel) {
+      ret = sge_select_parallel_environment(&a, match_pe_list);
+   } else {
+      a.slots = 1;
+      ret = sge_sequential_assignment(&a);
+   }
+
+   result += "result " + std::to_string(ret) + "\n";
+   const lListElem *ep;
+   for_each_ep(ep, queue_list) {
+      if (lGetUlong(ep, QU_tag) != 0) {
+         result += "tagged " + std::string(lGetString(ep, QU_full_name)) + " " +
+                   std::to_string(lGetUlong(ep, QU_tag)) + " " + std::to_string(lGetUlong(ep, QU_tagged4schedule)) + "\n";
+      }
+   }
+   for_each_ep(ep, a.gdil) {
+      result += "granted " + std::string(lGetString(ep, JG_qname)) + " " + std::to_string(lGetUlong(ep, JG_slots)) + "\n";
+   }
+   for_each_ep(ep, monitor_list) {
+      result += std::string(lGetString(ep, AN_text)) + "\n";
+   }
+
+   assignment_release(&a);
+   lFreeList(&monitor_list);
+   lFreeList(&host_list);
+   lFreeList(&queue_list);
+   lFreeElem(&job);
+   DRETURN(result);
+}
+
+static int
+contains_message(const std::string &result, u_long32 message_number, const char *arg0, const char *arg1) {
+   dstring message = DSTRING_INIT;
+   sge_dstring_sprintf(&message, sge_schedd_text(message_number), arg0, arg1);
+   std::string line = "Job 1 " + std::string(sge_dstring_get_string(&message)) + "\n";
+   sge_dstring_free(&message);
+
+   if (result.find(line) == std::string::npos) {
+      printf("failed: message missing: %s", line.c_str());
+      return 1;
+   }
+   return 0;
+}
+
+// the static prematch of the match workers must neither change the tagged queues nor the scheduler messages
+static int
+test_static_prematch(bool parallel) {
+   int errors = 0;
+   std::string sequential = run_assignment("NONE", parallel);
+   std::string threaded = run_assignment("MATCH_THREADS=4", parallel);
+
+   errors += contains_message(sequential, SCHEDD_INFO_HASNOPERMISSION_SS, "queue", "all.q@host000");
+   errors += contains_message(sequential, SCHEDD_INFO_HASNOPRJ_S, "queue", "all.q@host001");
+   errors += contains_message(sequential, SCHEDD_INFO_HASNOPERMISSION_SS, "host", "host002");
+   errors += contains_message(sequential, SCHEDD_INFO_NOTINHARDQUEUELST_S, "other.q@host000", nullptr);
+   if (sequential.find(parallel ? "granted all.q@host075" : "granted all.q@host070") == std::string::npos) {
+      printf("failed: unexpected %s assignment:\n%s", parallel ? "parallel" : "sequential", sequential.c_str());
+      errors++;
+   }
+   if (sequential != threaded) {
+      printf("failed: %s assignment differs with match threads\nwithout:\n%s\nwith:\n%s",
+             parallel ? "parallel" : "sequential", sequential.c_str(), threaded.c_str());
+      errors++;
+   }
+   return errors;
+}
+
+int main(int argc, char *argv[]) {
+   DENTER_MAIN(TOP_LAYER, "test_sched_match_workers");
+   int errors = 0;
+
+   lInit(nmv);
+
+   errors += test_run(1, 1000, 64, false);
+   errors += test_run(4, 100, 64, false);
+   errors += test_run(4, 0, 64, false);
+   errors += test_run(4, 1000, 64, true);
+   errors += test_run(4, 1001, 1, true);
+   errors += test_run(2, 128, 64, true);
+
+   // the workers are reused and started on demand when more threads are requested
+   for (int i = 0; i < 200; i++) {
+      errors += test_run(2 + i % 7, 5000 + i, 64, true);
+   }
+   errors += test_shutdown();
+
+   errors += test_match_threads_param("MATCH_THREADS=4", 4);
+   errors += test_match_threads_param("NONE", 0);
+   errors += test_match_threads_param("MATCH_THREADS=1000", 0);
+
+   create_match_objects();
+   errors += test_static_prematch(false);
+   errors += test_static_prematch(true);
+   lFreeList(&match_host_list);
+   lFreeList(&match_queue_list);
+   lFreeList(&match_centry_list);
+   lFreeList(&match_acl_list);
+   lFreeList(&match_pe_list);
+   ocs::DataStore::free_master_list(SGE_TYPE_CQUEUE);
+
+   if (errors == 0) {
+      printf("match workers ok\n");
+   }
+   DRETURN(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -54,6 +54,7 @@ static int do_qeti_test(lListElem *cr, u_long64 *qeti_expected_result);
 
 static int test_normal_utilization();
 static int test_extensive_utilization();
+static int test_large_utilization();
 
 int main(int argc, char *argv[]) 
 {
@@ -65,6 +66,7 @@ int main(int argc, char *argv[])
 
    ret += test_normal_utilization();
    ret += test_extensive_utilization();
+   ret += test_large_utilization();
 
    if (ret != 0) {
       printf("\ntest failed!\n");
@@ -300,3 +302,165 @@ static int test_extensive_utilization() {
 
    return ret;
 }
+
+#define LARGE_RESERVATIONS 300
+
+/* utilization at a point in time calculated from the reservations */
+static double large_utilization(const test_array_t *ta, int n, u_long64 time) {
+   double uti = 0;
+
+   for (int i = 0; i < n; i++) {
+      if (ta[i].start_time <= time && time < ta[i].start_time + ta[i].duration) {
+         uti += ta[i].uti;
+      }
+   }
+   return uti;
+}
+
+/* maximum utilization within a time frame calculated from the reservations */
+static double large_utilization_max(const test_array_t *ta, int n, u_long64 start, u_long64 duration) {
+   double max = large_utilization(ta, n, start);
+
+   for (int i = 0; i < n; i++) {
+      u_long64 times[] = {ta[i].start_time, ta[i].start_time + ta[i].duration};
+      for (u_long64 time : times) {
+         if (start < time && time < start + duration) {
+            max = MAX(max, large_utilization(ta, n, time));
+         }
+      }
+   }
+   return max;
+}
+
+static int check_large_diagram(const lListElem *cr, const test_array_t *ta, int n) {
+   int ret = 0;
+   const lListElem *rde;
+   const lListElem *prev = nullptr;
+
+   for_each_ep(rde, lGetList(cr, RUE_utilized)) {
+      u_long64 time = lGetUlong64(rde, RDE_time);
+      if (lGetDouble(rde, RDE_amount) != large_utilization(ta, n, time)) {
+         printf("failed: diagram has %f at " sge_u64 ", expected %f\n", lGetDouble(rde, RDE_amount), time,
+                large_utilization(ta, n, time));
+         ret++;
+      }
+      if (prev == nullptr ? lGetDouble(rde, RDE_amount) == 0.0 :
+          lGetDouble(rde, RDE_amount) == lGetDouble(prev, RDE_amount) || lGetUlong64(prev, RDE_time) >= time) {
+         printf("failed: diagram is not normalized at " sge_u64 "\n", time);
+         ret++;
+      }
+      prev = rde;
+   }
+   return ret;
+}
+
+static int check_large_queries(const lListElem *cr, const test_array_t *ta, int n) {
+   int ret = 0;
+   u_long64 below[6];
+
+   for (int i = 0; i < 6; i++) {
+      below[i] = utilization_below(cr, i * 2, "test", false);
+   }
+
+   // the same queries are answered by the timeline
+   utilization_timeline_add(cr);
+   for (int i = 0; i < 6; i++) {
+      u_long64 when = utilization_below(cr, i * 2, "test", false);
+      if (when != below[i]) {
+         printf("failed: utilization_below(%d) returned " sge_u64 " with timeline, expected " sge_u64 "\n",
+                i * 2, when, below[i]);
+         ret++;
+      }
+   }
+   for (u_long64 start = 500; start < 4500; start += 37) {
+      for (u_long64 duration = 1; duration < 1000; duration += 113) {
+         double expected = large_utilization_max(ta, n, start, duration);
+         double uti = utilization_max(cr, start, duration, false);
+         if (uti != expected) {
+            printf("failed: utilization(cr, " sge_u64 ", " sge_u64 ") returned %f with timeline, expected %f\n",
+                   start, duration, uti, expected);
+            ret++;
+         }
+      }
+   }
+   utilization_timeline_remove(cr);
+
+   return ret;
+}
+
+static int test_large_utilization() {
+   int ret = 0;
+   test_array_t ta[LARGE_RESERVATIONS];
+   u_long32 seed = 4711;
+
+   printf("\n - test large resource diagram - \n\n");
+
+   lListElem *cr = lCreateElem(RUE_Type);
+   lSetString(cr, RUE_name, "slots");
+
+   for (int i = 0; i < LARGE_RESERVATIONS; i++) {
+      seed = seed * 1103515245 + 12345;
+      ta[i].start_time = 1000 + (seed >> 8) % 3000;
+      seed = seed * 1103515245 + 12345;
+      ta[i].duration = 10 + (seed >> 8) % 500;
+      ta[i].uti = 1 + i % 4;
+      utilization_add(cr, ta[i].start_time, ta[i].duration, ta[i].uti, 100 + i, 1, PE_TAG, "pe_slots",
+                      "RESERVING", false, false);
+   }
+
+   printf("diagram has %d entries\n", lGetNumberOfElem(lGetList(cr, RUE_utilized)));
+   ret += check_large_diagram(cr, ta, LARGE_RESERVATIONS);
+   ret += check_large_queries(cr, ta, LARGE_RESERVATIONS);
+
+   // the timeline follows modifications of the diagram
+   utilization_timeline_add(cr);
+   for (int i = 0; i < LARGE_RESERVATIONS; i += 2) {
+      utilization_add(cr, ta[i].start_time, ta[i].duration, -ta[i].uti, 100 + i, 1, PE_TAG, "pe_slots",
+                      "RESERVING", false, false);
+      ta[i].uti = 0;
+      if (i % 50 == 0) {
+         ret += check_large_queries(cr, ta, LARGE_RESERVATIONS);
+      }
+   }
+   utilization_timeline_remove(cr);
+   ret += check_large_diagram(cr, ta, LARGE_RESERVATIONS);
+   ret += check_large_queries(cr, ta, LARGE_RESERVATIONS);
+
+   for (int i = 1; i < LARGE_RESERVATIONS; i += 2) {
+      utilization_add(cr, ta[i].start_time, ta[i].duration, -ta[i].uti, 100 + i, 1, PE_TAG, "pe_slots",
+                      "RESERVING", false, false);
+   }
+   if (lGetNumberOfElem(lGetList(cr, RUE_utilized)) != 0) {
+      printf("failed: diagram has %d entries after removing all reservations\n",
+             lGetNumberOfElem(lGetList(cr, RUE_utilized)));
+      ret++;
+   }
+
+   // diagrams modified by calendars can end with a utilization
+   u_long64 times[] = {100, 200, 300, 400, 500};
+   double amounts[] = {4, 0, 8, 2, 8};
+   lList *diagram = lCreateList("calendar", RDE_Type);
+   for (int i = 0; i < 5; i++) {
+      lListElem *rde = lAddElemUlong64(&diagram, RDE_time, times[i], RDE_Type);
+      lSetDouble(rde, RDE_amount, amounts[i]);
+   }
+   lSetList(cr, RUE_utilized, diagram);
+   for (int max_util = 0; max_util < 10; max_util++) {
+      u_long64 expected = utilization_below(cr, max_util, "test", false);
+      utilization_timeline_add(cr);
+      u_long64 when = utilization_below(cr, max_util, "test", false);
+      utilization_timeline_remove(cr);
+      if (when != expected) {
+         printf("failed: utilization_below(%d) returned " sge_u64 " with timeline, expected " sge_u64 "\n",
+                max_util, when, expected);
+         ret++;
+      }
+   }
+
+   if (ret == 0) {
+      printf("success: large resource diagram\n");
+   }
+
+   lFreeElem(&cr);
+   return ret;
+}
@@ -0,0 +1,160 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <pthread.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_time.h"
+
+#include "cull/cull.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/ocs_DataStore.h"
+
+// A writer thread (like an event mirror thread) modifies the READER data store while reader threads
+// pin published versions. Readers have to see the version that was published when they pinned it.
+
+static pthread_mutex_t test_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t test_cond = PTHREAD_COND_INITIALIZER;
+static int reader_state = 0;
+
+static const char *
+get_calendar_name() {
+   const lList *calendar_list = *ocs::DataStore::get_master_list(SGE_TYPE_CALENDAR);
+   return lGetString(lFirst(calendar_list), CAL_name);
+}
+
+static void
+set_calendar_name(const char *name) {
+   lList **calendar_list = ocs::DataStore::get_master_list_rw(SGE_TYPE_CALENDAR);
+   lFreeList(calendar_list);
+   lAddElemStr(calendar_list, CAL_name, name, CAL_Type);
+}
+
+static void
+set_reader_state(int state) {
+   pthread_mutex_lock(&test_mutex);
+   reader_state = state;
+   pthread_cond_broadcast(&test_cond);
+   pthread_mutex_unlock(&test_mutex);
+}
+
+static void
+wait_for_reader_state(int state) {
+   pthread_mutex_lock(&test_mutex);
+   while (reader_state != state) {
+      pthread_cond_wait(&test_cond, &test_mutex);
+   }
+   pthread_mutex_unlock(&test_mutex);
+}
+
+static void *
+reader_thread(void *arg) {
+   auto *errors = static_cast<int *>(arg);
+
+   ocs::DataStore::select_active_ds(ocs::DataStore::READER);
+
+   // pin the first version and keep it while the writer publishes a second one
+   ocs::DataStore::pin_version();
+   const char *name = get_calendar_name();
+   set_reader_state(1);
+   wait_for_reader_state(2);
+   if (name == nullptr || strcmp(name, "first") != 0 || strcmp(get_calendar_name(), "first") != 0) {
+      fprintf(stderr, "pinned version was modified\n");
+      (*errors)++;
+   }
+
+   // keep the pin for some time. the writer has to wait before it can reuse this version
+   sleep(1);
+   set_reader_state(3);
+   ocs::DataStore::unpin_version();
+
+   // a new pin returns the most recent version
+   ocs::DataStore::pin_version();
+   name = get_calendar_name();
+   if (name == nullptr || strcmp(name, "second") != 0) {
+      fprintf(stderr, "expected the second version but got %s\n", name != nullptr ? name : "nullptr");
+      (*errors)++;
+   }
+   ocs::DataStore::unpin_version();
+
+   return nullptr;
+}
+
+int main(int argc, char *argv[]) {
+   DENTER_MAIN(TOP_LAYER, "test_sgeobj_DataStore");
+   int errors = 0;
+   pthread_t reader;
+
+   lInit(nmv);
+
+   // the writer publishes the first version
+   ocs::DataStore::select_active_ds(ocs::DataStore::READER);
+   ocs::DataStore::select_unused_version();
+   set_calendar_name("first");
+   ocs::DataStore::publish_version();
+
+   pthread_create(&reader, nullptr, reader_thread, &errors);
+   wait_for_reader_state(1);
+
+   // modify the unused version while the reader holds the first one
+   ocs::DataStore::select_unused_version();
+   set_calendar_name("second");
+   ocs::DataStore::publish_version();
+   set_reader_state(2);
+
+   // selecting the version that is still pinned has to block till the reader releases it
+   ocs::DataStore::select_unused_version();
+   pthread_mutex_lock(&test_mutex);
+   if (reader_state != 3) {
+      fprintf(stderr, "writer got a version that is still pinned by a reader\n");
+      errors++;
+   }
+   pthread_mutex_unlock(&test_mutex);
+
+   pthread_join(reader, nullptr);
+
+   // a total update rebuilds the selected version as copy of the published one
+   ocs::DataStore::copy_published_version();
+   const char *name = get_calendar_name();
+   if (name == nullptr || strcmp(name, "second") != 0) {
+      fprintf(stderr, "expected a copy of the published version but got %s\n", name != nullptr ? name : "nullptr");
+      errors++;
+   }
+   set_calendar_name("third");
+   ocs::DataStore::pin_version();
+   name = get_calendar_name();
+   if (name == nullptr || strcmp(name, "second") != 0) {
+      fprintf(stderr, "modification of the copy is visible in the published version\n");
+      errors++;
+   }
+   ocs::DataStore::unpin_version();
+
+   ocs::DataStore::free_all_master_lists();
+
+   if (errors == 0) {
+      printf("data store versions ok\n");
+   }
+   DRETURN(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
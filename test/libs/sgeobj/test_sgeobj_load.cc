@@ -0,0 +1,110 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "uti/sge_rmon_macros.h"
+
+#include "cull/cull.h"
+
+#include "sgeobj/cull/sge_all_listsL.h"
+#include "sgeobj/sge_load.h"
+
+#include "basis_types.h"
+
+// load_set_value() parses numeric load values once, load_get_double() has to return the same
+// value as parsing the string with parse_ulong_val() would do.
+
+typedef struct {
+   const char *value;
+   u_long32 type;
+   bool valid;
+   bool numeric;
+   double expected;
+} load_test_t;
+
+static int
+check(lListElem *load_el, const load_test_t *test) {
+   double dval = -1.0;
+   bool valid = load_get_double(load_el, test->type, &dval);
+
+   if (valid != test->valid || (valid && dval != test->expected)) {
+      printf("load value \"%s\" (type %d): got %s %f, expected %s %f\n", test->value, (int)test->type,
+             valid ? "valid" : "invalid", dval, test->valid ? "valid" : "invalid", test->expected);
+      return 1;
+   }
+   return 0;
+}
+
+int main(int argc, char *argv[]) {
+   DENTER_MAIN(TOP_LAYER, "test_sgeobj_load");
+   int errors = 0;
+
+   load_test_t tests[] = {
+      {"0.25", TYPE_DOUBLE, true, true, 0.25},
+      {"4", TYPE_INT, true, true, 4},
+      {"1K", TYPE_MEM, true, true, 1024},
+      {"2.000G", TYPE_MEM, true, true, 2.0 * 1024 * 1024 * 1024},
+      {"true", TYPE_BOO, true, true, 1},
+      {"0:1:0", TYPE_TIM, true, true, 60},
+      {"lx-amd64", TYPE_DOUBLE, false, false, 0},
+      {"lx-amd64", TYPE_STR, false, false, 0},
+      {"4", TYPE_STR, false, true, 0},
+      {nullptr, 0, false, false, 0}
+   };
+
+   lInit(nmv);
+
+   lListElem *load_el = lCreateElem(HL_Type);
+   lSetString(load_el, HL_name, "test");
+
+   for (int i = 0; tests[i].value != nullptr; i++) {
+      // value set with load_set_value() uses the parsed value
+      load_set_value(load_el, tests[i].value);
+      if (lGetBool(load_el, HL_is_numeric) != tests[i].numeric) {
+         printf("load value \"%s\": HL_is_numeric is not set correctly\n", tests[i].value);
+         errors++;
+      }
+      errors += check(load_el, &tests[i]);
+
+      // value set directly is parsed on access
+      lSetString(load_el, HL_value, tests[i].value);
+      lSetBool(load_el, HL_is_numeric, false);
+      errors += check(load_el, &tests[i]);
+   }
+
+   // elements without the numeric fields (e.g. from an old spooling database) are parsed on access
+   lEnumeration *what = lWhat("%T(%I %I)", HL_Type, HL_name, HL_value);
+   lDescr *descr = lGetReducedDescr(HL_Type, what);
+   lListElem *reduced = lCreateElem(descr);
+   load_set_value(reduced, "2.000G");
+   errors += check(reduced, &tests[3]);
+   lFreeElem(&reduced);
+   sge_free(&descr);
+   lFreeWhat(&what);
+
+   lFreeElem(&load_el);
+
+   if (errors == 0) {
+      printf("load values ok\n");
+   }
+   DRETURN(errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
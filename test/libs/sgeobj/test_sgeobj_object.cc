@@ -189,5 +189,44 @@ int main(int argc, char *argv[])
 
    lFreeElem(&queue);
 
+   /* object_is_delta and object_apply_delta */
+   {
+      const int delta_field[] = {QU_full_name, QU_qname, QU_resource_utilization, NoName};
+      lEnumeration *what = lIntVector2What(QU_Type, delta_field);
+      lList *queue_list = nullptr;
+      lListElem *delta;
+
+      queue = lAddElemStr(&queue_list, QU_full_name, "all.q@host", QU_Type);
+      lSetString(queue, QU_qname, "all.q");
+      lSetHost(queue, QU_qhostname, "host");
+      lAddSubStr(queue, RUE_name, "old", QU_resource_utilization, RUE_Type);
+
+      lSetString(queue, QU_qname, "new.q");
+      lAddSubStr(queue, RUE_name, "new", QU_resource_utilization, RUE_Type);
+      delta = lSelectElemPack(queue, nullptr, what, false, nullptr);
+      lSetString(queue, QU_qname, "all.q");
+      lFreeList(lGetListRef(queue, QU_resource_utilization));
+      lAddSubStr(queue, RUE_name, "old", QU_resource_utilization, RUE_Type);
+
+      ret_bool = object_is_delta(queue, delta);
+      check_result_bool(ret_bool, true, "object_is_delta");
+      ret_bool = object_is_delta(delta, queue);
+      check_result_bool(ret_bool, false, "object_is_delta");
+      ret_bool = object_is_delta(queue, queue);
+      check_result_bool(ret_bool, false, "object_is_delta");
+
+      ret_bool = object_apply_delta(queue, delta);
+      check_result_bool(ret_bool, true, "object_apply_delta");
+      check_result_string(lGetString(queue, QU_qname), "new.q", "object_apply_delta");
+      check_result_string(lGetHost(queue, QU_qhostname), "host", "object_apply_delta");
+      check_result_int(lGetNumberOfElem(lGetList(queue, QU_resource_utilization)), 2, "object_apply_delta");
+      ret_bool = lGetSubStr(queue, RUE_name, "new", QU_resource_utilization) != nullptr;
+      check_result_bool(ret_bool, true, "object_apply_delta");
+
+      lFreeElem(&delta);
+      lFreeWhat(&what);
+      lFreeList(&queue_list);
+   }
+
    return exit_code;
 }
@@ -0,0 +1,286 @@
+/*___INFO__MARK_BEGIN_NEW__*/
+/***************************************************************************
+ *
+ *  Copyright 2024 HPC-Gridware GmbH
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ ***************************************************************************/
+/*___INFO__MARK_END_NEW__*/
+
+#include <pthread.h>
+#include <unistd.h>
+#include <cstdio>
+
+#include "test_uti_lock_main.h"
+
+#include "uti/sge_lock.h"
+#include "uti/sge_fgl.h"
+#include "uti/sge_rmon_macros.h"
+#include "uti/sge_time.h"
+
+// Threads lock the global lock alternating in LOCK_READ, LOCK_FGL and LOCK_WRITE mode
+// and verify that readers and fine-grained lockers never hold the lock at the same time.
+
+#define THREAD_COUNT 6
+#define THREAD_RUN_TIME 3
+
+static pthread_mutex_t mutex_lock = PTHREAD_MUTEX_INITIALIZER;
+static int thread_count = 0;
+static int readers = 0;
+static int fgl_holders = 0;
+static int writers = 0;
+static int max_fgl_holders = 0;
+static int errors = 0;
+
+static void *thread_function(void *anArg);
+
+int get_thread_demand() {
+   return THREAD_COUNT;
+}
+
+void *(*get_thread_func())(void *anArg) {
+   return thread_function;
+}
+
+void *get_thread_func_arg() {
+   return nullptr;
+}
+
+void set_thread_count(int count) {
+   thread_count = 0;
+   max_fgl_holders = 0;
+
+   SGE_LOCK(LOCK_GLOBAL, LOCK_WRITE);
+   sge_lock_set_fgl(LOCK_GLOBAL, true);
+   SGE_UNLOCK(LOCK_GLOBAL, LOCK_WRITE);
+}
+
+static void enter(int *counter) {
+   pthread_mutex_lock(&mutex_lock);
+   (*counter)++;
+   if (readers > 0 && fgl_holders > 0) {
+      printf("error: %d reader(s) and %d fgl holder(s) own the lock at the same time\n", readers, fgl_holders);
+      errors++;
+   }
+   if (writers > 0 && (writers + readers + fgl_holders) > 1) {
+      printf("error: a writer does not own the lock exclusively\n");
+      errors++;
+   }
+   if (fgl_holders > max_fgl_holders) {
+      max_fgl_holders = fgl_holders;
+   }
+   pthread_mutex_unlock(&mutex_lock);
+}
+
+static void leave(int *counter) {
+   pthread_mutex_lock(&mutex_lock);
+   (*counter)--;
+   pthread_mutex_unlock(&mutex_lock);
+}
+
+static bool check_try_lock() {
+   bool ret = true;
+
+   // fgl holders share the lock but exclude readers and writers
+   SGE_LOCK(LOCK_GLOBAL, LOCK_FGL);
+   if (!SGE_TRY_LOCK(LOCK_GLOBAL, LOCK_FGL)) {
+      printf("error: second LOCK_FGL could not be acquired\n");
+      ret = false;
+   } else {
+      SGE_UNLOCK(LOCK_GLOBAL, LOCK_FGL);
+   }
+   if (SGE_TRY_LOCK(LOCK_GLOBAL, LOCK_READ)) {
+      printf("error: LOCK_READ acquired while LOCK_FGL is held\n");
+      SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+      ret = false;
+   }
+   if (SGE_TRY_LOCK(LOCK_GLOBAL, LOCK_WRITE)) {
+      printf("error: LOCK_WRITE acquired while LOCK_FGL is held\n");
+      SGE_UNLOCK(LOCK_GLOBAL, LOCK_WRITE);
+      ret = false;
+   }
+   SGE_UNLOCK(LOCK_GLOBAL, LOCK_FGL);
+
+   // readers exclude fgl holders
+   SGE_LOCK(LOCK_GLOBAL, LOCK_READ);
+   if (SGE_TRY_LOCK(LOCK_GLOBAL, LOCK_FGL)) {
+      printf("error: LOCK_FGL acquired while LOCK_READ is held\n");
+      SGE_UNLOCK(LOCK_GLOBAL, LOCK_FGL);
+      ret = false;
+   }
+   SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+
+   // after all locks have been released everything is possible again
+   if (!SGE_TRY_LOCK(LOCK_GLOBAL, LOCK_WRITE)) {
+      printf("error: LOCK_WRITE could not be acquired\n");
+      ret = false;
+   } else {
+      SGE_UNLOCK(LOCK_GLOBAL, LOCK_WRITE);
+   }
+   return ret;
+}
+
+static bool check_disabled_fgl() {
+   bool ret = true;
+
+   SGE_LOCK(LOCK_GLOBAL, LOCK_WRITE);
+   sge_lock_set_fgl(LOCK_GLOBAL, false);
+   SGE_UNLOCK(LOCK_GLOBAL, LOCK_WRITE);
+
+   // without fine-grained locking LOCK_FGL is exclusive
+   SGE_LOCK(LOCK_GLOBAL, LOCK_FGL);
+   if (SGE_TRY_LOCK(LOCK_GLOBAL, LOCK_FGL)) {
+      printf("error: LOCK_FGL shared although fine-grained locking is disabled\n");
+      SGE_UNLOCK(LOCK_GLOBAL, LOCK_FGL);
+      ret = false;
+   }
+   if (SGE_TRY_LOCK(LOCK_GLOBAL, LOCK_READ)) {
+      printf("error: LOCK_READ acquired while LOCK_FGL is held\n");
+      SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+      ret = false;
+   }
+   SGE_UNLOCK(LOCK_GLOBAL, LOCK_FGL);
+
+   // readers still share the lock
+   SGE_LOCK(LOCK_GLOBAL, LOCK_READ);
+   if (!SGE_TRY_LOCK(LOCK_GLOBAL, LOCK_READ)) {
+      printf("error: second LOCK_READ could not be acquired\n");
+      ret = false;
+   } else {
+      SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+   }
+   SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+
+   if (!SGE_TRY_LOCK(LOCK_GLOBAL, LOCK_WRITE)) {
+      printf("error: LOCK_WRITE could not be acquired\n");
+      ret = false;
+   } else {
+      SGE_UNLOCK(LOCK_GLOBAL, LOCK_WRITE);
+   }
+   return ret;
+}
+
+static bool rsv_holder_active = false;
+static bool rsv_holder_locked = false;
+
+static void *rsv_holder_function(void *anArg) {
+   const char *object = (const char *) anArg;
+
+   fgl_clear();
+   fgl_add_r(1, false);
+   fgl_add_s(1, object, true);
+   fgl_lock();
+
+   pthread_mutex_lock(&mutex_lock);
+   rsv_holder_locked = true;
+   rsv_holder_active = true;
+   pthread_mutex_unlock(&mutex_lock);
+
+   usleep(200000);
+
+   pthread_mutex_lock(&mutex_lock);
+   rsv_holder_active = false;
+   pthread_mutex_unlock(&mutex_lock);
+
+   fgl_unlock();
+   fgl_clear();
+   return nullptr;
+}
+
+static bool check_reservations() {
+   bool ret = true;
+   pthread_t holder;
+   char object[] = "object";
+
+   // a read-only reservation has to wait for a read-write reservation of the same object
+   rsv_holder_locked = false;
+   pthread_create(&holder, nullptr, rsv_holder_function, object);
+   while (true) {
+      pthread_mutex_lock(&mutex_lock);
+      bool locked = rsv_holder_locked;
+      pthread_mutex_unlock(&mutex_lock);
+      if (locked) {
+         break;
+      }
+      usleep(1000);
+   }
+
+   fgl_clear();
+   fgl_add_r(1, false);
+   fgl_add_s(1, object, false);
+   fgl_lock();
+   pthread_mutex_lock(&mutex_lock);
+   if (rsv_holder_active) {
+      printf("error: RO reservation granted while the same object is reserved RW\n");
+      ret = false;
+   }
+   pthread_mutex_unlock(&mutex_lock);
+   fgl_unlock();
+   fgl_clear();
+
+   pthread_join(holder, nullptr);
+   return ret;
+}
+
+static void *thread_function(void *anArg) {
+   const u_long64 start = sge_get_gmt64();
+
+   DENTER(TOP_LAYER);
+
+   pthread_mutex_lock(&mutex_lock);
+   int thread_id = thread_count++;
+   pthread_mutex_unlock(&mutex_lock);
+
+   for (int i = thread_id; ; i++) {
+      if (i % 10 == 0) {
+         SGE_LOCK(LOCK_GLOBAL, LOCK_WRITE);
+         enter(&writers);
+         usleep(100);
+         leave(&writers);
+         SGE_UNLOCK(LOCK_GLOBAL, LOCK_WRITE);
+      } else if (i % 2 == 0) {
+         SGE_LOCK(LOCK_GLOBAL, LOCK_READ);
+         enter(&readers);
+         usleep(500);
+         leave(&readers);
+         SGE_UNLOCK(LOCK_GLOBAL, LOCK_READ);
+      } else {
+         SGE_LOCK(LOCK_GLOBAL, LOCK_FGL);
+         enter(&fgl_holders);
+         usleep(500);
+         leave(&fgl_holders);
+         SGE_UNLOCK(LOCK_GLOBAL, LOCK_FGL);
+      }
+
+      if (sge_get_gmt64() - start >= sge_gmt32_to_gmt64(THREAD_RUN_TIME)) {
+         break;
+      }
+   }
+
+   DRETURN(nullptr);
+}
+
+int validate(int count) {
+   if (!check_try_lock()) {
+      errors++;
+   }
+   if (!check_disabled_fgl()) {
+      errors++;
+   }
+   if (!check_reservations()) {
+      errors++;
+   }
+   printf("%d thread(s): up to %d fgl holder(s) shared the lock\n", count, max_fgl_holders);
+   return errors;
+}
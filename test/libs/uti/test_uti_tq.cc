@@ -236,9 +236,52 @@ test_mt_consumer_producer() {
    DRETURN(ret);
 }
 
+/*
+ * Scenario: non-blocking access
+ * - tasks of different types are stored in a queue
+ * - sge_tq_get_task() returns the tasks of a specific type in FIFO order
+ *   and nullptr if there is no task of that type
+ */
+bool
+test_get_task() {
+   bool ret = true;
+   sge_tq_queue_t *queue = nullptr;
+   static const char *t1_a = "t1_a";
+   static const char *t1_b = "t1_b";
+   static const char *t2_a = "t2_a";
+
+   DENTER(TOP_LAYER);
+
+   ret = sge_tq_create(&queue);
+   if (ret) {
+      const char *data = nullptr;
+
+      sge_tq_store_notify(queue, SGE_TQ_TYPE1, (void *)t1_a);
+      sge_tq_store_notify(queue, SGE_TQ_TYPE2, (void *)t2_a);
+      sge_tq_store_notify(queue, SGE_TQ_TYPE1, (void *)t1_b);
+
+      ret &= sge_tq_get_task(queue, SGE_TQ_TYPE1, (void **) &data);
+      ret &= data == t1_a;
+      ret &= sge_tq_get_task(queue, SGE_TQ_TYPE1, (void **) &data);
+      ret &= data == t1_b;
+      ret &= sge_tq_get_task(queue, SGE_TQ_TYPE1, (void **) &data);
+      ret &= data == nullptr;
+      ret &= sge_tq_get_task(queue, SGE_TQ_UNKNOWN, (void **) &data);
+      ret &= data == t2_a;
+      ret &= sge_tq_get_task_count(queue) == 0;
+      if (!ret) {
+         fprintf(stderr, "sge_tq_get_task() returned unexpected tasks in %s()\n", __func__);
+      }
+      sge_tq_destroy(&queue);
+   }
+
+   DRETURN(ret);
+}
+
 int main(int argc, char *argv[]) {
    DENTER_MAIN(TOP_LAYER, "test_sl");
-   bool ret = test_mt_consumer_producer();
+   bool ret = test_get_task();
+   ret &= test_mt_consumer_producer();
    DRETURN(ret ? 0 : 1);
 }
 